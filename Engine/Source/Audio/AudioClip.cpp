@@ -8,6 +8,8 @@
 #include <miniaudio.h>
 
 #include "Containers/StringConversion.h"
+#include "IO/FileStream.h"
+#include "IO/MemoryStream.h"
 
 namespace Nova
 {
@@ -39,65 +41,126 @@ namespace Nova
 
         if (!audioSystem) return false;
 
-        if (m_Initialized)
+        Uninitialize();
+
+        if (flags & AudioPlaybackFlagBits::FullInMemory)
         {
-            ma_sound_uninit(&m_Handle);
-            ma_decoder_uninit(&m_Decoder);
-            if (m_FFTNode) m_FFTNode->Destroy();
-            m_InternalBuffer.Free();
+            // Clips held in memory are decoded once at the device format and shared by every voice
+            const ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, audioSystem->GetOutputChannelCount(), audioSystem->GetOutputSampleRate());
+            ma_decoder decoder;
+            const ma_result result = ma_decoder_init_file_w(*StringConvertToWide(filepath), &decoderConfig, &decoder);
+            if (result != MA_SUCCESS) return false;
+
+            const bool decoded = DecodeToPcm(audioSystem, decoder);
+            ma_decoder_uninit(&decoder);
+            if (!decoded) return false;
+
+            return InitializeFromPcm(audioSystem, flags);
         }
 
-        const ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_s16, 2, 44100);
-        ma_result result = ma_decoder_init_file_w(*StringConvertToWide(filepath), &decoderConfig, &m_Decoder);
-        if (result != MA_SUCCESS) return false;
+        FileStream* stream = new FileStream(filepath, OpenModeFlagBits::ReadBinary);
+        if (!stream->IsOpened())
+        {
+            delete stream;
+            return false;
+        }
 
-        const uint32_t maflags = GetMiniaudioPlaybackFlags(flags);
+        return InitializeFromStream(audioSystem, stream, true, flags);
+    }
 
-        result = ma_sound_init_from_data_source(audioSystem->GetHandle(), &m_Decoder, maflags, nullptr, &m_Handle);
-        if (result != MA_SUCCESS) return false;
+    bool AudioClip::LoadFromMemory(const void* data, const size_t size, const AudioPlaybackFlags flags)
+    {
+        AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem)
+            return false;
 
+        Uninitialize();
 
-        if (flags & AudioPlaybackFlagBits::ComputeFFT)
+        if (flags & AudioPlaybackFlagBits::FullInMemory)
         {
-            m_FFTNode = new FFTAudioNode();
-            if (!m_FFTNode->Initialize(audioSystem))
-                return false;
-            if (!audioSystem->AttachAudioNodeToOutputBus(m_FFTNode))
-                return false;
+            // Decoded right away, the encoded data does not need to outlive this call
+            const ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, audioSystem->GetOutputChannelCount(), audioSystem->GetOutputSampleRate());
+            ma_decoder decoder;
+            const ma_result result = ma_decoder_init_memory(data, size, &decoderConfig, &decoder);
+            if (result != MA_SUCCESS) return false;
 
-            if (!ConnectToNode(m_FFTNode))
-                return false;
+            const bool decoded = DecodeToPcm(audioSystem, decoder);
+            ma_decoder_uninit(&decoder);
+            if (!decoded) return false;
+
+            return InitializeFromPcm(audioSystem, flags);
         }
 
-        m_PlaybackFlags = flags;
-        m_Initialized = true;
-        return true;
+        // Streamed clips keep their own copy of the encoded data since decoding happens over time
+        m_InternalBuffer = { (uint8_t*)data, size };
+        MemoryStream* stream = new MemoryStream(BufferView<uint8_t>(m_InternalBuffer.Data(), m_InternalBuffer.Count()));
+        return InitializeFromStream(audioSystem, stream, true, flags);
     }
 
-    bool AudioClip::LoadFromMemory(const void* data, const size_t size, const AudioPlaybackFlags flags)
+    bool AudioClip::LoadFromStream(Stream* stream, const AudioPlaybackFlags flags)
     {
         AudioDevice* audioSystem = AudioDevice::GetInstance();
-        if (!audioSystem)
+        if (!audioSystem || !stream || !stream->IsOpened())
             return false;
 
-        if (m_Initialized)
+        if (flags & AudioPlaybackFlagBits::FullInMemory)
         {
-            ma_sound_uninit(&m_Handle);
-            ma_decoder_uninit(&m_Decoder);
-            m_FFTNode->Destroy();
-            m_InternalBuffer.Free();
+            stream->Seek(Seek::End, 0);
+            const Stream::OffsetType size = stream->Tell();
+            stream->Seek(Seek::Begin, 0);
+            if (size <= 0) return false;
+
+            Array<uint8_t> data((size_t)size);
+            if (stream->ReadRaw(data.Data(), data.Count()) != data.Count())
+                return false;
+            return LoadFromMemory(data.Data(), data.Count(), flags);
         }
 
-        m_InternalBuffer = { (uint8_t*)data, size };
+        Uninitialize();
+        return InitializeFromStream(audioSystem, stream, false, flags);
+    }
 
-        const ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_s16, 2, 44100);
-        ma_result result = ma_decoder_init_memory(m_InternalBuffer.Data(), m_InternalBuffer.Size(), &decoderConfig, &m_Decoder);
+    void AudioClip::Destroy()
+    {
+        Uninitialize();
+    }
+
+    bool AudioClip::InitializeFromPcm(AudioDevice* audioSystem, const AudioPlaybackFlags flags)
+    {
+        const ma_result result = ma_audio_buffer_ref_init(ma_format_f32, audioSystem->GetOutputChannelCount(), m_PcmFrames.Data(), m_PcmFrameCount, &m_PcmBuffer);
         if (result != MA_SUCCESS) return false;
 
+        return InitializeSound(audioSystem, &m_PcmBuffer, flags);
+    }
+
+    bool AudioClip::InitializeFromStream(AudioDevice* audioSystem, Stream* stream, const bool ownsStream, const AudioPlaybackFlags flags)
+    {
+        // Half a second of decoded audio is kept ahead of the mixer, whatever the length of the track
+        const uint32_t bufferFrames = audioSystem->GetOutputSampleRate() / 2;
+        if (!m_StreamSource.Initialize(audioSystem, stream, ownsStream, bufferFrames))
+        {
+            m_StreamSource.Destroy();
+            return false;
+        }
+
+        audioSystem->GetStreamer().Register(&m_StreamSource);
+        m_IsStreaming = true;
+        return InitializeSound(audioSystem, m_StreamSource.GetDataSource(), flags);
+    }
+
+    bool AudioClip::InitializeSound(AudioDevice* audioSystem, ma_data_source* dataSource, const AudioPlaybackFlags flags)
+    {
         const uint32_t maflags = GetMiniaudioPlaybackFlags(flags);
 
-        result = ma_sound_init_from_data_source(audioSystem->GetHandle(), &m_Decoder, maflags, nullptr, &m_Handle);
-        if (result != MA_SUCCESS) return false;
+        m_Handle = Memory::Malloc<ma_sound>(1, MemoryTag::Audio);
+        const ma_result result = ma_sound_init_from_data_source(audioSystem->GetHandle(), dataSource, maflags, nullptr, m_Handle);
+        if (result != MA_SUCCESS)
+        {
+            Memory::Free(m_Handle);
+            m_Handle = nullptr;
+            return false;
+        }
+        m_Initialized = true;
 
         if (flags & AudioPlaybackFlagBits::ComputeFFT)
         {
@@ -111,19 +174,90 @@ namespace Nova
                 return false;
         }
 
-        m_Initialized = true;
         m_PlaybackFlags = flags;
         return true;
     }
 
-    void AudioClip::Destroy()
+    bool AudioClip::DecodeToPcm(AudioDevice* audioSystem, ma_decoder& decoder)
+    {
+        const uint32_t channels = audioSystem->GetOutputChannelCount();
+
+        ma_uint64 frameCount = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&decoder, &frameCount) == MA_SUCCESS && frameCount != 0)
+        {
+            m_PcmFrames = Array<float>(frameCount * channels);
+            ma_uint64 framesRead = 0;
+            ma_decoder_read_pcm_frames(&decoder, m_PcmFrames.Data(), frameCount, &framesRead);
+            m_PcmFrameCount = framesRead;
+            return m_PcmFrameCount != 0;
+        }
+
+        // Length is unknown for some encodings, decode chunk by chunk until the decoder runs dry
+        constexpr ma_uint64 chunkFrames = 4096;
+        Array<float> chunk(chunkFrames * channels);
+        while (true)
+        {
+            ma_uint64 framesRead = 0;
+            const ma_result result = ma_decoder_read_pcm_frames(&decoder, chunk.Data(), chunkFrames, &framesRead);
+            m_PcmFrames.AddRange(chunk.Data(), framesRead * channels);
+            m_PcmFrameCount += framesRead;
+            if (result != MA_SUCCESS || framesRead < chunkFrames)
+                break;
+        }
+        return m_PcmFrameCount != 0;
+    }
+
+    void AudioClip::Uninitialize()
     {
+        AudioDevice* audioSystem = AudioDevice::GetInstance();
+        bool pcmReleased = true;
+        bool commandsApplied = true;
+        if (audioSystem)
+        {
+            pcmReleased = audioSystem->GetVoicePool().ReleaseClip(this);
+            // Pending source commands may still point at this sound
+            commandsApplied = audioSystem->FlushCommands();
+        }
+
         if (m_Initialized)
         {
-            ma_sound_uninit(&m_Handle);
-            ma_decoder_uninit(&m_Decoder);
+            if (commandsApplied)
+            {
+                ma_sound_uninit(m_Handle);
+                Memory::Free(m_Handle);
+            }
+            else
+            {
+                // The audio thread stalled before applying them, the device uninitializes the sound once it did
+                audioSystem->RetireSound(m_Handle);
+            }
+            m_Handle = nullptr;
         }
-        if (m_FFTNode) m_FFTNode->Destroy();
+
+        if (m_IsStreaming)
+        {
+            if (audioSystem)
+                audioSystem->GetStreamer().Unregister(&m_StreamSource);
+            m_StreamSource.Destroy();
+            m_IsStreaming = false;
+        }
+
+        if (m_PcmFrameCount != 0)
+            ma_audio_buffer_ref_uninit(&m_PcmBuffer);
+
+        if (m_FFTNode)
+        {
+            m_FFTNode->Destroy();
+            m_FFTNode = nullptr;
+        }
+
+        // A stalled audio thread may still be mixing a voice of this clip
+        if (!pcmReleased)
+            audioSystem->RetirePcmFrames(Memory::Move(m_PcmFrames));
+
+        m_InternalBuffer.Clear();
+        m_PcmFrames = Array<float>();
+        m_PcmFrameCount = 0;
         m_Initialized = false;
     }
 
@@ -134,17 +268,17 @@ namespace Nova
 
     ma_sound* AudioClip::GetHandle()
     {
-        return &m_Handle;
+        return m_Handle;
     }
 
     const ma_sound* AudioClip::GetHandle() const
     {
-        return &m_Handle;
+        return m_Handle;
     }
 
     Array<uint8_t> AudioClip::GetSamples() const
     {
-        ma_data_source* source = ma_sound_get_data_source(&m_Handle);
+        ma_data_source* source = ma_sound_get_data_source(m_Handle);
         if (!source) return {};
 
         const AudioFormat format = GetFormat();
@@ -163,7 +297,7 @@ namespace Nova
         ma_format format;
         ma_uint32 channels;
         ma_uint32 sampleRate;
-        const ma_result result = ma_sound_get_data_format(&m_Handle, &format, &channels, &sampleRate, nullptr, 0);
+        const ma_result result = ma_sound_get_data_format(m_Handle, &format, &channels, &sampleRate, nullptr, 0);
         if (result != MA_SUCCESS) return {};
 
         uint8_t bytesPerSample = 0;
@@ -187,7 +321,7 @@ namespace Nova
 
     bool AudioClip::ConnectToNode(Ref<AudioNode> audioNode)
     {
-        const ma_result result = ma_node_attach_output_bus(&m_Handle, 0, audioNode->GetHandle(), 0);
+        const ma_result result = ma_node_attach_output_bus(m_Handle, 0, audioNode->GetHandle(), 0);
         return result == MA_SUCCESS;
     }
 
@@ -199,7 +333,7 @@ namespace Nova
     float AudioClip::GetDurationSeconds() const
     {
         float duration = 0.0f;
-        const ma_result result = ma_sound_get_length_in_seconds(&m_Handle, &duration);
+        const ma_result result = ma_sound_get_length_in_seconds(m_Handle, &duration);
         if (result != MA_SUCCESS) return 0.0f;
         return duration;
     }
@@ -207,7 +341,7 @@ namespace Nova
     uint64_t AudioClip::GetDurationFrames() const
     {
         uint64_t frames = 0;
-        const ma_result result = ma_sound_get_length_in_pcm_frames(&m_Handle, &frames);
+        const ma_result result = ma_sound_get_length_in_pcm_frames(m_Handle, &frames);
         if (result != MA_SUCCESS) return 0.0f;
         return frames;
     }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "AudioFormat.h"
+#include "AudioStream.h"
 #include "FFTAudioNode.h"
 #include "Runtime/Asset.h"
 #include "Containers/StringView.h"
@@ -26,6 +27,8 @@ namespace Nova
     NOVA_DECLARE_FLAGS(AudioPlaybackFlagBits, AudioPlaybackFlags);
 
     class AudioNode;
+    class AudioDevice;
+    class Stream;
 
     class AudioClip final : public Asset
     {
@@ -34,6 +37,8 @@ namespace Nova
         ~AudioClip() override = default;
         bool LoadFromFile(StringView filepath, AudioPlaybackFlags flags);
         bool LoadFromMemory(const void* data, size_t size, AudioPlaybackFlags flags);
+        // The stream is not owned, it must outlive the clip unless FullInMemory is set
+        bool LoadFromStream(Stream* stream, AudioPlaybackFlags flags);
         void Destroy() override;
 
         AssetType GetAssetType() const override;
@@ -45,6 +50,12 @@ namespace Nova
 
         Array<uint8_t> GetSamples() const;
 
+        // Decoded f32 frames at the device format, only available for FullInMemory clips.
+        // Shared by every voice playing this clip.
+        bool HasPcmData() const { return m_PcmFrameCount != 0; }
+        const float* GetPcmFrames() const { return m_PcmFrames.Data(); }
+        uint64_t GetPcmFrameCount() const { return m_PcmFrameCount; }
+
         AudioFormat GetFormat() const;
 
         bool ConnectToNode(Ref<AudioNode> audioNode);
@@ -52,9 +63,20 @@ namespace Nova
 
         bool IsValid() const { return m_Initialized;}
     private:
-        ma_sound m_Handle;
-        ma_decoder m_Decoder;
+        bool InitializeFromPcm(AudioDevice* audioSystem, AudioPlaybackFlags flags);
+        bool InitializeFromStream(AudioDevice* audioSystem, Stream* stream, bool ownsStream, AudioPlaybackFlags flags);
+        bool InitializeSound(AudioDevice* audioSystem, ma_data_source* dataSource, AudioPlaybackFlags flags);
+        bool DecodeToPcm(AudioDevice* audioSystem, ma_decoder& decoder);
+        void Uninitialize();
+
+        // Heap allocated, the audio device keeps it alive while queued source commands still point at it
+        ma_sound* m_Handle = nullptr;
+        ma_audio_buffer_ref m_PcmBuffer;
+        AudioStream m_StreamSource;
         Array<uint8_t> m_InternalBuffer;
+        Array<float> m_PcmFrames;
+        uint64_t m_PcmFrameCount = 0;
+        bool m_IsStreaming = false;
         AudioPlaybackFlags m_PlaybackFlags = AudioPlaybackFlagBits::None;
         Ref<FFTAudioNode> m_FFTNode = nullptr;
         bool m_Initialized = false;
@@ -0,0 +1,42 @@
+﻿#pragma once
+#include "Math/Vector3.h"
+#include "Runtime/Flags.h"
+#include <cstdint>
+#include <miniaudio.h>
+
+namespace Nova
+{
+    enum class AudioSourceParamBits
+    {
+        None = 0,
+        Volume = BIT(0),
+        Pitch = BIT(1),
+        Pan = BIT(2),
+        Looping = BIT(3),
+        Spatialization = BIT(4),
+        Position = BIT(5),
+        Velocity = BIT(6),
+        Direction = BIT(7),
+        Cone = BIT(8),
+
+        All = Volume | Pitch | Pan | Looping | Spatialization | Position | Velocity | Direction | Cone,
+    };
+
+    NOVA_DECLARE_FLAGS(AudioSourceParamBits, AudioSourceParamFlags);
+
+    // Every changed parameter of one sound packed in a single command.
+    // Only the fields flagged in dirtyParams are applied by the audio thread.
+    struct AudioSourceCommand
+    {
+        ma_sound* sound = nullptr;
+        AudioSourceParamFlags dirtyParams = AudioSourceParamBits::None;
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        float pan = 0.0f;
+        bool looping = false;
+        bool spatialized = false;
+        Vector3 position = Vector3::Zero;
+        Vector3 velocity = Vector3::Zero;
+        Vector3 direction = Vector3::Forward;
+    };
+}
@@ -1,8 +1,13 @@
 ﻿#include "AudioDevice.h"
 #include "AudioClip.h"
 #include "Runtime/Memory.h"
+#include "Math/Functions.h"
+#include "IO/Stream.h"
+#include "Runtime/Time.h"
+#include <chrono>
 #include <cstring>
 #include <print>
+#include <thread>
 
 #include "AudioNode.h"
 
@@ -20,6 +25,9 @@ namespace Nova
 {
     AudioDevice* AudioDevice::s_Instance = nullptr;
 
+    // A callback lasts a few milliseconds, one that has not returned after this long is not coming back
+    static constexpr double AudioThreadTimeout = 0.25;
+
     AudioDevice::AudioDevice()
     {
         memset(&m_Engine, 0, sizeof(ma_engine));
@@ -27,6 +35,7 @@ namespace Nova
 
     bool AudioDevice::Initialize(const AudioDeviceCreateInfo& createInfo)
     {
+        const Memory::ScopedTag memoryTag(MemoryTag::Audio);
         const ma_allocation_callbacks allocationCallbacks
         {
             this,
@@ -45,25 +54,53 @@ namespace Nova
         config.onProcess = AudioDevice::OnProcess;
         config.pProcessUserData = this;
         config.noAutoStart = true;
+        config.noDevice = createInfo.offline;
 
         ma_engine_stop(&m_Engine);
         ma_engine_uninit(&m_Engine);
         ma_result result = ma_engine_init(&config, &m_Engine);
         MA_RETURN_ON_FAIL(result);
 
-        result = ma_engine_start(&m_Engine);
-        MA_RETURN_ON_FAIL(result);
+        if (!createInfo.offline)
+        {
+            result = ma_engine_start(&m_Engine);
+            if (MA_FAILED(result))
+            {
+                ma_engine_uninit(&m_Engine);
+                return false;
+            }
+        }
 
         m_Channels = createInfo.channels;
         m_SampleRate = createInfo.sampleRate;
+        m_Offline = createInfo.offline;
         s_Instance = this;
+
+        if (!m_VoicePool.Initialize(this, createInfo.voiceCount, createInfo.maxRealVoices))
+        {
+            Destroy();
+            return false;
+        }
+
+        // Offline rendering decodes streams in lockstep with RenderFrames so the output is deterministic
+        if (!m_Streamer.Initialize(!createInfo.offline))
+        {
+            Destroy();
+            return false;
+        }
         return true;
     }
 
     void AudioDevice::Destroy()
     {
+        m_VoicePool.Destroy();
+        m_Streamer.Destroy();
         ma_engine_stop(&m_Engine);
+        ReleaseRetiredSounds();
         ma_engine_uninit(&m_Engine);
+        m_RetiredPcmFrames = Array<Array<float>>();
+        if (s_Instance == this)
+            s_Instance = nullptr;
     }
 
 
@@ -79,6 +116,202 @@ namespace Nova
         ma_sound_stop(clip->GetHandle());
     }
 
+    void AudioDevice::Update(const float deltaTime)
+    {
+        const Memory::ScopedTag memoryTag(MemoryTag::Audio);
+        m_VoicePool.Update(deltaTime);
+    }
+
+    uint64_t AudioDevice::RenderFrames(float* outFrames, const uint64_t frameCount)
+    {
+        NOVA_ASSERT(m_Offline, "RenderFrames requires an offline AudioDevice!");
+        if (!m_Offline || !outFrames) return 0;
+
+        // Stream ring buffers hold half a second, refill them often enough that they never run dry
+        const uint64_t chunkFrames = m_SampleRate / 8;
+        uint64_t framesRendered = 0;
+        while (framesRendered < frameCount)
+        {
+            m_Streamer.Pump();
+            ProcessCommands();
+
+            const uint64_t framesToRender = Math::Min(chunkFrames, frameCount - framesRendered);
+            ma_uint64 framesRead = 0;
+            const ma_result result = ma_engine_read_pcm_frames(&m_Engine, outFrames + framesRendered * m_Channels, framesToRender, &framesRead);
+            framesRendered += framesRead;
+            if (MA_FAILED(result) || framesRead == 0)
+                break;
+        }
+        return framesRendered;
+    }
+
+    bool AudioDevice::RenderFrames(Stream& stream, const uint64_t frameCount)
+    {
+        NOVA_ASSERT(m_Offline, "RenderFrames requires an offline AudioDevice!");
+        if (!m_Offline || !stream.IsOpened()) return false;
+
+        const auto onWrite = [](ma_encoder* encoder, const void* buffer, const size_t bytesToWrite, size_t* bytesWritten) -> ma_result
+        {
+            Stream* output = (Stream*)encoder->pUserData;
+            const Stream::SizeType written = output->WriteRaw(buffer, bytesToWrite);
+            if (written == Stream::EndOfFile) return MA_ERROR;
+            *bytesWritten = written;
+            return written == bytesToWrite ? MA_SUCCESS : MA_ERROR;
+        };
+
+        const auto onSeek = [](ma_encoder* encoder, const ma_int64 offset, const ma_seek_origin origin) -> ma_result
+        {
+            Stream* output = (Stream*)encoder->pUserData;
+            const Seek seekMode = origin == ma_seek_origin_start ? Seek::Begin : origin == ma_seek_origin_current ? Seek::Current : Seek::End;
+            return output->Seek(seekMode, (Stream::OffsetType)offset) ? MA_SUCCESS : MA_ERROR;
+        };
+
+        const ma_encoder_config encoderConfig = ma_encoder_config_init(ma_encoding_format_wav, ma_format_f32, m_Channels, m_SampleRate);
+        ma_encoder encoder;
+        ma_result result = ma_encoder_init(onWrite, onSeek, &stream, &encoderConfig, &encoder);
+        MA_RETURN_ON_FAIL(result);
+
+        const uint64_t chunkFrames = m_SampleRate / 8;
+        Array<float> chunk(chunkFrames * m_Channels);
+        uint64_t framesRendered = 0;
+        bool success = true;
+        while (framesRendered < frameCount)
+        {
+            const uint64_t framesToRender = Math::Min(chunkFrames, frameCount - framesRendered);
+            const uint64_t framesRead = RenderFrames(chunk.Data(), framesToRender);
+            if (framesRead == 0)
+            {
+                success = false;
+                break;
+            }
+
+            result = ma_encoder_write_pcm_frames(&encoder, chunk.Data(), framesRead, nullptr);
+            if (MA_FAILED(result))
+            {
+                success = false;
+                break;
+            }
+            framesRendered += framesRead;
+        }
+
+        // Patches the WAV header with the final data size
+        ma_encoder_uninit(&encoder);
+        return success;
+    }
+
+    AudioVoiceHandle AudioDevice::PlayOneShot(const AudioClip* clip, const AudioVoiceDesc& desc)
+    {
+        return m_VoicePool.Play(clip, desc);
+    }
+
+    bool AudioDevice::SubmitSourceCommand(const AudioSourceCommand& command)
+    {
+        return m_SourceCommands.TryEnqueue(command);
+    }
+
+    bool AudioDevice::FlushCommands()
+    {
+        if (m_SourceCommands.IsEmpty())
+            return true;
+
+        // The queue has a single consumer, the main thread can only take over while no callback can run
+        if (!IsAudioThreadRunning())
+        {
+            ProcessCommands();
+            return true;
+        }
+
+        // Every callback drains the queue before mixing, the one running entirely after this call applied everything
+        return WaitForAudioThread();
+    }
+
+    bool AudioDevice::WaitForAudioThread()
+    {
+        if (!IsAudioThreadRunning())
+            return true;
+
+        // The callback in flight bumps the count once, the next one runs entirely after this call
+        const uint64_t target = m_CallbackCount.load(std::memory_order_acquire) + 2;
+        const double deadline = Time::Get() + AudioThreadTimeout;
+        while (m_CallbackCount.load(std::memory_order_acquire) < target)
+        {
+            if (Time::Get() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+
+        if (!m_RetiredPcmFrames.IsEmpty())
+            m_RetiredPcmFrames = Array<Array<float>>();
+        // Every callback drains the command queue, nothing points at the retired sounds anymore
+        ReleaseRetiredSounds();
+        return true;
+    }
+
+    void AudioDevice::RetirePcmFrames(Array<float>&& frames)
+    {
+        m_RetiredPcmFrames.Emplace(Memory::Move(frames));
+    }
+
+    void AudioDevice::RetireSound(ma_sound* sound)
+    {
+        // The owner frees the data source next, the mixer must not reach the sound anymore
+        ma_node_detach_all_output_buses(sound);
+        m_RetiredSounds.Add(sound);
+    }
+
+    void AudioDevice::ReleaseRetiredSounds()
+    {
+        for (ma_sound* sound : m_RetiredSounds)
+        {
+            ma_sound_uninit(sound);
+            Memory::Free(sound);
+        }
+        m_RetiredSounds.Clear();
+    }
+
+    bool AudioDevice::IsAudioThreadRunning() const
+    {
+        if (m_Offline)
+            return false;
+
+        // Only a stopped device is guaranteed not to be inside a callback, starting and stopping ones may still be
+        const ma_device* device = ma_engine_get_device((ma_engine*)&m_Engine);
+        if (!device)
+            return false;
+
+        const ma_device_state state = ma_device_get_state(device);
+        return state != ma_device_state_uninitialized && state != ma_device_state_stopped;
+    }
+
+    void AudioDevice::ProcessCommands()
+    {
+        AudioSourceCommand command;
+        while (m_SourceCommands.TryDequeue(command))
+        {
+            ma_sound* sound = command.sound;
+            const AudioSourceParamFlags dirty = command.dirtyParams;
+
+            if (dirty.Contains(AudioSourceParamBits::Volume))
+                ma_sound_set_volume(sound, command.volume);
+            if (dirty.Contains(AudioSourceParamBits::Pitch))
+                ma_sound_set_pitch(sound, command.pitch);
+            if (dirty.Contains(AudioSourceParamBits::Pan))
+                ma_sound_set_pan(sound, command.pan);
+            if (dirty.Contains(AudioSourceParamBits::Looping))
+                ma_sound_set_looping(sound, command.looping);
+            if (dirty.Contains(AudioSourceParamBits::Spatialization))
+                ma_sound_set_spatialization_enabled(sound, command.spatialized);
+            if (dirty.Contains(AudioSourceParamBits::Position))
+                ma_sound_set_position(sound, command.position.x, command.position.y, command.position.z);
+            if (dirty.Contains(AudioSourceParamBits::Velocity))
+                ma_sound_set_velocity(sound, command.velocity.x, command.velocity.y, command.velocity.z);
+            if (dirty.Contains(AudioSourceParamBits::Direction))
+                ma_sound_set_direction(sound, command.direction.x, command.direction.y, command.direction.z);
+            if (dirty.Contains(AudioSourceParamBits::Cone))
+                ma_sound_set_cone(sound, Math::Tau, Math::Tau, 1.0f);
+        }
+    }
+
     AudioDevice* AudioDevice::GetInstance()
     {
         return s_Instance;
@@ -118,7 +351,9 @@ namespace Nova
 
         const ma_device* device = ma_engine_get_device((ma_engine*)&m_Engine);
 
-        return {m_Channels, m_SampleRate, GeBytesPerSample(device->playback.format), SampleInterleaving::Interleaved};
+        // The engine always mixes in f32 when there is no device to convert for
+        const uint32_t bytesPerSample = device ? GeBytesPerSample(device->playback.format) : GeBytesPerSample(ma_format_f32);
+        return {m_Channels, m_SampleRate, bytesPerSample, SampleInterleaving::Interleaved};
     }
 
     bool AudioDevice::AttachAudioNodeToOutputBus(Ref<AudioNode> audioNode)
@@ -132,16 +367,33 @@ namespace Nova
         //ma_node_detach_output_bus(audioNode.Get(), 0, ma_engine_get_endpoint(&m_Engine), 0);
     }
 
+    void AudioDevice::RegisterAudioNode(AudioNode* audioNode)
+    {
+        m_RegisteredNodes.AddUnique(audioNode);
+    }
+
+    void AudioDevice::UnregisterAudioNode(AudioNode* audioNode)
+    {
+        m_RegisteredNodes.Remove(audioNode);
+    }
+
+    void AudioDevice::GetAudioNodeStats(Array<AudioNodeStats>& outStats) const
+    {
+        outStats.Clear();
+        for (const AudioNode* audioNode : m_RegisteredNodes)
+            outStats.Add(audioNode->GetStats());
+    }
+
     void* AudioDevice::OnMalloc(const size_t size, void* userData)
     {
         (void)userData;
-        return Memory::Malloc<uint8_t>(size);
+        return Memory::Malloc<uint8_t>(size, MemoryTag::Audio);
     }
 
     void* AudioDevice::OnRealloc(void* where, const size_t size, void* userData)
     {
         (void)userData;
-        return Memory::Realloc<uint8_t>((uint8_t*)where, size);
+        return Memory::Realloc<uint8_t>((uint8_t*)where, size, MemoryTag::Audio);
     }
 
     void AudioDevice::OnFree(void* ptr, void* userData)
@@ -153,7 +405,11 @@ namespace Nova
     void AudioDevice::AudioDataProc(ma_device* device, void* output, const void* input, ma_uint32 frameCount)
     {
         ma_engine* engine = (ma_engine*)device->pUserData;
+        if (s_Instance)
+            s_Instance->ProcessCommands();
         ma_engine_read_pcm_frames(engine, output, frameCount, nullptr);
+        if (s_Instance)
+            s_Instance->m_CallbackCount.fetch_add(1, std::memory_order_release);
     }
 
     void AudioDevice::OnNotification(const ma_device_notification* notification)
@@ -1,8 +1,14 @@
 ﻿#pragma once
+#include "AudioCommand.h"
 #include "AudioFormat.h"
+#include "AudioNode.h"
+#include "AudioStream.h"
+#include "AudioVoicePool.h"
 #include "Runtime/RefCounted.h"
 #include "Runtime/Ref.h"
 #include "Containers/StringView.h"
+#include "Containers/SpscQueue.h"
+#include <atomic>
 #include <cstdint>
 #include <miniaudio.h>
 
@@ -10,6 +16,7 @@
 namespace Nova
 {
     class AudioClip;
+    class Stream;
     class AudioNode;
     struct AudioNodeCreateInfo;
 
@@ -18,6 +25,10 @@ namespace Nova
         uint32_t channels = 2;
         uint32_t sampleRate = 44100;
         uint32_t listenerCount = 1;
+        uint32_t voiceCount = 128;
+        uint32_t maxRealVoices = 32;
+        // No playback device is opened, the caller drives mixing with RenderFrames
+        bool offline = false;
     };
 
     class AudioDevice final : public RefCounted
@@ -26,9 +37,35 @@ namespace Nova
         AudioDevice();
         bool Initialize(const AudioDeviceCreateInfo& createInfo);
         void Destroy();
+        void Update(float deltaTime);
+
+        // Offline mode only. Mixes the next frames of the node graph on the calling thread as fast as possible.
+        uint64_t RenderFrames(float* outFrames, uint64_t frameCount);
+        // Offline mode only. Renders frameCount frames as a 32-bit float WAV file into the stream.
+        bool RenderFrames(Stream& stream, uint64_t frameCount);
+        bool IsOffline() const { return m_Offline; }
 
         void PlayAudioClip(AudioClip* clip);
         void StopAudioClip(AudioClip* clip);
+        AudioVoiceHandle PlayOneShot(const AudioClip* clip, const AudioVoiceDesc& desc = {});
+
+        AudioVoicePool& GetVoicePool() { return m_VoicePool; }
+        const AudioVoicePool& GetVoicePool() const { return m_VoicePool; }
+        AudioStreamer& GetStreamer() { return m_Streamer; }
+
+        // Main thread only. Applied at the start of the next audio callback, returns false if the queue is full.
+        bool SubmitSourceCommand(const AudioSourceCommand& command);
+        // Blocks until every submitted command has been applied, returns false if the audio callback stalled first
+        bool FlushCommands();
+
+        // Main thread only. Waits for the audio callback running at the time of the call to return, memory that it
+        // could be reading can be freed afterwards. Returns false if the callback stalled.
+        bool WaitForAudioThread();
+        // Keeps frames that a stalled callback may still read alive until the device is destroyed
+        void RetirePcmFrames(Array<float>&& frames);
+        // Takes ownership of a heap allocated sound that queued source commands still point at. It is detached from
+        // the node graph now and uninitialized once the audio thread applied the commands.
+        void RetireSound(ma_sound* sound);
 
         const ma_engine* GetHandle() const { return &m_Engine; }
         ma_engine* GetHandle() { return &m_Engine; }
@@ -43,6 +80,12 @@ namespace Nova
         bool AttachAudioNodeToOutputBus(Ref<AudioNode> audioNode);
         void DetachAudioNodeFromOutputBus(const Ref<AudioNode>& audioNode);
 
+        // Called by AudioNode on Initialize/Destroy, main thread only
+        void RegisterAudioNode(AudioNode* audioNode);
+        void UnregisterAudioNode(AudioNode* audioNode);
+        // Processing cost of every live node, measured on the audio thread
+        void GetAudioNodeStats(Array<AudioNodeStats>& outStats) const;
+
     protected:
         static void* OnMalloc( size_t size, void* userData);
         static void* OnRealloc(void* where, size_t size, void* userData);
@@ -51,11 +94,24 @@ namespace Nova
         static void OnNotification(const ma_device_notification* notification);
         static void OnProcess(void* userData, float* framesOut, ma_uint64 frameCount);
     private:
+        void ProcessCommands();
+        void ReleaseRetiredSounds();
+        bool IsAudioThreadRunning() const;
+
         ma_engine m_Engine;
         static AudioDevice* s_Instance;
         uint32_t m_Channels = 0;
         uint32_t m_SampleRate = 0;
+        bool m_Offline = false;
         Array<Ref<AudioNode>> m_AudioNodes;
+        Array<AudioNode*> m_RegisteredNodes;
+        AudioVoicePool m_VoicePool;
+        AudioStreamer m_Streamer;
+        SpscQueue<AudioSourceCommand, 1024> m_SourceCommands;
+        // Incremented by the audio thread at the end of every callback
+        std::atomic<uint64_t> m_CallbackCount = 0;
+        Array<Array<float>> m_RetiredPcmFrames;
+        Array<ma_sound*> m_RetiredSounds;
     };
 
     Ref<AudioDevice> CreateAudioDevice(const AudioDeviceCreateInfo& createInfo);
@@ -0,0 +1,47 @@
+﻿#include "AudioEffectNode.h"
+#include "Math/Functions.h"
+#include "Runtime/Memory.h"
+
+namespace Nova
+{
+    bool AudioEffectNode::Initialize(AudioDevice* system)
+    {
+        if (!AudioNode::Initialize(system)) return false;
+        if (m_Channels == 0 || m_Channels > MaxChannels) return false;
+
+        m_Scratch = Array<float>(m_Channels * MaxBlockFrames);
+        for (uint32_t channel = 0; channel < m_Channels; channel++)
+            m_ChannelBuffers[channel] = m_Scratch.Data() + channel * MaxBlockFrames;
+        return true;
+    }
+
+    void AudioEffectNode::OnProcess(const float** inFrames, const uint32_t inFrameCount, float** outFrames, const uint32_t outFrameCount)
+    {
+        const float* input = inFrames[0];
+        float* output = outFrames[0];
+        const uint32_t frameCount = Math::Min(inFrameCount, outFrameCount);
+
+        if (IsBypassed())
+        {
+            Memory::Memcpy(output, input, frameCount * m_Channels * sizeof(float));
+            return;
+        }
+
+        for (uint32_t offset = 0; offset < frameCount; offset += MaxBlockFrames)
+        {
+            const uint32_t blockFrames = Math::Min(MaxBlockFrames, frameCount - offset);
+            const float* blockInput = input + offset * m_Channels;
+            float* blockOutput = output + offset * m_Channels;
+
+            for (uint32_t frame = 0; frame < blockFrames; frame++)
+                for (uint32_t channel = 0; channel < m_Channels; channel++)
+                    m_ChannelBuffers[channel][frame] = blockInput[frame * m_Channels + channel];
+
+            ProcessBlock(m_ChannelBuffers, blockFrames);
+
+            for (uint32_t frame = 0; frame < blockFrames; frame++)
+                for (uint32_t channel = 0; channel < m_Channels; channel++)
+                    blockOutput[frame * m_Channels + channel] = m_ChannelBuffers[channel][frame];
+        }
+    }
+}
@@ -0,0 +1,33 @@
+﻿#pragma once
+#include "AudioNode.h"
+#include "Containers/Array.h"
+#include <atomic>
+
+namespace Nova
+{
+    // Base for one-in one-out effects. Interleaved engine frames are split into per-channel
+    // scratch buffers allocated once in Initialize, so effects only deal with planar blocks.
+    class AudioEffectNode : public AudioNode
+    {
+    public:
+        static constexpr uint32_t MaxChannels = 8;
+        static constexpr uint32_t MaxBlockFrames = 1024;
+
+        bool Initialize(AudioDevice* system) override;
+        void OnProcess(const float** inFrames, uint32_t inFrameCount, float** outFrames, uint32_t outFrameCount) override;
+        uint32_t GetInputBusCount() const override { return 1; }
+        uint32_t GetOutputBusCount() const override { return 1; }
+
+        void SetBypass(bool bypass) { m_Bypass.store(bypass, std::memory_order_relaxed); }
+        bool IsBypassed() const { return m_Bypass.load(std::memory_order_relaxed); }
+
+    protected:
+        // Audio thread. Processes frameCount frames of every channel in place.
+        virtual void ProcessBlock(float* const* channels, uint32_t frameCount) = 0;
+
+    private:
+        Array<float> m_Scratch;
+        float* m_ChannelBuffers[MaxChannels]{};
+        std::atomic<bool> m_Bypass = false;
+    };
+}
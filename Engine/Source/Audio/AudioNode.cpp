@@ -1,5 +1,7 @@
 ﻿#include "AudioNode.h"
 #include "AudioDevice.h"
+#include "Runtime/Time.h"
+#include "Math/Functions.h"
 
 namespace Nova
 {
@@ -23,12 +25,28 @@ namespace Nova
             AudioNode* node = (AudioNode*)nodeCustom->pUserData;
             if (!node) return;
 
-            node->OnProcess(inFrames, *inFrameCount, outFrames, *outFrameCount);
+            const double begin = Time::Get();
+            node->ProcessFrames(inFrames, inFrameCount, outFrames, outFrameCount);
+            node->RecordProcessTime(Time::Get() - begin, *outFrameCount);
         };
 
         m_Vtable.inputBusCount = GetInputBusCount();
         m_Vtable.outputBusCount = GetOutputBusCount();
         m_Vtable.flags = GetNodeFlags();
+        if (m_Vtable.flags & MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES)
+        {
+            m_Vtable.onGetRequiredInputFrameCount = [](ma_node* pNode, const ma_uint32 outputFrameCount, ma_uint32* inputFrameCount) -> ma_result
+            {
+                const ma_node_base_custom* nodeCustom = (const ma_node_base_custom*)pNode;
+                const AudioNode* node = (const AudioNode*)nodeCustom->pUserData;
+                if (!node) return MA_INVALID_ARGS;
+                *inputFrameCount = node->GetRequiredInputFrameCount(outputFrameCount);
+                return MA_SUCCESS;
+            };
+        }
+
+        m_Channels = system->GetOutputChannelCount();
+        m_SampleRate = system->GetOutputSampleRate();
 
         ma_node_config nodeConfig = ma_node_config_init();
         const uint32_t channels = system->GetOutputChannelCount();
@@ -42,6 +60,12 @@ namespace Nova
         const ma_result result = ma_node_init(graph, &nodeConfig, nullptr, &m_NodeBase);
         if (result != MA_SUCCESS) return false;
         m_NodeBase.pUserData = this;
+
+        if (m_Device)
+            m_Device->UnregisterAudioNode(this);
+        m_Device = system;
+        m_Device->RegisterAudioNode(this);
+        ResetStats();
         return true;
     }
 
@@ -49,6 +73,49 @@ namespace Nova
     {
         ma_node_detach_all_output_buses(&m_NodeBase);
         ma_node_uninit(&m_NodeBase, nullptr);
+
+        if (m_Device)
+        {
+            m_Device->UnregisterAudioNode(this);
+            m_Device = nullptr;
+        }
+    }
+
+    void AudioNode::ProcessFrames(const float** inFrames, uint32_t* inFrameCount, float** outFrames, uint32_t* outFrameCount)
+    {
+        OnProcess(inFrames, *inFrameCount, outFrames, *outFrameCount);
+    }
+
+    AudioNodeStats AudioNode::GetStats() const
+    {
+        AudioNodeStats stats;
+        stats.node = this;
+        stats.averageMicroseconds = m_AverageProcessTime.load(std::memory_order_relaxed) * 1000000.0f;
+        stats.peakMicroseconds = m_PeakProcessTime.load(std::memory_order_relaxed) * 1000000.0f;
+        stats.load = m_Load.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void AudioNode::ResetStats()
+    {
+        m_AverageProcessTime.store(0.0f, std::memory_order_relaxed);
+        m_PeakProcessTime.store(0.0f, std::memory_order_relaxed);
+        m_Load.store(0.0f, std::memory_order_relaxed);
+    }
+
+    void AudioNode::RecordProcessTime(const double seconds, const uint32_t frameCount)
+    {
+        // Only the audio thread writes these, relaxed stores are enough for the game thread to read them
+        constexpr float smoothing = 0.05f;
+        const float time = (float)seconds;
+        const float average = m_AverageProcessTime.load(std::memory_order_relaxed);
+        m_AverageProcessTime.store(average + (time - average) * smoothing, std::memory_order_relaxed);
+        m_PeakProcessTime.store(Math::Max(m_PeakProcessTime.load(std::memory_order_relaxed), time), std::memory_order_relaxed);
+
+        if (frameCount == 0 || m_SampleRate == 0) return;
+        const float budget = (float)frameCount / (float)m_SampleRate;
+        const float load = m_Load.load(std::memory_order_relaxed);
+        m_Load.store(load + (time / budget - load) * smoothing, std::memory_order_relaxed);
     }
 
     ma_node_base* AudioNode::GetHandle()
@@ -1,12 +1,24 @@
 ﻿#pragma once
 #include "Runtime/Object.h"
 #include "Containers/MulticastDelegate.h"
+#include <atomic>
 #include <miniaudio.h>
 
 
 namespace Nova
 {
     class AudioDevice;
+    class AudioNode;
+
+    struct AudioNodeStats
+    {
+        const AudioNode* node = nullptr;
+        // Processing time of one callback, in microseconds
+        float averageMicroseconds = 0.0f;
+        float peakMicroseconds = 0.0f;
+        // Fraction of the callback's real-time budget spent in this node
+        float load = 0.0f;
+    };
 
     class AudioNode : public Object
     {
@@ -19,6 +31,10 @@ namespace Nova
         virtual uint32_t GetOutputBusCount() const = 0;
 
         virtual void OnProcess(const float** inFrames, uint32_t inFrameCount, float** ourFrames, uint32_t outFrameCount) = 0;
+        // Nodes consuming and producing a different number of frames override this to report both counts back
+        virtual void ProcessFrames(const float** inFrames, uint32_t* inFrameCount, float** outFrames, uint32_t* outFrameCount);
+        // Only used by nodes flagged with MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES
+        virtual uint32_t GetRequiredInputFrameCount(uint32_t outFrameCount) const { return outFrameCount; }
         virtual void OnAttachToOutputBus(){}
         virtual void OnAttachToInputBus(){}
         virtual void OnDetachFromInputBus(){}
@@ -27,7 +43,16 @@ namespace Nova
         ma_node_base* GetHandle();
         const ma_node_base* GetHandle() const;
 
+        AudioNodeStats GetStats() const;
+        void ResetStats();
+
+    protected:
+        uint32_t m_Channels = 0;
+        uint32_t m_SampleRate = 0;
+
     private:
+        void RecordProcessTime(double seconds, uint32_t frameCount);
+
         struct ma_node_base_custom
         {
             ma_node_base base;
@@ -35,5 +60,9 @@ namespace Nova
         };
         ma_node_base_custom m_NodeBase{};
         ma_node_vtable m_Vtable{};
+        AudioDevice* m_Device = nullptr;
+        std::atomic<float> m_AverageProcessTime = 0.0f;
+        std::atomic<float> m_PeakProcessTime = 0.0f;
+        std::atomic<float> m_Load = 0.0f;
     };
 }
@@ -0,0 +1,96 @@
+﻿#pragma once
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define NOVA_AUDIO_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(_M_ARM64) || defined(__ARM_NEON)
+#define NOVA_AUDIO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Four-wide float helpers shared by the DSP nodes, falling back to scalar code on unknown targets
+namespace Nova::AudioSimd
+{
+#if defined(NOVA_AUDIO_SIMD_SSE)
+    using Float4 = __m128;
+
+    inline Float4 Load(const float* data) { return _mm_loadu_ps(data); }
+    inline void Store(float* data, const Float4 value) { _mm_storeu_ps(data, value); }
+    inline Float4 Splat(const float value) { return _mm_set1_ps(value); }
+    inline Float4 Set(const float x, const float y, const float z, const float w) { return _mm_setr_ps(x, y, z, w); }
+    inline Float4 Add(const Float4 lhs, const Float4 rhs) { return _mm_add_ps(lhs, rhs); }
+    inline Float4 Sub(const Float4 lhs, const Float4 rhs) { return _mm_sub_ps(lhs, rhs); }
+    inline Float4 Mul(const Float4 lhs, const Float4 rhs) { return _mm_mul_ps(lhs, rhs); }
+    inline Float4 MulAdd(const Float4 lhs, const Float4 rhs, const Float4 add) { return _mm_add_ps(_mm_mul_ps(lhs, rhs), add); }
+    inline Float4 Max(const Float4 lhs, const Float4 rhs) { return _mm_max_ps(lhs, rhs); }
+    inline Float4 Abs(const Float4 value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+#elif defined(NOVA_AUDIO_SIMD_NEON)
+    using Float4 = float32x4_t;
+
+    inline Float4 Load(const float* data) { return vld1q_f32(data); }
+    inline void Store(float* data, const Float4 value) { vst1q_f32(data, value); }
+    inline Float4 Splat(const float value) { return vdupq_n_f32(value); }
+    inline Float4 Set(const float x, const float y, const float z, const float w) { const float values[4] { x, y, z, w }; return vld1q_f32(values); }
+    inline Float4 Add(const Float4 lhs, const Float4 rhs) { return vaddq_f32(lhs, rhs); }
+    inline Float4 Sub(const Float4 lhs, const Float4 rhs) { return vsubq_f32(lhs, rhs); }
+    inline Float4 Mul(const Float4 lhs, const Float4 rhs) { return vmulq_f32(lhs, rhs); }
+    inline Float4 MulAdd(const Float4 lhs, const Float4 rhs, const Float4 add) { return vmlaq_f32(add, lhs, rhs); }
+    inline Float4 Max(const Float4 lhs, const Float4 rhs) { return vmaxq_f32(lhs, rhs); }
+    inline Float4 Abs(const Float4 value) { return vabsq_f32(value); }
+#else
+    struct Float4 { float x, y, z, w; };
+
+    inline Float4 Load(const float* data) { return { data[0], data[1], data[2], data[3] }; }
+    inline void Store(float* data, const Float4 value) { data[0] = value.x; data[1] = value.y; data[2] = value.z; data[3] = value.w; }
+    inline Float4 Splat(const float value) { return { value, value, value, value }; }
+    inline Float4 Set(const float x, const float y, const float z, const float w) { return { x, y, z, w }; }
+    inline Float4 Add(const Float4 lhs, const Float4 rhs) { return { lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w }; }
+    inline Float4 Sub(const Float4 lhs, const Float4 rhs) { return { lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w }; }
+    inline Float4 Mul(const Float4 lhs, const Float4 rhs) { return { lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w }; }
+    inline Float4 MulAdd(const Float4 lhs, const Float4 rhs, const Float4 add) { return Add(Mul(lhs, rhs), add); }
+    inline Float4 Max(const Float4 lhs, const Float4 rhs) { return { lhs.x > rhs.x ? lhs.x : rhs.x, lhs.y > rhs.y ? lhs.y : rhs.y, lhs.z > rhs.z ? lhs.z : rhs.z, lhs.w > rhs.w ? lhs.w : rhs.w }; }
+    inline Float4 Abs(const Float4 value) { return { value.x < 0.0f ? -value.x : value.x, value.y < 0.0f ? -value.y : value.y, value.z < 0.0f ? -value.z : value.z, value.w < 0.0f ? -value.w : value.w }; }
+#endif
+
+    inline float HorizontalSum(const Float4 value)
+    {
+        float lanes[4];
+        Store(lanes, value);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    // data[i] *= gain
+    inline void Scale(float* data, const float gain, const uint32_t count)
+    {
+        uint32_t index = 0;
+        const Float4 gain4 = Splat(gain);
+        for (; index + 4 <= count; index += 4)
+            Store(data + index, Mul(Load(data + index), gain4));
+        for (; index < count; index++)
+            data[index] *= gain;
+    }
+
+    // data[i] *= gains[i]
+    inline void Multiply(float* data, const float* gains, const uint32_t count)
+    {
+        uint32_t index = 0;
+        for (; index + 4 <= count; index += 4)
+            Store(data + index, Mul(Load(data + index), Load(gains + index)));
+        for (; index < count; index++)
+            data[index] *= gains[index];
+    }
+
+    // peaks[i] = max(peaks[i], |data[i]|)
+    inline void AccumulatePeaks(float* peaks, const float* data, const uint32_t count)
+    {
+        uint32_t index = 0;
+        for (; index + 4 <= count; index += 4)
+            Store(peaks + index, Max(Load(peaks + index), Abs(Load(data + index))));
+        for (; index < count; index++)
+        {
+            const float value = data[index] < 0.0f ? -data[index] : data[index];
+            peaks[index] = peaks[index] > value ? peaks[index] : value;
+        }
+    }
+}
@@ -0,0 +1,364 @@
+﻿#include "AudioStream.h"
+#include "AudioDevice.h"
+#include "IO/Stream.h"
+#include "Runtime/Memory.h"
+#include "Runtime/Profiler.h"
+#include <chrono>
+#include <cstring>
+
+namespace Nova
+{
+    ma_data_source_vtable AudioStream::s_VTable
+    {
+        OnRead,
+        OnSeek,
+        OnGetDataFormat,
+        OnGetCursor,
+        OnGetLength,
+        OnSetLooping,
+        // Looping is handled by the streaming thread, miniaudio must not seek back on its own
+        MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT
+    };
+
+    bool AudioStream::Initialize(AudioDevice* device, Stream* stream, const bool ownsStream, const uint32_t bufferFrames)
+    {
+        if (!device || !stream)
+            return false;
+
+        m_Stream = stream;
+        m_OwnsStream = ownsStream;
+        m_Channels = device->GetOutputChannelCount();
+        m_SampleRate = device->GetOutputSampleRate();
+        m_Length = 0;
+        m_FramesRead = 0;
+        m_FramesWritten = 0;
+        m_SeekBoundary = 0;
+        m_SeekTarget = 0;
+        m_SeekRequested = 0;
+        m_SeekAcknowledged = 0;
+        m_Cursor = 0;
+        m_DecoderAtEnd = false;
+        m_Looping = false;
+
+        // Decode straight to the device format so the mixer never converts
+        const ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, m_Channels, m_SampleRate);
+        ma_result result = ma_decoder_init(OnDecoderRead, OnDecoderSeek, this, &decoderConfig, &m_Decoder);
+        if (result != MA_SUCCESS)
+            return false;
+
+        ma_uint64 length = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&m_Decoder, &length) == MA_SUCCESS)
+            m_Length = length;
+
+        result = ma_pcm_rb_init(ma_format_f32, m_Channels, bufferFrames, nullptr, nullptr, &m_RingBuffer);
+        if (result != MA_SUCCESS)
+        {
+            ma_decoder_uninit(&m_Decoder);
+            return false;
+        }
+
+        ma_data_source_config dataSourceConfig = ma_data_source_config_init();
+        dataSourceConfig.vtable = &s_VTable;
+        result = ma_data_source_init(&dataSourceConfig, &m_DataSource.base);
+        if (result != MA_SUCCESS)
+        {
+            ma_pcm_rb_uninit(&m_RingBuffer);
+            ma_decoder_uninit(&m_Decoder);
+            return false;
+        }
+        m_DataSource.owner = this;
+
+        m_Initialized = true;
+
+        // Prefill so playback can start right away
+        Pump();
+        return true;
+    }
+
+    void AudioStream::Destroy()
+    {
+        if (m_Initialized)
+        {
+            ma_data_source_uninit(&m_DataSource.base);
+            ma_pcm_rb_uninit(&m_RingBuffer);
+            ma_decoder_uninit(&m_Decoder);
+            m_Initialized = false;
+        }
+
+        if (m_OwnsStream && m_Stream)
+        {
+            if (m_Stream->IsOpened())
+                m_Stream->Close();
+            delete m_Stream;
+        }
+        m_Stream = nullptr;
+        m_OwnsStream = false;
+    }
+
+    bool AudioStream::Pump()
+    {
+        bool didWork = false;
+
+        const uint32_t seekRequested = m_SeekRequested.load(std::memory_order_acquire);
+        if (seekRequested != m_SeekAcknowledged.load(std::memory_order_relaxed))
+        {
+            ma_decoder_seek_to_pcm_frame(&m_Decoder, m_SeekTarget.load(std::memory_order_relaxed));
+            m_DecoderAtEnd.store(false, std::memory_order_relaxed);
+            // Every frame already written belongs to the old position, the mixer skips them
+            m_SeekBoundary.store(m_FramesWritten.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_SeekAcknowledged.store(seekRequested, std::memory_order_release);
+            didWork = true;
+        }
+
+        if (m_DecoderAtEnd.load(std::memory_order_relaxed))
+        {
+            // Looping may have been turned on after the decoder ran dry, start over unless there is nothing to play
+            if (!m_Looping.load(std::memory_order_relaxed) || m_FramesWritten.load(std::memory_order_relaxed) == 0)
+                return didWork;
+
+            ma_decoder_seek_to_pcm_frame(&m_Decoder, 0);
+            m_DecoderAtEnd.store(false, std::memory_order_relaxed);
+            didWork = true;
+        }
+
+        bool wrapped = false;
+        while (ma_pcm_rb_available_write(&m_RingBuffer) > 0)
+        {
+            ma_uint32 frameCount = ma_pcm_rb_available_write(&m_RingBuffer);
+            void* buffer = nullptr;
+            if (ma_pcm_rb_acquire_write(&m_RingBuffer, &frameCount, &buffer) != MA_SUCCESS || frameCount == 0)
+                break;
+
+            ma_uint64 framesRead = 0;
+            const ma_result result = ma_decoder_read_pcm_frames(&m_Decoder, buffer, frameCount, &framesRead);
+            ma_pcm_rb_commit_write(&m_RingBuffer, (ma_uint32)framesRead);
+            m_FramesWritten.fetch_add(framesRead, std::memory_order_relaxed);
+            didWork |= framesRead != 0;
+
+            if (result == MA_SUCCESS && framesRead == frameCount)
+            {
+                wrapped = false;
+                continue;
+            }
+
+            // Two empty reads in a row means the stream has no frames at all, stop instead of spinning
+            if (m_Looping.load(std::memory_order_relaxed) && !(wrapped && framesRead == 0))
+            {
+                ma_decoder_seek_to_pcm_frame(&m_Decoder, 0);
+                wrapped = framesRead == 0;
+                continue;
+            }
+
+            m_DecoderAtEnd.store(true, std::memory_order_release);
+            break;
+        }
+
+        return didWork;
+    }
+
+    ma_uint64 AudioStream::ReadFrames(float* framesOut, const ma_uint64 frameCount)
+    {
+        ma_uint64 totalRead = 0;
+        while (totalRead < frameCount)
+        {
+            ma_uint32 framesToRead = (ma_uint32)(frameCount - totalRead);
+            void* buffer = nullptr;
+            if (ma_pcm_rb_acquire_read(&m_RingBuffer, &framesToRead, &buffer) != MA_SUCCESS || framesToRead == 0)
+                break;
+
+            if (framesOut)
+                Memory::Memcpy(framesOut + totalRead * m_Channels, buffer, framesToRead * m_Channels * sizeof(float));
+            ma_pcm_rb_commit_read(&m_RingBuffer, framesToRead);
+            totalRead += framesToRead;
+        }
+
+        m_FramesRead += totalRead;
+        return totalRead;
+    }
+
+    void AudioStream::SkipFrames(const ma_uint64 frameCount)
+    {
+        ReadFrames(nullptr, frameCount);
+    }
+
+    ma_result AudioStream::OnDecoderRead(ma_decoder* decoder, void* bufferOut, const size_t bytesToRead, size_t* bytesRead)
+    {
+        const AudioStream* stream = (const AudioStream*)decoder->pUserData;
+        const Stream::SizeType read = stream->m_Stream->ReadRaw(bufferOut, bytesToRead);
+        if (read == Stream::EndOfFile)
+        {
+            *bytesRead = 0;
+            return MA_ERROR;
+        }
+
+        *bytesRead = read;
+        return read == 0 ? MA_AT_END : MA_SUCCESS;
+    }
+
+    ma_result AudioStream::OnDecoderSeek(ma_decoder* decoder, const ma_int64 byteOffset, const ma_seek_origin origin)
+    {
+        const AudioStream* stream = (const AudioStream*)decoder->pUserData;
+        const Seek seekMode = origin == ma_seek_origin_start ? Seek::Begin : origin == ma_seek_origin_current ? Seek::Current : Seek::End;
+        return stream->m_Stream->Seek(seekMode, (Stream::OffsetType)byteOffset) ? MA_SUCCESS : MA_ERROR;
+    }
+
+    ma_result AudioStream::OnRead(ma_data_source* dataSource, void* framesOut, const ma_uint64 frameCount, ma_uint64* framesRead)
+    {
+        AudioStream* stream = ((DataSource*)dataSource)->owner;
+        float* output = (float*)framesOut;
+        const uint32_t channels = stream->m_Channels;
+
+        // The streaming thread has not serviced the last seek yet, play silence rather than stale frames
+        if (stream->m_SeekRequested.load(std::memory_order_relaxed) != stream->m_SeekAcknowledged.load(std::memory_order_acquire))
+        {
+            memset(output, 0, frameCount * channels * sizeof(float));
+            *framesRead = frameCount;
+            return MA_SUCCESS;
+        }
+
+        const uint64_t seekBoundary = stream->m_SeekBoundary.load(std::memory_order_relaxed);
+        if (stream->m_FramesRead < seekBoundary)
+            stream->SkipFrames(seekBoundary - stream->m_FramesRead);
+
+        ma_uint64 read = stream->ReadFrames(output, frameCount);
+        if (read < frameCount)
+        {
+            if (stream->m_DecoderAtEnd.load(std::memory_order_acquire) && ma_pcm_rb_available_read(&stream->m_RingBuffer) == 0)
+            {
+                *framesRead = read;
+                stream->m_Cursor.fetch_add(read, std::memory_order_relaxed);
+                return read == 0 ? MA_AT_END : MA_SUCCESS;
+            }
+
+            // Underrun, pad with silence so the mixer never waits on I/O
+            memset(output + read * channels, 0, (frameCount - read) * channels * sizeof(float));
+        }
+
+        uint64_t cursor = stream->m_Cursor.load(std::memory_order_relaxed) + read;
+        if (stream->m_Length != 0 && stream->m_Looping.load(std::memory_order_relaxed))
+            cursor %= stream->m_Length;
+        stream->m_Cursor.store(cursor, std::memory_order_relaxed);
+
+        *framesRead = frameCount;
+        return MA_SUCCESS;
+    }
+
+    ma_result AudioStream::OnSeek(ma_data_source* dataSource, const ma_uint64 frameIndex)
+    {
+        AudioStream* stream = ((DataSource*)dataSource)->owner;
+        stream->m_SeekTarget.store(frameIndex, std::memory_order_relaxed);
+        stream->m_Cursor.store(frameIndex, std::memory_order_relaxed);
+        stream->m_SeekRequested.fetch_add(1, std::memory_order_release);
+        return MA_SUCCESS;
+    }
+
+    ma_result AudioStream::OnGetDataFormat(ma_data_source* dataSource, ma_format* format, ma_uint32* channels, ma_uint32* sampleRate, ma_channel* channelMap, const size_t channelMapCap)
+    {
+        const AudioStream* stream = ((DataSource*)dataSource)->owner;
+        *format = ma_format_f32;
+        *channels = stream->m_Channels;
+        *sampleRate = stream->m_SampleRate;
+        if (channelMap)
+            ma_channel_map_init_standard(ma_standard_channel_map_default, channelMap, channelMapCap, stream->m_Channels);
+        return MA_SUCCESS;
+    }
+
+    ma_result AudioStream::OnGetCursor(ma_data_source* dataSource, ma_uint64* cursor)
+    {
+        const AudioStream* stream = ((DataSource*)dataSource)->owner;
+        *cursor = stream->m_Cursor.load(std::memory_order_relaxed);
+        return MA_SUCCESS;
+    }
+
+    ma_result AudioStream::OnGetLength(ma_data_source* dataSource, ma_uint64* length)
+    {
+        const AudioStream* stream = ((DataSource*)dataSource)->owner;
+        *length = stream->m_Length;
+        return stream->m_Length != 0 ? MA_SUCCESS : MA_NOT_IMPLEMENTED;
+    }
+
+    ma_result AudioStream::OnSetLooping(ma_data_source* dataSource, const ma_bool32 isLooping)
+    {
+        AudioStream* stream = ((DataSource*)dataSource)->owner;
+        stream->m_Looping.store(isLooping, std::memory_order_relaxed);
+        return MA_SUCCESS;
+    }
+
+    bool AudioStreamer::Initialize(const bool threaded)
+    {
+        m_Running = true;
+        if (threaded)
+            m_Thread = std::thread(&AudioStreamer::Run, this);
+        return true;
+    }
+
+    void AudioStreamer::Destroy()
+    {
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (!m_Running) return;
+            m_Running = false;
+        }
+
+        m_Condition.notify_all();
+        if (m_Thread.joinable())
+            m_Thread.join();
+        m_Streams.Clear();
+    }
+
+    void AudioStreamer::Register(AudioStream* stream)
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Streams.AddUnique(stream);
+    }
+
+    void AudioStreamer::Unregister(AudioStream* stream)
+    {
+        std::unique_lock lock(m_Mutex);
+        m_Streams.Remove(stream);
+
+        // The streaming thread may be decoding it from its snapshot, later rounds no longer see it
+        if (m_IsPumping)
+        {
+            const uint64_t round = m_PumpRound;
+            m_PumpCondition.wait(lock, [this, round] { return m_PumpRound != round; });
+        }
+    }
+
+    void AudioStreamer::Pump()
+    {
+        NOVA_ASSERT(!m_Thread.joinable(), "AudioStreamer is already pumped by its own thread!");
+        std::scoped_lock lock(m_Mutex);
+        for (AudioStream* stream : m_Streams)
+            stream->Pump();
+    }
+
+    void AudioStreamer::Run()
+    {
+        NOVA_PROFILE_THREAD("Audio Streaming");
+        std::unique_lock lock(m_Mutex);
+        while (m_Running)
+        {
+            // Decoding runs unlocked on a snapshot so Register/Unregister never wait on I/O
+            m_PumpStreams.Clear();
+            m_PumpStreams.AddRange(m_Streams);
+            m_IsPumping = true;
+            lock.unlock();
+
+            bool didWork = false;
+            {
+                NOVA_PROFILE_SCOPE("AudioStreamer::Pump");
+                for (AudioStream* stream : m_PumpStreams)
+                    didWork |= stream->Pump();
+            }
+
+            lock.lock();
+            m_IsPumping = false;
+            ++m_PumpRound;
+            m_PumpCondition.notify_all();
+
+            if (!didWork)
+                m_Condition.wait_for(lock, std::chrono::milliseconds(2));
+        }
+    }
+}
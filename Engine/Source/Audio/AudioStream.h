@@ -0,0 +1,104 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <miniaudio.h>
+
+namespace Nova
+{
+    class AudioDevice;
+    class Stream;
+
+    // Data source decoding an encoded Stream ahead of the mixer.
+    // The decoder only runs on the streaming thread, the mixer only reads decoded frames from a ring buffer.
+    class AudioStream
+    {
+    public:
+        AudioStream() = default;
+        AudioStream(const AudioStream&) = delete;
+        AudioStream& operator=(const AudioStream&) = delete;
+
+        bool Initialize(AudioDevice* device, Stream* stream, bool ownsStream, uint32_t bufferFrames);
+        void Destroy();
+
+        ma_data_source* GetDataSource() { return &m_DataSource; }
+
+        // Streaming thread only. Decodes until the ring buffer is full, returns true if any work was done.
+        bool Pump();
+    private:
+        struct DataSource
+        {
+            ma_data_source_base base;
+            AudioStream* owner;
+        };
+
+        static ma_data_source_vtable s_VTable;
+
+        static ma_result OnDecoderRead(ma_decoder* decoder, void* bufferOut, size_t bytesToRead, size_t* bytesRead);
+        static ma_result OnDecoderSeek(ma_decoder* decoder, ma_int64 byteOffset, ma_seek_origin origin);
+
+        static ma_result OnRead(ma_data_source* dataSource, void* framesOut, ma_uint64 frameCount, ma_uint64* framesRead);
+        static ma_result OnSeek(ma_data_source* dataSource, ma_uint64 frameIndex);
+        static ma_result OnGetDataFormat(ma_data_source* dataSource, ma_format* format, ma_uint32* channels, ma_uint32* sampleRate, ma_channel* channelMap, size_t channelMapCap);
+        static ma_result OnGetCursor(ma_data_source* dataSource, ma_uint64* cursor);
+        static ma_result OnGetLength(ma_data_source* dataSource, ma_uint64* length);
+        static ma_result OnSetLooping(ma_data_source* dataSource, ma_bool32 isLooping);
+
+        ma_uint64 ReadFrames(float* framesOut, ma_uint64 frameCount);
+        void SkipFrames(ma_uint64 frameCount);
+
+        DataSource m_DataSource;
+        ma_decoder m_Decoder;
+        ma_pcm_rb m_RingBuffer;
+        Stream* m_Stream = nullptr;
+        bool m_OwnsStream = false;
+        bool m_Initialized = false;
+        uint32_t m_Channels = 0;
+        uint32_t m_SampleRate = 0;
+        uint64_t m_Length = 0;
+
+        // Written by the streaming thread
+        std::atomic<uint64_t> m_FramesWritten = 0;
+        std::atomic<uint64_t> m_SeekBoundary = 0;
+        std::atomic<uint32_t> m_SeekAcknowledged = 0;
+        std::atomic<bool> m_DecoderAtEnd = false;
+
+        // Written by the mixer thread
+        std::atomic<uint64_t> m_SeekTarget = 0;
+        std::atomic<uint32_t> m_SeekRequested = 0;
+        std::atomic<uint64_t> m_Cursor = 0;
+        std::atomic<bool> m_Looping = false;
+        uint64_t m_FramesRead = 0;
+    };
+
+    // Single background thread keeping every registered AudioStream decoded ahead.
+    class AudioStreamer
+    {
+    public:
+        // Without a thread, streams are only decoded when Pump is called
+        bool Initialize(bool threaded = true);
+        void Destroy();
+
+        void Register(AudioStream* stream);
+        // Once this returns the streaming thread no longer touches the stream
+        void Unregister(AudioStream* stream);
+        // Fills every registered stream from the calling thread, only valid when not threaded
+        void Pump();
+    private:
+        void Run();
+
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::condition_variable m_PumpCondition;
+        Array<AudioStream*> m_Streams;
+        // Streaming thread only, the streams decoded in the current round
+        Array<AudioStream*> m_PumpStreams;
+        uint64_t m_PumpRound = 0;
+        bool m_IsPumping = false;
+        bool m_Running = false;
+    };
+}
@@ -0,0 +1,391 @@
+﻿#include "AudioVoicePool.h"
+#include "AudioDevice.h"
+#include "AudioClip.h"
+#include "Math/Functions.h"
+#include "Runtime/Memory.h"
+
+#include <algorithm>
+
+namespace Nova
+{
+    bool AudioVoicePool::Initialize(AudioDevice* device, const uint32_t voiceCount, const uint32_t maxRealVoices)
+    {
+        if (!device || voiceCount == 0)
+            return false;
+
+        Destroy();
+
+        m_Device = device;
+        m_VoiceCount = voiceCount;
+        m_MaxRealVoices = Math::Min(maxRealVoices, voiceCount);
+        m_Voices = Memory::Calloc<Voice>(voiceCount, MemoryTag::Audio);
+        m_SortedVoices = Array<uint32_t>(voiceCount);
+
+        // Every voice owns its sound for the lifetime of the pool, playing a clip only rebinds the PCM data
+        const uint32_t channels = device->GetOutputChannelCount();
+        for (uint32_t index = 0; index < voiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            ma_result result = ma_audio_buffer_ref_init(ma_format_f32, channels, nullptr, 0, &voice.buffer);
+            if (result != MA_SUCCESS)
+            {
+                // Only the voices before this one own a sound to uninitialize
+                m_VoiceCount = index;
+                Destroy();
+                return false;
+            }
+
+            result = ma_sound_init_from_data_source(device->GetHandle(), &voice.buffer, 0, nullptr, &voice.sound);
+            if (result != MA_SUCCESS)
+            {
+                ma_audio_buffer_ref_uninit(&voice.buffer);
+                m_VoiceCount = index;
+                Destroy();
+                return false;
+            }
+
+            voice.state = AudioVoiceState::Free;
+        }
+        return true;
+    }
+
+    void AudioVoicePool::Destroy()
+    {
+        if (!m_Voices)
+            return;
+
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            ma_sound_uninit(&voice.sound);
+            ma_audio_buffer_ref_uninit(&voice.buffer);
+        }
+
+        Memory::Free(m_Voices);
+        m_Voices = nullptr;
+        m_VoiceCount = 0;
+        m_RealVoiceCount = 0;
+        m_VirtualVoiceCount = 0;
+        m_SortedVoices.Clear();
+    }
+
+    void AudioVoicePool::Update(const float deltaTime)
+    {
+        if (!m_Voices)
+            return;
+
+        const uint32_t sampleRate = m_Device->GetOutputSampleRate();
+        m_SortedVoices.Clear();
+
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            if (voice.state == AudioVoiceState::Free)
+                continue;
+
+            const uint64_t frameCount = voice.clip->GetPcmFrameCount();
+            if (voice.state == AudioVoiceState::Real)
+            {
+                if (ma_sound_at_end(&voice.sound))
+                {
+                    Release(voice);
+                    continue;
+                }
+            }
+            else
+            {
+                voice.cursor += (uint64_t)(deltaTime * (float)sampleRate * voice.desc.pitch);
+                if (voice.cursor >= frameCount)
+                {
+                    if (!voice.desc.looping)
+                    {
+                        Release(voice);
+                        continue;
+                    }
+                    voice.cursor %= Math::Max<uint64_t>(frameCount, 1);
+                }
+            }
+
+            voice.audibility = ComputeAudibility(voice);
+            m_SortedVoices.Add(index);
+        }
+
+        std::sort(m_SortedVoices.Data(), m_SortedVoices.Data() + m_SortedVoices.Count(), [this](const uint32_t lhs, const uint32_t rhs)
+        {
+            const Voice& a = m_Voices[lhs];
+            const Voice& b = m_Voices[rhs];
+            if (a.desc.priority != b.desc.priority)
+                return a.desc.priority > b.desc.priority;
+            return a.audibility > b.audibility;
+        });
+
+        // Demote first so promoted voices always find a free mixer slot
+        for (size_t rank = 0; rank < m_SortedVoices.Count(); ++rank)
+        {
+            Voice& voice = m_Voices[m_SortedVoices[rank]];
+            const bool shouldBeReal = rank < m_MaxRealVoices && voice.audibility >= m_VirtualizationThreshold;
+            if (!shouldBeReal && voice.state == AudioVoiceState::Real)
+                MakeVirtual(voice);
+        }
+
+        for (size_t rank = 0; rank < m_SortedVoices.Count(); ++rank)
+        {
+            Voice& voice = m_Voices[m_SortedVoices[rank]];
+            const bool shouldBeReal = rank < m_MaxRealVoices && voice.audibility >= m_VirtualizationThreshold;
+            if (shouldBeReal && voice.state == AudioVoiceState::Virtual)
+                MakeReal(voice);
+        }
+    }
+
+    AudioVoiceHandle AudioVoicePool::Play(const AudioClip* clip, const AudioVoiceDesc& desc)
+    {
+        if (!m_Voices || !clip || !clip->HasPcmData())
+            return {};
+
+        Voice* voice = nullptr;
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            if (m_Voices[index].state == AudioVoiceState::Free)
+            {
+                voice = &m_Voices[index];
+                break;
+            }
+        }
+
+        if (!voice)
+        {
+            voice = FindVoiceToSteal(desc.priority);
+            if (!voice) return {};
+            Release(*voice);
+        }
+
+        voice->clip = clip;
+        voice->boundClip = clip;
+        voice->desc = desc;
+        voice->cursor = 0;
+        voice->playOrder = m_PlayOrder++;
+        ma_audio_buffer_ref_set_data(&voice->buffer, clip->GetPcmFrames(), clip->GetPcmFrameCount());
+        ApplyDesc(*voice);
+        voice->audibility = ComputeAudibility(*voice);
+
+        voice->state = AudioVoiceState::Virtual;
+        ++m_VirtualVoiceCount;
+        if (m_RealVoiceCount < m_MaxRealVoices && voice->audibility >= m_VirtualizationThreshold)
+            MakeReal(*voice);
+
+        AudioVoiceHandle handle;
+        handle.index = (uint32_t)(voice - m_Voices);
+        handle.generation = voice->generation;
+        return handle;
+    }
+
+    void AudioVoicePool::Stop(const AudioVoiceHandle handle)
+    {
+        if (Voice* voice = Resolve(handle))
+            Release(*voice);
+    }
+
+    void AudioVoicePool::StopAll(const AudioClip* clip)
+    {
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            if (voice.state != AudioVoiceState::Free && voice.clip == clip)
+                Release(voice);
+        }
+    }
+
+    void AudioVoicePool::StopAll()
+    {
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            if (voice.state != AudioVoiceState::Free)
+                Release(voice);
+        }
+    }
+
+    bool AudioVoicePool::ReleaseClip(const AudioClip* clip)
+    {
+        bool bound = false;
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            if (voice.boundClip != clip)
+                continue;
+
+            if (voice.state != AudioVoiceState::Free)
+                Release(voice);
+            bound = true;
+        }
+
+        if (!bound)
+            return true;
+
+        // Stopping only takes effect from the next callback, the one running now may still read the PCM
+        if (!m_Device->WaitForAudioThread())
+            return false;
+
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            if (voice.boundClip != clip)
+                continue;
+
+            ma_audio_buffer_ref_set_data(&voice.buffer, nullptr, 0);
+            voice.boundClip = nullptr;
+        }
+        return true;
+    }
+
+    bool AudioVoicePool::IsPlaying(const AudioVoiceHandle handle) const
+    {
+        return Resolve(handle) != nullptr;
+    }
+
+    void AudioVoicePool::SetVolume(const AudioVoiceHandle handle, const float volume)
+    {
+        Voice* voice = Resolve(handle);
+        if (!voice) return;
+        voice->desc.volume = volume;
+        ma_sound_set_volume(&voice->sound, volume);
+    }
+
+    void AudioVoicePool::SetPitch(const AudioVoiceHandle handle, const float pitch)
+    {
+        Voice* voice = Resolve(handle);
+        if (!voice) return;
+        voice->desc.pitch = pitch;
+        ma_sound_set_pitch(&voice->sound, pitch);
+    }
+
+    void AudioVoicePool::SetPosition(const AudioVoiceHandle handle, const Vector3& position)
+    {
+        Voice* voice = Resolve(handle);
+        if (!voice) return;
+        voice->desc.position = position;
+        ma_sound_set_position(&voice->sound, position.x, position.y, position.z);
+    }
+
+    void AudioVoicePool::SetVirtualizationThreshold(const float gain)
+    {
+        m_VirtualizationThreshold = gain;
+    }
+
+    float AudioVoicePool::GetVirtualizationThreshold() const
+    {
+        return m_VirtualizationThreshold;
+    }
+
+    uint32_t AudioVoicePool::GetVoiceCount() const
+    {
+        return m_VoiceCount;
+    }
+
+    uint32_t AudioVoicePool::GetRealVoiceCount() const
+    {
+        return m_RealVoiceCount;
+    }
+
+    uint32_t AudioVoicePool::GetVirtualVoiceCount() const
+    {
+        return m_VirtualVoiceCount;
+    }
+
+    AudioVoicePool::Voice* AudioVoicePool::Resolve(const AudioVoiceHandle handle) const
+    {
+        if (!handle.IsValid() || handle.index >= m_VoiceCount)
+            return nullptr;
+
+        Voice& voice = m_Voices[handle.index];
+        if (voice.state == AudioVoiceState::Free || voice.generation != handle.generation)
+            return nullptr;
+        return &voice;
+    }
+
+    void AudioVoicePool::Release(Voice& voice)
+    {
+        if (voice.state == AudioVoiceState::Real)
+        {
+            ma_sound_stop(&voice.sound);
+            --m_RealVoiceCount;
+        }
+        else if (voice.state == AudioVoiceState::Virtual)
+        {
+            --m_VirtualVoiceCount;
+        }
+
+        // The PCM binding is left in place, the mixer may still be reading it during the current callback
+        voice.state = AudioVoiceState::Free;
+        voice.clip = nullptr;
+        ++voice.generation;
+    }
+
+    void AudioVoicePool::MakeReal(Voice& voice)
+    {
+        ma_sound_seek_to_pcm_frame(&voice.sound, voice.cursor);
+        ma_sound_start(&voice.sound);
+        voice.state = AudioVoiceState::Real;
+        --m_VirtualVoiceCount;
+        ++m_RealVoiceCount;
+    }
+
+    void AudioVoicePool::MakeVirtual(Voice& voice)
+    {
+        ma_uint64 cursor = 0;
+        ma_sound_get_cursor_in_pcm_frames(&voice.sound, &cursor);
+        ma_sound_stop(&voice.sound);
+        voice.cursor = cursor;
+        voice.state = AudioVoiceState::Virtual;
+        --m_RealVoiceCount;
+        ++m_VirtualVoiceCount;
+    }
+
+    void AudioVoicePool::ApplyDesc(Voice& voice)
+    {
+        const AudioVoiceDesc& desc = voice.desc;
+        ma_sound_set_volume(&voice.sound, desc.volume);
+        ma_sound_set_pitch(&voice.sound, desc.pitch);
+        ma_sound_set_pan(&voice.sound, desc.pan);
+        ma_sound_set_looping(&voice.sound, desc.looping);
+        ma_sound_set_spatialization_enabled(&voice.sound, desc.spatialized);
+        ma_sound_set_position(&voice.sound, desc.position.x, desc.position.y, desc.position.z);
+    }
+
+    float AudioVoicePool::ComputeAudibility(const Voice& voice) const
+    {
+        const AudioVoiceDesc& desc = voice.desc;
+        if (!desc.spatialized)
+            return desc.volume;
+
+        // Same inverse distance model miniaudio applies by default
+        const ma_vec3f listener = ma_engine_listener_get_position(m_Device->GetHandle(), 0);
+        const Vector3 delta = desc.position - Vector3(listener.x, listener.y, listener.z);
+        const float distance = delta.Magnitude();
+        const float minDistance = ma_sound_get_min_distance(&voice.sound);
+        const float rolloff = ma_sound_get_rolloff(&voice.sound);
+        if (distance <= minDistance)
+            return desc.volume;
+        return desc.volume * minDistance / (minDistance + rolloff * (distance - minDistance));
+    }
+
+    AudioVoicePool::Voice* AudioVoicePool::FindVoiceToSteal(const uint8_t priority) const
+    {
+        Voice* candidate = nullptr;
+        for (uint32_t index = 0; index < m_VoiceCount; ++index)
+        {
+            Voice& voice = m_Voices[index];
+            if (voice.desc.priority > priority)
+                continue;
+
+            if (!candidate
+                || voice.desc.priority < candidate->desc.priority
+                || (voice.desc.priority == candidate->desc.priority && voice.audibility < candidate->audibility)
+                || (voice.desc.priority == candidate->desc.priority && voice.audibility == candidate->audibility && voice.playOrder < candidate->playOrder))
+            {
+                candidate = &voice;
+            }
+        }
+        return candidate;
+    }
+}
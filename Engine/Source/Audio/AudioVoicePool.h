@@ -0,0 +1,106 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include "Math/Vector3.h"
+#include <cstdint>
+#include <miniaudio.h>
+
+namespace Nova
+{
+    class AudioDevice;
+    class AudioClip;
+
+    struct AudioVoiceHandle
+    {
+        uint32_t index = ~0u;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != ~0u; }
+    };
+
+    struct AudioVoiceDesc
+    {
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        float pan = 0.0f;
+        Vector3 position = Vector3::Zero;
+        bool looping = false;
+        bool spatialized = false;
+        // Higher priority voices are kept audible and can steal lower priority ones
+        uint8_t priority = 128;
+    };
+
+    enum class AudioVoiceState : uint8_t
+    {
+        Free,
+        Real,
+        Virtual,
+    };
+
+    // Fixed pool of voices playing clips from their shared decoded PCM buffer.
+    // At most maxRealVoices are mixed, the others are virtualized and only keep track of their cursor.
+    class AudioVoicePool
+    {
+    public:
+        AudioVoicePool() = default;
+        AudioVoicePool(const AudioVoicePool&) = delete;
+        AudioVoicePool& operator=(const AudioVoicePool&) = delete;
+
+        bool Initialize(AudioDevice* device, uint32_t voiceCount, uint32_t maxRealVoices);
+        void Destroy();
+        void Update(float deltaTime);
+
+        AudioVoiceHandle Play(const AudioClip* clip, const AudioVoiceDesc& desc);
+        void Stop(AudioVoiceHandle handle);
+        void StopAll(const AudioClip* clip);
+        void StopAll();
+        // Stops the voices playing the clip and unbinds its PCM data from every voice, after which it can be freed.
+        // Returns false if the audio thread stalled and may still be reading the data.
+        bool ReleaseClip(const AudioClip* clip);
+        bool IsPlaying(AudioVoiceHandle handle) const;
+
+        void SetVolume(AudioVoiceHandle handle, float volume);
+        void SetPitch(AudioVoiceHandle handle, float pitch);
+        void SetPosition(AudioVoiceHandle handle, const Vector3& position);
+
+        // Voices whose estimated gain falls under this threshold are virtualized
+        void SetVirtualizationThreshold(float gain);
+        float GetVirtualizationThreshold() const;
+
+        uint32_t GetVoiceCount() const;
+        uint32_t GetRealVoiceCount() const;
+        uint32_t GetVirtualVoiceCount() const;
+    private:
+        struct Voice
+        {
+            ma_sound sound;
+            ma_audio_buffer_ref buffer;
+            const AudioClip* clip;
+            // Clip whose PCM the buffer still points to, stays set after the voice is released
+            const AudioClip* boundClip;
+            AudioVoiceDesc desc;
+            AudioVoiceState state;
+            uint32_t generation;
+            uint64_t cursor;
+            uint64_t playOrder;
+            float audibility;
+        };
+
+        Voice* Resolve(AudioVoiceHandle handle) const;
+        void Release(Voice& voice);
+        void MakeReal(Voice& voice);
+        void MakeVirtual(Voice& voice);
+        void ApplyDesc(Voice& voice);
+        float ComputeAudibility(const Voice& voice) const;
+        Voice* FindVoiceToSteal(uint8_t priority) const;
+
+        AudioDevice* m_Device = nullptr;
+        Voice* m_Voices = nullptr;
+        uint32_t m_VoiceCount = 0;
+        uint32_t m_MaxRealVoices = 0;
+        uint32_t m_RealVoiceCount = 0;
+        uint32_t m_VirtualVoiceCount = 0;
+        uint64_t m_PlayOrder = 0;
+        float m_VirtualizationThreshold = 0.001f;
+        Array<uint32_t> m_SortedVoices;
+    };
+}
@@ -0,0 +1,157 @@
+﻿#include "BiquadAudioNode.h"
+#include "AudioSimd.h"
+#include "Math/Functions.h"
+
+namespace Nova
+{
+    void BiquadAudioNode::SetFilterType(const BiquadFilterType type)
+    {
+        m_FilterType.store(type, std::memory_order_relaxed);
+        m_Dirty.store(true, std::memory_order_release);
+    }
+
+    void BiquadAudioNode::SetFrequency(const float frequency)
+    {
+        m_Frequency.store(frequency, std::memory_order_relaxed);
+        m_Dirty.store(true, std::memory_order_release);
+    }
+
+    void BiquadAudioNode::SetQuality(const float quality)
+    {
+        m_Quality.store(Math::Max(quality, 0.01f), std::memory_order_relaxed);
+        m_Dirty.store(true, std::memory_order_release);
+    }
+
+    void BiquadAudioNode::SetGain(const float gainDecibels)
+    {
+        m_Gain.store(gainDecibels, std::memory_order_relaxed);
+        m_Dirty.store(true, std::memory_order_release);
+    }
+
+    BiquadFilterType BiquadAudioNode::GetFilterType() const
+    {
+        return m_FilterType.load(std::memory_order_relaxed);
+    }
+
+    float BiquadAudioNode::GetFrequency() const
+    {
+        return m_Frequency.load(std::memory_order_relaxed);
+    }
+
+    float BiquadAudioNode::GetQuality() const
+    {
+        return m_Quality.load(std::memory_order_relaxed);
+    }
+
+    float BiquadAudioNode::GetGain() const
+    {
+        return m_Gain.load(std::memory_order_relaxed);
+    }
+
+    void BiquadAudioNode::UpdateCoefficients()
+    {
+        const float nyquist = 0.5f * (float)m_SampleRate;
+        const float frequency = Math::Clamp(m_Frequency.load(std::memory_order_relaxed), 10.0f, nyquist * 0.99f);
+        const float quality = m_Quality.load(std::memory_order_relaxed);
+        const float gain = m_Gain.load(std::memory_order_relaxed);
+
+        const float omega = Math::Tau * frequency / (float)m_SampleRate;
+        const float cosOmega = Math::Cos(omega);
+        const float alpha = Math::Sin(omega) / (2.0f * quality);
+        const float amplitude = Math::Pow(10.0f, gain / 40.0f);
+
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
+        switch (m_FilterType.load(std::memory_order_relaxed))
+        {
+        case BiquadFilterType::LowPass:
+            b0 = (1.0f - cosOmega) * 0.5f; b1 = 1.0f - cosOmega; b2 = b0;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosOmega; a2 = 1.0f - alpha;
+            break;
+        case BiquadFilterType::HighPass:
+            b0 = (1.0f + cosOmega) * 0.5f; b1 = -(1.0f + cosOmega); b2 = b0;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosOmega; a2 = 1.0f - alpha;
+            break;
+        case BiquadFilterType::BandPass:
+            b0 = alpha; b1 = 0.0f; b2 = -alpha;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosOmega; a2 = 1.0f - alpha;
+            break;
+        case BiquadFilterType::Notch:
+            b0 = 1.0f; b1 = -2.0f * cosOmega; b2 = 1.0f;
+            a0 = 1.0f + alpha; a1 = -2.0f * cosOmega; a2 = 1.0f - alpha;
+            break;
+        case BiquadFilterType::Peak:
+            b0 = 1.0f + alpha * amplitude; b1 = -2.0f * cosOmega; b2 = 1.0f - alpha * amplitude;
+            a0 = 1.0f + alpha / amplitude; a1 = -2.0f * cosOmega; a2 = 1.0f - alpha / amplitude;
+            break;
+        case BiquadFilterType::LowShelf:
+        {
+            const float sqrtAmplitude = 2.0f * Math::Sqrt(amplitude) * alpha;
+            b0 = amplitude * ((amplitude + 1.0f) - (amplitude - 1.0f) * cosOmega + sqrtAmplitude);
+            b1 = 2.0f * amplitude * ((amplitude - 1.0f) - (amplitude + 1.0f) * cosOmega);
+            b2 = amplitude * ((amplitude + 1.0f) - (amplitude - 1.0f) * cosOmega - sqrtAmplitude);
+            a0 = (amplitude + 1.0f) + (amplitude - 1.0f) * cosOmega + sqrtAmplitude;
+            a1 = -2.0f * ((amplitude - 1.0f) + (amplitude + 1.0f) * cosOmega);
+            a2 = (amplitude + 1.0f) + (amplitude - 1.0f) * cosOmega - sqrtAmplitude;
+            break;
+        }
+        case BiquadFilterType::HighShelf:
+        {
+            const float sqrtAmplitude = 2.0f * Math::Sqrt(amplitude) * alpha;
+            b0 = amplitude * ((amplitude + 1.0f) + (amplitude - 1.0f) * cosOmega + sqrtAmplitude);
+            b1 = -2.0f * amplitude * ((amplitude - 1.0f) + (amplitude + 1.0f) * cosOmega);
+            b2 = amplitude * ((amplitude + 1.0f) + (amplitude - 1.0f) * cosOmega - sqrtAmplitude);
+            a0 = (amplitude + 1.0f) - (amplitude - 1.0f) * cosOmega + sqrtAmplitude;
+            a1 = 2.0f * ((amplitude - 1.0f) - (amplitude + 1.0f) * cosOmega);
+            a2 = (amplitude + 1.0f) - (amplitude - 1.0f) * cosOmega - sqrtAmplitude;
+            break;
+        }
+        }
+
+        m_B0 = b0 / a0;
+        m_B1 = b1 / a0;
+        m_B2 = b2 / a0;
+        m_A1 = a1 / a0;
+        m_A2 = a2 / a0;
+    }
+
+    void BiquadAudioNode::ProcessBlock(float* const* channels, const uint32_t frameCount)
+    {
+        using namespace AudioSimd;
+
+        if (m_Dirty.exchange(false, std::memory_order_acquire))
+            UpdateCoefficients();
+
+        const Float4 b0 = Splat(m_B0);
+        const Float4 b1 = Splat(m_B1);
+        const Float4 b2 = Splat(m_B2);
+        const Float4 a1 = Splat(m_A1);
+        const Float4 a2 = Splat(m_A2);
+
+        // Transposed direct form II, one channel per lane
+        for (uint32_t group = 0; group < m_Channels; group += 4)
+        {
+            const uint32_t laneCount = Math::Min(4u, m_Channels - group);
+            Float4 z1 = Load(m_Z1 + group);
+            Float4 z2 = Load(m_Z2 + group);
+
+            float lanes[4]{};
+            for (uint32_t frame = 0; frame < frameCount; frame++)
+            {
+                for (uint32_t lane = 0; lane < laneCount; lane++)
+                    lanes[lane] = channels[group + lane][frame];
+
+                const Float4 input = Load(lanes);
+                const Float4 output = MulAdd(b0, input, z1);
+                z1 = Sub(MulAdd(b1, input, z2), Mul(a1, output));
+                z2 = Sub(Mul(b2, input), Mul(a2, output));
+                Store(lanes, output);
+
+                for (uint32_t lane = 0; lane < laneCount; lane++)
+                    channels[group + lane][frame] = lanes[lane];
+            }
+
+            Store(m_Z1 + group, z1);
+            Store(m_Z2 + group, z2);
+        }
+    }
+}
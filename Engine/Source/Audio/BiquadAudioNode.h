@@ -0,0 +1,48 @@
+﻿#pragma once
+#include "AudioEffectNode.h"
+
+namespace Nova
+{
+    enum class BiquadFilterType
+    {
+        LowPass,
+        HighPass,
+        BandPass,
+        Notch,
+        Peak,
+        LowShelf,
+        HighShelf,
+    };
+
+    // Second order IIR filter, coefficients from the RBJ audio EQ cookbook.
+    // Channels are filtered four at a time in SIMD lanes since the recursion prevents vectorizing over time.
+    class BiquadAudioNode final : public AudioEffectNode
+    {
+    public:
+        void SetFilterType(BiquadFilterType type);
+        void SetFrequency(float frequency);
+        void SetQuality(float quality);
+        void SetGain(float gainDecibels);
+
+        BiquadFilterType GetFilterType() const;
+        float GetFrequency() const;
+        float GetQuality() const;
+        float GetGain() const;
+
+    protected:
+        void ProcessBlock(float* const* channels, uint32_t frameCount) override;
+
+    private:
+        void UpdateCoefficients();
+
+        std::atomic<BiquadFilterType> m_FilterType = BiquadFilterType::LowPass;
+        std::atomic<float> m_Frequency = 1000.0f;
+        std::atomic<float> m_Quality = 0.7071f;
+        std::atomic<float> m_Gain = 0.0f;
+        std::atomic<bool> m_Dirty = true;
+
+        float m_B0 = 1.0f, m_B1 = 0.0f, m_B2 = 0.0f, m_A1 = 0.0f, m_A2 = 0.0f;
+        float m_Z1[MaxChannels]{};
+        float m_Z2[MaxChannels]{};
+    };
+}
@@ -0,0 +1,104 @@
+﻿#include "CompressorAudioNode.h"
+#include "AudioSimd.h"
+#include "Math/Functions.h"
+
+namespace Nova
+{
+    void CompressorAudioNode::SetThreshold(const float thresholdDecibels)
+    {
+        m_Threshold.store(Math::Min(thresholdDecibels, 0.0f), std::memory_order_relaxed);
+    }
+
+    void CompressorAudioNode::SetRatio(const float ratio)
+    {
+        m_Ratio.store(ratio <= 0.0f ? 0.0f : Math::Max(ratio, 1.0f), std::memory_order_relaxed);
+    }
+
+    void CompressorAudioNode::SetAttack(const float seconds)
+    {
+        m_Attack.store(Math::Max(seconds, 0.0001f), std::memory_order_relaxed);
+    }
+
+    void CompressorAudioNode::SetRelease(const float seconds)
+    {
+        m_Release.store(Math::Max(seconds, 0.001f), std::memory_order_relaxed);
+    }
+
+    void CompressorAudioNode::SetMakeupGain(const float gainDecibels)
+    {
+        m_MakeupGain.store(gainDecibels, std::memory_order_relaxed);
+    }
+
+    float CompressorAudioNode::GetThreshold() const
+    {
+        return m_Threshold.load(std::memory_order_relaxed);
+    }
+
+    float CompressorAudioNode::GetRatio() const
+    {
+        return m_Ratio.load(std::memory_order_relaxed);
+    }
+
+    float CompressorAudioNode::GetAttack() const
+    {
+        return m_Attack.load(std::memory_order_relaxed);
+    }
+
+    float CompressorAudioNode::GetRelease() const
+    {
+        return m_Release.load(std::memory_order_relaxed);
+    }
+
+    float CompressorAudioNode::GetMakeupGain() const
+    {
+        return m_MakeupGain.load(std::memory_order_relaxed);
+    }
+
+    float CompressorAudioNode::GetGainReduction() const
+    {
+        return m_GainReduction.load(std::memory_order_relaxed);
+    }
+
+    void CompressorAudioNode::ProcessBlock(float* const* channels, const uint32_t frameCount)
+    {
+        const float threshold = GetThreshold();
+        const float ratio = GetRatio();
+        // Fraction of the overshoot removed, 1 for a limiter
+        const float slope = ratio == 0.0f ? 1.0f : 1.0f - 1.0f / ratio;
+        const float attack = Math::Exp(-1.0f / (GetAttack() * (float)m_SampleRate));
+        const float release = Math::Exp(-1.0f / (GetRelease() * (float)m_SampleRate));
+        const float makeup = Math::Pow(10.0f, GetMakeupGain() / 20.0f);
+        const float thresholdLinear = Math::Pow(10.0f, threshold / 20.0f);
+
+        for (uint32_t frame = 0; frame < frameCount; frame++)
+            m_Peaks[frame] = 0.0f;
+        for (uint32_t channel = 0; channel < m_Channels; channel++)
+            AudioSimd::AccumulatePeaks(m_Peaks, channels[channel], frameCount);
+
+        float envelope = m_Envelope;
+        float reduction = 0.0f;
+        for (uint32_t frame = 0; frame < frameCount; frame++)
+        {
+            const float peak = m_Peaks[frame];
+            const float coefficient = peak > envelope ? attack : release;
+            envelope = peak + (envelope - peak) * coefficient;
+
+            // Below threshold the gain is constant, skip the log/exp pair
+            if (envelope <= thresholdLinear)
+            {
+                m_Gains[frame] = makeup;
+                reduction = 0.0f;
+                continue;
+            }
+
+            const float overshoot = 20.0f * Math::Log10(envelope) - threshold;
+            reduction = overshoot * slope;
+            m_Gains[frame] = Math::Pow(10.0f, -reduction / 20.0f) * makeup;
+        }
+        m_Envelope = envelope;
+        m_GainReduction.store(reduction, std::memory_order_relaxed);
+
+        for (uint32_t channel = 0; channel < m_Channels; channel++)
+            AudioSimd::Multiply(channels[channel], m_Gains, frameCount);
+    }
+}
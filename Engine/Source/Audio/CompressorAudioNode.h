@@ -0,0 +1,41 @@
+﻿#pragma once
+#include "AudioEffectNode.h"
+
+namespace Nova
+{
+    // Feed-forward peak compressor linked across channels. A ratio of zero turns it into a brick-wall limiter.
+    // Only the envelope follower runs per sample, detection and gain application are vectorized.
+    class CompressorAudioNode final : public AudioEffectNode
+    {
+    public:
+        void SetThreshold(float thresholdDecibels);
+        void SetRatio(float ratio);
+        void SetAttack(float seconds);
+        void SetRelease(float seconds);
+        void SetMakeupGain(float gainDecibels);
+
+        float GetThreshold() const;
+        float GetRatio() const;
+        float GetAttack() const;
+        float GetRelease() const;
+        float GetMakeupGain() const;
+
+        // Gain reduction applied at the end of the last processed block, for meters
+        float GetGainReduction() const;
+
+    protected:
+        void ProcessBlock(float* const* channels, uint32_t frameCount) override;
+
+    private:
+        std::atomic<float> m_Threshold = -12.0f;
+        std::atomic<float> m_Ratio = 4.0f;
+        std::atomic<float> m_Attack = 0.005f;
+        std::atomic<float> m_Release = 0.1f;
+        std::atomic<float> m_MakeupGain = 0.0f;
+        std::atomic<float> m_GainReduction = 0.0f;
+
+        float m_Envelope = 0.0f;
+        float m_Peaks[MaxBlockFrames]{};
+        float m_Gains[MaxBlockFrames]{};
+    };
+}
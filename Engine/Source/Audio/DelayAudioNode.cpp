@@ -0,0 +1,100 @@
+﻿#include "DelayAudioNode.h"
+#include "AudioSimd.h"
+#include "Math/Functions.h"
+
+namespace Nova
+{
+    bool DelayAudioNode::Initialize(AudioDevice* system)
+    {
+        if (!AudioEffectNode::Initialize(system)) return false;
+
+        // The whole delay line is allocated once, changing the delay time never reallocates
+        m_Capacity = (uint32_t)(MaxDelaySeconds * (float)m_SampleRate) + 1;
+        m_Buffer = Array<float>(m_Capacity * m_Channels);
+        m_WritePosition = 0;
+        return true;
+    }
+
+    void DelayAudioNode::SetDelay(const float seconds)
+    {
+        m_Delay.store(Math::Clamp(seconds, 0.001f, MaxDelaySeconds), std::memory_order_relaxed);
+    }
+
+    void DelayAudioNode::SetFeedback(const float feedback)
+    {
+        m_Feedback.store(Math::Clamp(feedback, 0.0f, 0.99f), std::memory_order_relaxed);
+    }
+
+    void DelayAudioNode::SetMix(const float mix)
+    {
+        m_Mix.store(Math::Clamp(mix, 0.0f, 1.0f), std::memory_order_relaxed);
+    }
+
+    float DelayAudioNode::GetDelay() const
+    {
+        return m_Delay.load(std::memory_order_relaxed);
+    }
+
+    float DelayAudioNode::GetFeedback() const
+    {
+        return m_Feedback.load(std::memory_order_relaxed);
+    }
+
+    float DelayAudioNode::GetMix() const
+    {
+        return m_Mix.load(std::memory_order_relaxed);
+    }
+
+    void DelayAudioNode::ProcessBlock(float* const* channels, const uint32_t frameCount)
+    {
+        using namespace AudioSimd;
+
+        const uint32_t delayFrames = Math::Clamp((uint32_t)(GetDelay() * (float)m_SampleRate), 1u, m_Capacity - 1);
+        const float mix = GetMix();
+        const float feedbackGain = GetFeedback();
+        const Float4 dry = Splat(1.0f - mix);
+        const Float4 wet = Splat(mix);
+        const Float4 feedback = Splat(feedbackGain);
+
+        uint32_t processed = 0;
+        uint32_t writePosition = m_WritePosition;
+        while (processed < frameCount)
+        {
+            const uint32_t readPosition = (writePosition + m_Capacity - delayFrames) % m_Capacity;
+
+            // Largest span where neither position wraps and no sample reads what this span writes
+            uint32_t span = Math::Min(frameCount - processed, delayFrames);
+            span = Math::Min(span, m_Capacity - readPosition);
+            span = Math::Min(span, m_Capacity - writePosition);
+
+            for (uint32_t channel = 0; channel < m_Channels; channel++)
+            {
+                float* samples = channels[channel] + processed;
+                float* line = m_Buffer.Data() + channel * m_Capacity;
+                const float* delayed = line + readPosition;
+                float* write = line + writePosition;
+
+                uint32_t index = 0;
+                for (; index + 4 <= span; index += 4)
+                {
+                    const Float4 input = Load(samples + index);
+                    const Float4 echo = Load(delayed + index);
+                    Store(write + index, MulAdd(echo, feedback, input));
+                    Store(samples + index, MulAdd(input, dry, Mul(echo, wet)));
+                }
+                for (; index < span; index++)
+                {
+                    const float input = samples[index];
+                    const float echo = delayed[index];
+                    write[index] = input + echo * feedbackGain;
+                    samples[index] = input * (1.0f - mix) + echo * mix;
+                }
+            }
+
+            processed += span;
+            writePosition = (writePosition + span) % m_Capacity;
+        }
+
+        m_WritePosition = writePosition;
+    }
+}
@@ -0,0 +1,35 @@
+﻿#pragma once
+#include "AudioEffectNode.h"
+
+namespace Nova
+{
+    // Feedback delay line. Blocks no longer than the delay have no dependency between
+    // their own samples, so the whole block is processed with vector loads.
+    class DelayAudioNode final : public AudioEffectNode
+    {
+    public:
+        static constexpr float MaxDelaySeconds = 2.0f;
+
+        bool Initialize(AudioDevice* system) override;
+
+        void SetDelay(float seconds);
+        void SetFeedback(float feedback);
+        void SetMix(float mix);
+
+        float GetDelay() const;
+        float GetFeedback() const;
+        float GetMix() const;
+
+    protected:
+        void ProcessBlock(float* const* channels, uint32_t frameCount) override;
+
+    private:
+        std::atomic<float> m_Delay = 0.25f;
+        std::atomic<float> m_Feedback = 0.35f;
+        std::atomic<float> m_Mix = 0.35f;
+
+        Array<float> m_Buffer;
+        uint32_t m_Capacity = 0;
+        uint32_t m_WritePosition = 0;
+    };
+}
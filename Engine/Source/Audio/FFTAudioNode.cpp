@@ -1,6 +1,13 @@
 ﻿#include "FFTAudioNode.h"
+#include "AudioDevice.h"
+#include "Runtime/Memory.h"
 #include <kiss_fftr.h>
 
+#if defined(_M_X64) || defined(__SSE2__)
+#define NOVA_FFT_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Nova
 {
     float HannWindow(const uint32_t n, const uint32_t fftSize)
@@ -67,61 +74,215 @@ namespace Nova
         return GetFFTWindow(window)(n, fftSize);
     }
 
+    void ComputeFFTWindow(const FFTWindow window, const uint32_t fftSize, float* outTable)
+    {
+        for (uint32_t n = 0; n < fftSize; n++)
+        {
+            switch (window)
+            {
+            case FFTWindow::Rectangular: outTable[n] = RectangularWindow(n, fftSize); break;
+            case FFTWindow::Hann: outTable[n] = HannWindow(n, fftSize); break;
+            case FFTWindow::Hamming: outTable[n] = HammingWindow(n, fftSize); break;
+            case FFTWindow::Blackman: outTable[n] = BlackmanWindow(n, fftSize); break;
+            case FFTWindow::BlackmanHarris: outTable[n] = BlackmanHarrisWindow(n, fftSize); break;
+            case FFTWindow::Triangle: outTable[n] = TriangleWindow(n, fftSize); break;
+            }
+        }
+    }
+
+    static uint32_t GetFFTSizeIndex(const uint32_t fftSize)
+    {
+        uint32_t index = 0;
+        for (uint32_t size = FFTAudioNode::MinFFTSize; size < fftSize; size <<= 1)
+            index++;
+        return index;
+    }
+
     bool FFTAudioNode::Initialize(AudioDevice* system)
     {
         if (!AudioNode::Initialize(system)) return false;
-        std::free(m_Config);
-        m_Config = kiss_fftr_alloc(m_FFTSize, 0, nullptr, nullptr);
-        if (!m_Config) return false;
+
+        // Every supported size is planned up front, changing size never allocates on the audio thread
+        for (uint32_t index = 0; index < FFTSizeCount; index++)
+        {
+            std::free(m_Configs[index]);
+            m_Configs[index] = kiss_fftr_alloc(MinFFTSize << index, 0, nullptr, nullptr);
+            if (!m_Configs[index]) return false;
+        }
+
+        m_FFTSize = 0;
+        ApplyPendingSettings();
         return true;
     }
 
     void FFTAudioNode::Destroy()
     {
         AudioNode::Destroy();
-        std::free(m_Config);
+        for (kiss_fftr_cfg& config : m_Configs)
+        {
+            std::free(config);
+            config = nullptr;
+        }
     }
 
     void FFTAudioNode::OnProcess(const float** inFrames, const uint32_t inFrameCount, float** outFrames, const uint32_t outFrameCount)
     {
-        for (int sampleIndex = 0; sampleIndex < m_FFTSize && sampleIndex < inFrameCount; sampleIndex++)
+        ApplyPendingSettings();
+
+        const float* input = inFrames[0];
+        const float channelScale = 1.0f / (float)m_Channels;
+        for (uint32_t frameIndex = 0; frameIndex < inFrameCount; frameIndex++)
         {
-            m_InputBuffer[sampleIndex] = inFrames[0][sampleIndex] * ApplyWindow(m_FFTWindow, sampleIndex, m_FFTSize);
+            float mono = 0.0f;
+            for (uint32_t channel = 0; channel < m_Channels; channel++)
+                mono += input[frameIndex * m_Channels + channel];
+
+            m_History[m_WritePosition] = mono * channelScale;
+            m_WritePosition = (m_WritePosition + 1) & (MaxFFTSize - 1);
+
+            if (++m_SamplesSinceLastFFT >= m_HopSize)
+            {
+                m_SamplesSinceLastFFT = 0;
+                Analyze();
+            }
         }
+    }
+
+    void FFTAudioNode::ApplyPendingSettings()
+    {
+        const uint32_t fftSize = m_RequestedFFTSize.load(std::memory_order_relaxed);
+        const FFTWindow window = m_RequestedFFTWindow.load(std::memory_order_relaxed);
+        const float overlap = m_RequestedOverlap.load(std::memory_order_relaxed);
+        if (fftSize == m_FFTSize && window == m_FFTWindow && overlap == m_Overlap)
+            return;
 
-        kiss_fftr(m_Config, m_InputBuffer, (kiss_fft_cpx*)m_OutputBuffer);
+        m_FFTSize = fftSize;
+        m_FFTWindow = window;
+        m_Overlap = overlap;
+        m_HopSize = Math::Max(1u, (uint32_t)((float)fftSize * (1.0f - overlap)));
+        m_SamplesSinceLastFFT = 0;
 
-        for (int sampleIndex = 0; sampleIndex < m_FFTSize && sampleIndex < inFrameCount; sampleIndex++)
-            m_Magnitudes[sampleIndex] = Math::Sqrt(m_OutputBuffer[sampleIndex].r * m_OutputBuffer[sampleIndex].r + m_OutputBuffer[sampleIndex].i * m_OutputBuffer[sampleIndex].i);
+        ComputeFFTWindow(window, fftSize, m_Window);
+        float windowSum = 0.0f;
+        for (uint32_t n = 0; n < fftSize; n++)
+            windowSum += m_Window[n];
+        m_WindowScale = windowSum > 0.0f ? 2.0f / windowSum : 1.0f;
 
+        // Log-spaced band edges between the first bin and Nyquist
+        const uint32_t binCount = fftSize / 2;
+        for (uint32_t band = 0; band <= BandCount; band++)
+        {
+            const float t = (float)band / (float)BandCount;
+            const uint32_t edge = (uint32_t)Math::Pow((float)binCount, t);
+            m_BandEdges[band] = Math::Clamp(edge, 1u, binCount);
+        }
+    }
+
+    void FFTAudioNode::Analyze()
+    {
+        const uint32_t fftSize = m_FFTSize;
+        const uint32_t binCount = fftSize / 2;
+
+        // Unroll the most recent fftSize samples of the history ring
+        const uint32_t start = (m_WritePosition - fftSize) & (MaxFFTSize - 1);
+        const uint32_t firstPart = Math::Min(fftSize, MaxFFTSize - start);
+        Memory::Memcpy(m_InputBuffer, m_History + start, firstPart * sizeof(float));
+        Memory::Memcpy(m_InputBuffer + firstPart, m_History, (fftSize - firstPart) * sizeof(float));
+
+        for (uint32_t n = 0; n < fftSize; n++)
+            m_InputBuffer[n] *= m_Window[n];
+
+        kiss_fftr(m_Configs[GetFFTSizeIndex(fftSize)], m_InputBuffer, (kiss_fft_cpx*)m_OutputBuffer);
+
+        Spectrum& spectrum = m_Spectra[m_BackIndex];
+        const float* bins = (const float*)m_OutputBuffer;
+        float* magnitudes = spectrum.magnitudes;
+
+        uint32_t bin = 0;
+#if defined(NOVA_FFT_SSE)
+        for (; bin + 4 <= binCount; bin += 4)
+        {
+            const __m128 lo = _mm_loadu_ps(bins + bin * 2);
+            const __m128 hi = _mm_loadu_ps(bins + bin * 2 + 4);
+            const __m128 real = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 imaginary = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 power = _mm_add_ps(_mm_mul_ps(real, real), _mm_mul_ps(imaginary, imaginary));
+            _mm_storeu_ps(magnitudes + bin, _mm_sqrt_ps(power));
+        }
+#endif
+        for (; bin < binCount; bin++)
+        {
+            const float real = bins[bin * 2];
+            const float imaginary = bins[bin * 2 + 1];
+            magnitudes[bin] = Math::Sqrt(real * real + imaginary * imaginary);
+        }
+
+        for (uint32_t band = 0; band < BandCount; band++)
+        {
+            const uint32_t first = m_BandEdges[band];
+            const uint32_t last = Math::Max(first + 1, m_BandEdges[band + 1]);
+            float sum = 0.0f;
+            for (uint32_t index = first; index < last && index < binCount; index++)
+                sum += magnitudes[index];
+            const float amplitude = sum / (float)(last - first) * m_WindowScale;
+            spectrum.bands[band] = 20.0f * Math::Log10(Math::Max(amplitude, 1e-6f));
+        }
+
+        spectrum.binCount = binCount;
+        m_BackIndex = m_MiddleIndex.exchange(m_BackIndex | SpectrumReadyBit, std::memory_order_acq_rel) & ~SpectrumReadyBit;
+    }
+
+    void FFTAudioNode::AcquireSpectrum()
+    {
+        if ((m_MiddleIndex.load(std::memory_order_relaxed) & SpectrumReadyBit) == 0)
+            return;
+        m_FrontIndex = m_MiddleIndex.exchange(m_FrontIndex, std::memory_order_acq_rel) & ~SpectrumReadyBit;
     }
 
     uint32_t FFTAudioNode::GetFFTSize() const
     {
-        return m_FFTSize;
+        return m_RequestedFFTSize.load(std::memory_order_relaxed);
     }
 
     void FFTAudioNode::SetFFTSize(const uint32_t fftSize)
     {
         NOVA_ASSERT((fftSize & (fftSize - 1)) == 0, "FFTSize must be a power of 2!");
-        m_FFTSize = fftSize;
-        std::free(m_Config);
-        m_Config = kiss_fftr_alloc(m_FFTSize, 0, nullptr, nullptr);
+        NOVA_ASSERT(fftSize >= MinFFTSize && fftSize <= MaxFFTSize, "FFTSize out of range!");
+        m_RequestedFFTSize.store(fftSize, std::memory_order_relaxed);
     }
 
     void FFTAudioNode::SetFFTWindow(const FFTWindow window)
     {
-        m_FFTWindow = window;
+        m_RequestedFFTWindow.store(window, std::memory_order_relaxed);
     }
 
     FFTWindow FFTAudioNode::GetFFTWindow() const
     {
-        return m_FFTWindow;
+        return m_RequestedFFTWindow.load(std::memory_order_relaxed);
+    }
+
+    void FFTAudioNode::SetOverlap(const float overlap)
+    {
+        m_RequestedOverlap.store(Math::Clamp(overlap, 0.0f, 0.9375f), std::memory_order_relaxed);
+    }
+
+    float FFTAudioNode::GetOverlap() const
+    {
+        return m_RequestedOverlap.load(std::memory_order_relaxed);
     }
 
     BufferView<float> FFTAudioNode::GetFrequencies()
     {
-        return { m_Magnitudes, m_FFTSize / 2 };
+        AcquireSpectrum();
+        const Spectrum& spectrum = m_Spectra[m_FrontIndex];
+        return { spectrum.magnitudes, spectrum.binCount };
+    }
+
+    BufferView<float> FFTAudioNode::GetBands()
+    {
+        AcquireSpectrum();
+        const Spectrum& spectrum = m_Spectra[m_FrontIndex];
+        return { spectrum.bands, spectrum.binCount != 0 ? BandCount : 0 };
     }
 
     uint32_t FFTAudioNode::GetInputBusCount() const
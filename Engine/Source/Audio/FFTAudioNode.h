@@ -1,12 +1,13 @@
 ﻿#pragma once
 #include "AudioNode.h"
 #include "Containers/BufferView.h"
+#include <atomic>
 
 typedef struct kiss_fftr_state* kiss_fftr_cfg;
 
 namespace Nova
 {
-    struct FFTComplex { float i, r; };
+    struct FFTComplex { float r, i; };
 
     enum class FFTWindow
     {
@@ -27,11 +28,15 @@ namespace Nova
 
     Function<float(uint32_t, uint32_t)> GetFFTWindow(FFTWindow window);
     float ApplyWindow(FFTWindow window, uint32_t n, uint32_t fftSize);
+    void ComputeFFTWindow(FFTWindow window, uint32_t fftSize, float* outTable);
 
     class FFTAudioNode final : public AudioNode
     {
     public:
-        static constexpr uint32_t MaxFFTSize = 2048;
+        static constexpr uint32_t MinFFTSize = 64;
+        static constexpr uint32_t MaxFFTSize = 4096;
+        static constexpr uint32_t BandCount = 32;
+
         bool Initialize(AudioDevice* system) override;
         void Destroy() override;
         void OnProcess(const float** inFrames, uint32_t inFrameCount, float** outFrames,uint32_t outFrameCount) override;
@@ -39,18 +44,57 @@ namespace Nova
         void SetFFTSize(uint32_t fftSize);
         void SetFFTWindow(FFTWindow window);
         FFTWindow GetFFTWindow() const;
+        // Fraction of each analysis window shared with the previous one, the hop size is fftSize * (1 - overlap)
+        void SetOverlap(float overlap);
+        float GetOverlap() const;
 
+        // Latest published spectrum. The view stays valid until the next call to GetFrequencies or GetBands.
         BufferView<float> GetFrequencies();
+        // Log-spaced band levels in decibels, same lifetime rules as GetFrequencies
+        BufferView<float> GetBands();
         uint32_t GetInputBusCount() const override;
         uint32_t GetOutputBusCount() const override;
         uint32_t GetNodeFlags() const override;
 
     private:
-        uint32_t m_FFTSize = 256;
+        static constexpr uint32_t FFTSizeCount = 7;
+        static constexpr uint32_t SpectrumReadyBit = 4;
+
+        struct Spectrum
+        {
+            float magnitudes[MaxFFTSize / 2 + 1];
+            float bands[BandCount];
+            uint32_t binCount;
+        };
+
+        void ApplyPendingSettings();
+        void Analyze();
+        void AcquireSpectrum();
+
+        // Settings requested by the game thread, picked up by the audio thread
+        std::atomic<uint32_t> m_RequestedFFTSize = 256;
+        std::atomic<FFTWindow> m_RequestedFFTWindow = FFTWindow::Rectangular;
+        std::atomic<float> m_RequestedOverlap = 0.5f;
+
+        // Audio thread state
+        uint32_t m_FFTSize = 0;
         FFTWindow m_FFTWindow = FFTWindow::Rectangular;
-        kiss_fftr_cfg m_Config = nullptr;
+        float m_Overlap = 0.0f;
+        uint32_t m_HopSize = 0;
+        uint32_t m_WritePosition = 0;
+        uint32_t m_SamplesSinceLastFFT = 0;
+        float m_WindowScale = 1.0f;
+        kiss_fftr_cfg m_Configs[FFTSizeCount]{};
+        float m_Window[MaxFFTSize]{};
+        float m_History[MaxFFTSize]{};
         float m_InputBuffer[MaxFFTSize]{};
         FFTComplex m_OutputBuffer[MaxFFTSize / 2 + 1]{};
-        float m_Magnitudes[MaxFFTSize / 2 + 1]{};
+        uint32_t m_BandEdges[BandCount + 1]{};
+
+        // Triple buffered so neither thread ever waits on the other
+        Spectrum m_Spectra[3]{};
+        std::atomic<uint32_t> m_MiddleIndex = 1;
+        uint32_t m_BackIndex = 2;
+        uint32_t m_FrontIndex = 0;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,97 @@
+﻿#include "ResamplerAudioNode.h"
+#include "AudioSimd.h"
+#include "Math/Functions.h"
+
+namespace Nova
+{
+    bool ResamplerAudioNode::Initialize(AudioDevice* system)
+    {
+        if (!AudioNode::Initialize(system)) return false;
+        if (m_Channels == 0 || m_Channels > MaxChannels) return false;
+
+        m_Position = 0.0;
+        for (float& sample : m_PreviousFrame)
+            sample = 0.0f;
+        return true;
+    }
+
+    void ResamplerAudioNode::SetRatio(const float ratio)
+    {
+        m_Ratio.store(Math::Clamp(ratio, MinRatio, MaxRatio), std::memory_order_relaxed);
+    }
+
+    float ResamplerAudioNode::GetRatio() const
+    {
+        return m_Ratio.load(std::memory_order_relaxed);
+    }
+
+    uint32_t ResamplerAudioNode::GetRequiredInputFrameCount(const uint32_t outFrameCount) const
+    {
+        if (outFrameCount == 0) return 0;
+        // The last output frame interpolates towards input frame floor(position + (count - 1) * ratio) + 1
+        const double last = m_Position + (double)(outFrameCount - 1) * (double)GetRatio();
+        return (uint32_t)last + 1;
+    }
+
+    void ResamplerAudioNode::OnProcess(const float** inFrames, uint32_t inFrameCount, float** outFrames, uint32_t outFrameCount)
+    {
+        ProcessFrames(inFrames, &inFrameCount, outFrames, &outFrameCount);
+    }
+
+    void ResamplerAudioNode::ProcessFrames(const float** inFrames, uint32_t* inFrameCount, float** outFrames, uint32_t* outFrameCount)
+    {
+        using namespace AudioSimd;
+
+        const float* input = inFrames[0];
+        float* output = outFrames[0];
+        const uint32_t channels = m_Channels;
+        const uint32_t availableFrames = *inFrameCount;
+        const uint32_t requestedFrames = *outFrameCount;
+        const double ratio = (double)GetRatio();
+
+        // Frame 0 of the virtual input is the last frame of the previous call, frame n is input frame n - 1
+        const auto getFrame = [&](const uint32_t index) -> const float*
+        {
+            return index == 0 ? m_PreviousFrame : input + (index - 1) * channels;
+        };
+
+        double position = m_Position;
+        uint32_t produced = 0;
+        while (produced < requestedFrames)
+        {
+            const uint32_t index = (uint32_t)position;
+            if (index + 1 > availableFrames)
+                break;
+
+            const float fraction = (float)(position - (double)index);
+            const float* from = getFrame(index);
+            const float* to = getFrame(index + 1);
+            float* destination = output + produced * channels;
+
+            uint32_t channel = 0;
+            const Float4 weight = Splat(fraction);
+            for (; channel + 4 <= channels; channel += 4)
+            {
+                const Float4 a = Load(from + channel);
+                Store(destination + channel, MulAdd(Sub(Load(to + channel), a), weight, a));
+            }
+            for (; channel < channels; channel++)
+                destination[channel] = from[channel] + (to[channel] - from[channel]) * fraction;
+
+            produced++;
+            position += ratio;
+        }
+
+        const uint32_t consumed = Math::Min((uint32_t)position, availableFrames);
+        if (consumed > 0)
+        {
+            const float* last = input + (consumed - 1) * channels;
+            for (uint32_t channel = 0; channel < channels; channel++)
+                m_PreviousFrame[channel] = last[channel];
+        }
+
+        m_Position = position - (double)consumed;
+        *inFrameCount = consumed;
+        *outFrameCount = produced;
+    }
+}
@@ -0,0 +1,34 @@
+﻿#pragma once
+#include "AudioNode.h"
+#include <atomic>
+
+namespace Nova
+{
+    // Variable-rate linear interpolating sample-rate converter, consumes ratio input frames per output frame.
+    // Used for varispeed playback or to bring a sub-graph rendered at another rate back to the device rate.
+    class ResamplerAudioNode final : public AudioNode
+    {
+    public:
+        static constexpr uint32_t MaxChannels = 8;
+        static constexpr float MinRatio = 0.25f;
+        static constexpr float MaxRatio = 4.0f;
+
+        bool Initialize(AudioDevice* system) override;
+        void OnProcess(const float** inFrames, uint32_t inFrameCount, float** outFrames, uint32_t outFrameCount) override;
+        void ProcessFrames(const float** inFrames, uint32_t* inFrameCount, float** outFrames, uint32_t* outFrameCount) override;
+        uint32_t GetRequiredInputFrameCount(uint32_t outFrameCount) const override;
+
+        uint32_t GetInputBusCount() const override { return 1; }
+        uint32_t GetOutputBusCount() const override { return 1; }
+        uint32_t GetNodeFlags() const override { return MA_NODE_FLAG_DIFFERENT_PROCESSING_RATES; }
+
+        void SetRatio(float ratio);
+        float GetRatio() const;
+
+    private:
+        std::atomic<float> m_Ratio = 1.0f;
+        // Fractional read position, relative to m_PreviousFrame
+        double m_Position = 0.0;
+        float m_PreviousFrame[MaxChannels]{};
+    };
+}
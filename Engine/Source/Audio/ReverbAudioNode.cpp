@@ -0,0 +1,143 @@
+﻿#include "ReverbAudioNode.h"
+#include "AudioSimd.h"
+#include "Math/Functions.h"
+
+namespace Nova
+{
+    // Freeverb tunings in frames at 44.1 kHz, scaled to the device rate
+    static constexpr uint32_t s_CombTunings[ReverbAudioNode::CombCount] { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+    static constexpr uint32_t s_AllpassTunings[ReverbAudioNode::AllpassCount] { 556, 441, 341, 225 };
+    static constexpr uint32_t s_StereoSpread = 23;
+    static constexpr float s_FixedGain = 0.015f;
+    static constexpr float s_WetScale = 3.0f;
+
+    bool ReverbAudioNode::Initialize(AudioDevice* system)
+    {
+        if (!AudioEffectNode::Initialize(system)) return false;
+
+        const float rateScale = (float)m_SampleRate / 44100.0f;
+        uint32_t totalLength = 0;
+        for (uint32_t channel = 0; channel < m_Channels; channel++)
+        {
+            // Odd channels get slightly longer lines so the tails decorrelate
+            const uint32_t spread = channel % 2 == 1 ? s_StereoSpread : 0;
+            for (uint32_t comb = 0; comb < CombCount; comb++)
+            {
+                const uint32_t length = Math::Max(1u, (uint32_t)((float)(s_CombTunings[comb] + spread) * rateScale));
+                m_Combs[channel][comb] = { totalLength, length, 0 };
+                m_CombFilters[channel][comb] = 0.0f;
+                totalLength += length;
+            }
+
+            for (uint32_t allpass = 0; allpass < AllpassCount; allpass++)
+            {
+                const uint32_t length = Math::Max(1u, (uint32_t)((float)(s_AllpassTunings[allpass] + spread) * rateScale));
+                m_Allpasses[channel][allpass] = { totalLength, length, 0 };
+                totalLength += length;
+            }
+        }
+
+        m_Buffer = Array<float>(totalLength);
+        return true;
+    }
+
+    void ReverbAudioNode::SetRoomSize(const float roomSize)
+    {
+        m_RoomSize.store(Math::Clamp(roomSize, 0.0f, 1.0f), std::memory_order_relaxed);
+    }
+
+    void ReverbAudioNode::SetDamping(const float damping)
+    {
+        m_Damping.store(Math::Clamp(damping, 0.0f, 1.0f), std::memory_order_relaxed);
+    }
+
+    void ReverbAudioNode::SetMix(const float mix)
+    {
+        m_Mix.store(Math::Clamp(mix, 0.0f, 1.0f), std::memory_order_relaxed);
+    }
+
+    float ReverbAudioNode::GetRoomSize() const
+    {
+        return m_RoomSize.load(std::memory_order_relaxed);
+    }
+
+    float ReverbAudioNode::GetDamping() const
+    {
+        return m_Damping.load(std::memory_order_relaxed);
+    }
+
+    float ReverbAudioNode::GetMix() const
+    {
+        return m_Mix.load(std::memory_order_relaxed);
+    }
+
+    void ReverbAudioNode::ProcessBlock(float* const* channels, const uint32_t frameCount)
+    {
+        using namespace AudioSimd;
+
+        const float damping = GetDamping() * 0.4f;
+        const float mix = GetMix();
+        const float dry = 1.0f - mix;
+        const float wet = mix * s_WetScale;
+        const Float4 feedback = Splat(GetRoomSize() * 0.28f + 0.7f);
+        const Float4 damp = Splat(damping);
+        const Float4 undamp = Splat(1.0f - damping);
+        float* buffer = m_Buffer.Data();
+
+        for (uint32_t channel = 0; channel < m_Channels; channel++)
+        {
+            float* samples = channels[channel];
+            DelayLine* combs = m_Combs[channel];
+            DelayLine* allpasses = m_Allpasses[channel];
+            float* filters = m_CombFilters[channel];
+
+            for (uint32_t frame = 0; frame < frameCount; frame++)
+            {
+                const float input = samples[frame];
+                const Float4 combInput = Splat(input * s_FixedGain);
+                Float4 combSum = Splat(0.0f);
+
+                for (uint32_t group = 0; group < CombCount; group += 4)
+                {
+                    DelayLine* lines = combs + group;
+                    float* taps[4]
+                    {
+                        buffer + lines[0].offset + lines[0].position,
+                        buffer + lines[1].offset + lines[1].position,
+                        buffer + lines[2].offset + lines[2].position,
+                        buffer + lines[3].offset + lines[3].position,
+                    };
+
+                    const Float4 output = Set(*taps[0], *taps[1], *taps[2], *taps[3]);
+                    const Float4 filter = MulAdd(output, undamp, Mul(Load(filters + group), damp));
+                    Store(filters + group, filter);
+
+                    float written[4];
+                    Store(written, MulAdd(filter, feedback, combInput));
+                    for (uint32_t lane = 0; lane < 4; lane++)
+                    {
+                        *taps[lane] = written[lane];
+                        if (++lines[lane].position >= lines[lane].length)
+                            lines[lane].position = 0;
+                    }
+
+                    combSum = Add(combSum, output);
+                }
+
+                float result = HorizontalSum(combSum);
+                for (uint32_t allpass = 0; allpass < AllpassCount; allpass++)
+                {
+                    DelayLine& line = allpasses[allpass];
+                    float& tap = buffer[line.offset + line.position];
+                    const float delayed = tap;
+                    tap = result + delayed * 0.5f;
+                    result = delayed - result;
+                    if (++line.position >= line.length)
+                        line.position = 0;
+                }
+
+                samples[frame] = input * dry + result * wet;
+            }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+﻿#pragma once
+#include "AudioEffectNode.h"
+
+namespace Nova
+{
+    // Schroeder-Moorer reverb with the Freeverb tunings: eight damped combs in parallel followed by four allpasses.
+    // The eight combs of a channel run as two groups of four SIMD lanes.
+    class ReverbAudioNode final : public AudioEffectNode
+    {
+    public:
+        static constexpr uint32_t CombCount = 8;
+        static constexpr uint32_t AllpassCount = 4;
+
+        bool Initialize(AudioDevice* system) override;
+
+        void SetRoomSize(float roomSize);
+        void SetDamping(float damping);
+        void SetMix(float mix);
+
+        float GetRoomSize() const;
+        float GetDamping() const;
+        float GetMix() const;
+
+    protected:
+        void ProcessBlock(float* const* channels, uint32_t frameCount) override;
+
+    private:
+        struct DelayLine
+        {
+            uint32_t offset;
+            uint32_t length;
+            uint32_t position;
+        };
+
+        std::atomic<float> m_RoomSize = 0.5f;
+        std::atomic<float> m_Damping = 0.5f;
+        std::atomic<float> m_Mix = 0.25f;
+
+        Array<float> m_Buffer;
+        DelayLine m_Combs[MaxChannels][CombCount]{};
+        DelayLine m_Allpasses[MaxChannels][AllpassCount]{};
+        float m_CombFilters[MaxChannels][CombCount]{};
+    };
+}
@@ -30,7 +30,9 @@ namespace Nova
     {
         Component::OnUpdate(deltaTime);
 
+        // There is no audio device in headless runs
         AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
 
         const Transform* transform = GetTransform();
         const Vector3& position = transform->GetPosition();
@@ -48,6 +50,7 @@ namespace Nova
     {
         Component::OnEnable();
         AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
         ma_engine_listener_set_enabled(audioSystem->GetHandle(), m_Index, true);
     }
 
@@ -55,6 +58,7 @@ namespace Nova
     {
         Component::OnDisable();
         AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
         ma_engine_listener_set_enabled(audioSystem->GetHandle(), m_Index, false);
     }
 
@@ -27,28 +27,51 @@ namespace Nova
     {
         Component::OnUpdate(deltaTime);
 
+        // There is no audio device in headless runs
+        AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
         if (!m_Clip) return;
 
-        ma_sound_set_volume(m_Clip->GetHandle(), m_Volume);
-        ma_sound_set_pitch(m_Clip->GetHandle(), m_Pitch);
-        ma_sound_set_pan(m_Clip->GetHandle(), m_Pan);
-        ma_sound_set_looping(m_Clip->GetHandle(), m_Looping);
-        ma_sound_set_spatialization_enabled(m_Clip->GetHandle(), m_Spatialized);
-
-        m_PositionFrames = ma_sound_get_time_in_pcm_frames(m_Clip->GetHandle());
-        ma_sound_get_length_in_pcm_frames(m_Clip->GetHandle(), &m_DurationFrames);
         if(IsPlaying())
+        {
+            m_PositionFrames = ma_sound_get_time_in_pcm_frames(m_Clip->GetHandle());
             OnPlayingEvent.Broadcast(m_Clip, m_PositionFrames, m_DurationFrames);
+        }
 
         const Transform* transform = GetTransform();
         const Vector3 position = transform->GetPosition();
         const Vector3 forward = transform->GetForwardVector();
         const Vector3 velocity = (position - m_LastPosition) / deltaTime;
+
+        if (!(position == m_LastPosition))
+            m_DirtyParams |= AudioSourceParamBits::Position;
+        if (!(velocity == m_LastVelocity))
+            m_DirtyParams |= AudioSourceParamBits::Velocity;
+        if (!(forward == m_LastDirection))
+            m_DirtyParams |= AudioSourceParamBits::Direction;
+
         m_LastPosition = position;
-        ma_sound_set_position(m_Clip->GetHandle(), position.x, position.y, position.z);
-        ma_sound_set_velocity(m_Clip->GetHandle(), velocity.x, velocity.y, velocity.z);
-        ma_sound_set_direction(m_Clip->GetHandle(), forward.x, forward.y, forward.z);
-        ma_sound_set_cone(m_Clip->GetHandle(), Math::Tau, Math::Tau, 1.0f);
+        m_LastVelocity = velocity;
+        m_LastDirection = forward;
+
+        if (m_DirtyParams == AudioSourceParamBits::None)
+            return;
+
+        AudioSourceCommand command;
+        command.sound = m_Clip->GetHandle();
+        command.dirtyParams = m_DirtyParams;
+        command.volume = m_Volume;
+        command.pitch = m_Pitch;
+        command.pan = m_Pan;
+        command.looping = m_Looping;
+        command.spatialized = m_Spatialized;
+        command.position = position;
+        command.velocity = velocity;
+        command.direction = forward;
+
+        // Keep the dirty flags if the queue is full, they are sent again next frame
+        if (audioSystem->SubmitSourceCommand(command))
+            m_DirtyParams = AudioSourceParamBits::None;
     }
 
     void AudioSource::OnGui()
@@ -58,7 +81,7 @@ namespace Nova
         if (ImGui::TreeNode("Audio Clip"))
         {
             const String uuid = m_Clip ? m_Clip->GetUuid().GetString() : "None";
-            const String text = StringFormat("UUID: {}", uuid);
+            const FrameString text = StringFormat<FrameAllocator>("UUID: {}", uuid);
             ImGui::TextUnformatted(StringView(text));
 
             ImGui::Separator();
@@ -96,11 +119,16 @@ namespace Nova
             ImGui::TreePop();
         }
 
-        ImGui::DragFloat("Volume", &m_Volume, 0.01f, 0.0f, 1.0f, "%.2f");
-        ImGui::DragFloat("Pitch", &m_Pitch, 0.01f, 0.0f, 0.0f, "%.2f");
-        ImGui::DragFloat("Pan", &m_Pan, 0.01f, -1.0f, 1.0f, "%.2f");
-        ImGui::Checkbox("Looping", &m_Looping);
-        ImGui::Checkbox("Spatialized", &m_Spatialized);
+        if (ImGui::DragFloat("Volume", &m_Volume, 0.01f, 0.0f, 1.0f, "%.2f"))
+            m_DirtyParams |= AudioSourceParamBits::Volume;
+        if (ImGui::DragFloat("Pitch", &m_Pitch, 0.01f, 0.0f, 0.0f, "%.2f"))
+            m_DirtyParams |= AudioSourceParamBits::Pitch;
+        if (ImGui::DragFloat("Pan", &m_Pan, 0.01f, -1.0f, 1.0f, "%.2f"))
+            m_DirtyParams |= AudioSourceParamBits::Pan;
+        if (ImGui::Checkbox("Looping", &m_Looping))
+            m_DirtyParams |= AudioSourceParamBits::Looping;
+        if (ImGui::Checkbox("Spatialized", &m_Spatialized))
+            m_DirtyParams |= AudioSourceParamBits::Spatialization;
     }
 
 
@@ -108,6 +136,7 @@ namespace Nova
     void AudioSource::Play()
     {
         AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
         audioSystem->PlayAudioClip(m_Clip);
         OnStartedEvent.Broadcast(m_Clip, false);
     }
@@ -116,6 +145,7 @@ namespace Nova
     {
         if (!m_Clip) return;
         AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
         audioSystem->StopAudioClip(m_Clip);
         ma_sound_set_start_time_in_pcm_frames(m_Clip->GetHandle(), 0);
         OnStoppedEvent.Broadcast(m_Clip, false);
@@ -124,6 +154,7 @@ namespace Nova
     void AudioSource::Pause()
     {
         AudioDevice* audioSystem = AudioDevice::GetInstance();
+        if (!audioSystem) return;
         audioSystem->StopAudioClip(m_Clip);
         OnStoppedEvent.Broadcast(m_Clip, true);
         m_Paused = true;
@@ -134,6 +165,7 @@ namespace Nova
         if (m_Paused)
         {
             AudioDevice* audioSystem = AudioDevice::GetInstance();
+            if (!audioSystem) return;
             audioSystem->PlayAudioClip(m_Clip);
             OnStartedEvent.Broadcast(m_Clip, false);
             m_Paused = false;
@@ -149,31 +181,43 @@ namespace Nova
     {
         if(IsPlaying()) Stop();
         m_Clip = clip;
+        m_DurationFrames = m_Clip ? m_Clip->GetDurationFrames() : 0;
+        m_DirtyParams = AudioSourceParamBits::All;
     }
 
     void AudioSource::SetVolume(const float volume)
     {
+        if (m_Volume == volume) return;
         m_Volume = volume;
+        m_DirtyParams |= AudioSourceParamBits::Volume;
     }
 
     void AudioSource::SetPitch(const float pitch)
     {
+        if (m_Pitch == pitch) return;
         m_Pitch = pitch;
+        m_DirtyParams |= AudioSourceParamBits::Pitch;
     }
 
     void AudioSource::SetPan(const float pan)
     {
+        if (m_Pan == pan) return;
         m_Pan = pan;
+        m_DirtyParams |= AudioSourceParamBits::Pan;
     }
 
     void AudioSource::SetIsLooping(bool looping)
     {
+        if (m_Looping == looping) return;
         m_Looping = looping;
+        m_DirtyParams |= AudioSourceParamBits::Looping;
     }
 
     void AudioSource::SetIsSpatialized(bool spatialized)
     {
+        if (m_Spatialized == spatialized) return;
         m_Spatialized = spatialized;
+        m_DirtyParams |= AudioSourceParamBits::Spatialization;
     }
 
     float AudioSource::GetVolume() const
@@ -1,5 +1,6 @@
 #pragma once
 #include "Runtime/Component.h"
+#include "Audio/AudioCommand.h"
 #include "Containers/MulticastDelegate.h"
 #include "Math/Vector3.h"
 #include "Runtime/Ref.h"
@@ -62,5 +63,8 @@ namespace Nova
         uint64_t m_PositionFrames = 0;
         uint64_t m_DurationFrames = 0;
         Vector3 m_LastPosition = Vector3::Zero;
+        Vector3 m_LastVelocity = Vector3::Zero;
+        Vector3 m_LastDirection = Vector3::Forward;
+        AudioSourceParamFlags m_DirtyParams = AudioSourceParamBits::All;
     };
 }
@@ -28,9 +28,8 @@ namespace Nova
     {
         Component::OnUpdate(deltaTime);
         const Application* application = GetApplication();
-        const Window* window = application->GetWindow();
-        const float newWidth = window->GetWidth();
-        const float newHeight = window->GetHeight();
+        const float newWidth = application->GetWindowWidth();
+        const float newHeight = application->GetWindowHeight();
 
         if (Math::AreDifferent(m_Width, newWidth) || Math::AreDifferent(m_Height, newHeight))
         {
@@ -5,15 +5,10 @@
 
 namespace Nova
 {
-    void PhysicsComponent::OnPhysicsUpdate(const float deltaTime)
+    void PhysicsComponent::SyncTransform(const Vector3& position, const Quaternion& rotation)
     {
-        Component::OnPhysicsUpdate(deltaTime);
-        const Vector3 position = m_Body->GetPosition();
-        const Quaternion rotation = m_Body->GetRotation();
-
         Transform* transform = GetTransform();
-        transform->SetPosition(position);
-        transform->SetRotation(rotation);
+        transform->SetPositionAndRotation(position, rotation);
     }
 
     PhysicsBody* PhysicsComponent::GetPhysicsBody()
@@ -15,7 +15,7 @@ namespace Nova
     public:
         PhysicsComponent(Entity* owner, const String& name) : Component(owner, name) {}
 
-        void OnPhysicsUpdate(float deltaTime) override;
+        void SyncTransform(const Vector3& position, const Quaternion& rotation);
         PhysicsBody* GetPhysicsBody();
         const PhysicsBody* GetPhysicsBody() const;
 
@@ -1,102 +1,19 @@
-#include "SpriteRenderer.h"
+﻿#include "SpriteRenderer.h"
 #include "Runtime/Entity.h"
-#include "Runtime/Scene.h"
 #include "Math/Matrix4.h"
-#include "Rendering/ShaderModule.h"
-#include "Runtime/Application.h"
 #include "Components/Transform.h"
-#include "Components/Camera.h"
-#include "Utils/BufferUtils.h"
-#include "Rendering/RenderDevice.h"
-#include "Rendering/Shader.h"
+#include "Rendering/SpriteBatchRenderer.h"
 #include "Runtime/SpriteAnimation.h"
-#include "Rendering/ShaderBindingSet.h"
-#include "Rendering/Buffer.h"
-#include "Rendering/CommandBuffer.h"
 #include "Rendering/Texture.h"
 #include <imgui.h>
 
 namespace Nova
 {
-    struct SpriteVertex
-    {
-        Vector2 position;
-        Vector2 texCoord;
-    };
-
-    struct Uniforms
-    {
-        int32_t frameIndex;
-        int32_t cols;
-        int32_t rows;
-        int32_t flags;
-        Matrix4 mvp;
-        Vector2 tiling;
-        Vector2 offset;
-        Vector4 scale[2];
-        Vector4 color;
-    };
-
-
     SpriteRenderer::SpriteRenderer(Entity* owner) : Component(owner, "Sprite Renderer")
     {
 
     }
 
-    void SpriteRenderer::OnInit()
-    {
-        Application* application = GetApplication();
-        Ref<RenderDevice> device = application->GetRenderDevice();
-        const Ref<Window> window = application->GetWindow();
-        const Rect2D<uint32_t> viewport = window->GetBounds();
-
-        const uint32_t indices[] = { 0, 2, 1, 0, 3, 2 };
-        m_IndexBuffer = BufferUtils::CreateIndexBuffer(device, indices);
-
-        const SpriteVertex vertices[]
-        {
-            { {-0.5f, +0.5f }, {0.0f, 1.0f} },
-            { {+0.5f, +0.5f }, {1.0f, 1.0f} },
-            { {+0.5f, -0.5f }, {1.0f, 0.0f} },
-            { {-0.5f, -0.5f }, {0.0f, 0.0f} },
-        };
-        m_VertexBuffer = BufferUtils::CreateVertexBuffer(device, vertices);
-
-        m_UniformBuffer = device->CreateBuffer({ device, BufferUsage::UniformBuffer, sizeof(Uniforms) });
-        m_StagingBuffer = device->CreateBuffer({ device, BufferUsage::StagingBuffer, 4 * sizeof(SpriteVertex) });
-        if (!m_Sampler) m_Sampler = device->GetOrCreateSampler(SamplerCreateInfo(device));
-
-        const AssetDatabase& assetDatabase = application->GetAssetDatabase();
-        m_Shader = assetDatabase.Get<Shader>("SpriteShader");
-        m_BindingSet = m_Shader->CreateBindingSet(0);
-
-        GraphicsPipelineCreateInfo pipelineCreateInfo;
-        pipelineCreateInfo.device = device;
-        pipelineCreateInfo.shader = m_Shader;
-
-        VertexLayout vertexLayout;
-        vertexLayout.AddInputBinding(0, VertexInputRate::Vertex);
-        vertexLayout.AddInputAttribute("POSITION", ShaderDataType::Float2, 0);
-        vertexLayout.AddInputAttribute("TEXCOORDS", ShaderDataType::Float2, 0);
-        pipelineCreateInfo.vertexInputState = CreateInputStateFromVertexLayout(vertexLayout);
-
-        pipelineCreateInfo.multisampleState.sampleCount = 8;
-
-        pipelineCreateInfo.viewportState.x = viewport.x;
-        pipelineCreateInfo.viewportState.y = viewport.y;
-        pipelineCreateInfo.viewportState.width = viewport.width;
-        pipelineCreateInfo.viewportState.height = viewport.height;
-
-        pipelineCreateInfo.scissorState.x =  viewport.x;
-        pipelineCreateInfo.scissorState.y = viewport.y;
-        pipelineCreateInfo.scissorState.width = viewport.width;
-        pipelineCreateInfo.scissorState.height = viewport.height;
-        m_Pipeline = device->CreateGraphicsPipeline(pipelineCreateInfo);
-
-        m_BindingSet->BindSampler(0, *m_Sampler);
-        m_BindingSet->BindBuffer(2, *m_UniformBuffer, 0, sizeof(Uniforms));
-    }
-
     void SpriteRenderer::OnUpdate(const float deltaTime)
     {
         if (m_SpriteAnimation)
@@ -117,74 +34,8 @@ namespace Nova
 
     void SpriteRenderer::OnPreRender(CommandBuffer& cmdBuffer)
     {
-        Scene* scene = GetScene();
-
-        Array<Camera*> cameras = scene->GetAllComponents<Camera>();
-        if (cameras.IsEmpty()) return;
-
-        Camera* camera = cameras.First();
-        if (!camera->IsEnabled()) return;
-
-        const Matrix4& viewProjection = camera->GetViewProjectionMatrix();
         const Matrix4& worldSpaceMatrix = GetTransform()->GetWorldSpaceMatrix();
-        const Matrix4 mvp = viewProjection * worldSpaceMatrix;
-
-        const Vector2 tiling = m_Flags.Contains(SpriteRendererFlagBits::TileWithScale)
-        ? (Vector2)GetTransform()->GetScale()
-        : m_Tiling;
-
-        const Matrix2 spriteScale = m_Sprite.texture
-        ? Math::Scale(Matrix2::Identity, Vector2(m_Sprite.width, m_Sprite.height) / (float)m_PixelsPerUnit)
-        : Matrix2::Identity;
-
-        Uniforms uniforms;
-        uniforms.flags = m_Flags.As<int32_t>();
-        uniforms.frameIndex = m_SpriteIndex;
-        uniforms.rows = m_SpriteAnimation ? m_SpriteAnimation->GetSpriteSheet().rows : 0;
-        uniforms.cols = m_SpriteAnimation ? m_SpriteAnimation->GetSpriteSheet().columns : 0;
-        uniforms.mvp = mvp;
-        uniforms.tiling = tiling;
-        uniforms.offset = m_TilingOffset;
-        uniforms.scale[0] = Vector4(spriteScale[0].x, spriteScale[0].y, 0.0f, 0.0f);
-        uniforms.scale[1] = Vector4(spriteScale[1].x, spriteScale[1].y, 0.0f, 0.0f);
-        uniforms.color = m_ColorTint;
-
-        cmdBuffer.UpdateBuffer(*m_UniformBuffer, 0, sizeof(Uniforms), &uniforms);
-    }
-
-    void SpriteRenderer::OnRender(CommandBuffer& cmdBuffer)
-    {
-        if(!m_Sprite.texture) return;
-
-        Application* application = GetApplication();
-        const auto window = application->GetWindow();
-        const auto viewport = window->GetBounds();
-
-
-
-        m_BindingSet->BindTexture(1, *m_Sprite.texture, BindingType::SampledTexture);
-        cmdBuffer.BindGraphicsPipeline(*m_Pipeline);
-        cmdBuffer.BindShaderBindingSet(*m_Shader, *m_BindingSet);
-        cmdBuffer.BindVertexBuffer(*m_VertexBuffer, 0);
-        cmdBuffer.BindIndexBuffer(*m_IndexBuffer, 0, Format::Uint32);
-        cmdBuffer.SetViewport(viewport.x, viewport.y, viewport.width, viewport.height, 0.0f, 1.0f);
-        cmdBuffer.SetScissor(viewport.x, viewport.y, viewport.width, viewport.height);
-        cmdBuffer.DrawIndexed(6, 1, 0, 0, 0);
-    }
-
-    void SpriteRenderer::OnDestroy()
-    {
-        const Application* application = GetApplication();
-        const Ref<RenderDevice>& device = application->GetRenderDevice();
-        device->WaitIdle();
-
-        m_BindingSet->Destroy();
-        m_VertexBuffer->Destroy();
-        m_IndexBuffer->Destroy();
-        m_UniformBuffer->Destroy();
-        m_StagingBuffer->Destroy();
-        m_Sampler->Destroy();
-        m_Pipeline->Destroy();
+        SpriteBatchRenderer::DrawSprite(m_Sprite, worldSpaceMatrix, m_Flags, m_ColorTint, m_Tiling, m_TilingOffset, (float)m_PixelsPerUnit);
     }
 
     void SpriteRenderer::OnGui()
@@ -224,33 +75,24 @@ namespace Nova
         if (!sprite.texture) return;
         if (sprite == m_Sprite) return;
 
-        Ref<RenderDevice> renderDevice = RenderDevice::GetInstance();
-        renderDevice->WaitIdle();
-
         m_Sprite = sprite;
         m_SpriteAnimation = nullptr;
 
         m_SpriteIndex = 0;
         m_Time = 0.0f;
-        m_BindingSet->BindTexture(1, *m_Sprite.texture, BindingType::SampledTexture);
     }
 
     void SpriteRenderer::SetSprite(Ref<Texture> texture)
     {
-        SetSprite({0, 0, texture->GetWidth(), texture->GetHeight(), texture});
+        SetSprite({0, 0, texture->GetSourceWidth(), texture->GetSourceHeight(), texture});
     }
 
     void SpriteRenderer::SetSpriteAnimation(SpriteAnimation* spriteAnimation)
     {
-        const Application* application = GetApplication();
-        const Ref<RenderDevice>& device = application->GetRenderDevice();
-        device->WaitIdle();
-
         m_SpriteAnimation = spriteAnimation;
         m_SpriteIndex = 0;
         m_Time = 0.0f;
         m_Sprite = spriteAnimation->GetSprite(m_SpriteIndex);
-        m_BindingSet->BindTexture(1, *m_Sprite.texture, BindingType::SampledTexture);
     }
 
     SpriteAnimation* SpriteRenderer::GetSpriteAnimation() const
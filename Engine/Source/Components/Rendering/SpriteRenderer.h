@@ -2,32 +2,23 @@
 #include "Runtime/Component.h"
 #include "Runtime/Sprite.h"
 #include "Math/Vector2.h"
-#include "Rendering/Buffer.h"
-#include "Rendering/GraphicsPipeline.h"
-#include "Rendering/Sampler.h"
-#include "Rendering/ShaderBindingSet.h"
 #include "Rendering/SpriteRendererFlags.h"
+#include "Runtime/Color.h"
 #include "Runtime/Ref.h"
 
-typedef struct VkPipelineLayout_T* VkPipelineLayout;
-typedef struct VkDescriptorSet_T* VkDescriptorSet;
-typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
-
 namespace Nova
 {
-    class Shader;
     class SpriteAnimation;
+    class Texture;
 
+    // Submits its sprite to the SpriteBatchRenderer, which draws every sprite of the frame at once
     class SpriteRenderer final : public Component
     {
     public:
         explicit SpriteRenderer(Entity* owner);
 
-        void OnInit() override;
         void OnUpdate(float deltaTime) override;
         void OnPreRender(CommandBuffer& cmdBuffer) override;
-        void OnRender(CommandBuffer& cmdBuffer) override;
-        void OnDestroy() override;
         void OnGui() override;
 
         Sprite& GetSprite();
@@ -68,15 +59,6 @@ namespace Nova
         float m_Time = 0.0f;
         float m_Speed = 1.0f / 20.0f;
         uint32_t m_SpriteIndex = 0;
-
-        Ref<Shader> m_Shader = nullptr;
-        Ref<ShaderBindingSet> m_BindingSet = nullptr;
-        Ref<Buffer> m_VertexBuffer = nullptr;
-        Ref<Buffer> m_IndexBuffer = nullptr;
-        Ref<Buffer> m_UniformBuffer = nullptr;
-        Ref<Buffer> m_StagingBuffer = nullptr;
-        static inline Ref<Sampler> m_Sampler = nullptr;
-        Ref<GraphicsPipeline> m_Pipeline = nullptr;
     };
 
 
@@ -72,9 +72,11 @@ namespace Nova
         const Scene* scene = owner->GetOwner();
         Application* application = scene->GetOwner();
         Ref<RenderDevice> device = application->GetRenderDevice();
+        if (!device) return;
 
         const AssetDatabase& assetDatabase = application->GetAssetDatabase();
-        m_Shader = assetDatabase.Get<Shader>("PBRShadingShader");
+        static const Name shaderName("PBRShadingShader");
+        m_Shader = assetDatabase.Get<Shader>(shaderName);
         VertexLayout vertexLayout;
         vertexLayout.AddInputBinding(0, VertexInputRate::Vertex);
         vertexLayout.AddInputAttribute("POSITION", ShaderDataType::Float3, 0);
@@ -128,6 +130,7 @@ namespace Nova
         const Scene* scene = owner->GetOwner();
         Application* application = scene->GetOwner();
         Ref<RenderDevice> device = application->GetRenderDevice();
+        if (!device) return;
         device->WaitIdle();
 
         m_BindingSet1->Destroy();
@@ -161,9 +164,9 @@ namespace Nova
         const Vector3& cameraDirection = cameraTransform->GetForwardVector();
         const Vector3& entityPosition = entityTransform->GetPosition();
 
-        const Array<LightComponent*> allLights = scene->GetAllComponents<LightComponent>();
-        Array<LightComponent**> dirLights = allLights.Where([](const LightComponent* light) { return light->GetType() == LightType::Directional; });
-        Array<LightComponent**> ambLights = allLights.Where([](const LightComponent* light) { return light->GetType() == LightType::Ambient; });
+        const FrameArray<LightComponent*> allLights = scene->GetAllComponents<LightComponent, FrameAllocator>();
+        FrameArray<LightComponent**> dirLights = allLights.Where([](const LightComponent* light) { return light->GetType() == LightType::Directional; });
+        FrameArray<LightComponent**> ambLights = allLights.Where([](const LightComponent* light) { return light->GetType() == LightType::Ambient; });
 
         LightComponent** dirLight = dirLights.IsEmpty() ? nullptr : dirLights.First();
         LightComponent** ambLight = ambLights.IsEmpty() ? nullptr : ambLights.First();
@@ -234,11 +237,8 @@ namespace Nova
         if (m_StaticMesh->GetMaterialInfos().IsEmpty())
             return;
 
-        Ref<Buffer> vertexBuffer = m_StaticMesh->GetVertexBuffer();
-        if (!vertexBuffer) return;
-
-        Ref<Buffer> indexBuffer = m_StaticMesh->GetIndexBuffer();
-        if (!indexBuffer) return;
+        const GeometryHandle geometry = m_StaticMesh->GetGeometry();
+        if (geometry == InvalidGeometryHandle) return;
 
         // THIS NEEDS TO BE OPTIMIZED BY FILTER THE AVAILABLE LIGHTS
         Entity* owner = GetOwner();
@@ -258,6 +258,11 @@ namespace Nova
         cmdBuffer.SetViewport(0.0f, 0.0f, width, height, 0.0f, 1.0f);
         cmdBuffer.SetScissor(0, 0, (int32_t)width, (int32_t)height);
 
+        // Every mesh shares the same buffers, sub meshes only differ by their offsets
+        const GeometryBuffer& geometryBuffer = application->GetRenderDevice()->GetGeometryBuffer();
+        const GeometryRange range = geometryBuffer.GetRange(geometry);
+        geometryBuffer.Bind(cmdBuffer);
+
         const auto& materialInfos = m_StaticMesh->GetMaterialInfos();
         for (const MaterialInfo& materialInfo : materialInfos)
         {
@@ -267,9 +272,9 @@ namespace Nova
 
             for (const SubMeshInfo& subMesh : materialInfo.subMeshes)
             {
-                cmdBuffer.BindVertexBuffer(*vertexBuffer, subMesh.vertexBufferOffset);
-                cmdBuffer.BindIndexBuffer(*indexBuffer, subMesh.indexBufferOffset, Format::Uint32);
-                cmdBuffer.DrawIndexed(subMesh.indexBufferSize / sizeof(uint32_t), 1, 0, 0, 0);
+                const uint32_t firstIndex = range.firstIndex + subMesh.indexOffset;
+                const int32_t vertexOffset = (int32_t)(range.firstVertex + subMesh.vertexOffset);
+                cmdBuffer.DrawIndexed(subMesh.indexCount, 1, firstIndex, vertexOffset, 0);
             }
         }
     }
@@ -283,7 +288,7 @@ namespace Nova
     {
         const Application* application = GetApplication();
         const Ref<RenderDevice>& device = application->GetRenderDevice();
-        device->WaitIdle();
+        if (device) device->WaitIdle();
 
         m_StaticMesh = newMesh;
     }
@@ -85,6 +85,15 @@ namespace Nova
         OnChanged.BroadcastChecked();
     }
 
+    void Transform::SetPositionAndRotation(const Vector3& position, const Quaternion& rotation)
+    {
+        m_Position = position;
+        m_Rotation = rotation;
+        m_WorldSpaceMatrix.SetDirty();
+        m_LocalSpaceMatrix.SetDirty();
+        OnChanged.BroadcastChecked();
+    }
+
     void Transform::SetScale(const Vector3& scale)
     {
         m_Scale = scale;
@@ -20,6 +20,7 @@ namespace Nova
         
         void SetPosition(const Vector3& position);
         void SetRotation(const Quaternion& rotation);
+        void SetPositionAndRotation(const Vector3& position, const Quaternion& rotation);
         void SetScale(const Vector3& scale);
         void SetScale(float scale);
 
@@ -0,0 +1,33 @@
+﻿#pragma once
+#include "Runtime/Memory.h"
+#include "Runtime/Arena.h"
+#include <concepts>
+
+namespace Nova
+{
+    // Allocators of Array and StringBase are stateless policies.
+    // Allocate returns zeroed storage for count elements, tag is the memory tag used when the allocator tracks one.
+    template<typename Allocator>
+    concept ContainerAllocator = requires(void* ptr, size_t count, MemoryTag tag)
+    {
+        { Allocator::template Allocate<int>(count, tag) } -> std::same_as<int*>;
+        Allocator::Free(ptr);
+    };
+
+    struct HeapAllocator
+    {
+        template<typename T>
+        static T* Allocate(const size_t count, const MemoryTag tag)
+        {
+            return Memory::Calloc<T>(count, tag);
+        }
+
+        static void Free(void* ptr)
+        {
+            Memory::Free(ptr);
+        }
+    };
+
+    static_assert(ContainerAllocator<HeapAllocator>);
+    static_assert(ContainerAllocator<FrameAllocator>);
+}
@@ -5,12 +5,15 @@
 #include "Runtime/Assertion.h"
 #include "Math/Functions.h"
 #include "Function.h"
+#include "Allocator.h"
 #include <initializer_list>
 #include <algorithm>
+#include <memory>
+#include <type_traits>
 
 namespace Nova
 {
-    template<typename T>
+    template<typename T, ContainerAllocator Allocator = HeapAllocator>
     class Array final : public Iterable<T>
     {
     public:
@@ -33,42 +36,49 @@ namespace Nova
         Array()
         {
             m_Allocated = 1;
-            m_Data = Memory::Calloc<T>(m_Allocated);
+            m_Data = Allocate(m_Allocated);
             m_Count = 0;
         }
 
         explicit Array(ConstReferenceType first)
         {
             m_Allocated = 1;
-            m_Data = Memory::Calloc<T>(m_Allocated);
+            m_Data = Allocate(m_Allocated);
             m_Count = 1;
-            m_Data[0] = first;
+            new (m_Data) T(first);
         }
 
+        // Elements are value initialized
         explicit Array(const SizeType count)
         {
             m_Allocated = Math::NearestPowerOfTwo<SizeType>(count);
-            m_Data = Memory::Calloc<T>(m_Allocated);
+            m_Data = Allocate(m_Allocated);
             m_Count = count;
+            std::uninitialized_value_construct_n(m_Data, m_Count);
         }
 
 
         Array(const std::initializer_list<T>& list) : m_Count(list.size()), m_Allocated(list.size())
         {
-            m_Data = Memory::Calloc<T>(m_Allocated);
-            std::copy(list.begin(), list.end(), m_Data);
+            m_Data = Allocate(m_Allocated);
+            std::uninitialized_copy(list.begin(), list.end(), m_Data);
         }
 
         Array(ConstPointerType data, SizeType count) : m_Count(count), m_Allocated(count)
         {
-            m_Data = Memory::Calloc<T>(m_Allocated);
-            std::copy(data, data + count, m_Data);
+            m_Data = Allocate(m_Allocated);
+            std::uninitialized_copy_n(data, count, m_Data);
         }
 
         Array(const Array& other) : m_Count(other.m_Count), m_Allocated(other.m_Allocated)
         {
-            m_Data = Memory::Calloc<T>(m_Allocated);
-            std::copy(other.begin(), other.end(), m_Data);
+            m_Data = Allocate(m_Allocated);
+            std::uninitialized_copy_n(other.m_Data, other.m_Count, m_Data);
+        }
+
+        template<ContainerAllocator OtherAllocator>
+        explicit Array(const Array<T, OtherAllocator>& other) : Array(other.Data(), other.Count())
+        {
         }
 
         Array(Array&& other) noexcept
@@ -84,7 +94,8 @@ namespace Nova
 
         ~Array() override
         {
-            Memory::Free(m_Data);
+            DestroyElements();
+            Allocator::Free(m_Data);
         }
 
         Array& operator=(const Array& other)
@@ -92,11 +103,12 @@ namespace Nova
             if(this == &other)
                 return *this;
 
+            DestroyElements();
+            Allocator::Free(m_Data);
             m_Allocated = other.m_Allocated;
             m_Count = other.m_Count;
-            Memory::Free(m_Data);
-            m_Data = Memory::Calloc<T>(m_Allocated);
-            std::copy(other.begin(), other.end(), m_Data);
+            m_Data = Allocate(m_Allocated);
+            std::uninitialized_copy_n(other.m_Data, other.m_Count, m_Data);
             return *this;
         }
 
@@ -105,6 +117,8 @@ namespace Nova
             if(this == &other)
                 return *this;
 
+            DestroyElements();
+            Allocator::Free(m_Data);
             m_Data = other.m_Data;
             m_Count = other.m_Count;
             m_Allocated = other.m_Allocated;
@@ -173,15 +187,14 @@ namespace Nova
         {
             if(m_Count >= m_Allocated)
             {
-                m_Allocated = Realloc(m_Allocated);
-                PointerType realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = realloc;
+                // The element may live in the storage that is about to be released
+                T copy(element);
+                Grow(m_Count + 1);
+                new (m_Data + m_Count++) T(Memory::Move(copy));
+                return;
             }
 
-            m_Data[m_Count++] = element;
+            new (m_Data + m_Count++) T(element);
         }
 
         void AddUnique(ConstReferenceType element)
@@ -195,113 +208,64 @@ namespace Nova
         {
             if(m_Count >= m_Allocated)
             {
-                m_Allocated = Realloc(m_Allocated);
-                PointerType realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = realloc;
+                T element(std::forward<Args>(args)...);
+                Grow(m_Count + 1);
+                new (m_Data + m_Count++) T(Memory::Move(element));
+                return;
             }
 
-            m_Data[m_Count++] = T(std::forward<Args>(args)...);
+            new (m_Data + m_Count++) T(std::forward<Args>(args)...);
         }
 
         void AddRange(const std::initializer_list<T>& list)
         {
-            const SizeType totalCount = m_Count + list.size();
-            if(totalCount >= m_Allocated)
-            {
-                do
-                {
-                    m_Allocated = Realloc(m_Allocated);
-                } while (m_Allocated < totalCount);
-                PointerType Realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    Realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = Realloc;
-            }
-
-            std::copy(list.begin(), list.end(), &m_Data[m_Count]);
-            m_Count += list.size();
+            AddRange(list.begin(), list.size());
         }
 
         void AddRange(const Array& other)
         {
-            const SizeType totalCount = m_Count + other.m_Count;
-            if(totalCount >= m_Allocated)
-            {
-                do
-                {
-                    m_Allocated = Realloc(m_Allocated);
-                } while (m_Allocated < totalCount);
-
-                PointerType Realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    Realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = Realloc;
-            }
-
-            std::copy(other.begin(), other.end(), &m_Data[m_Count]);
-            m_Count += other.Count();
+            AddRange(other.m_Data, other.m_Count);
         }
 
         template<size_t N>
         void AddRange(const T(&data)[N])
         {
-            const SizeType totalCount = m_Count + N;
-            if(totalCount >= m_Allocated)
-            {
-                do
-                {
-                    m_Allocated = Realloc(m_Allocated);
-                } while (m_Allocated < totalCount);
-
-                PointerType realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = realloc;
-            }
-
-            std::copy(data, data + N, &m_Data[m_Count]);
-            m_Count += N;
+            AddRange(data, N);
         }
 
         void AddRange(ConstPointerType data, SizeType count)
         {
+            if (count == 0)
+                return;
+
             const SizeType totalCount = m_Count + count;
-            if(totalCount >= m_Allocated)
+            if(totalCount > m_Allocated)
             {
-                do
+                // Adding a range of this array to itself, copy it before the storage moves
+                if (data < m_Data + m_Count && data + count > m_Data)
                 {
-                    m_Allocated = Realloc(m_Allocated);
-                } while (m_Allocated < totalCount);
-                PointerType Realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    Realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = Realloc;
+                    const Array copy(data, count);
+                    AddRange(copy.m_Data, copy.m_Count);
+                    return;
+                }
+                Grow(totalCount);
             }
 
-            std::copy(data, data + count, &m_Data[m_Count]);
-            m_Count += count;
+            std::uninitialized_copy_n(data, count, m_Data + m_Count);
+            m_Count = totalCount;
         }
 
         void Emplace(T&& element)
         {
             if(m_Count >= m_Allocated)
             {
-                m_Allocated = Realloc(m_Allocated);
-                PointerType Realloc = Memory::Calloc<T>(m_Allocated);
-                for(SizeType i = 0; i < m_Count; ++i)
-                    Realloc[i] = m_Data[i];
-                Memory::Free(m_Data);
-                m_Data = Realloc;
+                T moved(Memory::Move(element));
+                Grow(m_Count + 1);
+                new (m_Data + m_Count++) T(Memory::Move(moved));
+                return;
             }
 
-            m_Data[m_Count++] = Memory::Move(element);
+            new (m_Data + m_Count++) T(Memory::Move(element));
         }
 
         Array Union(const Array& other)
@@ -317,16 +281,16 @@ namespace Nova
             SizeType index = Find(element);
             if(index == SizeType(-1)) return false;
 
-            std::move(m_Data + index + 1, m_Data + m_Count, m_Data + index);
-            m_Count--;
+            RemoveAt(index);
             return true;
         }
 
         void RemoveAt(SizeType index)
         {
-            NOVA_ASSERT(index <= m_Count, "Index out of bounds!");
+            NOVA_ASSERT(index < m_Count, "Index out of bounds!");
             std::move(m_Data + index + 1, m_Data + m_Count, m_Data + index);
             m_Count--;
+            std::destroy_at(m_Data + m_Count);
         }
 
         bool RemoveAll(ConstReferenceType element)
@@ -335,8 +299,7 @@ namespace Nova
             bool found = false;
             while ((index = Find(element)) != SizeType(-1))
             {
-                if(index < m_Count) std::move(m_Data + index + 1, m_Data + m_Count, m_Data + index);
-                m_Count--;
+                RemoveAt(index);
                 found = true;
             }
             return found;
@@ -365,7 +328,9 @@ namespace Nova
 
         void PopBack()
         {
-            RemoveAt(m_Count);
+            NOVA_ASSERT(m_Count > 0, "Array is empty!");
+            m_Count--;
+            std::destroy_at(m_Data + m_Count);
         }
 
         void PopHead()
@@ -373,24 +338,28 @@ namespace Nova
             RemoveAt(0);
         }
 
+        // Keeps the storage for the next elements
         void Clear()
         {
+            DestroyElements();
             m_Count = 0;
         }
 
         void Free()
         {
-            delete [] m_Data;
+            DestroyElements();
+            Allocator::Free(m_Data);
             m_Data = nullptr;
             m_Count = 0;
             m_Allocated = 0;
         }
 
         // Return an array of pointer to elements of type T, inside m_Data, where each element satisfies Predicate
-        Array<PointerType> Where(const Predicate& predicate) const
+        template<ContainerAllocator OutAllocator = Allocator>
+        Array<PointerType, OutAllocator> Where(const Predicate& predicate) const
         {
             if(!predicate) return {};
-            Array<PointerType> Result;
+            Array<PointerType, OutAllocator> Result;
             for(SizeType i = 0; i < m_Count; ++i)
             {
                 if(predicate(m_Data[i]))
@@ -411,11 +380,11 @@ namespace Nova
             return nullptr;
         }
 
-        template<typename Out>
-        Array<Out*> Select(const Selector<Out>& selector) const
+        template<typename Out, ContainerAllocator OutAllocator = Allocator>
+        Array<Out*, OutAllocator> Select(const Selector<Out>& selector) const
         {
             if(!selector) return {};
-            Array<Out*> Result;
+            Array<Out*, OutAllocator> Result;
             for(SizeType i = 0; i < m_Count; ++i)
             {
                 Result.Add(selector(m_Data[i]));
@@ -446,10 +415,10 @@ namespace Nova
         bool IsEmpty() const { return m_Count == 0; }
 
 
-        template<typename U>
-        Array<U> Transform(const Function<U(ConstReferenceType)>& predicate) const
+        template<typename U, ContainerAllocator OutAllocator = Allocator>
+        Array<U, OutAllocator> Transform(const Function<U(ConstReferenceType)>& predicate) const
         {
-            Array<U> result;
+            Array<U, OutAllocator> result;
             for (size_t index = 0; index < m_Count; ++index)
             {
                 const T& element = m_Data[index];
@@ -459,7 +428,7 @@ namespace Nova
         }
 
         template<typename U> requires std::is_convertible_v<T, U>
-        Array<U> As()
+        Array<U, Allocator> As()
         {
             return Transform<U>([](ConstReferenceType element) { return U(element); });
         }
@@ -493,6 +462,32 @@ namespace Nova
             QuickSort(0, m_Count - 1, compareFunc);
         }
     private:
+        // Counted as containers unless a Memory::ScopedTag says otherwise
+        static PointerType Allocate(const SizeType count)
+        {
+            return Allocator::template Allocate<T>(count, Memory::GetCurrentTag(MemoryTag::Containers));
+        }
+
+        void DestroyElements()
+        {
+            std::destroy_n(m_Data, m_Count);
+        }
+
+        // Moves the elements to storage holding at least minCount elements
+        void Grow(const SizeType minCount)
+        {
+            SizeType allocated = Math::Max<SizeType>(m_Allocated, 1);
+            while (allocated < minCount)
+                allocated = Realloc(allocated);
+
+            const PointerType data = Allocate(allocated);
+            std::uninitialized_move_n(m_Data, m_Count, data);
+            DestroyElements();
+            Allocator::Free(m_Data);
+            m_Data = data;
+            m_Allocated = allocated;
+        }
+
         void QuickSort(SizeType low, SizeType high,
                const Function<bool(ConstReferenceType, ConstReferenceType)>& compareFunc)
         {
@@ -535,4 +530,8 @@ namespace Nova
             return Current * 2;
         }
     };
+
+    // Temporaries living until the end of the next frame, see FrameAllocator
+    template<typename T>
+    using FrameArray = Array<T, FrameAllocator>;
 }
@@ -41,7 +41,9 @@ namespace Nova
             return m_Data[index].value;
         }
 
-        SizeType FindKey(const KeyType& key) const
+        // Key may be any type comparable with KeyType, e.g. a StringView for String keys
+        template<typename OtherKeyType = KeyType>
+        SizeType FindKey(const OtherKeyType& key) const
         {
             for(SizeType i = 0; i < m_Data.Count(); ++i)
             {
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+
+namespace Nova
+{
+    // Bounded lock-free queue for exactly one producer thread and one consumer thread.
+    // Capacity must be a power of two, one slot is always kept empty.
+    template<typename T, size_t Capacity>
+    class SpscQueue
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+        static constexpr size_t Mask = Capacity - 1;
+    public:
+        using ValueType = T;
+        using SizeType = size_t;
+
+        SpscQueue() = default;
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // Producer side
+        bool TryEnqueue(const T& item)
+        {
+            const size_t head = m_Head.load(std::memory_order_relaxed);
+            const size_t next = (head + 1) & Mask;
+            if (next == m_Tail.load(std::memory_order_acquire))
+                return false;
+
+            m_Data[head] = item;
+            m_Head.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side
+        bool TryDequeue(T& outItem)
+        {
+            const size_t tail = m_Tail.load(std::memory_order_relaxed);
+            if (tail == m_Head.load(std::memory_order_acquire))
+                return false;
+
+            outItem = m_Data[tail];
+            m_Tail.store((tail + 1) & Mask, std::memory_order_release);
+            return true;
+        }
+
+        bool IsEmpty() const
+        {
+            return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+        }
+
+        static constexpr SizeType GetCapacity() { return Capacity - 1; }
+    private:
+        alignas(64) std::atomic<size_t> m_Head = 0;
+        alignas(64) std::atomic<size_t> m_Tail = 0;
+        alignas(64) T m_Data[Capacity];
+    };
+}
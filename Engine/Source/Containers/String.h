@@ -1,31 +1,19 @@
 ﻿#pragma once
+#include "Containers/StringView.h"
 #include "Containers/Array.h"
 #include "Runtime/Iterator.h"
 #include "Runtime/Assertion.h"
 #include "Runtime/TypeTraits.h"
 #include "Containers/BufferView.h"
+#include <algorithm>
 #include <string_view>
 #include <iostream>
 
 namespace Nova
 {
-
-    template<Character T>
-    static constexpr size_t StringLength(const T* data)
-    {
-        if (!data) return 0;
-
-        const T* ptr = data;
-        size_t count = 0;
-        while (*ptr != 0)
-        {
-            count++;
-            ++ptr;
-        }
-        return count;
-    }
-    
-    template<typename T> requires IsCharacterValue<T>
+    // Strings of up to InlineCapacity characters are stored inside the object, longer ones use Allocator.
+    // Appending grows the capacity geometrically, assigning reuses the buffer when it is large enough.
+    template<typename T, ContainerAllocator Allocator = HeapAllocator> requires IsCharacterValue<T>
     class StringBase : public Iterable<T>
     {
     public:
@@ -37,50 +25,45 @@ namespace Nova
         using ConstIterator = ConstIterator<T>;
         using ArrayType = Array<CharacterType>;
         using BufferType = BufferView<CharacterType>;
+        using StringViewType = StringViewBase<CharacterType>;
         
         static constexpr SizeType CharacterSize = sizeof(CharacterType);
+        static constexpr SizeType InlineCapacity = 24 / CharacterSize - 1;
         
-        StringBase()
-        {
-            m_Data = new CharacterType[1]{};
-            m_Count = 0;
-        }
+        StringBase() = default;
         
         StringBase(StringLiteralType data)
         {
             NOVA_ASSERT(data, "Cannot construct string with nullptr!");
-            m_Count = StringLength(data);
-            m_Data = new CharacterType[m_Count + 1]{};
-            memcpy(m_Data, data, m_Count * CharacterSize);
+            Assign(data, StringLength(data));
         }
 
-        explicit StringBase(const SizeType count) : m_Count(count)
+        explicit StringBase(const SizeType count)
         {
-            m_Data = new CharacterType[m_Count + 1]{};
+            Reserve(count);
+            m_Count = count;
+            Data()[m_Count] = 0;
         }
 
-        StringBase(CharacterType* data, SizeType count)
+        StringBase(const CharacterType* data, SizeType count)
         {
             NOVA_ASSERT(data, "Cannot construct string with nullptr!");
-            m_Count = count;
-            m_Data = new CharacterType[m_Count + 1]{};
-            memcpy(m_Data, data, m_Count * CharacterSize);
+            Assign(data, count);
+        }
+
+        explicit StringBase(const StringViewType string)
+        {
+            Assign(string.Data(), string.Count());
         }
 
         StringBase(const StringBase& other)
         {
-            delete[] m_Data;
-            m_Data = new CharacterType[other.m_Count + 1]{};
-            memcpy(m_Data, other.m_Data, other.m_Count * CharacterSize);
-            m_Count = other.m_Count;
+            Assign(other.Data(), other.m_Count);
         }
 
-        StringBase(StringBase&& Other) noexcept
+        StringBase(StringBase&& other) noexcept
         {
-            m_Data = Other.m_Data;
-            m_Count = Other.m_Count;
-            Other.m_Data = nullptr;
-            Other.m_Count = 0;
+            MoveFrom(other);
         }
 
         StringBase& operator=(const StringBase& other)
@@ -88,10 +71,7 @@ namespace Nova
             if(this == &other)
                 return *this;
 
-            if(m_Data) delete[] m_Data;
-            m_Data = new CharacterType[other.m_Count + 1]{};
-            memcpy(m_Data, other.m_Data, other.m_Count * CharacterSize);
-            m_Count = other.m_Count;
+            Assign(other.Data(), other.m_Count);
             return *this;
         }
 
@@ -100,186 +80,171 @@ namespace Nova
             if(this == &other)
                 return *this;
 
-            delete[] m_Data;
-            
-            m_Data = other.m_Data;
-            m_Count = other.m_Count;
-            other.m_Data = nullptr;
-            other.m_Count = 0;
+            Free();
+            MoveFrom(other);
+            return *this;
+        }
+
+        StringBase& operator=(StringLiteralType data)
+        {
+            NOVA_ASSERT(data, "Cannot assign nullptr to a string!");
+            Assign(data, StringLength(data));
             return *this;
         }
 
         template<SizeType N>
         StringBase& operator=(CharacterType (&&buffer)[N])
         {
-            const SizeType count = StringLength(buffer);
-            if (count < N)
-            {
-                delete[] m_Data;
-                m_Data = new CharacterType[count];
-            }
-
-            Memory::Memmove(m_Data, buffer, count * CharacterSize);
-            m_Data[m_Count] = 0;
-            m_Count = count;
+            Assign(buffer, StringLength(buffer));
             return *this;
         }
 
         ~StringBase() override
         {
-            delete[] m_Data;
-            m_Count = 0;
+            Free();
         }
 
         CharacterType& operator[](SizeType index)
         {
             NOVA_ASSERT(index <= m_Count, "Index out of bounds");
-            return m_Data[index];
+            return Data()[index];
         }
         
         const CharacterType& operator[](SizeType index) const
         {
             NOVA_ASSERT(index <= m_Count, "Index out of bounds");
-            return m_Data[index];
+            return Data()[index];
         }
 
-        bool operator==(const StringBase& other) const
+        bool operator==(const StringViewType other) const
         {
-            return std::strcmp(m_Data, other.m_Data) == 0 && m_Count == other.m_Count;
+            return m_Count == other.Count() && Memory::Memcmp(Data(), other.Data(), m_Count * CharacterSize);
         }
 
         bool IsEmpty() const { return m_Count == 0; }
 
-        CharacterType* Data() { return m_Data; }
-        const CharacterType* Data() const { return m_Data; }
+        CharacterType* Data() { return m_Heap ? m_Heap : m_Inline; }
+        const CharacterType* Data() const { return m_Heap ? m_Heap : m_Inline; }
         
-        CharacterType* operator*() { return m_Data; }
-        const CharacterType* operator*() const { return m_Data; }
+        CharacterType* operator*() { return Data(); }
+        const CharacterType* operator*() const { return Data(); }
         
         SizeType Count() const { return m_Count; }
         SizeType Size() const { return m_Count * CharacterSize; }
+        SizeType Capacity() const { return IsInline() ? InlineCapacity : m_Capacity; }
+        bool IsInline() const { return !m_Heap; }
 
+        // Makes room for capacity characters without changing the content
+        void Reserve(const SizeType capacity)
+        {
+            if (capacity <= Capacity())
+                return;
+
+            CharacterType* newData = Allocate(capacity + 1);
+            memcpy(newData, Data(), (m_Count + 1) * CharacterSize);
+            if (m_Heap)
+                Deallocate(m_Heap);
+            m_Heap = newData;
+            m_Capacity = capacity;
+        }
 
         StringBase& Resize(const SizeType newCount)
         {
             if (m_Count == newCount) return *this;
 
-            if (m_Count > newCount)
+            if (newCount > m_Count)
             {
-                CharacterType* newData = new CharacterType [newCount + 1]{0};
-                Memory::Memcpy(newData, m_Data, m_Count * CharacterSize);
-                delete [] m_Data;
-                m_Data = newData;
-                m_Count = newCount;
-                return *this;
-            }
-
-            if (m_Count < newCount)
-            {
-                CharacterType* newData = new CharacterType [newCount + 1]{0};
-                Memory::Memcpy(newData, m_Data, newCount * CharacterSize);
-                delete [] m_Data;
-                m_Data = newData;
-                m_Count = newCount;
-                return *this;
+                Reserve(newCount);
+                Memory::Memset(Data() + m_Count, 0, newCount - m_Count);
             }
 
-            return *this;
-        }
-        
-        StringBase& Append(StringLiteralType data)
-        {
-            NOVA_ASSERT(data, "Cannot append string with nullptr string literal!");
-            const SizeType dataCount = StringLength(data);
-            const SizeType newCount = m_Count + dataCount;
-            CharacterType* newData = new CharacterType[newCount + 1]{};
-            memcpy(newData, m_Data, m_Count * CharacterSize);
-            memcpy(newData + m_Count, data, dataCount * CharacterSize);
-            delete [] m_Data;
-            m_Data = newData;
             m_Count = newCount;
+            Data()[m_Count] = 0;
             return *this;
         }
 
-        
         StringBase& Append(CharacterType character)
         {
-            const SizeType newCount = m_Count + 1;
-            CharacterType* newData = new CharacterType[newCount + 1]{};
-            memcpy(newData, m_Data, m_Count * CharacterSize);
-            memcpy(newData + m_Count, &character, CharacterSize);
-            delete [] m_Data;
-            m_Data = newData;
-            m_Count = newCount;
+            if (m_Count + 1 > Capacity())
+                Grow(m_Count + 1);
+
+            CharacterType* data = Data();
+            data[m_Count++] = character;
+            data[m_Count] = 0;
             return *this;
         }
 
-        StringBase& Append(const StringBase& string)
+        StringBase& Append(const StringViewType string)
         {
             const SizeType dataCount = string.Count();
+            if (dataCount == 0)
+                return *this;
+
+            const CharacterType* source = string.Data();
             const SizeType newCount = m_Count + dataCount;
-            CharacterType* newData = new CharacterType[newCount + 1]{};
-            memcpy(newData, m_Data, m_Count * CharacterSize);
-            memcpy(newData + m_Count, string.Data(), dataCount * CharacterSize);
-            delete [] m_Data;
-            m_Data = newData;
+            if (newCount > Capacity())
+            {
+                // Appending a part of this string, it moves with the characters
+                const bool aliased = source >= Data() && source < Data() + m_Count;
+                const SizeType offset = source - Data();
+                Grow(newCount);
+                if (aliased) source = Data() + offset;
+            }
+
+            CharacterType* data = Data();
+            memcpy(data + m_Count, source, dataCount * CharacterSize);
             m_Count = newCount;
+            data[m_Count] = 0;
             return *this;
         }
-        
+
+        // Characters from begin to end included
         StringBase Substring(SizeType begin, SizeType end) const
         {
             NOVA_ASSERT(begin < m_Count && begin + (end - begin) <= m_Count, "Indices out of bounds!");
             const SizeType newCount = end - begin + 1;
-            CharacterType* newData = new CharacterType[newCount + 1]{};
-            memcpy(newData, m_Data + begin, newCount * CharacterSize);
-            return {newData, newCount};
+            return StringBase(Data() + begin, newCount);
         }
 
         StringBase Substring(const SizeType begin) const
         {
-            return Substring(begin, m_Count);
+            NOVA_ASSERT(begin <= m_Count, "Index out of bounds!");
+            return StringBase(Data() + begin, m_Count - begin);
         }
         
         SizeType Find(CharacterType character) const
         {
             for(SizeType i = 0; i < m_Count; ++i)
             {
-                if(m_Data[i] == character)
+                if(Data()[i] == character)
                     return i;
             }
             return -1;
         }
 
-        SizeType Find(const StringBase& string) const
+        SizeType Find(const StringViewType string) const
         {
-            std::basic_string_view<CharacterType> view(m_Data, m_Count);
-            std::basic_string_view<CharacterType> otherView(string.m_Data, string.m_Count);
-            return view.find(otherView);
+            return AsView().Find(string);
         }
 
-        SizeType Find(SizeType index, const StringBase& string) const
+        SizeType Find(SizeType index, const StringViewType string) const
         {
-            std::basic_string_view<CharacterType> view(m_Data + index, m_Count);
-            std::basic_string_view<CharacterType> otherView(string.m_Data, string.m_Count);
-            return view.find(otherView);
+            return AsView().Find(index, string);
         }
 
-        SizeType FindLast(const StringBase& string) const
+        SizeType FindLast(const StringViewType string) const
         {
-            std::basic_string_view<CharacterType> view(m_Data, m_Count);
-            std::basic_string_view<CharacterType> otherView(string.m_Data, string.m_Count);
-            return view.find_last_of(otherView);
+            return AsView().FindLast(string);
         }
 
-        bool EndsWith(const StringBase& string) const
+        bool EndsWith(const StringViewType string) const
         {
-            return FindLast(string) != SizeType(-1);
+            return AsView().EndsWith(string);
         }
 
-        bool StartsWith(const StringBase& string) const
+        bool StartsWith(const StringViewType string) const
         {
-            return Find(string) == 0;
+            return AsView().StartsWith(string);
         }
         
         SizeType OccurrencesOf(CharacterType character) const
@@ -287,91 +252,59 @@ namespace Nova
             SizeType result = 0;
             for(SizeType i = 0; i < m_Count; ++i)
             {
-                CharacterType current = m_Data[i];
+                CharacterType current = Data()[i];
                 if(current == character)
                     result++;
             }
             return result;
         }
 
-        StringBase& Replace(const StringBase& from, const StringBase& to)
+        StringBase& Replace(const StringViewType from, const StringViewType to)
         {
             const SizeType index = Find(from);
             if(index == -1ULL) return *this;
-
-            if (to.Count() <= from.Count())
-            {
-                memcpy(m_Data + index, *to, to.Size());
-                return *this;
-            }
-            
-            const SizeType delta = to.Count() - from.Count();
-            const SizeType newCount = m_Count + delta;
-            CharacterType* newData = new CharacterType[newCount]{};
-                
-            CharacterType* dest = newData;
-            CharacterType* src = m_Data;
-            SizeType size = index * CharacterSize;
-            memcpy(dest, src, size);
-                
-            dest = newData + index * CharacterSize;
-            src = const_cast<CharacterType*>(*to);
-            size = to.Size();
-            memcpy(dest, src, size);
-
-            dest = newData + index * CharacterSize + to.Size();
-            src = m_Data + index * CharacterSize + from.Size();
-            size = m_Count * CharacterSize - (index * CharacterSize + from.Size());
-            memcpy(dest, src, size);
-
-            delete [] m_Data;
-            m_Data = newData;
-            m_Count = newCount;
-            return *this;
+            return Replace(index, from.Count(), to);
         }
 
-        StringBase& Replace(SizeType index, SizeType count, const StringBase& to)
+        StringBase& Replace(SizeType index, SizeType count, const StringViewType to)
         {
-            NOVA_ASSERT(index < m_Count && index + count <= m_Count, "Range is out of bounds!");
-            if (index == -1ULL) return *this;
+            NOVA_ASSERT(index <= m_Count && index + count <= m_Count, "Range is out of bounds!");
 
-            if (to.Count() <= count)
+            // The replacement may point into this string, which the move below or Grow would overwrite
+            if (Overlaps(to))
             {
-                memcpy(m_Data + index, *to, to.Size());
-                return *this;
+                const StringBase copy(to);
+                return Replace(index, count, copy.AsView());
             }
 
-            const SizeType delta = to.Count() - count;
-            const SizeType newCount = m_Count + delta;
-            CharacterType* newData = new CharacterType[newCount]{};
-                
-            CharacterType* dest = newData;
-            CharacterType* src = m_Data;
-            SizeType size = index * CharacterSize;
-            memcpy(dest, src, size);
-                
-            dest = newData + index * CharacterSize;
-            src = const_cast<CharacterType*>(*to);
-            size = to.Size();
-            memcpy(dest, src, size);
-
-            dest = newData + index * CharacterSize + to.Size();
-            src = m_Data + index * CharacterSize + count * CharacterSize;
-            size = m_Count * CharacterSize - (index * CharacterSize + count * CharacterSize);
-            memcpy(dest, src, size);
-
-            delete [] m_Data;
-            m_Data = newData;
+            const SizeType newCount = m_Count - count + to.Count();
+            if (newCount > Capacity())
+                Grow(newCount);
+
+            CharacterType* data = Data();
+            CharacterType* tail = data + index + count;
+            ::memmove(data + index + to.Count(), tail, (m_Count - index - count) * CharacterSize);
+            memcpy(data + index, to.Data(), to.Size());
             m_Count = newCount;
+            data[m_Count] = 0;
             return *this;
         }
 
-        StringBase& ReplaceAll(const StringBase& from, const StringBase& to)
+        StringBase& ReplaceAll(const StringViewType from, const StringViewType to)
         {
+            if (from.IsEmpty()) return *this;
+            if (Overlaps(from) || Overlaps(to))
+            {
+                const StringBase fromCopy(from);
+                const StringBase toCopy(to);
+                return ReplaceAll(fromCopy.AsView(), toCopy.AsView());
+            }
+
             SizeType index = 0;
             while ((index = Find(index, from)) != -1ULL)
             {
-                Replace(index, m_Count - index, to);
+                Replace(index, from.Count(), to);
+                index += to.Count();
             }
             return *this;
         }
@@ -379,10 +312,11 @@ namespace Nova
         StringBase& ReplaceAll(CharacterType from, CharacterType to)
         {
             if (from == to) return *this;
-            if (!m_Data || m_Count <= 0) return *this;
+            if (m_Count <= 0) return *this;
 
-            CharacterType* ptr = m_Data;
-            while (ptr < m_Data + m_Count)
+            CharacterType* ptr = Data();
+            CharacterType* end = ptr + m_Count;
+            while (ptr < end)
             {
                 if (*ptr == from)
                     *ptr = to;
@@ -399,16 +333,16 @@ namespace Nova
             NOVA_ASSERT(from + (to - from) <= m_Count, "Range is illegal");
             const SizeType delta = to - from;
             
-            const CharacterType* src = m_Data + to;
-            CharacterType* dest = m_Data + from;
+            const CharacterType* src = Data() + to;
+            CharacterType* dest = Data() + from;
             const SizeType size = (m_Count - to) * CharacterSize;
             ::memmove(dest, src, size);
             m_Count -= delta;
-            m_Data[m_Count] = 0;
+            Data()[m_Count] = 0;
             return *this;
         }
 
-        StringBase& Remove(const StringBase& string)
+        StringBase& Remove(const StringViewType string)
         {
             const SizeType index = Find(string);
             if (index == -1ULL) return *this;
@@ -416,82 +350,140 @@ namespace Nova
             return *this;
         }
         
-        Iterator begin() override { return m_Data; }
-        Iterator end() override { return m_Data + m_Count; }
-        ConstIterator begin() const override { return m_Data; }
-        ConstIterator end() const override { return m_Data + m_Count; }
+        Iterator begin() override { return Data(); }
+        Iterator end() override { return Data() + m_Count; }
+        ConstIterator begin() const override { return Data(); }
+        ConstIterator end() const override { return Data() + m_Count; }
 
-        ArrayType AsArray() const { return ArrayType(m_Data, m_Count); }
-        BufferType AsBuffer() const { return BufferType(m_Data, m_Count); }
+        ArrayType AsArray() const { return ArrayType(Data(), m_Count); }
+        BufferType AsBuffer() const { return BufferType(Data(), m_Count); }
+        StringViewType AsView() const { return StringViewType(Data(), m_Count); }
 
         template<typename U> requires (sizeof(T) % sizeof(U) == 0)
-        BufferView<U> GetView() { return BufferView<U>((U*)m_Data, m_Count); }
+        BufferView<U> GetView() { return BufferView<U>((U*)Data(), m_Count); }
         
-        StringBase& operator+(const StringBase& other)
+        StringBase& operator+(const StringViewType other)
         {
             return Append(other);
         }
 
+        // True if the view points into the characters of this string
+        bool Overlaps(const StringViewType view) const
+        {
+            const CharacterType* begin = Data();
+            return view.Data() < begin + m_Count && view.Data() + view.Count() > begin;
+        }
+
         StringBase& TrimEnd(CharacterType character)
         {
             SizeType count = 0;
-            for (size_t index = m_Count - 1; index > 0; --index)
-            {
-                if (m_Data[index] != character)
-                    break;
-                count++;
-            }
+            while (count < m_Count && Data()[m_Count - 1 - count] == character)
+                ++count;
 
             if (count == 0)
                 return *this;
 
             m_Count -= count;
-            m_Data[m_Count] = 0;
+            Data()[m_Count] = 0;
             return *this;
         }
 
         StringBase TrimStart(CharacterType character) const
         {
-            StringBase copy(*this);
             SizeType count = 0;
-            while (count < copy.m_Count && copy.m_Data[count] == character)
+            while (count < m_Count && Data()[count] == character)
                 ++count;
-
-            if (count == 0)
-                return copy;
-
-            memmove(copy.m_Data, copy.m_Data + count, (copy.m_Count - count) * CharacterSize);
-            copy.m_Count -= count;
-            copy.m_Data[m_Count] = 0;
-            return copy;
+            return StringBase(Data() + count, m_Count - count);
         }
 
         StringBase TrimStart(const Array<CharacterType>& characters) const
         {
-            StringBase copy(*this);
             SizeType count = 0;
-            while (count < copy.m_Count && characters.Contains(copy.m_Data[count]))
+            while (count < m_Count && characters.Contains(Data()[count]))
                 ++count;
-
-            if (count == 0)
-                return *this;
-
-            ::memmove(copy.m_Data, copy.m_Data + count, (copy.m_Count - count) * CharacterSize);
-            copy.m_Count -= count;
-            copy.m_Data[copy.m_Count] = 0;
-            return copy;
+            return StringBase(Data() + count, m_Count - count);
         }
 
         friend std::basic_ostream<CharacterType>& operator<<(std::basic_ostream<CharacterType>& os, const StringBase& string)
         {
-            os.write(string.m_Data, string.m_Count * CharacterSize);
+            os.write(string.Data(), string.m_Count * CharacterSize);
             os.flush();
             return os;
         }
 
     private:
-        CharacterType* m_Data = nullptr;
-        size_t m_Count = 0;
+        static CharacterType* Allocate(const SizeType count)
+        {
+            return Allocator::template Allocate<CharacterType>(count, MemoryTag::Strings);
+        }
+
+        static void Deallocate(CharacterType* data)
+        {
+            Allocator::Free(data);
+        }
+
+        void Assign(const CharacterType* data, const SizeType count)
+        {
+            if (count > Capacity())
+            {
+                // data may point into the current buffer, only release it once copied
+                CharacterType* newData = Allocate(count + 1);
+                memcpy(newData, data, count * CharacterSize);
+                Free();
+                m_Heap = newData;
+                m_Capacity = count;
+            }
+            else
+            {
+                ::memmove(Data(), data, count * CharacterSize);
+            }
+
+            m_Count = count;
+            Data()[m_Count] = 0;
+        }
+
+        void Grow(const SizeType minCapacity)
+        {
+            Reserve(std::max(minCapacity, Capacity() * 2));
+        }
+
+        void MoveFrom(StringBase& other)
+        {
+            if (other.m_Heap)
+            {
+                m_Heap = other.m_Heap;
+                m_Capacity = other.m_Capacity;
+            }
+            else
+            {
+                memcpy(m_Inline, other.m_Inline, (other.m_Count + 1) * CharacterSize);
+            }
+
+            m_Count = other.m_Count;
+            other.m_Heap = nullptr;
+            other.m_Inline[0] = 0;
+            other.m_Count = 0;
+        }
+
+        void Free()
+        {
+            if (m_Heap)
+                Deallocate(m_Heap);
+            m_Heap = nullptr;
+            m_Inline[0] = 0;
+            m_Count = 0;
+        }
+
+        // Null while the characters are inline, so zeroed memory is a valid empty string
+        // as containers rely on, and the object can be moved around bitwise
+        CharacterType* m_Heap = nullptr;
+        SizeType m_Count = 0;
+        // The capacity of heap buffers takes the place of the inline characters
+        union
+        {
+            CharacterType m_Inline[InlineCapacity + 1] = {};
+            SizeType m_Capacity;
+        };
     };
 
     using String = StringBase<char>;
@@ -499,6 +491,9 @@ namespace Nova
     using String16 = StringBase<char16_t>;
     using String32 = StringBase<char32_t>;
     using WideString = StringBase<wchar_t>;
+
+    // Temporaries living until the end of the next frame, see FrameAllocator
+    using FrameString = StringBase<char, FrameAllocator>;
 }
 
 
@@ -17,11 +17,56 @@ struct std::formatter<Nova::StringView> : std::formatter<std::string_view>
 
 namespace Nova
 {
-    template <typename... Args>
-    String StringFormat(const StringView& format, const Args&... args)
+    // Output iterator writing into a fixed size buffer, still counting the characters that did not fit.
+    // Copies share the count like std::back_insert_iterator shares its container.
+    class StringFormatIterator
     {
-        std::string formatted = std::vformat(static_cast<std::string_view>(format), std::make_format_args(args...));
-        return {formatted.data(), formatted.size()};
+    public:
+        using difference_type = ptrdiff_t;
+
+        StringFormatIterator() = default;
+        StringFormatIterator(char* data, const size_t capacity, size_t& count) : m_Data(data), m_Capacity(capacity), m_Count(&count) { }
+
+        StringFormatIterator& operator*() { return *this; }
+        StringFormatIterator& operator++() { return *this; }
+        StringFormatIterator operator++(int) { return *this; }
+
+        StringFormatIterator& operator=(const char character)
+        {
+            if (*m_Count < m_Capacity)
+                m_Data[*m_Count] = character;
+            ++*m_Count;
+            return *this;
+        }
+    private:
+        char* m_Data = nullptr;
+        size_t m_Capacity = 0;
+        size_t* m_Count = nullptr;
+    };
+
+    // Formats in a stack buffer first so the returned string is the only allocation.
+    // Pass FrameAllocator as Allocator for strings that do not outlive the frame.
+    template <ContainerAllocator Allocator = HeapAllocator, typename... Args>
+    StringBase<char, Allocator> StringFormat(const StringView& format, const Args&... args)
+    {
+        const std::string_view formatView(format.Data(), format.Count());
+        const auto formatArgs = std::make_format_args(args...);
+
+        char buffer[256];
+        size_t count = 0;
+        std::vformat_to(StringFormatIterator(buffer, sizeof(buffer), count), formatView, formatArgs);
+
+        StringBase<char, Allocator> result(count);
+        if (count <= sizeof(buffer))
+        {
+            Memory::Memcpy(result.Data(), buffer, count);
+        }
+        else
+        {
+            size_t written = 0;
+            std::vformat_to(StringFormatIterator(result.Data(), count, written), formatView, formatArgs);
+        }
+        return result;
     }
 
     template<Character T, typename... Args>
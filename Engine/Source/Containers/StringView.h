@@ -1,22 +1,44 @@
 ﻿#pragma once
+#include "Containers/Allocator.h"
+#include "Runtime/Assertion.h"
+#include "Runtime/Iterator.h"
 #include "Runtime/TypeTraits.h"
-#include "String.h"
+#include <string_view>
+#include <iostream>
 
 namespace Nova
 {
+    template<Character T>
+    static constexpr size_t StringLength(const T* data)
+    {
+        if (!data) return 0;
+
+        const T* ptr = data;
+        size_t count = 0;
+        while (*ptr != 0)
+        {
+            count++;
+            ++ptr;
+        }
+        return count;
+    }
+
+    template<typename T, ContainerAllocator Allocator> requires IsCharacterValue<T>
+    class StringBase;
+
     template<typename T> requires IsCharacterValue<T>
     class StringViewBase
     {
-        using StringType = StringBase<T>;
-        using CharacterType = StringType::CharacterType;
-        using PointerType = StringType::PointerType;
+        using CharacterType = T;
+        using PointerType = CharacterType*;
         using ConstPointerType = const CharacterType*;
-        using StringLiteralType = StringType::StringLiteralType;
-        using SizeType = StringType::SizeType;
-        using ConstIterator = StringType::ConstIterator;
+        using StringLiteralType = const CharacterType*;
+        using SizeType = size_t;
+        using ConstIterator = ConstIterator<T>;
     public:
         StringViewBase() = default;
-        StringViewBase(const StringType& string) : m_Data(string.Data()), m_Count(string.Count()) { }
+        template<ContainerAllocator Allocator>
+        StringViewBase(const StringBase<T, Allocator>& string) : m_Data(string.Data()), m_Count(string.Count()) { }
         constexpr StringViewBase(ConstPointerType data) : m_Data(data), m_Count(StringLength(data)){}
         constexpr StringViewBase(ConstPointerType data, SizeType count) : m_Data(data), m_Count(count){}
         constexpr StringViewBase(decltype(nullptr)) : m_Data(nullptr), m_Count(0){}
@@ -28,7 +50,7 @@ namespace Nova
 
         bool operator==(const StringViewBase& Other) const
         {
-            return m_Count == Other.m_Count && Memory::Memcmp(m_Data, Other.m_Data, m_Count * StringType::CharacterSize);
+            return m_Count == Other.m_Count && Memory::Memcmp(m_Data, Other.m_Data, m_Count * sizeof(CharacterType));
         }
 
         bool IsValid() const { return m_Data && m_Count != 0; }
@@ -50,7 +72,7 @@ namespace Nova
             return m_Data[index];
         }
 
-        SizeType Find(StringType::CharacterType character)
+        SizeType Find(CharacterType character) const
         {
             std::basic_string_view<CharacterType> view(m_Data, m_Count);
             return view.find(character);
@@ -65,26 +87,26 @@ namespace Nova
 
         SizeType Find(SizeType index, const StringViewBase& str) const
         {
-            std::basic_string_view<CharacterType> view(m_Data + index, m_Count);
+            std::basic_string_view<CharacterType> view(m_Data, m_Count);
             std::basic_string_view<CharacterType> otherView(str.m_Data, str.m_Count);
-            return view.find(otherView);
+            return view.find(otherView, index);
         }
 
         SizeType FindLast(const StringViewBase& string) const
         {
             std::basic_string_view<CharacterType> view(m_Data, m_Count);
             std::basic_string_view<CharacterType> otherView(string.m_Data, string.m_Count);
-            return view.find_last_of(otherView);
+            return view.rfind(otherView);
         }
 
         bool StartsWith(const StringViewBase& string) const
         {
-            return Find(string) == 0;
+            return m_Count >= string.m_Count && Memory::Memcmp(m_Data, string.m_Data, string.Size());
         }
 
         bool EndsWith(const StringViewBase& string) const
         {
-            return FindLast(string) != SizeType(-1);
+            return m_Count >= string.m_Count && Memory::Memcmp(m_Data + m_Count - string.m_Count, string.m_Data, string.Size());
         }
 
         friend std::basic_ostream<CharacterType>& operator<<(std::basic_ostream<CharacterType>& os, const StringViewBase& string)
@@ -103,3 +125,6 @@ namespace Nova
     using StringView32 = StringViewBase<char32_t>;
     using WideStringView = StringViewBase<wchar_t>;
 }
+
+// StringBase takes views, included last so either header can come first
+#include "String.h"
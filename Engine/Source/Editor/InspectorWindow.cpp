@@ -70,7 +70,7 @@ namespace Nova
             }
             ImGui::PopID();
 
-            ImGui::TextUnformatted(*StringFormat("UUID: {}", entity->GetUUID().GetString()));
+            ImGui::TextUnformatted(*StringFormat<FrameAllocator>("UUID: {}", entity->GetUUID().GetString()));
 
             static bool showContextMenu = false;
             entity->ForEach([](Component* component)
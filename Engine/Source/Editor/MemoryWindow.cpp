@@ -0,0 +1,178 @@
+﻿#include "MemoryWindow.h"
+#include "Containers/StringFormat.h"
+#include "External/ImGuiExtension.h"
+#include "Rendering/RenderDevice.h"
+
+#include <cfloat>
+
+namespace Nova
+{
+    static FrameString FormatBytes(const size_t bytes)
+    {
+        if (bytes >= 1024 * 1024)
+            return StringFormat<FrameAllocator>("{:.2f} MiB", (double)bytes / (1024.0 * 1024.0));
+        if (bytes >= 1024)
+            return StringFormat<FrameAllocator>("{:.2f} KiB", (double)bytes / 1024.0);
+        return StringFormat<FrameAllocator>("{} B", bytes);
+    }
+
+    // Device memory is reported by the backends, it does not depend on memory tracking
+    static void DrawDeviceMemory(RenderDevice& device)
+    {
+        ResidencyManager& residencyManager = device.GetResidencyManager();
+        constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable;
+
+        Array<DeviceHeapBudget> heaps;
+        if (device.GetMemoryHeapBudgets(heaps) && ImGui::BeginTable("Heaps", 5, tableFlags))
+        {
+            ImGui::TableSetupColumn("Heap", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Usage");
+            ImGui::TableSetupColumn("Budget");
+            ImGui::TableSetupColumn("Size");
+            ImGui::TableSetupColumn("Device Local");
+            ImGui::TableHeadersRow();
+
+            for (size_t heapIndex = 0; heapIndex < heaps.Count(); ++heapIndex)
+            {
+                const DeviceHeapBudget& heap = heaps[heapIndex];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", heapIndex);
+                ImGui::TableNextColumn();
+                if (heap.usage > heap.budget)
+                    ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", *FormatBytes(heap.usage));
+                else
+                    ImGui::TextUnformatted(*FormatBytes(heap.usage));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(*FormatBytes(heap.budget));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(*FormatBytes(heap.size));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(heap.deviceLocal ? "Yes" : "No");
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::BeginTable("Categories", 3, tableFlags))
+        {
+            ImGui::TableSetupColumn("Category", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Usage");
+            ImGui::TableSetupColumn("Budget");
+            ImGui::TableHeadersRow();
+
+            for (size_t category = 0; category < (size_t)DeviceMemoryCategory::Count; ++category)
+            {
+                const uint64_t budget = residencyManager.GetBudget((DeviceMemoryCategory)category);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GetDeviceMemoryCategoryName((DeviceMemoryCategory)category));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(*FormatBytes(residencyManager.GetUsage((DeviceMemoryCategory)category)));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(budget ? *FormatBytes(budget) : "Unlimited");
+            }
+            ImGui::EndTable();
+        }
+
+        int32_t textureBudget = (int32_t)(residencyManager.GetBudget(DeviceMemoryCategory::Textures) / (1024 * 1024));
+        if (ImGui::InputInt("Texture Budget (MiB)", &textureBudget, 16, 256))
+            residencyManager.SetBudget(DeviceMemoryCategory::Textures, (uint64_t)Math::Max(0, textureBudget) * 1024 * 1024);
+
+        const ResidencyStats stats = residencyManager.GetStats();
+        ImGui::Text("Streamed textures: %u, %u below full resolution, %s resident", stats.streamedTextureCount, stats.degradedTextureCount, *FormatBytes(stats.residentTextureBytes));
+        ImGui::Text("Mips evicted: %llu, restored: %llu", (unsigned long long)stats.evictedMipCount, (unsigned long long)stats.restoredMipCount);
+    }
+
+    MemoryWindow::MemoryWindow(): EditorWindow("Memory Window")
+    {
+
+    }
+
+    void MemoryWindow::OnUpdate(float deltaTime)
+    {
+        size_t frameAllocations = 0;
+        for (size_t tag = 0; tag < (size_t)MemoryTag::Count; ++tag)
+            frameAllocations += Memory::GetTagStats((MemoryTag)tag).frameAllocations;
+
+        m_FrameAllocations[m_HistoryIndex] = (float)frameAllocations;
+        m_HistoryIndex = (m_HistoryIndex + 1) % HistorySize;
+    }
+
+    void MemoryWindow::OnGui()
+    {
+        if (!m_Show) return;
+
+        if (ImGui::Begin("Memory", &m_Show))
+        {
+#if !defined(NOVA_MEMORY_TRACKING)
+            ImGui::TextUnformatted("Memory tracking is compiled out, enable NOVA_ENGINE_MEMORY_TRACKING to use it.");
+#else
+            const size_t lastIndex = (m_HistoryIndex + HistorySize - 1) % HistorySize;
+            const FrameString overlay = StringFormat<FrameAllocator>("{} allocations last frame", (size_t)m_FrameAllocations[lastIndex]);
+            ImGui::PlotHistogram("##FrameAllocations", m_FrameAllocations, (int)HistorySize, (int)m_HistoryIndex, *overlay, 0.0f, FLT_MAX, ImVec2(-1.0f, 64.0f));
+
+            const Arena& frameArena = FrameAllocator::Get();
+            ImGui::Text("Frame arena: %s used, %s reserved", *FormatBytes(frameArena.GetUsedBytes()), *FormatBytes(frameArena.GetCapacity()));
+
+            constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable;
+            if (ImGui::BeginTable("Tags", 6, tableFlags))
+            {
+                ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Live");
+                ImGui::TableSetupColumn("Peak");
+                ImGui::TableSetupColumn("Live Allocations");
+                ImGui::TableSetupColumn("Total Allocations");
+                ImGui::TableSetupColumn("Frame Allocations");
+                ImGui::TableHeadersRow();
+
+                MemoryTagStats total;
+                for (size_t tag = 0; tag < (size_t)MemoryTag::Count; ++tag)
+                {
+                    const MemoryTagStats stats = Memory::GetTagStats((MemoryTag)tag);
+                    total.liveBytes += stats.liveBytes;
+                    total.peakBytes += stats.peakBytes;
+                    total.liveAllocations += stats.liveAllocations;
+                    total.totalAllocations += stats.totalAllocations;
+                    total.frameAllocations += stats.frameAllocations;
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(Memory::GetTagName((MemoryTag)tag));
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(*FormatBytes(stats.liveBytes));
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(*FormatBytes(stats.peakBytes));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", stats.liveAllocations);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%zu", stats.totalAllocations);
+                    ImGui::TableNextColumn();
+                    if (stats.frameAllocations > 0)
+                        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "%zu", stats.frameAllocations);
+                    else
+                        ImGui::TextUnformatted("0");
+                }
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted("Total");
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(*FormatBytes(total.liveBytes));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(*FormatBytes(total.peakBytes));
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", total.liveAllocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", total.totalAllocations);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", total.frameAllocations);
+                ImGui::EndTable();
+            }
+#endif
+
+            if (const Ref<RenderDevice> device = RenderDevice::GetInstance(); device && ImGui::CollapsingHeader("Device Memory", ImGuiTreeNodeFlags_DefaultOpen))
+                DrawDeviceMemory(*device);
+        }
+        ImGui::End();
+    }
+}
@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "EditorWindow.h"
+#include "Runtime/Memory.h"
+
+namespace Nova
+{
+    class MemoryWindow final : public EditorWindow
+    {
+    public:
+        static constexpr size_t HistorySize = 256;
+
+        explicit MemoryWindow();
+
+        void OnUpdate(float deltaTime) override;
+        void OnGui() override;
+    private:
+        // Allocations per frame, all tags together
+        float m_FrameAllocations[HistorySize] = {};
+        size_t m_HistoryIndex = 0;
+    };
+}
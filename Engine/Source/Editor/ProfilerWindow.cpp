@@ -0,0 +1,125 @@
+﻿#include "ProfilerWindow.h"
+#include "Containers/StringFormat.h"
+#include "External/ImGuiExtension.h"
+#include "Runtime/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Nova
+{
+    ProfilerWindow::ProfilerWindow(): EditorWindow("Profiler Window")
+    {
+
+    }
+
+    void ProfilerWindow::OnGui()
+    {
+        if (!m_Show) return;
+
+        if (ImGui::Begin("Profiler", &m_Show))
+        {
+#if !defined(NOVA_PROFILING)
+            ImGui::TextUnformatted("Profiling is compiled out, enable NOVA_ENGINE_PROFILING to use it.");
+#else
+            Profiler& profiler = Profiler::Get();
+
+            const Array<float> frameTimes = profiler.GetFrameTimes();
+            const float lastFrameTime = frameTimes.Last();
+            const FrameString overlay = StringFormat<FrameAllocator>("{:.2f} ms", lastFrameTime);
+            ImGui::PlotLines("##FrameTimes", frameTimes.Data(), (int)frameTimes.Count(), 0, *overlay, 0.0f, 33.3f, ImVec2(-1.0f, 64.0f));
+
+            if (profiler.IsCapturing())
+            {
+                if (ImGui::Button("Stop Capture"))
+                    profiler.StopCapture();
+                ImGui::SameLine();
+                ImGui::Text("%zu events", profiler.GetCapturedEventCount());
+            }
+            else
+            {
+                if (ImGui::Button("Start Capture"))
+                    profiler.StartCapture();
+
+                ImGui::SameLine();
+                ImGui::BeginDisabled(profiler.GetCapturedEventCount() == 0);
+                if (ImGui::Button("Export Chrome Trace"))
+                {
+                    m_ExportStatus = profiler.ExportChromeTrace(m_ExportPath)
+                        ? StringFormat("Exported {} events to {}", profiler.GetCapturedEventCount(), m_ExportPath)
+                        : StringFormat("Failed to write {}", m_ExportPath);
+                }
+                ImGui::EndDisabled();
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Reset"))
+                profiler.ResetStats();
+
+            if (!m_ExportStatus.IsEmpty())
+                ImGui::TextUnformatted(*m_ExportStatus);
+            if (profiler.GetDroppedEvents() > 0)
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "%u events dropped, a thread buffer was full", profiler.GetDroppedEvents());
+
+            for (const ProfileCounterStats& counter : profiler.GetCounters())
+                ImGui::Text("%s: %lld", counter.name, (long long)counter.frameValue);
+
+            constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+            if (ImGui::BeginTable("Scopes", 5, tableFlags))
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Calls");
+                ImGui::TableSetupColumn("Frame (ms)");
+                ImGui::TableSetupColumn("Average (ms)", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+                ImGui::TableSetupColumn("Max (ms)");
+                ImGui::TableHeadersRow();
+
+                Array<ProfileScopeStats> stats = profiler.GetScopeStats();
+                if (const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs && sortSpecs->SpecsCount > 0)
+                {
+                    const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+                    const auto getKey = [&spec](const ProfileScopeStats& scope) -> double
+                    {
+                        switch (spec.ColumnIndex)
+                        {
+                        case 1: return scope.callCount;
+                        case 2: return scope.frameTime;
+                        case 3: return scope.averageTime;
+                        case 4: return scope.maxTime;
+                        default: return 0.0;
+                        }
+                    };
+
+                    std::sort(stats.Data(), stats.Data() + stats.Count(), [&](const ProfileScopeStats& lhs, const ProfileScopeStats& rhs)
+                    {
+                        if (spec.ColumnIndex == 0)
+                        {
+                            const int comparison = std::strcmp(lhs.name, rhs.name);
+                            return spec.SortDirection == ImGuiSortDirection_Ascending ? comparison < 0 : comparison > 0;
+                        }
+                        return spec.SortDirection == ImGuiSortDirection_Ascending ? getKey(lhs) < getKey(rhs) : getKey(lhs) > getKey(rhs);
+                    });
+                }
+
+                for (const ProfileScopeStats& scope : stats)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(scope.name);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%u", scope.callCount);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", scope.frameTime);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", scope.averageTime);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", scope.maxTime);
+                }
+                ImGui::EndTable();
+            }
+#endif
+        }
+        ImGui::End();
+    }
+}
@@ -0,0 +1,16 @@
+﻿#pragma once
+#include "EditorWindow.h"
+
+namespace Nova
+{
+    class ProfilerWindow final : public EditorWindow
+    {
+    public:
+        explicit ProfilerWindow();
+
+        void OnGui() override;
+    private:
+        String m_ExportPath = "Profile.json";
+        String m_ExportStatus;
+    };
+}
@@ -27,6 +27,8 @@ namespace Nova
 
     bool FileStream::Open(const StringView& filepath, const OpenModeFlags openMode)
     {
+        m_Filepath = filepath;
+        m_OpenMode = openMode;
 #ifdef NOVA_PLATFORM_WINDOWS
         WideString wFilepath = StringConvertToWide(filepath);
         m_Handle = _wfopen(*wFilepath, *StringConvertToWide(GetMode(openMode)));
@@ -71,6 +73,11 @@ namespace Nova
         m_Handle = nullptr;
     }
 
+    void FileStream::Flush()
+    {
+        (void)fflush(m_Handle);
+    }
+
     Stream::OffsetType FileStream::GetSize()
     {
         Seek(Seek::End, 0);
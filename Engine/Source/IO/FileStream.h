@@ -15,6 +15,7 @@ namespace Nova
         bool Seek(Nova::Seek seekMode, OffsetType offset) override;
         OffsetType Tell() const override;
         void Close() override;
+        void Flush();
         OffsetType GetSize();
         bool IsGood() const override;
 
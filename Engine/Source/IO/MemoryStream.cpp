@@ -1,4 +1,5 @@
 ﻿#include "MemoryStream.h"
+#include <algorithm>
 
 namespace Nova
 {
@@ -10,9 +11,12 @@ namespace Nova
     Stream::SizeType MemoryStream::ReadRaw(void* outBuffer, const SizeType size)
     {
         if(!m_Opened) return EndOfFile;
-        memcpy(outBuffer, &m_Buffer[m_Position], size);
-        m_Position += (OffsetType)size;
-        return size;
+        if(m_Position >= (OffsetType)m_Buffer.Count()) return 0;
+
+        const SizeType readSize = std::min(size, m_Buffer.Count() - (SizeType)m_Position);
+        memcpy(outBuffer, &m_Buffer[m_Position], readSize);
+        m_Position += (OffsetType)readSize;
+        return readSize;
     }
 
     Stream::SizeType MemoryStream::WriteRaw(const void* inBuffer, const SizeType size)
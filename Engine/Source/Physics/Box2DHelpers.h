@@ -1,9 +1,11 @@
 ﻿#pragma once
 #include "PhysicsConstraints.h"
+#include "PhysicsQuery.h"
 #include "box2d/math_functions.h"
 #include "box2d/types.h"
 #include "Math/Vector2.h"
 #include "Math/Vector3.h"
+#include "Math/Quaternion.h"
 
 
 namespace Nova
@@ -32,6 +34,22 @@ namespace Nova
         return Vector2(vector.x, vector.y);
     }
 
+    inline Quaternion ToQuaternion(const b2Rot& rotation)
+    {
+        const b2Vec2 axisX = b2Rot_GetXAxis(rotation);
+        const b2Vec2 axisY = b2Rot_GetYAxis(rotation);
+        const Vector3 axis = Vector3(ToVector2(axisX)).Cross(Vector3(ToVector2(axisY)));
+        return Quaternion::FromAxisAngle(axis, b2Rot_GetAngle(rotation));
+    }
+
+    inline b2QueryFilter Tob2QueryFilter(const PhysicsQueryFilter& filter)
+    {
+        b2QueryFilter queryFilter = b2DefaultQueryFilter();
+        queryFilter.categoryBits = filter.categoryBits;
+        queryFilter.maskBits = filter.maskBits;
+        return queryFilter;
+    }
+
     inline PhysicsConstraintsFlags ToPhysicsConstraints(const b2MotionLocks& motionLocks)
     {
         PhysicsConstraintsFlags constraints;
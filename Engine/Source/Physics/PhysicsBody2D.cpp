@@ -45,10 +45,7 @@ namespace Nova
     Quaternion PhysicsBody2D::GetRotation() const
     {
         const b2Transform transform = b2Body_GetTransform(m_Handle);
-        const b2Vec2 axisX = b2Rot_GetXAxis(transform.q);
-        const b2Vec2 axisY = b2Rot_GetYAxis(transform.q);
-        const Vector3 axis = Vector3(ToVector2(axisX)).Cross(Vector3(ToVector2(axisY)));
-        return Quaternion::FromAxisAngle(axis, b2Rot_GetAngle(transform.q));
+        return ToQuaternion(transform.q);
     }
 
     void PhysicsBody2D::SetPositionAndRotation(const Vector3& position, const Quaternion& rotation)
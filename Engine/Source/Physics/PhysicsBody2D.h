@@ -49,6 +49,9 @@ namespace Nova
 
         bool IsAwake() const override;
     private:
+        friend PhysicsWorld2D;
         b2BodyId m_Handle = b2_nullBodyId;
+        // Step of the world the body last moved in, contacts between resting bodies keep their manifold
+        uint64_t m_LastMoveStep = 0;
     };
 }
@@ -1,8 +1,11 @@
 ﻿#pragma once
+#include "Containers/Array.h"
 #include "Math/Vector3.h"
+#include "Math/Quaternion.h"
 
 namespace Nova
 {
+    class PhysicsBody;
     class PhysicsBody2D;
 
     struct PhysicsContact
@@ -11,4 +14,38 @@ namespace Nova
         Vector3 normal;
         PhysicsBody* otherBody = nullptr;
     };
+
+    struct PhysicsContactEvent
+    {
+        PhysicsBody* body = nullptr;
+        PhysicsContact contact;
+    };
+
+    // Contact events gathered during a single physics step, delivered to listeners in one batch
+    struct PhysicsContactEvents
+    {
+        Array<PhysicsContactEvent> beginEvents;
+        Array<PhysicsContactEvent> stayEvents;
+        Array<PhysicsContactEvent> endEvents;
+
+        bool IsEmpty() const
+        {
+            return beginEvents.IsEmpty() && stayEvents.IsEmpty() && endEvents.IsEmpty();
+        }
+
+        void Clear()
+        {
+            beginEvents.Clear();
+            stayEvents.Clear();
+            endEvents.Clear();
+        }
+    };
+
+    struct PhysicsBodyMoveEvent
+    {
+        PhysicsBody* body = nullptr;
+        Vector3 position;
+        Quaternion rotation;
+        bool fellAsleep = false;
+    };
 }
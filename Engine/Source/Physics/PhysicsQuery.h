@@ -0,0 +1,89 @@
+﻿#pragma once
+#include "Math/Vector3.h"
+#include "Math/Quaternion.h"
+#include <cstdint>
+
+namespace Nova
+{
+    class PhysicsBody;
+    class PhysicsShape;
+
+    struct PhysicsQueryFilter
+    {
+        uint64_t categoryBits = ~0ull;
+        uint64_t maskBits = ~0ull;
+    };
+
+    struct PhysicsRay
+    {
+        Vector3 origin = Vector3::Zero;
+        Vector3 direction = Vector3::Right;
+        float maxDistance = 1.0f;
+    };
+
+    struct PhysicsCastHit
+    {
+        PhysicsBody* body = nullptr;
+        PhysicsShape* shape = nullptr;
+        Vector3 point = Vector3::Zero;
+        Vector3 normal = Vector3::Zero;
+        float distance = 0.0f;
+        float fraction = 0.0f;
+        bool hit = false;
+    };
+
+    struct PhysicsOverlapHit
+    {
+        PhysicsBody* body = nullptr;
+        PhysicsShape* shape = nullptr;
+    };
+
+    enum class PhysicsQueryShapeType
+    {
+        Circle,
+        Box,
+        Capsule,
+    };
+
+    // Shape description used by cast and overlap queries, does not live in the world
+    struct PhysicsQueryShape
+    {
+        PhysicsQueryShapeType type = PhysicsQueryShapeType::Circle;
+        Vector3 position = Vector3::Zero;
+        Quaternion rotation = Quaternion::Identity;
+        float width = 1.0f;
+        float height = 1.0f;
+        float radius = 0.5f;
+
+        static PhysicsQueryShape Circle(const Vector3& position, const float radius)
+        {
+            PhysicsQueryShape shape;
+            shape.type = PhysicsQueryShapeType::Circle;
+            shape.position = position;
+            shape.radius = radius;
+            return shape;
+        }
+
+        static PhysicsQueryShape Box(const Vector3& position, const Quaternion& rotation, const float width, const float height)
+        {
+            PhysicsQueryShape shape;
+            shape.type = PhysicsQueryShapeType::Box;
+            shape.position = position;
+            shape.rotation = rotation;
+            shape.width = width;
+            shape.height = height;
+            return shape;
+        }
+
+        static PhysicsQueryShape Capsule(const Vector3& position, const Quaternion& rotation, const float height, const float radius)
+        {
+            PhysicsQueryShape shape;
+            shape.type = PhysicsQueryShapeType::Capsule;
+            shape.position = position;
+            shape.rotation = rotation;
+            shape.height = height;
+            shape.radius = radius;
+            return shape;
+        }
+    };
+}
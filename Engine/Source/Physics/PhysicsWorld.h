@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "PhysicsBodyDefinition.h"
+#include "PhysicsContactInfo.h"
 #include "Containers/Array.h"
+#include "Containers/MulticastDelegate.h"
 #include "Math/Vector3.h"
 #include "Runtime/Object.h"
 #include "Runtime/Scene.h"
@@ -23,6 +25,8 @@ namespace Nova
     class PhysicsWorld : public Object
     {
     public:
+        using ContactEventsDelegate = MulticastDelegate<void(const PhysicsContactEvents& events)>;
+
         PhysicsWorld(const String& name) : Object(name) {}
         ~PhysicsWorld() override = default;
         virtual bool Initialize(const PhysicsWorldCreateInfo& createInfo) = 0;
@@ -39,9 +43,18 @@ namespace Nova
         Application* GetApplication() { return m_Owner->GetOwner(); }
 
         const Array<PhysicsBody*>& GetBodies() const { return m_Bodies; }
+
+        // Bodies whose transform changed during the last step
+        const Array<PhysicsBodyMoveEvent>& GetMoveEvents() const { return m_MoveEvents; }
+        const PhysicsContactEvents& GetContactEvents() const { return m_ContactEvents; }
+
+        // Broadcast once per step with every contact event of that step
+        ContactEventsDelegate OnContactEvents;
     protected:
         Scene* m_Owner = nullptr;
         Array<PhysicsBody*> m_Bodies;
+        Array<PhysicsBodyMoveEvent> m_MoveEvents;
+        PhysicsContactEvents m_ContactEvents;
         float m_TimeStep = 0.0f;
         uint32_t m_Iterations = 0;
     };
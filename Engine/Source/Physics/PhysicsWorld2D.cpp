@@ -4,14 +4,82 @@
 #include "PhysicsContactInfo.h"
 #include "Box2DHelpers.h"
 #include "Runtime/Application.h"
+#include "Runtime/Memory.h"
+#include "Runtime/ThreadPool.h"
 
 #include <box2d/box2d.h>
 
 
 namespace Nova
 {
+    static constexpr size_t RayCastBatchSize = 256;
+    static constexpr size_t MinContactSlots = 64;
+    static constexpr float MinRayDirectionSquared = 1e-12f;
+
+    // Shape indices start at 1, so a key is never 0 and 0 marks an empty slot
+    static uint64_t MakeShapePairKey(const b2ShapeId shapeA, const b2ShapeId shapeB)
+    {
+        const uint64_t indexA = (uint32_t)shapeA.index1;
+        const uint64_t indexB = (uint32_t)shapeB.index1;
+        return indexA < indexB ? indexA << 32 | indexB : indexB << 32 | indexA;
+    }
+
+    static size_t HashShapePairKey(const uint64_t key)
+    {
+        uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+        return (size_t)hash;
+    }
+
+    static PhysicsCastHit ToCastHit(const b2ShapeId shapeId, const b2Vec2 point, const b2Vec2 normal, const float fraction, const float length)
+    {
+        PhysicsShape2D* shape = (PhysicsShape2D*)b2Shape_GetUserData(shapeId);
+        PhysicsCastHit hit;
+        hit.shape = shape;
+        hit.body = shape ? shape->GetPhysicsBody() : nullptr;
+        hit.point = Vector3(ToVector2(point));
+        hit.normal = Vector3(ToVector2(normal));
+        hit.fraction = fraction;
+        hit.distance = fraction * length;
+        hit.hit = true;
+        return hit;
+    }
+
+    static PhysicsOverlapHit ToOverlapHit(const b2ShapeId shapeId)
+    {
+        PhysicsShape2D* shape = (PhysicsShape2D*)b2Shape_GetUserData(shapeId);
+        PhysicsOverlapHit hit;
+        hit.shape = shape;
+        hit.body = shape ? shape->GetPhysicsBody() : nullptr;
+        return hit;
+    }
+
+    static b2ShapeProxy MakeShapeProxy(const PhysicsQueryShape& shape)
+    {
+        const b2Vec2 position = Tob2Vec2(shape.position);
+        const b2Rot rotation = b2MakeRot(shape.rotation.ToEuler().z);
+
+        switch (shape.type)
+        {
+        case PhysicsQueryShapeType::Box:
+            {
+                const b2Polygon box = b2MakeOffsetBox(shape.width * 0.5f, shape.height * 0.5f, position, rotation);
+                return b2MakeProxy(box.vertices, box.count, 0.0f);
+            }
+        case PhysicsQueryShapeType::Capsule:
+            {
+                const b2Vec2 centers[2] = { b2Vec2(0.0f, shape.height * 0.5f), b2Vec2(0.0f, -shape.height * 0.5f) };
+                return b2MakeOffsetProxy(centers, 2, shape.radius, position, rotation);
+            }
+        case PhysicsQueryShapeType::Circle:
+        default:
+            return b2MakeProxy(&position, 1, shape.radius);
+        }
+    }
+
     bool PhysicsWorld2D::Initialize(const PhysicsWorldCreateInfo& createInfo)
     {
+        const Memory::ScopedTag memoryTag(MemoryTag::Physics);
         b2WorldDef worldDef = b2DefaultWorldDef();
         worldDef.gravity = b2Vec2(createInfo.gravity.x, createInfo.gravity.y);
         worldDef.userData = this;
@@ -27,79 +95,226 @@ namespace Nova
 
     void PhysicsWorld2D::Step()
     {
-        Application* app = GetApplication();
+        const Memory::ScopedTag memoryTag(MemoryTag::Physics);
         b2World_Step(m_Handle, m_TimeStep, m_Iterations);
+        m_StepIndex++;
+        GatherMoveEvents();
+        GatherContactEvents();
+        DispatchContactEvents();
+    }
 
-        const b2ContactEvents contactEvents = b2World_GetContactEvents(m_Handle);
-        for (int i = 0; i < contactEvents.beginCount; ++i)
+    void PhysicsWorld2D::GatherMoveEvents()
+    {
+        m_MoveEvents.Clear();
+
+        const b2BodyEvents bodyEvents = b2World_GetBodyEvents(m_Handle);
+        for (int i = 0; i < bodyEvents.moveCount; ++i)
         {
-            if (const b2ContactBeginTouchEvent* beginEvent = contactEvents.beginEvents + i;
-                b2Shape_IsValid(beginEvent->shapeIdA) && b2Shape_IsValid(beginEvent->shapeIdB))
-            {
-                if (!b2Contact_IsValid(beginEvent->contactId)) continue;
-
-                b2ContactData contactData = b2Contact_GetData(beginEvent->contactId);
-                const PhysicsShape2D* shapeA = (PhysicsShape2D*)b2Shape_GetUserData(contactData.shapeIdA);
-                const PhysicsShape2D* shapeB = (PhysicsShape2D*)b2Shape_GetUserData(contactData.shapeIdB);
-                PhysicsBody2D* bodyA = shapeA->GetPhysicsBody();
-                PhysicsBody2D* bodyB = shapeB->GetPhysicsBody();
-                const b2Manifold& manifold = contactData.manifold;
-
-                PhysicsContact contactA;
-                contactA.point = Vector3(ToVector2(manifold.points[0].point));
-                contactA.normal = Vector3(ToVector2(-manifold.normal));
-                contactA.otherBody = bodyB;
-                if (manifold.points[0].persisted) {
-                    bodyA->OnContactBeginEvent.Broadcast(contactA);
-                } else{
-                    bodyA->OnContactStayEvent.Broadcast(contactA);
-                }
-
-                PhysicsContact contactB;
-                contactB.point = Vector3(ToVector2(manifold.points[1].point));
-                contactB.normal = Vector3(ToVector2(manifold.normal));
-                contactB.otherBody = bodyA;
-                if (manifold.points[1].persisted) {
-                    bodyB->OnContactBeginEvent.Broadcast(contactB);
-                } else{
-                    bodyB->OnContactStayEvent.Broadcast(contactB);
-                }
-            }
+            const b2BodyMoveEvent& moveEvent = bodyEvents.moveEvents[i];
+            PhysicsBody2D* body = (PhysicsBody2D*)moveEvent.userData;
+            if (!body) continue;
+            body->m_LastMoveStep = m_StepIndex;
 
+            PhysicsBodyMoveEvent event;
+            event.body = body;
+            event.position = Vector3(ToVector2(moveEvent.transform.p));
+            event.rotation = ToQuaternion(moveEvent.transform.q);
+            event.fellAsleep = moveEvent.fellAsleep;
+            m_MoveEvents.Add(event);
         }
+    }
+
+    void PhysicsWorld2D::GatherContactEvents()
+    {
+        m_ContactEvents.Clear();
+
+        const auto addEvents = [](Array<PhysicsContactEvent>& events, const ActiveContact& contact)
+        {
+            PhysicsContactEvent eventA;
+            eventA.body = contact.bodyA;
+            eventA.contact.point = contact.point;
+            eventA.contact.normal = -contact.normal;
+            eventA.contact.otherBody = contact.bodyB;
+            events.Add(eventA);
+
+            PhysicsContactEvent eventB;
+            eventB.body = contact.bodyB;
+            eventB.contact.point = contact.point;
+            eventB.contact.normal = contact.normal;
+            eventB.contact.otherBody = contact.bodyA;
+            events.Add(eventB);
+        };
+
+        const b2ContactEvents contactEvents = b2World_GetContactEvents(m_Handle);
 
+        // End events first so contacts that stopped touching are not reported as staying.
+        // The shapes may already be destroyed, their indices still identify the pair.
         for (int i = 0; i < contactEvents.endCount; ++i)
         {
-            if (const b2ContactEndTouchEvent* endEvent = contactEvents.endEvents + i;
-                b2Shape_IsValid(endEvent->shapeIdA) && b2Shape_IsValid(endEvent->shapeIdB))
+            const b2ContactEndTouchEvent& endEvent = contactEvents.endEvents[i];
+            const ContactSlot* slot = FindContactSlot(MakeShapePairKey(endEvent.shapeIdA, endEvent.shapeIdB));
+            if (!slot) continue;
+
+            const uint32_t index = slot->index;
+            addEvents(m_ContactEvents.endEvents, m_ActiveContacts[index]);
+            RemoveActiveContact(index);
+        }
+
+        for (ActiveContact& contact : m_ActiveContacts)
+        {
+            // The manifold only changes when one of the bodies moved, resting contacts report the cached one
+            const bool moved = contact.bodyA->m_LastMoveStep == m_StepIndex || contact.bodyB->m_LastMoveStep == m_StepIndex;
+            if (!moved || !b2Contact_IsValid(contact.handle))
             {
-                if (!b2Contact_IsValid(endEvent->contactId)) continue;
-
-                b2ContactData contactData = b2Contact_GetData(endEvent->contactId);
-                const PhysicsShape2D* shapeA = (PhysicsShape2D*)b2Shape_GetUserData(contactData.shapeIdA);
-                const PhysicsShape2D* shapeB = (PhysicsShape2D*)b2Shape_GetUserData(contactData.shapeIdB);
-                PhysicsBody2D* bodyA = shapeA->GetPhysicsBody();
-                PhysicsBody2D* bodyB = shapeB->GetPhysicsBody();
-                const b2Manifold& manifold = contactData.manifold;
-
-                PhysicsContact contactA;
-                contactA.point = Vector3(ToVector2(manifold.points[0].point));
-                contactA.normal = Vector3(ToVector2(-manifold.normal));
-                contactA.otherBody = bodyB;
-                bodyA->OnContactEndEvent.Broadcast(contactA);
-
-                PhysicsContact contactB;
-                contactB.point = Vector3(ToVector2(manifold.points[1].point));
-                contactB.normal = Vector3(ToVector2(manifold.normal));
-                contactB.otherBody = bodyA;
-                bodyB->OnContactEndEvent.Broadcast(contactB);
+                addEvents(m_ContactEvents.stayEvents, contact);
+                continue;
             }
+
+            const b2ContactData contactData = b2Contact_GetData(contact.handle);
+            if (contactData.manifold.pointCount > 0)
+                contact.point = Vector3(ToVector2(contactData.manifold.points[0].point));
+            contact.normal = Vector3(ToVector2(contactData.manifold.normal));
+            addEvents(m_ContactEvents.stayEvents, contact);
+        }
+
+        for (int i = 0; i < contactEvents.beginCount; ++i)
+        {
+            const b2ContactBeginTouchEvent& beginEvent = contactEvents.beginEvents[i];
+            if (!b2Shape_IsValid(beginEvent.shapeIdA) || !b2Shape_IsValid(beginEvent.shapeIdB))
+                continue;
+            if (!b2Contact_IsValid(beginEvent.contactId))
+                continue;
+
+            const b2ContactData contactData = b2Contact_GetData(beginEvent.contactId);
+            const PhysicsShape2D* shapeA = (PhysicsShape2D*)b2Shape_GetUserData(contactData.shapeIdA);
+            const PhysicsShape2D* shapeB = (PhysicsShape2D*)b2Shape_GetUserData(contactData.shapeIdB);
+
+            ActiveContact contact;
+            contact.handle = beginEvent.contactId;
+            contact.key = MakeShapePairKey(beginEvent.shapeIdA, beginEvent.shapeIdB);
+            contact.bodyA = shapeA->GetPhysicsBody();
+            contact.bodyB = shapeB->GetPhysicsBody();
+            contact.point = Vector3(ToVector2(contactData.manifold.points[0].point));
+            contact.normal = Vector3(ToVector2(contactData.manifold.normal));
+            addEvents(m_ContactEvents.beginEvents, contact);
+
+            // A pair touching again before its end event was seen replaces the stale entry
+            if (const ContactSlot* slot = FindContactSlot(contact.key))
+                RemoveActiveContact(slot->index);
+            AddActiveContact(contact);
+        }
+    }
+
+    PhysicsWorld2D::ContactSlot* PhysicsWorld2D::FindContactSlot(const uint64_t key)
+    {
+        if (m_ContactSlots.IsEmpty()) return nullptr;
+
+        const size_t mask = m_ContactSlots.Count() - 1;
+        for (size_t slotIndex = HashShapePairKey(key) & mask;; slotIndex = (slotIndex + 1) & mask)
+        {
+            ContactSlot& slot = m_ContactSlots[slotIndex];
+            if (slot.key == key) return &slot;
+            if (slot.key == 0) return nullptr;
+        }
+    }
+
+    void PhysicsWorld2D::InsertContactSlot(const uint64_t key, const uint32_t index)
+    {
+        const auto place = [this](const uint64_t slotKey, const uint32_t slotValue)
+        {
+            const size_t mask = m_ContactSlots.Count() - 1;
+            size_t slotIndex = HashShapePairKey(slotKey) & mask;
+            while (m_ContactSlots[slotIndex].key != 0)
+                slotIndex = (slotIndex + 1) & mask;
+            m_ContactSlots[slotIndex] = { slotKey, slotValue };
+        };
+
+        // Kept at most half full so probes stay short, every contact is placed again after growing
+        if ((m_ActiveContacts.Count() + 1) * 2 > m_ContactSlots.Count())
+        {
+            const size_t slotCount = Math::Max(MinContactSlots, m_ContactSlots.Count() * 2);
+            m_ContactSlots = Array<ContactSlot>(slotCount);
+            for (ContactSlot& slot : m_ContactSlots)
+                slot = ContactSlot();
+            for (size_t contactIndex = 0; contactIndex < m_ActiveContacts.Count(); ++contactIndex)
+                place(m_ActiveContacts[contactIndex].key, (uint32_t)contactIndex);
+        }
+
+        place(key, index);
+    }
+
+    void PhysicsWorld2D::EraseContactSlot(const uint64_t key)
+    {
+        ContactSlot* slot = FindContactSlot(key);
+        if (!slot) return;
+
+        // Backward shift deletion, following slots move into the hole unless they already sit at their home slot
+        const size_t mask = m_ContactSlots.Count() - 1;
+        size_t hole = slot - m_ContactSlots.Data();
+        for (size_t slotIndex = (hole + 1) & mask; m_ContactSlots[slotIndex].key != 0; slotIndex = (slotIndex + 1) & mask)
+        {
+            const size_t home = HashShapePairKey(m_ContactSlots[slotIndex].key) & mask;
+            if (((slotIndex - home) & mask) < ((slotIndex - hole) & mask))
+                continue;
+            m_ContactSlots[hole] = m_ContactSlots[slotIndex];
+            hole = slotIndex;
+        }
+        m_ContactSlots[hole] = ContactSlot();
+    }
+
+    void PhysicsWorld2D::AddActiveContact(const ActiveContact& contact)
+    {
+        InsertContactSlot(contact.key, (uint32_t)m_ActiveContacts.Count());
+        m_ActiveContacts.Add(contact);
+    }
+
+    void PhysicsWorld2D::RemoveActiveContact(const size_t index)
+    {
+        EraseContactSlot(m_ActiveContacts[index].key);
+
+        // Swap remove, the moved contact gets its new position in the index
+        const size_t lastIndex = m_ActiveContacts.Count() - 1;
+        if (index != lastIndex)
+        {
+            m_ActiveContacts[index] = m_ActiveContacts[lastIndex];
+            FindContactSlot(m_ActiveContacts[index].key)->index = (uint32_t)index;
+        }
+        m_ActiveContacts.PopBack();
+    }
+
+    void PhysicsWorld2D::DispatchContactEvents()
+    {
+        if (m_ContactEvents.IsEmpty())
+            return;
+
+        OnContactEvents.Broadcast(m_ContactEvents);
+
+        // Per-body delegates are kept for convenience, only bound ones are visited
+        for (const PhysicsContactEvent& event : m_ContactEvents.beginEvents)
+        {
+            if (event.body->OnContactBeginEvent.IsBound())
+                event.body->OnContactBeginEvent.Broadcast(event.contact);
         }
 
+        for (const PhysicsContactEvent& event : m_ContactEvents.stayEvents)
+        {
+            if (event.body->OnContactStayEvent.IsBound())
+                event.body->OnContactStayEvent.Broadcast(event.contact);
+        }
+
+        for (const PhysicsContactEvent& event : m_ContactEvents.endEvents)
+        {
+            if (event.body->OnContactEndEvent.IsBound())
+                event.body->OnContactEndEvent.Broadcast(event.contact);
+        }
     }
 
     void PhysicsWorld2D::Destroy()
     {
+        m_ActiveContacts.Clear();
+        m_ContactSlots.Clear();
+        m_MoveEvents.Clear();
+        m_ContactEvents.Clear();
         b2DestroyWorld(m_Handle);
     }
 
@@ -112,13 +327,24 @@ namespace Nova
 
         const b2BodyId bodyHandle = b2CreateBody(m_Handle, &def);
         PhysicsBody2D* createdBody = new PhysicsBody2D(bodyHandle, *this);
-        b2Body_SetUserData(bodyHandle, this);
+        b2Body_SetUserData(bodyHandle, createdBody);
         m_Bodies.Add(createdBody);
         return createdBody;
     }
 
     void PhysicsWorld2D::DestroyBody(PhysicsBody* body)
     {
+        for (size_t index = 0; index < m_ActiveContacts.Count();)
+        {
+            const ActiveContact& contact = m_ActiveContacts[index];
+            if (contact.bodyA != body && contact.bodyB != body)
+            {
+                ++index;
+                continue;
+            }
+            RemoveActiveContact(index);
+        }
+
         b2DestroyBody(((PhysicsBody2D*)body)->GetHandle());
         m_Bodies.Remove(body);
         delete body;
@@ -135,6 +361,155 @@ namespace Nova
     }
 
 
+    bool PhysicsWorld2D::RayCast(const PhysicsRay& ray, PhysicsCastHit& outHit, const PhysicsQueryFilter& filter) const
+    {
+        // A zero direction has no meaningful normalization, treat it as a miss
+        if (ray.direction.MagnitudeSquared() <= MinRayDirectionSquared)
+        {
+            outHit = PhysicsCastHit();
+            return false;
+        }
+
+        const Vector3 translation = ray.direction.Normalized() * ray.maxDistance;
+        const b2RayResult result = b2World_CastRayClosest(m_Handle, Tob2Vec2(ray.origin), Tob2Vec2(translation), Tob2QueryFilter(filter));
+        if (!result.hit)
+        {
+            outHit = PhysicsCastHit();
+            return false;
+        }
+
+        outHit = ToCastHit(result.shapeId, result.point, result.normal, result.fraction, ray.maxDistance);
+        return true;
+    }
+
+    size_t PhysicsWorld2D::RayCastAll(const PhysicsRay& ray, PhysicsCastHit* outHits, const size_t maxHits, const PhysicsQueryFilter& filter) const
+    {
+        if (!outHits || maxHits == 0)
+            return 0;
+
+        if (ray.direction.MagnitudeSquared() <= MinRayDirectionSquared)
+            return 0;
+
+        struct Context
+        {
+            PhysicsCastHit* hits;
+            size_t maxHits;
+            size_t count;
+            float length;
+        } context { outHits, maxHits, 0, ray.maxDistance };
+
+        const auto callback = [](const b2ShapeId shapeId, const b2Vec2 point, const b2Vec2 normal, const float fraction, void* userData) -> float
+        {
+            Context* ctx = (Context*)userData;
+            ctx->hits[ctx->count++] = ToCastHit(shapeId, point, normal, fraction, ctx->length);
+            return ctx->count < ctx->maxHits ? 1.0f : 0.0f;
+        };
+
+        const Vector3 translation = ray.direction.Normalized() * ray.maxDistance;
+        b2World_CastRay(m_Handle, Tob2Vec2(ray.origin), Tob2Vec2(translation), Tob2QueryFilter(filter), callback, &context);
+        return context.count;
+    }
+
+    bool PhysicsWorld2D::ShapeCast(const PhysicsQueryShape& shape, const Vector3& translation, PhysicsCastHit& outHit, const PhysicsQueryFilter& filter) const
+    {
+        struct Context
+        {
+            PhysicsCastHit hit;
+            float length;
+        } context { PhysicsCastHit(), translation.Magnitude() };
+
+        // Clipping the cast to the reported fraction keeps the closest hit only
+        const auto callback = [](const b2ShapeId shapeId, const b2Vec2 point, const b2Vec2 normal, const float fraction, void* userData) -> float
+        {
+            Context* ctx = (Context*)userData;
+            ctx->hit = ToCastHit(shapeId, point, normal, fraction, ctx->length);
+            return fraction;
+        };
+
+        const b2ShapeProxy proxy = MakeShapeProxy(shape);
+        b2World_CastShape(m_Handle, &proxy, Tob2Vec2(translation), Tob2QueryFilter(filter), callback, &context);
+        outHit = context.hit;
+        return outHit.hit;
+    }
+
+    size_t PhysicsWorld2D::OverlapAABB(const Vector3& min, const Vector3& max, PhysicsOverlapHit* outHits, const size_t maxHits, const PhysicsQueryFilter& filter) const
+    {
+        if (!outHits || maxHits == 0)
+            return 0;
+
+        struct Context
+        {
+            PhysicsOverlapHit* hits;
+            size_t maxHits;
+            size_t count;
+        } context { outHits, maxHits, 0 };
+
+        const auto callback = [](const b2ShapeId shapeId, void* userData) -> bool
+        {
+            Context* ctx = (Context*)userData;
+            ctx->hits[ctx->count++] = ToOverlapHit(shapeId);
+            return ctx->count < ctx->maxHits;
+        };
+
+        b2AABB aabb;
+        aabb.lowerBound = Tob2Vec2(min);
+        aabb.upperBound = Tob2Vec2(max);
+        b2World_OverlapAABB(m_Handle, aabb, Tob2QueryFilter(filter), callback, &context);
+        return context.count;
+    }
+
+    size_t PhysicsWorld2D::OverlapShape(const PhysicsQueryShape& shape, PhysicsOverlapHit* outHits, const size_t maxHits, const PhysicsQueryFilter& filter) const
+    {
+        if (!outHits || maxHits == 0)
+            return 0;
+
+        struct Context
+        {
+            PhysicsOverlapHit* hits;
+            size_t maxHits;
+            size_t count;
+        } context { outHits, maxHits, 0 };
+
+        const auto callback = [](const b2ShapeId shapeId, void* userData) -> bool
+        {
+            Context* ctx = (Context*)userData;
+            ctx->hits[ctx->count++] = ToOverlapHit(shapeId);
+            return ctx->count < ctx->maxHits;
+        };
+
+        const b2ShapeProxy proxy = MakeShapeProxy(shape);
+        b2World_OverlapShape(m_Handle, &proxy, Tob2QueryFilter(filter), callback, &context);
+        return context.count;
+    }
+
+    void PhysicsWorld2D::RayCastBatch(const PhysicsRay* rays, const size_t count, PhysicsCastHit* outHits, const PhysicsQueryFilter& filter) const
+    {
+        if (!rays || !outHits || count == 0)
+            return;
+
+        const auto castRange = [this, rays, outHits, &filter](const size_t begin, const size_t end, uint32_t)
+        {
+            for (size_t i = begin; i < end; ++i)
+                RayCast(rays[i], outHits[i], filter);
+        };
+
+        Application* application = m_Owner ? m_Owner->GetOwner() : nullptr;
+        if (!application)
+        {
+            castRange(0, count, 0);
+            return;
+        }
+
+        ThreadPool& threadPool = application->GetThreadPool();
+        threadPool.ParallelFor(count, RayCastBatchSize, castRange);
+    }
+
+    void PhysicsWorld2D::RayCastBatch(const Array<PhysicsRay>& rays, Array<PhysicsCastHit>& outHits, const PhysicsQueryFilter& filter) const
+    {
+        NOVA_ASSERT(outHits.Count() >= rays.Count(), "RayCastBatch output buffer is too small");
+        RayCastBatch(rays.Data(), rays.Count(), outHits.Data(), filter);
+    }
+
     b2WorldId PhysicsWorld2D::GetHandle() const
     {
         return m_Handle;
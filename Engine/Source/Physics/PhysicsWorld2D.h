@@ -1,9 +1,12 @@
 ﻿#pragma once
 #include "PhysicsWorld.h"
+#include "PhysicsQuery.h"
 #include <box2d/id.h>
 
 namespace Nova
 {
+    class PhysicsBody2D;
+
     class PhysicsWorld2D : public PhysicsWorld
     {
     public:
@@ -18,8 +21,50 @@ namespace Nova
         void SetGravity(const Vector3& gravity) override;
         Vector3 GetGravity() const override;
 
+        // Queries must not run while the world is stepping
+        bool RayCast(const PhysicsRay& ray, PhysicsCastHit& outHit, const PhysicsQueryFilter& filter = {}) const;
+        size_t RayCastAll(const PhysicsRay& ray, PhysicsCastHit* outHits, size_t maxHits, const PhysicsQueryFilter& filter = {}) const;
+        bool ShapeCast(const PhysicsQueryShape& shape, const Vector3& translation, PhysicsCastHit& outHit, const PhysicsQueryFilter& filter = {}) const;
+        size_t OverlapAABB(const Vector3& min, const Vector3& max, PhysicsOverlapHit* outHits, size_t maxHits, const PhysicsQueryFilter& filter = {}) const;
+        size_t OverlapShape(const PhysicsQueryShape& shape, PhysicsOverlapHit* outHits, size_t maxHits, const PhysicsQueryFilter& filter = {}) const;
+
+        // Casts every ray, closest hit only. outHits must hold count elements.
+        // Rays are split across the application thread pool when there is one.
+        void RayCastBatch(const PhysicsRay* rays, size_t count, PhysicsCastHit* outHits, const PhysicsQueryFilter& filter = {}) const;
+        void RayCastBatch(const Array<PhysicsRay>& rays, Array<PhysicsCastHit>& outHits, const PhysicsQueryFilter& filter = {}) const;
+
         b2WorldId GetHandle() const;
     private:
+        struct ActiveContact
+        {
+            b2ContactId handle = b2_nullContactId;
+            uint64_t key = 0;
+            PhysicsBody2D* bodyA = nullptr;
+            PhysicsBody2D* bodyB = nullptr;
+            Vector3 point;
+            Vector3 normal;
+        };
+
+        // Open addressed index from shape pair key to position in m_ActiveContacts
+        struct ContactSlot
+        {
+            uint64_t key = 0;
+            uint32_t index = 0;
+        };
+
+        void GatherMoveEvents();
+        void GatherContactEvents();
+        void DispatchContactEvents();
+
+        ContactSlot* FindContactSlot(uint64_t key);
+        void InsertContactSlot(uint64_t key, uint32_t index);
+        void EraseContactSlot(uint64_t key);
+        void AddActiveContact(const ActiveContact& contact);
+        void RemoveActiveContact(size_t index);
+
         b2WorldId m_Handle = b2_nullWorldId;
+        Array<ActiveContact> m_ActiveContacts;
+        Array<ContactSlot> m_ContactSlots;
+        uint64_t m_StepIndex = 0;
     };
 }
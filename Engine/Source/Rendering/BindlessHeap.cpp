@@ -0,0 +1,133 @@
+﻿#include "BindlessHeap.h"
+#include "Buffer.h"
+#include "Sampler.h"
+#include "Texture.h"
+#include "Runtime/Log.h"
+
+NOVA_DECLARE_LOG_CATEGORY_STATIC(BindlessHeap, "BINDLESS HEAP")
+
+namespace Nova
+{
+    BindlessIndex BindlessHeap::Register(Texture& texture)
+    {
+        return Register(ResourceType::Texture, texture);
+    }
+
+    BindlessIndex BindlessHeap::Register(Buffer& buffer)
+    {
+        // Buffers are reached as storage buffers, other usages were not created to be read that way
+        if (buffer.GetUsage() != BufferUsage::StorageBuffer)
+        {
+            NOVA_LOG(BindlessHeap, Verbosity::Error, "Only storage buffers can be registered!");
+            return InvalidBindlessIndex;
+        }
+        return Register(ResourceType::Buffer, buffer);
+    }
+
+    BindlessIndex BindlessHeap::Register(Sampler& sampler)
+    {
+        return Register(ResourceType::Sampler, sampler);
+    }
+
+    BindlessIndex BindlessHeap::Register(const ResourceType type, Resource& resource)
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (resource.m_BindlessIndex != InvalidBindlessIndex)
+            return resource.m_BindlessIndex;
+
+        Slots& slots = m_Slots[GetSlotsIndex(type)];
+        BindlessIndex index = InvalidBindlessIndex;
+        if (!slots.freeIndices.IsEmpty())
+        {
+            index = slots.freeIndices.Last();
+            slots.freeIndices.PopBack();
+        }
+        else if (slots.nextIndex < slots.capacity)
+        {
+            index = slots.nextIndex++;
+        }
+        else
+        {
+            NOVA_LOG(BindlessHeap, Verbosity::Error, "Heap is full, {} slots of this type are in use!", slots.capacity);
+            return InvalidBindlessIndex;
+        }
+
+        WriteDescriptor(type, index, resource);
+        resource.m_BindlessIndex = index;
+        slots.count++;
+        return index;
+    }
+
+    void BindlessHeap::Update(Resource& resource)
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (resource.m_BindlessIndex == InvalidBindlessIndex)
+            return;
+        WriteDescriptor(resource.GetResourceType(), resource.m_BindlessIndex, resource);
+    }
+
+    void BindlessHeap::Release(Resource& resource)
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (resource.m_BindlessIndex == InvalidBindlessIndex)
+            return;
+
+        // The slot keeps its stale descriptor until reused, partially bound sets allow it as long as no shader reads it
+        Slots& slots = m_Slots[GetSlotsIndex(resource.GetResourceType())];
+        slots.releasedIndices[m_FrameIndex % ReleaseDelay].Add(resource.m_BindlessIndex);
+        slots.count--;
+        resource.m_BindlessIndex = InvalidBindlessIndex;
+    }
+
+    void BindlessHeap::NewFrame()
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_FrameIndex++;
+
+        // This bucket was filled ReleaseDelay frames ago, every frame that could use those indices completed since
+        for (Slots& slots : m_Slots)
+        {
+            Array<BindlessIndex>& releasedIndices = slots.releasedIndices[m_FrameIndex % ReleaseDelay];
+            if (releasedIndices.IsEmpty())
+                continue;
+            slots.freeIndices.AddRange(releasedIndices);
+            releasedIndices.Clear();
+        }
+    }
+
+    uint32_t BindlessHeap::GetCount(const ResourceType type) const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_Slots[GetSlotsIndex(type)].count;
+    }
+
+    uint32_t BindlessHeap::GetCapacity(const ResourceType type) const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_Slots[GetSlotsIndex(type)].capacity;
+    }
+
+    void BindlessHeap::InitializeSlots(const BindlessHeapCreateInfo& createInfo)
+    {
+        ReleaseSlots();
+
+        std::scoped_lock lock(m_Mutex);
+        m_Slots[GetSlotsIndex(ResourceType::Texture)].capacity = createInfo.textureCount;
+        m_Slots[GetSlotsIndex(ResourceType::Buffer)].capacity = createInfo.bufferCount;
+        m_Slots[GetSlotsIndex(ResourceType::Sampler)].capacity = createInfo.samplerCount;
+    }
+
+    void BindlessHeap::ReleaseSlots()
+    {
+        std::scoped_lock lock(m_Mutex);
+        for (Slots& slots : m_Slots)
+        {
+            slots.freeIndices.Clear();
+            for (Array<BindlessIndex>& releasedIndices : slots.releasedIndices)
+                releasedIndices.Clear();
+            slots.nextIndex = 0;
+            slots.count = 0;
+            slots.capacity = 0;
+        }
+    }
+}
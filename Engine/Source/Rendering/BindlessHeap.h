@@ -0,0 +1,84 @@
+﻿#pragma once
+#include "Resource.h"
+#include "Containers/Array.h"
+#include "Runtime/RefCounted.h"
+#include <cstdint>
+#include <mutex>
+
+namespace Nova
+{
+    class RenderDevice;
+    class Texture;
+    class Buffer;
+    class Sampler;
+    class ShaderBindingSet;
+
+    struct BindlessHeapCreateInfo
+    {
+        RenderDevice* device = nullptr;
+        uint32_t textureCount = 16384;
+        uint32_t bufferCount = 4096;
+        uint32_t samplerCount = 256;
+    };
+
+    // One descriptor set holding every registered texture, storage buffer and sampler.
+    // Resources register once and keep the same index until released, shaders including Bindless.slang
+    // reach them through that index, usually passed in push constants, instead of a binding set per draw.
+    class BindlessHeap : public RefCounted
+    {
+    public:
+        static constexpr uint32_t SetIndex = 3;
+        static constexpr uint32_t TextureBinding = 0;
+        static constexpr uint32_t BufferBinding = 1;
+        static constexpr uint32_t SamplerBinding = 2;
+
+        // Frames a released index waits before it is handed out again, so frames still in flight never see it change
+        static constexpr uint32_t ReleaseDelay = 3;
+
+        BindlessHeap() = default;
+        ~BindlessHeap() override = default;
+
+        virtual bool Initialize(const BindlessHeapCreateInfo& createInfo) = 0;
+        virtual void Destroy() = 0;
+
+        // Bound at SetIndex like any other binding set
+        virtual Nova::ShaderBindingSet* GetBindingSet() = 0;
+
+        // Return the index the resource already has when it is registered again
+        BindlessIndex Register(Texture& texture);
+        BindlessIndex Register(Buffer& buffer);
+        BindlessIndex Register(Sampler& sampler);
+
+        // Rewrites the descriptor of a registered resource whose view or handle was recreated
+        void Update(Resource& resource);
+        void Release(Resource& resource);
+
+        // Recycles the indices released ReleaseDelay frames ago, called by the render device once the frame fence was waited
+        void NewFrame();
+
+        uint32_t GetCount(ResourceType type) const;
+        uint32_t GetCapacity(ResourceType type) const;
+    protected:
+        void InitializeSlots(const BindlessHeapCreateInfo& createInfo);
+        void ReleaseSlots();
+
+        // Called with the heap locked, descriptors of one set must not be written from two threads at once
+        virtual void WriteDescriptor(ResourceType type, BindlessIndex index, Resource& resource) = 0;
+    private:
+        struct Slots
+        {
+            Array<BindlessIndex> freeIndices;
+            Array<BindlessIndex> releasedIndices[ReleaseDelay];
+            uint32_t nextIndex = 0;
+            uint32_t count = 0;
+            uint32_t capacity = 0;
+        };
+
+        BindlessIndex Register(ResourceType type, Resource& resource);
+        static uint32_t GetSlotsIndex(ResourceType type) { return (uint32_t)type; }
+
+        mutable std::mutex m_Mutex;
+        Slots m_Slots[3];
+        uint64_t m_FrameIndex = 0;
+    };
+}
@@ -71,6 +71,8 @@ namespace Nova
     struct CommandBufferBeginInfo
     {
         CommandBufferUsageFlags flags;
+        // Render pass continued by a secondary command buffer, required with RenderPassContinue
+        const RenderPassBeginInfo* renderPass = nullptr;
     };
 
     class CommandBuffer : public RefCounted
@@ -1,37 +1,177 @@
 ﻿#include "DebugRenderer.h"
 #include "Buffer.h"
-#include "RenderDevice.h"
+#include "CommandBuffer.h"
 #include "GraphicsPipeline.h"
-#include "RenderPass.h"
-#include "ShaderBindingSet.h"
+#include "RenderDevice.h"
+#include "Shader.h"
+#include "Containers/Array.h"
+#include "Math/Functions.h"
 #include "Math/Matrix4.h"
 #include "Math/Quaternion.h"
 #include "Math/Vector3.h"
 #include "Runtime/Application.h"
-#include "Vulkan/RenderDevice.h"
+#include "Runtime/Color.h"
+#include "Runtime/Profiler.h"
+#include "Runtime/Window.h"
+#include <array>
+#include <atomic>
+#include <mutex>
 
 namespace Nova
 {
+    // Mirrored in Debug.slang
     struct LineVertex
     {
-        Vector3 position;
-        Color color;
+        float x, y, z;
+        uint32_t color;
     };
 
-    static Matrix4 s_ViewProjection = Matrix4::Identity;
-    static Array<LineVertex> s_Vertices;
-    static Array<uint32_t> s_Indices;
-    static uint32_t s_IndicesCount = 0;
-    static Ref<Shader> s_Shader = nullptr;
-    static Ref<Buffer> s_VertexBuffer = nullptr;
-    static Ref<Buffer> s_IndexBuffer = nullptr;
-    static Ref<GraphicsPipeline> s_Pipeline = nullptr;
-    static Ref<ShaderBindingSet> s_BindingSet = nullptr;
-    static bool s_Begin = false;
+    static_assert(sizeof(LineVertex) == 16, "LineVertex must match Debug.slang");
+
+    static constexpr uint32_t LayerCount = 2;
 
     // CAREFUL THIS MIGHT INCREASE VERTEX COUNT
     static constexpr uint32_t CIRCLE_PRECISION = 60;
 
+    struct DebugLines
+    {
+        Array<LineVertex> vertices[LayerCount];
+    };
+
+    // Lines submitted by one thread, merged into the vertex buffer at End
+    struct DebugThreadLines : DebugLines
+    {
+        DebugThreadLines();
+        ~DebugThreadLines();
+    };
+
+    static Matrix4 s_ViewProjection = Matrix4::Identity;
+    static Ref<RenderDevice> s_Device = nullptr;
+    static Ref<GraphicsPipeline> s_Pipelines[LayerCount];
+    static Ref<Buffer> s_VertexBuffer = nullptr;
+    static Shader* s_Shader = nullptr;
+    static std::mutex s_ThreadLinesMutex;
+    static Array<DebugThreadLines*> s_ThreadLines;
+    // Lines left behind by threads that exited before End
+    static DebugLines s_RetiredLines;
+    static uint32_t s_Capacity = 0;
+    static uint32_t s_FrameCount = 0;
+    static uint32_t s_FirstVertex = 0;
+    static uint32_t s_VertexCounts[LayerCount] = {};
+    static std::atomic<bool> s_Begin = false;
+
+    DebugThreadLines::DebugThreadLines()
+    {
+        std::scoped_lock lock(s_ThreadLinesMutex);
+        s_ThreadLines.Add(this);
+    }
+
+    DebugThreadLines::~DebugThreadLines()
+    {
+        std::scoped_lock lock(s_ThreadLinesMutex);
+        s_ThreadLines.Remove(this);
+        if (!s_Begin.load(std::memory_order_acquire)) return;
+
+        for (uint32_t layer = 0; layer < LayerCount; layer++)
+        {
+            if (!vertices[layer].IsEmpty())
+                s_RetiredLines.vertices[layer].AddRange(vertices[layer]);
+        }
+    }
+
+    // Expects s_ThreadLinesMutex to be locked
+    template<typename Function>
+    static void ForEachLines(Function&& function)
+    {
+        function(s_RetiredLines);
+        for (DebugThreadLines* threadLines : s_ThreadLines)
+            function(*threadLines);
+    }
+
+    static thread_local DebugThreadLines s_LocalLines;
+
+    static uint32_t PackColor(const Color& color)
+    {
+        const auto pack = [](const float value) { return (uint32_t)(Math::Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return pack(color.r) | pack(color.g) << 8 | pack(color.b) << 16 | pack(color.a) << 24;
+    }
+
+    static Array<LineVertex>& GetLocalVertices(const DebugLayer layer)
+    {
+        NOVA_ASSERT(s_Begin.load(std::memory_order_relaxed), "Cannot draw outside a DebugRenderer::Begin/End scope!");
+        return s_LocalLines.vertices[(uint32_t)layer];
+    }
+
+    // Unit circle, sampled once
+    static const float* GetCirclePoints()
+    {
+        static const auto points = []
+        {
+            std::array<float, 2 * (CIRCLE_PRECISION + 1)> result;
+            constexpr float angle = Math::Tau / CIRCLE_PRECISION;
+            for (uint32_t i = 0; i <= CIRCLE_PRECISION; i++)
+            {
+                result[2 * i + 0] = Math::Cos((float)(i % CIRCLE_PRECISION) * angle);
+                result[2 * i + 1] = Math::Sin((float)(i % CIRCLE_PRECISION) * angle);
+            }
+            return result;
+        }();
+        return points.data();
+    }
+
+    // Adds the segments [firstSegment, firstSegment + segmentCount) of a circle spanned by axisX and axisY
+    static void AddArc(Array<LineVertex>& vertices, const Vector3& center, const Vector3& axisX, const Vector3& axisY, const float radius, const uint32_t color, const uint32_t firstSegment, const uint32_t segmentCount)
+    {
+        NOVA_ASSERT(firstSegment + segmentCount <= CIRCLE_PRECISION, "Arc goes past the end of the circle!");
+        const float* points = GetCirclePoints();
+        const float xx = axisX.x * radius, xy = axisX.y * radius, xz = axisX.z * radius;
+        const float yx = axisY.x * radius, yy = axisY.y * radius, yz = axisY.z * radius;
+
+        LineVertex arc[2 * CIRCLE_PRECISION];
+        for (uint32_t i = 0; i <= segmentCount; i++)
+        {
+            const float cos = points[2 * (firstSegment + i) + 0];
+            const float sin = points[2 * (firstSegment + i) + 1];
+            const LineVertex vertex { center.x + xx * cos + yx * sin, center.y + xy * cos + yy * sin, center.z + xz * cos + yz * sin, color };
+            if (i > 0) arc[2 * i - 1] = vertex;
+            if (i < segmentCount) arc[2 * i] = vertex;
+        }
+
+        vertices.AddRange(arc, 2 * segmentCount);
+    }
+
+    static void AddLine(Array<LineVertex>& vertices, const Vector3& start, const Vector3& end, const uint32_t color)
+    {
+        const LineVertex line[2]
+        {
+            { start.x, start.y, start.z, color },
+            { end.x, end.y, end.z, color },
+        };
+        vertices.AddRange(line);
+    }
+
+    static bool CreateVertexBuffer(const uint32_t capacity)
+    {
+        // One region per frame in flight, a frame never writes where the GPU may still be reading
+        const uint32_t frameCount = s_Device->GetImageCount();
+
+        BufferCreateInfo bufferCreateInfo;
+        bufferCreateInfo.device = s_Device;
+        bufferCreateInfo.usage = BufferUsage::VertexBuffer;
+        bufferCreateInfo.size = (size_t)capacity * frameCount * sizeof(LineVertex);
+        bufferCreateInfo.mapped = true;
+        Ref<Buffer> buffer = s_Device->CreateBuffer(bufferCreateInfo);
+        if (!buffer) return false;
+
+        if (s_VertexBuffer)
+            s_VertexBuffer->Destroy();
+
+        s_VertexBuffer = buffer;
+        s_Capacity = capacity;
+        s_FrameCount = frameCount;
+        return true;
+    }
+
     bool DebugRenderer::Initialize(const DebugRendererCreateInfo& createInfo)
     {
         if (!createInfo.device) return false;
@@ -49,194 +189,272 @@ namespace Nova
         VertexLayout vertexLayout;
         vertexLayout.AddInputBinding(0, VertexInputRate::Vertex);
         vertexLayout.AddInputAttribute("POSITION", ShaderDataType::Float3, 0);
-        vertexLayout.AddInputAttribute("COLOR", ShaderDataType::Float4, 0);
+        vertexLayout.AddInputAttribute("COLOR", ShaderDataType::UInt, 0);
         pipelineInfo.vertexInputState = CreateInputStateFromVertexLayout(vertexLayout);
 
-        pipelineInfo.rasterizationState.cullMode = CullMode::FrontAndBackFaces;
+        pipelineInfo.rasterizationState.cullMode = CullMode::None;
         pipelineInfo.rasterizationState.frontFace = FrontFace::CounterClockwise;
         pipelineInfo.rasterizationState.lineWidth = 3.0f;
         pipelineInfo.rasterizationState.polygonMode = PolygonMode::Line;
 
         pipelineInfo.inputAssemblyState.topology = PrimitiveTopology::LineList;
-
-        ColorBlendState colorBlendState;
-        colorBlendState.colorBlendEnable = false;
-        colorBlendState.colorWriteMask = ColorChannelFlags::All();
-        pipelineInfo.colorBlendStates.Add(colorBlendState);
+        pipelineInfo.colorBlendStates.Add(ColorBlendState(true, BlendFunction::AlphaBlend(), ColorChannelFlags::All()));
         pipelineInfo.multisampleState.sampleCount = 8;
 
-        s_Pipeline = s_Device->CreateGraphicsPipeline(pipelineInfo);
-        if (!s_Pipeline) return false;
+        // Lines are tested against the scene but never occlude it
+        pipelineInfo.depthStencilState.depthTestEnable = true;
+        pipelineInfo.depthStencilState.depthWriteEnable = false;
+        pipelineInfo.depthStencilState.depthCompareOp = CompareOperation::LessOrEqual;
+        s_Pipelines[(uint32_t)DebugLayer::World] = s_Device->CreateGraphicsPipeline(pipelineInfo);
+        if (!s_Pipelines[(uint32_t)DebugLayer::World]) return false;
 
-        BufferCreateInfo vertexBufferCreateInfo;
-        vertexBufferCreateInfo.device = s_Device;
-        vertexBufferCreateInfo.usage = BufferUsage::VertexBuffer;
-        vertexBufferCreateInfo.size = createInfo.maxVertices * sizeof(LineVertex);
-        s_VertexBuffer = s_Device->CreateBuffer(vertexBufferCreateInfo);
-        if (!s_VertexBuffer) return false;
+        pipelineInfo.depthStencilState.depthTestEnable = false;
+        s_Pipelines[(uint32_t)DebugLayer::Overlay] = s_Device->CreateGraphicsPipeline(pipelineInfo);
+        if (!s_Pipelines[(uint32_t)DebugLayer::Overlay]) return false;
 
-        BufferCreateInfo indexBufferCreateInfo;
-        indexBufferCreateInfo.device = s_Device;
-        indexBufferCreateInfo.usage = BufferUsage::IndexBuffer;
-        indexBufferCreateInfo.size = 2 * createInfo.maxVertices * sizeof(LineVertex);
-        s_IndexBuffer = s_Device->CreateBuffer(indexBufferCreateInfo);
-        if (!s_IndexBuffer) return false;
-
-        return true;
+        return CreateVertexBuffer(Math::Max(createInfo.maxLines, 1u) * 2);
     }
 
     void DebugRenderer::Destroy()
     {
         if (s_Device) s_Device->WaitIdle();
-        if (s_Pipeline) s_Pipeline->Destroy();
+        for (Ref<GraphicsPipeline>& pipeline : s_Pipelines)
+        {
+            if (pipeline) pipeline->Destroy();
+            pipeline = nullptr;
+        }
+
         if (s_VertexBuffer) s_VertexBuffer->Destroy();
-        if (s_IndexBuffer) s_IndexBuffer->Destroy();
+        s_VertexBuffer = nullptr;
+        s_Device = nullptr;
+        s_Shader = nullptr;
+        s_Capacity = 0;
+        s_FrameCount = 0;
+        s_FirstVertex = 0;
+        for (uint32_t& count : s_VertexCounts)
+            count = 0;
+
+        std::scoped_lock lock(s_ThreadLinesMutex);
+        for (Array<LineVertex>& vertices : s_RetiredLines.vertices)
+            vertices = Array<LineVertex>();
     }
 
     void DebugRenderer::Begin(const Matrix4& viewProjection)
     {
         NOVA_ASSERT(!s_Begin, "DebugRenderer::Begin/End call mismatch!");
         s_ViewProjection = viewProjection;
-        s_Vertices.Clear();
-        s_Indices.Clear();
-        s_IndicesCount = 0;
-        s_Begin = true;
+
+        std::scoped_lock lock(s_ThreadLinesMutex);
+        ForEachLines([](DebugLines& lines)
+        {
+            for (Array<LineVertex>& vertices : lines.vertices)
+                vertices.Clear();
+        });
+        s_Begin.store(true, std::memory_order_release);
     }
 
     void DebugRenderer::End(CommandBuffer& cmdBuffer)
     {
         NOVA_ASSERT(s_Begin, "DebugRenderer::End/End call mismatch!");
-        if (s_Vertices.IsEmpty())
+        if (!s_Begin) return;
+        s_Begin.store(false, std::memory_order_release);
+
+        for (uint32_t& count : s_VertexCounts)
+            count = 0;
+        if (!s_VertexBuffer) return;
+
+        std::scoped_lock lock(s_ThreadLinesMutex);
+        uint32_t counts[LayerCount] = {};
+        ForEachLines([&counts](const DebugLines& lines)
+        {
+            for (uint32_t layer = 0; layer < LayerCount; layer++)
+                counts[layer] += (uint32_t)lines.vertices[layer].Count();
+        });
+
+        const uint32_t count = counts[0] + counts[1];
+        if (count == 0) return;
+
+        if (count > s_Capacity || s_Device->GetImageCount() != s_FrameCount)
         {
-            s_Begin = false;
-            return;
+            const uint32_t capacity = Math::Max(s_Capacity, Math::NearestPowerOfTwo<uint32_t>(count));
+            if (!CreateVertexBuffer(capacity))
+                return;
+        }
+
+        const uint32_t frameIndex = s_Device->GetCurrentFrameIndex() % s_FrameCount;
+        s_FirstVertex = frameIndex * s_Capacity;
+
+        LineVertex* mapped = (LineVertex*)s_VertexBuffer->Map();
+        if (!mapped) return;
+
+        // Layers are laid out one after the other so each one is a single contiguous draw
+        LineVertex* vertices = mapped + s_FirstVertex;
+        for (uint32_t layer = 0; layer < LayerCount; layer++)
+        {
+            ForEachLines([&vertices, layer](const DebugLines& lines)
+            {
+                const Array<LineVertex>& layerVertices = lines.vertices[layer];
+                if (layerVertices.IsEmpty()) return;
+                Memory::Memcpy(vertices, layerVertices.Data(), layerVertices.Size());
+                vertices += layerVertices.Count();
+            });
+            s_VertexCounts[layer] = counts[layer];
         }
 
-        cmdBuffer.UpdateBuffer(*s_VertexBuffer, 0, s_Vertices.Size(), s_Vertices.Data());
-        cmdBuffer.UpdateBuffer(*s_IndexBuffer, 0, s_Indices.Size(), s_Indices.Data());
-        s_Begin = false;
+        s_VertexBuffer->Unmap(mapped);
     }
 
     void DebugRenderer::Render(CommandBuffer& cmdBuffer)
     {
-        if (s_Vertices.IsEmpty()) return;
+        const uint32_t count = s_VertexCounts[0] + s_VertexCounts[1];
+        if (count == 0) return;
 
-        Application& application = Application::GetCurrentApplication();
+        const Application& application = Application::GetCurrentApplication();
         const auto window = application.GetWindow();
         const auto viewport = window->GetBounds();
 
-        cmdBuffer.BindGraphicsPipeline(*s_Pipeline);
-        cmdBuffer.BindVertexBuffer(*s_VertexBuffer, 0);
-        cmdBuffer.BindIndexBuffer(*s_IndexBuffer, 0, Format::Uint32);
-        cmdBuffer.PushConstants(*s_Shader, ShaderStageFlagBits::Vertex | ShaderStageFlagBits::Fragment, 0, sizeof(Matrix4), s_ViewProjection.ValuePtr());
-        cmdBuffer.SetViewport(viewport.x, viewport.y, viewport.width, viewport.height, 0.0f, 1.0f);
-        cmdBuffer.SetScissor(viewport.x, viewport.y, viewport.width, viewport.height);
-        cmdBuffer.DrawIndexed(s_Indices.Count(), 1, 0, 0, 0);
-    }
-
-    void DebugRenderer::DrawLine(const Vector3& start, const Vector3& end, const Color& color, float thickness)
-    {
-        NOVA_ASSERT(s_Begin, "Cannot draw outside a DebugRenderer::Begin/End scope!");
-        const Vector3 line = end - start;
-        if (line.MagnitudeSquared() <= Math::Epsilon) return;
-
-        const LineVertex vertices[2]
+        uint32_t firstVertex = s_FirstVertex;
+        uint32_t drawCalls = 0;
+        for (uint32_t layer = 0; layer < LayerCount; layer++)
         {
-            LineVertex(start, color),
-            LineVertex(end, color),
-        };
-
-        s_Vertices.AddRange(vertices);
+            const uint32_t vertexCount = s_VertexCounts[layer];
+            if (vertexCount == 0) continue;
+
+            cmdBuffer.BindGraphicsPipeline(*s_Pipelines[layer]);
+            cmdBuffer.BindVertexBuffer(*s_VertexBuffer, 0);
+            cmdBuffer.PushConstants(*s_Shader, ShaderStageFlagBits::Vertex | ShaderStageFlagBits::Fragment, 0, sizeof(Matrix4), s_ViewProjection.ValuePtr());
+            cmdBuffer.SetViewport(viewport.x, viewport.y, viewport.width, viewport.height, 0.0f, 1.0f);
+            cmdBuffer.SetScissor(viewport.x, viewport.y, viewport.width, viewport.height);
+            cmdBuffer.Draw(vertexCount, 1, firstVertex, 0);
+            firstVertex += vertexCount;
+            drawCalls++;
+        }
 
-        const uint32_t indices[2] { s_IndicesCount + 0, s_IndicesCount + 1 };
-        s_Indices.AddRange(indices);
+        NOVA_PROFILE_COUNTER("Debug Draw Calls", drawCalls);
+        NOVA_PROFILE_COUNTER("Debug Lines", count / 2);
+    }
 
-        s_IndicesCount += 2;
+    void DebugRenderer::DrawLine(const Vector3& start, const Vector3& end, const Color& color, float thickness, const DebugLayer layer)
+    {
+        Array<LineVertex>& vertices = GetLocalVertices(layer);
+        const float x = end.x - start.x, y = end.y - start.y, z = end.z - start.z;
+        if (x * x + y * y + z * z <= Math::Epsilon) return;
+        AddLine(vertices, start, end, PackColor(color));
     }
 
-    void DebugRenderer::DrawSquare(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Color& color, float thickness)
+    void DebugRenderer::DrawSquare(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Color& color, float thickness, const DebugLayer layer)
     {
-        NOVA_ASSERT(s_Begin, "Cannot draw outside a DebugRenderer::Begin/End scope!");
-        if (size.MagnitudeSquared() <= Math::Epsilon) return;
+        Array<LineVertex>& vertices = GetLocalVertices(layer);
+        if (size.x * size.x + size.y * size.y <= Math::Epsilon) return;
 
-        const Vector3 posA = position + Vector3(-size.x * 0.5f, -size.y * 0.5f, 0.0f);
-        const Vector3 posB = position + Vector3(-size.x * 0.5f, +size.y * 0.5f, 0.0f);
-        const Vector3 posC = position + Vector3(+size.x * 0.5f, +size.y * 0.5f, 0.0f);
-        const Vector3 posD = position + Vector3(+size.x * 0.5f, -size.y * 0.5f, 0.0f);
+        const Vector3 halfX = rotation * Vector3(size.x * 0.5f, 0.0f, 0.0f);
+        const Vector3 halfY = rotation * Vector3(0.0f, size.y * 0.5f, 0.0f);
+        const uint32_t packedColor = PackColor(color);
 
-#if 1
-        const LineVertex vertices[4]
+        Vector3 corners[4];
+        for (uint32_t i = 0; i < 4; i++)
         {
-            LineVertex(rotation * posA, color),
-            LineVertex(rotation * posB, color),
-            LineVertex(rotation * posC, color),
-            LineVertex(rotation * posD, color),
-        };
+            // Walks the corners around the square: (-,-) (-,+) (+,+) (+,-)
+            const float sx = i < 2 ? -1.0f : 1.0f;
+            const float sy = i == 0 || i == 3 ? -1.0f : 1.0f;
+            corners[i].x = position.x + halfX.x * sx + halfY.x * sy;
+            corners[i].y = position.y + halfX.y * sx + halfY.y * sy;
+            corners[i].z = position.z + halfX.z * sx + halfY.z * sy;
+        }
 
-        s_Vertices.AddRange(vertices);
+        for (uint32_t i = 0; i < 4; i++)
+            AddLine(vertices, corners[i], corners[(i + 1) % 4], packedColor);
+    }
 
-        const uint32_t indices[8]
-        {
-            s_IndicesCount + 0,
-            s_IndicesCount + 1,
-            s_IndicesCount + 1,
-            s_IndicesCount + 2,
-            s_IndicesCount + 2,
-            s_IndicesCount + 3,
-            s_IndicesCount + 3,
-            s_IndicesCount + 0,
-        };
-        s_Indices.AddRange(indices);
-        s_IndicesCount += 4;
-#else
+    void DebugRenderer::DrawCircle(const Vector3& position, const Quaternion& rotation, const float radius, const Color& color, float thickness, const DebugLayer layer)
+    {
+        Array<LineVertex>& vertices = GetLocalVertices(layer);
+        if (radius <= Math::Epsilon) return;
 
-        DrawLine(posA, posB, color, thickness);
-        DrawLine(posB, posC, color, thickness);
-        DrawLine(posC, posD, color, thickness);
-        DrawLine(posD, posA, color, thickness);
-#endif
+        const Vector3 axisX = rotation * Vector3::Right;
+        const Vector3 axisY = rotation * Vector3::Up;
+        AddArc(vertices, position, axisX, axisY, radius, PackColor(color), 0, CIRCLE_PRECISION);
     }
 
-    void DebugRenderer::DrawCircle(const Vector3& position, const Quaternion& rotation, const float radius, const Color& color, float thickness)
+    void DebugRenderer::DrawBox(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Color& color, float thickness, const DebugLayer layer)
     {
-        NOVA_ASSERT(s_Begin, "Cannot draw outside a DebugRenderer::Begin/End scope!");
-        if (radius <= Math::Epsilon) return;
+        Array<LineVertex>& vertices = GetLocalVertices(layer);
+        if (size.MagnitudeSquared() <= Math::Epsilon) return;
 
-        constexpr float angle = Math::Tau / CIRCLE_PRECISION;
+        const Vector3 halfX = rotation * Vector3(size.x * 0.5f, 0.0f, 0.0f);
+        const Vector3 halfY = rotation * Vector3(0.0f, size.y * 0.5f, 0.0f);
+        const Vector3 halfZ = rotation * Vector3(0.0f, 0.0f, size.z * 0.5f);
+        const uint32_t packedColor = PackColor(color);
 
-        for (uint32_t i = 0; i < CIRCLE_PRECISION; i++)
+        // Corner i sits on the positive side of X, Y and Z when bit 0, 1 and 2 are set
+        Vector3 corners[8];
+        for (uint32_t i = 0; i < 8; i++)
         {
-            const Vector3 point = position + Vector3(radius * Math::Cos((float)i * angle), radius * Math::Sin((float)i * angle), 0.0f);
-            const LineVertex vertex(rotation * point, color);
-            s_Vertices.Add(vertex);
+            const float sx = i & 1 ? 1.0f : -1.0f;
+            const float sy = i & 2 ? 1.0f : -1.0f;
+            const float sz = i & 4 ? 1.0f : -1.0f;
+            corners[i].x = position.x + halfX.x * sx + halfY.x * sy + halfZ.x * sz;
+            corners[i].y = position.y + halfX.y * sx + halfY.y * sy + halfZ.y * sz;
+            corners[i].z = position.z + halfX.z * sx + halfY.z * sy + halfZ.z * sz;
         }
 
-        for (uint32_t i = 0; i < CIRCLE_PRECISION; i++)
+        // Every edge joins two corners differing by a single bit
+        for (uint32_t i = 0; i < 8; i++)
         {
-            if (i < CIRCLE_PRECISION - 1)
+            for (uint32_t bit = 1; bit < 8; bit <<= 1)
             {
-                const uint32_t indices[2]
-                {
-                    s_IndicesCount + i,
-                    s_IndicesCount + i + 1,
-                };
-                s_Indices.AddRange(indices);
-            } else
-            {
-                const uint32_t indices[2]
-                {
-                    s_IndicesCount + CIRCLE_PRECISION - 1,
-                    s_IndicesCount + 0,
-                };
-                s_Indices.AddRange(indices);
+                if (!(i & bit))
+                    AddLine(vertices, corners[i], corners[i | bit], packedColor);
             }
         }
+    }
+
+    void DebugRenderer::DrawSphere(const Vector3& position, const float radius, const Color& color, float thickness, const DebugLayer layer)
+    {
+        Array<LineVertex>& vertices = GetLocalVertices(layer);
+        if (radius <= Math::Epsilon) return;
+
+        const uint32_t packedColor = PackColor(color);
+        AddArc(vertices, position, Vector3::Right, Vector3::Up, radius, packedColor, 0, CIRCLE_PRECISION);
+        AddArc(vertices, position, Vector3::Right, Vector3::Forward, radius, packedColor, 0, CIRCLE_PRECISION);
+        AddArc(vertices, position, Vector3::Forward, Vector3::Up, radius, packedColor, 0, CIRCLE_PRECISION);
+    }
 
-        s_IndicesCount += s_Vertices.Count();
+    void DebugRenderer::DrawCapsule(const Vector3& position, const float height, const float radius, const Color& color, float thickness, const DebugLayer layer)
+    {
+        Array<LineVertex>& vertices = GetLocalVertices(layer);
+        if (radius <= Math::Epsilon) return;
+
+        // The capsule stands along Y, height includes both caps
+        const float halfHeight = Math::Max(height * 0.5f - radius, 0.0f);
+        const Vector3 top(position.x, position.y + halfHeight, position.z);
+        const Vector3 bottom(position.x, position.y - halfHeight, position.z);
+        const Vector3 down(0.0f, -1.0f, 0.0f);
+        const uint32_t packedColor = PackColor(color);
+        constexpr uint32_t halfCircle = CIRCLE_PRECISION / 2;
+
+        AddArc(vertices, top, Vector3::Right, Vector3::Forward, radius, packedColor, 0, CIRCLE_PRECISION);
+        AddArc(vertices, bottom, Vector3::Right, Vector3::Forward, radius, packedColor, 0, CIRCLE_PRECISION);
+
+        AddArc(vertices, top, Vector3::Right, Vector3::Up, radius, packedColor, 0, halfCircle);
+        AddArc(vertices, top, Vector3::Forward, Vector3::Up, radius, packedColor, 0, halfCircle);
+        AddArc(vertices, bottom, Vector3::Right, down, radius, packedColor, 0, halfCircle);
+        AddArc(vertices, bottom, Vector3::Forward, down, radius, packedColor, 0, halfCircle);
+
+        if (halfHeight <= 0.0f) return;
+        AddLine(vertices, Vector3(top.x + radius, top.y, top.z), Vector3(bottom.x + radius, bottom.y, bottom.z), packedColor);
+        AddLine(vertices, Vector3(top.x - radius, top.y, top.z), Vector3(bottom.x - radius, bottom.y, bottom.z), packedColor);
+        AddLine(vertices, Vector3(top.x, top.y, top.z + radius), Vector3(bottom.x, bottom.y, bottom.z + radius), packedColor);
+        AddLine(vertices, Vector3(top.x, top.y, top.z - radius), Vector3(bottom.x, bottom.y, bottom.z - radius), packedColor);
+    }
+
+    uint32_t DebugRenderer::GetLineCount()
+    {
+        return (s_VertexCounts[0] + s_VertexCounts[1]) / 2;
     }
 
-    void DebugRenderer::DrawCapsule(const Vector3& position, float height, float radius, const Color& color, float thickness)
+    uint32_t DebugRenderer::GetCapacity()
     {
-        NOVA_ASSERT(s_Begin, "Cannot draw outside a DebugRenderer::Begin/End scope!");
+        return s_Capacity / 2;
     }
 }
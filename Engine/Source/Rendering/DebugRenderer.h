@@ -1,14 +1,12 @@
 ﻿#pragma once
-#include "Runtime/Object.h"
-#include "Runtime/Ref.h"
-
+#include <cstdint>
 
 namespace Nova
 {
     struct Vector3;
-    struct Vector2;
-    class Matrix4;
+    struct Quaternion;
     struct Color;
+    class Matrix4;
     class CommandBuffer;
     class RenderDevice;
     class Shader;
@@ -16,30 +14,44 @@ namespace Nova
 
 namespace Nova
 {
+    enum class DebugLayer
+    {
+        // Hidden behind scene geometry
+        World,
+        // Drawn on top of everything
+        Overlay,
+    };
+
     struct DebugRendererCreateInfo
     {
         RenderDevice* device = nullptr;
         Shader* shader = nullptr;
-        uint32_t maxVertices = 0;
+        uint32_t maxLines = 65536;
     };
 
+    // Every primitive is broken down into line segments and the whole frame is drawn with one draw per layer.
+    // Segments are written into a persistently mapped buffer holding one region per frame in flight,
+    // the regions grow when a frame submits more lines than they can hold.
+    // Draw functions may be called from any thread between Begin and End, each thread fills its own list
+    // and End merges them. Submitting threads must be done before End is called.
     class DebugRenderer final
     {
     public:
-        DebugRenderer() = default;
-        ~DebugRenderer() = default;
-
         static bool Initialize(const DebugRendererCreateInfo& createInfo);
         static void Destroy();
 
         static void Begin(const Matrix4& viewProjection);
         static void End(CommandBuffer& cmdBuffer);
         static void Render(CommandBuffer& cmdBuffer);
-        static void DrawLine(const Vector3& start, const Vector3& end, const Color& color, float thickness = 1.0f);
-        static void DrawSquare(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Color& color, float thickness = 1.0f);
-        static void DrawCircle(const Vector3& position, const Quaternion& rotation, float radius, const Color& color, float thickness = 1.0f);
-        static void DrawCapsule(const Vector3& position, float height, float radius, const Color& color, float thickness = 1.0f);
-    private:
-        static inline Ref<RenderDevice> s_Device = nullptr;
+
+        static void DrawLine(const Vector3& start, const Vector3& end, const Color& color, float thickness = 1.0f, DebugLayer layer = DebugLayer::World);
+        static void DrawSquare(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Color& color, float thickness = 1.0f, DebugLayer layer = DebugLayer::World);
+        static void DrawCircle(const Vector3& position, const Quaternion& rotation, float radius, const Color& color, float thickness = 1.0f, DebugLayer layer = DebugLayer::World);
+        static void DrawBox(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Color& color, float thickness = 1.0f, DebugLayer layer = DebugLayer::World);
+        static void DrawSphere(const Vector3& position, float radius, const Color& color, float thickness = 1.0f, DebugLayer layer = DebugLayer::World);
+        static void DrawCapsule(const Vector3& position, float height, float radius, const Color& color, float thickness = 1.0f, DebugLayer layer = DebugLayer::World);
+
+        static uint32_t GetLineCount();
+        static uint32_t GetCapacity();
     };
 }
@@ -3,6 +3,7 @@
 #include "GraphicsPipeline.h"
 #include "RenderPass.h"
 #include "Texture.h"
+#include "CommandBuffer.h"
 
 namespace Nova
 {
@@ -48,30 +49,6 @@ namespace Nova
             pass.pipeline = createInfo.device->CreateGraphicsPipeline(pipelineCreateInfo);
             if (!pass.pipeline) return false;
 
-            for (uint32_t i = 0; i < createInfo.device->GetImageCount(); i++)
-            {
-                TextureCreateInfo textureCreateInfo
-                {
-                    .device = createInfo.device,
-                    .usageFlags = TextureUsageFlagBits::Sampled,
-                    .format = pass.description.format,
-                    .width = createInfo.width,
-                    .height = createInfo.height,
-                    .depth = 1,
-                    .mips = 1,
-                    .sampleCount = 1,
-                    .data = nullptr,
-                    .dataSize = 0
-                };
-
-                pass.textures[i] = createInfo.device->CreateTexture(textureCreateInfo);
-                if (!pass.textures[i])
-                {
-                    pass.pipeline->Destroy();
-                    return false;
-                }
-            }
-
             m_GBufferPasses.Add(pass);
         }
 
@@ -103,6 +80,62 @@ namespace Nova
         Initialize(createInfo);
     }
 
+    RenderGraphHandle DeferredRenderer::AddPasses(RenderGraph& graph)
+    {
+        if (!m_IsValid) return InvalidRenderGraphHandle;
+
+        static const Name passNames[] = { "GBufferAlbedo", "GBufferPosition", "GBufferNormal", "GBufferTangent", "GBufferCustom", "GBufferEmission", "GBufferLighting" };
+
+        RenderGraphTextureDesc textureDesc;
+        textureDesc.width = m_Width;
+        textureDesc.height = m_Height;
+        textureDesc.sampleCount = 1;
+        textureDesc.usageFlags = TextureUsageFlagBits::ColorAttachment | TextureUsageFlagBits::Sampled;
+
+        RenderGraphHandle lightingTexture = InvalidRenderGraphHandle;
+        for (GBufferPass& pass : m_GBufferPasses)
+        {
+            const Name& passName = passNames[(size_t)pass.description.type];
+            textureDesc.format = pass.description.format;
+            pass.texture = graph.CreateTexture(passName, textureDesc);
+
+            const RenderGraphHandle texture = pass.texture;
+            GraphicsPipeline* pipeline = pass.pipeline;
+            const Rect2D<uint32_t> renderArea = {0, 0, m_Width, m_Height};
+            RenderGraphBuilder builder = graph.AddPass(passName, [texture, pipeline, renderArea](const RenderGraph& graph, CommandBuffer& cmdBuffer)
+            {
+                RenderPassAttachmentInfo colorAttachment;
+                colorAttachment.type = RenderPassAttachmentType::Color;
+                colorAttachment.loadOp = LoadOperation::Clear;
+                colorAttachment.storeOp = StoreOperation::Store;
+                colorAttachment.textureView = graph.GetTexture(texture)->GetView().Get();
+
+                RenderPassBeginInfo renderPassBeginInfo;
+                renderPassBeginInfo.renderArea = renderArea;
+                renderPassBeginInfo.colorAttachmentCount = 1;
+                renderPassBeginInfo.colorAttachments = &colorAttachment;
+
+                cmdBuffer.BeginRenderPass(renderPassBeginInfo);
+                cmdBuffer.BindGraphicsPipeline(*pipeline);
+                cmdBuffer.EndRenderPass();
+            });
+            builder.Write(pass.texture, ResourceState::ColorAttachment);
+
+            if (pass.description.type != GBufferPassType::Lighting)
+                continue;
+
+            // Lighting reads every target declared before it
+            for (const GBufferPass& other : m_GBufferPasses)
+            {
+                if (&other == &pass) break;
+                builder.Read(other.texture, ResourceState::ShaderRead);
+            }
+            lightingTexture = pass.texture;
+        }
+
+        return lightingTexture;
+    }
+
     bool DeferredRenderer::IsValid() const
     {
         return m_IsValid;
@@ -112,9 +145,8 @@ namespace Nova
     {
         for (GBufferPass& pass : m_GBufferPasses)
         {
-            for (uint32_t i = 0; i < m_Device->GetImageCount(); i++)
-                pass.textures[i]->Destroy();
             pass.pipeline->Destroy();
+            pass.pipeline = nullptr;
         }
         m_GBufferPasses.Clear();
         m_IsValid = false;
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "RenderGraph.h"
 #include "Runtime/Format.h"
 #include "Runtime/Object.h"
 #include "Runtime/Ref.h"
@@ -37,7 +38,7 @@ namespace Nova
     struct GBufferPass
     {
         GBufferPassDescription description;
-        Ref<Texture> textures[3] = {nullptr, nullptr, nullptr};
+        RenderGraphHandle texture = InvalidRenderGraphHandle;
         Ref<GraphicsPipeline> pipeline;
     };
 
@@ -60,6 +61,10 @@ namespace Nova
         void Destroy();
         void Resize(uint32_t width, uint32_t height);
 
+        // Declares one pass per G-buffer target, the targets are transient textures of the graph.
+        // Returns the lighting target, nothing is rendered unless a later pass reads it.
+        RenderGraphHandle AddPasses(RenderGraph& graph);
+
         bool IsValid() const;
         void Invalidate();
     private:
@@ -10,10 +10,13 @@ namespace Nova
         RenderDevice* device;
         Map<BindingType, uint32_t> sizes;
         size_t maxSets;
+        // Sets allocated from the pool may be written while command buffers using them are pending
+        bool updateAfterBind = false;
 
         DescriptorPoolCreateInfo& SetDevice(RenderDevice* device) { this->device = device; return *this; }
         DescriptorPoolCreateInfo& SetBindingTypeSize(const BindingType bindingType, const uint32_t size) { sizes[bindingType] = size; return *this; }
         DescriptorPoolCreateInfo& SetMaxSets(const uint32_t maxSets) { this->maxSets = maxSets; return *this; }
+        DescriptorPoolCreateInfo& SetUpdateAfterBind(const bool updateAfterBind) { this->updateAfterBind = updateAfterBind; return *this; }
     };
 
     class DescriptorPool
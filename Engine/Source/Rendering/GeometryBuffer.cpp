@@ -0,0 +1,331 @@
+﻿#include "GeometryBuffer.h"
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "Fence.h"
+#include "Queue.h"
+#include "RenderDevice.h"
+#include "Runtime/Common.h"
+#include "Runtime/Log.h"
+#include <algorithm>
+
+NOVA_DECLARE_LOG_CATEGORY_STATIC(GeometryBuffer, "GEOMETRY BUFFER")
+
+namespace Nova
+{
+    struct BufferCopyRegion
+    {
+        const Buffer* src;
+        const Buffer* dest;
+        size_t srcOffset;
+        size_t destOffset;
+        size_t size;
+    };
+
+    static bool SubmitCopies(RenderDevice* device, const Array<BufferCopyRegion>& regions)
+    {
+        if (regions.IsEmpty()) return true;
+
+        Ref<CommandBuffer> cmdBuffer = device->CreateTransferCommandBuffer();
+        if (!cmdBuffer) return false;
+        NOVA_DEFER(cmdBuffer, &CommandBuffer::Free);
+
+        cmdBuffer->Begin({ CommandBufferUsageFlagBits::OneTimeSubmit });
+        for (const BufferCopyRegion& region : regions)
+            cmdBuffer->BufferCopy(*region.src, *region.dest, region.srcOffset, region.destOffset, region.size);
+        cmdBuffer->End();
+
+        Ref<Fence> fence = device->CreateFence();
+        if (!fence) return false;
+        NOVA_DEFER(fence, &Fence::Destroy);
+
+        const Queue* transferQueue = device->GetTransferQueue();
+        transferQueue->Submit(cmdBuffer, nullptr, nullptr, fence);
+        fence->Wait(FENCE_WAIT_INFINITE);
+        return true;
+    }
+
+    bool GeometryBuffer::Initialize(const GeometryBufferCreateInfo& createInfo)
+    {
+        if (!createInfo.device) return false;
+        if (createInfo.vertexStride == 0) return false;
+
+        Destroy();
+        std::scoped_lock lock(m_Mutex);
+        m_Device = createInfo.device;
+        m_VertexStride = createInfo.vertexStride;
+        m_InitialVertexCapacity = std::max(createInfo.vertexCapacity, 1u);
+        m_InitialIndexCapacity = std::max(createInfo.indexCapacity, 1u);
+        return true;
+    }
+
+    void GeometryBuffer::Destroy()
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (m_VertexBuffer) m_VertexBuffer->Destroy();
+        if (m_IndexBuffer) m_IndexBuffer->Destroy();
+        m_VertexBuffer = nullptr;
+        m_IndexBuffer = nullptr;
+        m_VertexAllocator = TlsfAllocator();
+        m_IndexAllocator = TlsfAllocator();
+        m_Entries.Clear();
+        m_FreeHandles.Clear();
+        m_FreedSinceIdle = false;
+        m_Device = nullptr;
+    }
+
+    GeometryHandle GeometryBuffer::Allocate(const void* vertices, const uint32_t vertexCount, const uint32_t* indices, const uint32_t indexCount)
+    {
+        if (!vertices || !indices) return InvalidGeometryHandle;
+        if (vertexCount == 0 || indexCount == 0) return InvalidGeometryHandle;
+
+        std::scoped_lock lock(m_Mutex);
+        if (!m_Device) return InvalidGeometryHandle;
+
+        if (!m_VertexBuffer && !Rebuild(std::max(m_InitialVertexCapacity, vertexCount), std::max(m_InitialIndexCapacity, indexCount)))
+            return InvalidGeometryHandle;
+
+        Entry entry;
+        entry.used = true;
+        entry.vertexAllocation = m_VertexAllocator.Allocate(vertexCount);
+        entry.indexAllocation = m_IndexAllocator.Allocate(indexCount);
+
+        if (!entry.vertexAllocation.IsValid() || !entry.indexAllocation.IsValid())
+        {
+            m_VertexAllocator.Free(entry.vertexAllocation);
+            m_IndexAllocator.Free(entry.indexAllocation);
+
+            // Compacting is enough when the space exists but is scattered, otherwise grow geometrically
+            const uint32_t usedVertices = m_VertexAllocator.GetSize() - m_VertexAllocator.GetFreeSize();
+            const uint32_t usedIndices = m_IndexAllocator.GetSize() - m_IndexAllocator.GetFreeSize();
+            uint32_t vertexCapacity = m_VertexAllocator.GetSize();
+            uint32_t indexCapacity = m_IndexAllocator.GetSize();
+            if (usedVertices + vertexCount > vertexCapacity)
+                vertexCapacity = std::max(vertexCapacity * 2, usedVertices + vertexCount);
+            if (usedIndices + indexCount > indexCapacity)
+                indexCapacity = std::max(indexCapacity * 2, usedIndices + indexCount);
+
+            m_Device->WaitIdle();
+            if (!Rebuild(vertexCapacity, indexCapacity))
+                return InvalidGeometryHandle;
+
+            entry.vertexAllocation = m_VertexAllocator.Allocate(vertexCount);
+            entry.indexAllocation = m_IndexAllocator.Allocate(indexCount);
+            if (!entry.vertexAllocation.IsValid() || !entry.indexAllocation.IsValid())
+            {
+                m_VertexAllocator.Free(entry.vertexAllocation);
+                m_IndexAllocator.Free(entry.indexAllocation);
+                NOVA_LOG(GeometryBuffer, Verbosity::Error, "Failed to allocate {} vertices and {} indices!", vertexCount, indexCount);
+                return InvalidGeometryHandle;
+            }
+        }
+
+        entry.range.firstVertex = entry.vertexAllocation.offset;
+        entry.range.vertexCount = vertexCount;
+        entry.range.firstIndex = entry.indexAllocation.offset;
+        entry.range.indexCount = indexCount;
+
+        // Frames in flight may still draw a mesh freed since, its range must not be overwritten under them
+        if (m_FreedSinceIdle)
+        {
+            m_Device->WaitIdle();
+            m_FreedSinceIdle = false;
+        }
+
+        if (!Upload(entry, vertices, indices))
+        {
+            m_VertexAllocator.Free(entry.vertexAllocation);
+            m_IndexAllocator.Free(entry.indexAllocation);
+            return InvalidGeometryHandle;
+        }
+
+        GeometryHandle handle = InvalidGeometryHandle;
+        if (!m_FreeHandles.IsEmpty())
+        {
+            handle = m_FreeHandles.Last();
+            m_FreeHandles.PopBack();
+            m_Entries[handle] = entry;
+        }
+        else
+        {
+            handle = (GeometryHandle)m_Entries.Count();
+            m_Entries.Add(entry);
+        }
+        return handle;
+    }
+
+    void GeometryBuffer::Free(const GeometryHandle handle)
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (handle >= m_Entries.Count() || !m_Entries[handle].used)
+            return;
+
+        Entry& entry = m_Entries[handle];
+        m_VertexAllocator.Free(entry.vertexAllocation);
+        m_IndexAllocator.Free(entry.indexAllocation);
+        entry = Entry();
+        m_FreeHandles.Add(handle);
+        m_FreedSinceIdle = true;
+    }
+
+    GeometryRange GeometryBuffer::GetRange(const GeometryHandle handle) const
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (handle >= m_Entries.Count() || !m_Entries[handle].used)
+            return {};
+        return m_Entries[handle].range;
+    }
+
+    DrawIndexedIndirectParameters GeometryBuffer::GetDrawParameters(const GeometryHandle handle, const uint32_t instanceCount, const uint32_t firstInstance) const
+    {
+        const GeometryRange range = GetRange(handle);
+        DrawIndexedIndirectParameters parameters;
+        parameters.indexCount = range.indexCount;
+        parameters.instanceCount = instanceCount;
+        parameters.firstIndex = range.firstIndex;
+        parameters.vertexOffset = (int32_t)range.firstVertex;
+        parameters.firstInstance = firstInstance;
+        return parameters;
+    }
+
+    void GeometryBuffer::Bind(CommandBuffer& cmdBuffer) const
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (!m_VertexBuffer || !m_IndexBuffer) return;
+        cmdBuffer.BindVertexBuffer(*m_VertexBuffer, 0);
+        cmdBuffer.BindIndexBuffer(*m_IndexBuffer, 0, Format::Uint32);
+    }
+
+    Ref<Buffer> GeometryBuffer::GetVertexBuffer() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_VertexBuffer;
+    }
+
+    Ref<Buffer> GeometryBuffer::GetIndexBuffer() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_IndexBuffer;
+    }
+
+    bool GeometryBuffer::NeedsDefragment() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (!m_VertexBuffer) return false;
+        return IsFragmented(m_VertexAllocator) || IsFragmented(m_IndexAllocator);
+    }
+
+    bool GeometryBuffer::Defragment()
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (!m_VertexBuffer) return true;
+
+        m_Device->WaitIdle();
+        return Rebuild(m_VertexAllocator.GetSize(), m_IndexAllocator.GetSize());
+    }
+
+    uint32_t GeometryBuffer::GetVertexCapacity() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_VertexAllocator.GetSize();
+    }
+
+    uint32_t GeometryBuffer::GetIndexCapacity() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_IndexAllocator.GetSize();
+    }
+
+    uint32_t GeometryBuffer::GetUsedVertexCount() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_VertexAllocator.GetSize() - m_VertexAllocator.GetFreeSize();
+    }
+
+    uint32_t GeometryBuffer::GetUsedIndexCount() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        return m_IndexAllocator.GetSize() - m_IndexAllocator.GetFreeSize();
+    }
+
+    bool GeometryBuffer::Rebuild(const uint32_t vertexCapacity, const uint32_t indexCapacity)
+    {
+        Ref<Buffer> vertexBuffer = m_Device->CreateBuffer(BufferUsage::VertexBuffer, (size_t)vertexCapacity * m_VertexStride);
+        if (!vertexBuffer) return false;
+
+        Ref<Buffer> indexBuffer = m_Device->CreateBuffer(BufferUsage::IndexBuffer, (size_t)indexCapacity * sizeof(uint32_t));
+        if (!indexBuffer)
+        {
+            vertexBuffer->Destroy();
+            return false;
+        }
+
+        // A fresh allocator splits its only region from the front, so reallocating in handle order packs everything
+        TlsfAllocator vertexAllocator(vertexCapacity);
+        TlsfAllocator indexAllocator(indexCapacity);
+        Array<Entry> entries = m_Entries;
+        Array<BufferCopyRegion> regions;
+
+        for (Entry& entry : entries)
+        {
+            if (!entry.used) continue;
+
+            entry.vertexAllocation = vertexAllocator.Allocate(entry.range.vertexCount);
+            entry.indexAllocation = indexAllocator.Allocate(entry.range.indexCount);
+            NOVA_ASSERT(entry.vertexAllocation.IsValid() && entry.indexAllocation.IsValid(), "Rebuilt geometry buffer is too small!");
+
+            regions.Add({ m_VertexBuffer.Get(), vertexBuffer.Get(), (size_t)entry.range.firstVertex * m_VertexStride,
+                (size_t)entry.vertexAllocation.offset * m_VertexStride, (size_t)entry.range.vertexCount * m_VertexStride });
+            regions.Add({ m_IndexBuffer.Get(), indexBuffer.Get(), (size_t)entry.range.firstIndex * sizeof(uint32_t),
+                (size_t)entry.indexAllocation.offset * sizeof(uint32_t), (size_t)entry.range.indexCount * sizeof(uint32_t) });
+
+            entry.range.firstVertex = entry.vertexAllocation.offset;
+            entry.range.firstIndex = entry.indexAllocation.offset;
+        }
+
+        if (!SubmitCopies(m_Device, regions))
+        {
+            vertexBuffer->Destroy();
+            indexBuffer->Destroy();
+            return false;
+        }
+
+        if (m_VertexBuffer) m_VertexBuffer->Destroy();
+        if (m_IndexBuffer) m_IndexBuffer->Destroy();
+        m_FreedSinceIdle = false;
+        m_VertexBuffer = vertexBuffer;
+        m_IndexBuffer = indexBuffer;
+        m_VertexAllocator = Memory::Move(vertexAllocator);
+        m_IndexAllocator = Memory::Move(indexAllocator);
+        m_Entries = Memory::Move(entries);
+        return true;
+    }
+
+    bool GeometryBuffer::Upload(const Entry& entry, const void* vertices, const uint32_t* indices)
+    {
+        const size_t vertexSize = (size_t)entry.range.vertexCount * m_VertexStride;
+        const size_t indexSize = (size_t)entry.range.indexCount * sizeof(uint32_t);
+
+        Ref<Buffer> stagingBuffer = m_Device->CreateBuffer(BufferUsage::StagingBuffer, vertexSize + indexSize);
+        if (!stagingBuffer) return false;
+        NOVA_DEFER(stagingBuffer, &Buffer::Destroy);
+
+        uint8_t* mappedData = (uint8_t*)stagingBuffer->Map();
+        Memory::Memcpy(mappedData, vertices, vertexSize);
+        Memory::Memcpy(mappedData + vertexSize, indices, indexSize);
+        stagingBuffer->Unmap(mappedData);
+
+        Array<BufferCopyRegion> regions;
+        regions.Add({ stagingBuffer.Get(), m_VertexBuffer.Get(), 0, (size_t)entry.range.firstVertex * m_VertexStride, vertexSize });
+        regions.Add({ stagingBuffer.Get(), m_IndexBuffer.Get(), vertexSize, (size_t)entry.range.firstIndex * sizeof(uint32_t), indexSize });
+        return SubmitCopies(m_Device, regions);
+    }
+
+    bool GeometryBuffer::IsFragmented(const TlsfAllocator& allocator) const
+    {
+        // Holes only matter once a good part of the buffer is free and no longer usable for big meshes
+        const uint32_t freeSize = allocator.GetFreeSize();
+        if (freeSize < allocator.GetSize() / 4)
+            return false;
+        return allocator.GetLargestFreeRegion() < freeSize / 2;
+    }
+}
@@ -0,0 +1,102 @@
+﻿#pragma once
+#include "CommandBuffer.h"
+#include "Vertex.h"
+#include "Containers/Array.h"
+#include "Runtime/Ref.h"
+#include "Runtime/TlsfAllocator.h"
+#include <cstdint>
+#include <mutex>
+
+namespace Nova
+{
+    class RenderDevice;
+    class Buffer;
+
+    struct GeometryBufferCreateInfo
+    {
+        RenderDevice* device = nullptr;
+        uint32_t vertexStride = sizeof(Vertex);
+        uint32_t vertexCapacity = 256 * 1024;
+        uint32_t indexCapacity = 1024 * 1024;
+    };
+
+    using GeometryHandle = uint32_t;
+    static constexpr GeometryHandle InvalidGeometryHandle = ~0u;
+
+    // Where a mesh lives in the shared buffers, in vertices and indices.
+    // Indices stay relative to the mesh, draws pass firstVertex as their vertex offset.
+    struct GeometryRange
+    {
+        uint32_t firstVertex = 0;
+        uint32_t vertexCount = 0;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+    };
+
+    // One vertex buffer and one uint32 index buffer shared by every mesh of the device, suballocated with a TLSF
+    // allocator. Meshes keep a handle instead of their own buffers so draws of different meshes only differ by
+    // firstIndex and vertexOffset, and can be merged into a single indirect draw.
+    // Growing and defragmenting move the ranges into new buffers and wait for the device to be idle, neither may
+    // happen while a frame is being recorded. Handles stay valid, ranges must be queried again afterwards.
+    class GeometryBuffer
+    {
+    public:
+        GeometryBuffer() = default;
+        ~GeometryBuffer() = default;
+        GeometryBuffer(const GeometryBuffer&) = delete;
+        GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+
+        // Buffers are only created with the first allocation
+        bool Initialize(const GeometryBufferCreateInfo& createInfo);
+        void Destroy();
+        bool IsInitialized() const { return m_Device; }
+
+        // Copies the geometry in, growing the buffers when it does not fit
+        GeometryHandle Allocate(const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+        void Free(GeometryHandle handle);
+
+        GeometryRange GetRange(GeometryHandle handle) const;
+        DrawIndexedIndirectParameters GetDrawParameters(GeometryHandle handle, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+
+        // Binds both buffers at offset 0, nothing else needs rebinding between meshes
+        void Bind(CommandBuffer& cmdBuffer) const;
+        Ref<Buffer> GetVertexBuffer() const;
+        Ref<Buffer> GetIndexBuffer() const;
+
+        // True once frees left the free space too scattered for its size
+        bool NeedsDefragment() const;
+        bool Defragment();
+
+        uint32_t GetVertexCapacity() const;
+        uint32_t GetIndexCapacity() const;
+        uint32_t GetUsedVertexCount() const;
+        uint32_t GetUsedIndexCount() const;
+    private:
+        struct Entry
+        {
+            GeometryRange range;
+            TlsfAllocator::Allocation vertexAllocation;
+            TlsfAllocator::Allocation indexAllocation;
+            bool used = false;
+        };
+
+        // Expect m_Mutex to be locked
+        bool Rebuild(uint32_t vertexCapacity, uint32_t indexCapacity);
+        bool Upload(const Entry& entry, const void* vertices, const uint32_t* indices);
+        bool IsFragmented(const TlsfAllocator& allocator) const;
+
+        RenderDevice* m_Device = nullptr;
+        uint32_t m_VertexStride = 0;
+        uint32_t m_InitialVertexCapacity = 0;
+        uint32_t m_InitialIndexCapacity = 0;
+
+        mutable std::mutex m_Mutex;
+        Ref<Buffer> m_VertexBuffer = nullptr;
+        Ref<Buffer> m_IndexBuffer = nullptr;
+        TlsfAllocator m_VertexAllocator;
+        TlsfAllocator m_IndexAllocator;
+        Array<Entry> m_Entries;
+        Array<GeometryHandle> m_FreeHandles;
+        bool m_FreedSinceIdle = false;
+    };
+}
@@ -1,6 +1,7 @@
 ﻿#include "ImGuiRenderer.h"
 #include "RenderDevice.h"
 #include "External/ImGuiExtension.h"
+#include "Null/ImGuiRenderer.h"
 
 #include <imgui.h>
 
@@ -64,7 +65,7 @@ namespace Nova
         ImGuiRenderer* renderer = nullptr;
         switch (device->GetDeviceType())
         {
-        case RenderDeviceType::Null: return nullptr;
+        case RenderDeviceType::Null: NOVA_RETURN_IMPL(Null::ImGuiRenderer)
 #ifdef NOVA_HAS_VULKAN
         case RenderDeviceType::Vulkan: NOVA_RETURN_IMPL(Vulkan::ImGuiRenderer)
 #endif
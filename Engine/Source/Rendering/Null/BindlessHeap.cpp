@@ -0,0 +1,38 @@
+﻿#include "BindlessHeap.h"
+
+namespace Nova::Null
+{
+    bool BindlessHeap::Initialize(const BindlessHeapCreateInfo& createInfo)
+    {
+        if (!m_BindingSetLayout.Initialize(createInfo.device, SetIndex))
+            return false;
+
+        ShaderBindingSetCreateInfo bindingSetCreateInfo;
+        bindingSetCreateInfo.device = createInfo.device;
+        bindingSetCreateInfo.layout = &m_BindingSetLayout;
+        if (!m_BindingSet.Initialize(bindingSetCreateInfo))
+            return false;
+
+        InitializeSlots(createInfo);
+        return true;
+    }
+
+    void BindlessHeap::Destroy()
+    {
+        ReleaseSlots();
+        m_BindingSet.Destroy();
+        m_BindingSetLayout.Destroy();
+    }
+
+    Nova::ShaderBindingSet* BindlessHeap::GetBindingSet()
+    {
+        return &m_BindingSet;
+    }
+
+    void BindlessHeap::WriteDescriptor(const ResourceType type, const BindlessIndex index, Resource& resource)
+    {
+        (void)type;
+        (void)index;
+        (void)resource;
+    }
+}
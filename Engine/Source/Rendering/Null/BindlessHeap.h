@@ -0,0 +1,21 @@
+﻿#pragma once
+#include "Rendering/BindlessHeap.h"
+#include "ShaderBindingSet.h"
+#include "ShaderBindingSetLayout.h"
+
+namespace Nova::Null
+{
+    // Hands out indices like the real heap, descriptors are never written
+    class BindlessHeap final : public Nova::BindlessHeap
+    {
+    public:
+        bool Initialize(const BindlessHeapCreateInfo& createInfo) override;
+        void Destroy() override;
+        Nova::ShaderBindingSet* GetBindingSet() override;
+    protected:
+        void WriteDescriptor(ResourceType type, BindlessIndex index, Resource& resource) override;
+    private:
+        ShaderBindingSetLayout m_BindingSetLayout;
+        ShaderBindingSet m_BindingSet;
+    };
+}
@@ -0,0 +1,56 @@
+﻿#include "Buffer.h"
+#include "RenderDevice.h"
+#include "Rendering/BindlessHeap.h"
+#include "Runtime/Memory.h"
+
+namespace Nova::Null
+{
+    Buffer::~Buffer()
+    {
+        Destroy();
+    }
+
+    bool Buffer::Initialize(const BufferCreateInfo& createInfo)
+    {
+        if (createInfo.usage == BufferUsage::None)
+            return false;
+
+        uint8_t* data = Memory::Calloc<uint8_t>(createInfo.size ? createInfo.size : 1, MemoryTag::Rendering);
+        if (!data) return false;
+
+        if (m_Device && m_Data)
+            m_Device->GetResidencyManager().OnFree(DeviceMemoryCategory::Buffers, m_Size);
+        Memory::Free(m_Data);
+        m_Data = data;
+        m_Device = (RenderDevice*)createInfo.device;
+        m_Size = createInfo.size;
+        m_Usage = createInfo.usage;
+        m_Mapped = createInfo.mapped;
+        m_MappedData = m_Mapped ? m_Data : nullptr;
+        if (m_Device)
+            m_Device->GetResidencyManager().OnAllocate(DeviceMemoryCategory::Buffers, m_Size);
+        return true;
+    }
+
+    void Buffer::Destroy()
+    {
+        if (m_Device && GetBindlessIndex() != InvalidBindlessIndex)
+            m_Device->GetBindlessHeap()->Release(*this);
+        if (m_Device && m_Data)
+            m_Device->GetResidencyManager().OnFree(DeviceMemoryCategory::Buffers, m_Size);
+        Memory::Free(m_Data);
+        m_Data = nullptr;
+        m_MappedData = nullptr;
+        m_Size = 0;
+    }
+
+    void* Buffer::Map()
+    {
+        return m_Data;
+    }
+
+    void Buffer::Unmap(const void* ptr)
+    {
+        (void)ptr;
+    }
+}
@@ -0,0 +1,27 @@
+﻿#pragma once
+#include "Rendering/Buffer.h"
+#include <cstdint>
+
+namespace Nova::Null
+{
+    class RenderDevice;
+
+    // Buffer backed by plain CPU memory so uploads and readbacks behave like on a real device
+    class Buffer final : public Nova::Buffer
+    {
+    public:
+        Buffer() = default;
+        ~Buffer() override;
+
+        bool Initialize(const BufferCreateInfo& createInfo) override;
+        void Destroy() override;
+
+        void* Map() override;
+        void Unmap(const void* ptr) override;
+
+        uint8_t* GetData() const { return m_Data; }
+    private:
+        RenderDevice* m_Device = nullptr;
+        uint8_t* m_Data = nullptr;
+    };
+}
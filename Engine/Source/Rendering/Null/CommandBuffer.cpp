@@ -0,0 +1,388 @@
+﻿#include "CommandBuffer.h"
+#include "Buffer.h"
+#include "RenderDevice.h"
+#include "Rendering/BlitRegion.h"
+#include "Rendering/Material.h"
+#include "Rendering/RenderPass.h"
+#include "Rendering/ShaderBindingSet.h"
+#include "Runtime/Color.h"
+#include "Runtime/Memory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Nova::Null
+{
+    struct ClearColorCommand { Color color; uint32_t attachmentIndex; };
+    struct ClearDepthStencilCommand { float depth; uint32_t stencil; };
+    struct BindPipelineCommand { const void* pipeline; };
+    struct BindBufferCommand { const Nova::Buffer* buffer; uint64_t offset; Format indexFormat; };
+    struct BindShaderBindingSetCommand { const Nova::Shader* shader; const Nova::ShaderBindingSet* bindingSet; };
+    struct BindMaterialCommand { const Nova::Material* material; };
+    struct SetViewportCommand { float x, y, width, height, minDepth, maxDepth; };
+    struct SetScissorCommand { int32_t x, y, width, height; };
+    struct DrawCommand { uint32_t vertexCount, instanceCount, firstVertex, firstInstance; };
+    struct DrawIndexedCommand { uint32_t indexCount, instanceCount, firstIndex; int32_t vertexOffset; uint32_t firstInstance; };
+    struct DrawIndirectCommand { const Nova::Buffer* buffer; uint64_t offset; uint32_t drawCount; };
+    struct BeginRenderPassCommand { Rect2D<uint32_t> renderArea; uint32_t colorAttachmentCount; bool hasDepthAttachment; };
+    // Followed by the constant values
+    struct PushConstantsCommand { const Nova::Shader* shader; ShaderStageFlags stageFlags; uint64_t offset; size_t size; };
+    // Followed by the data
+    struct UpdateBufferCommand { const Nova::Buffer* buffer; uint64_t offset; size_t size; };
+    struct BarrierCommand { const void* resource; };
+    struct DispatchCommand { uint32_t groupCountX, groupCountY, groupCountZ; };
+    struct DispatchIndirectCommand { const Nova::Buffer* buffer; uint64_t offset; };
+    struct BufferCopyCommand { const Nova::Buffer* src; const Nova::Buffer* dest; size_t srcOffset, destOffset, size; };
+    struct CopyBufferToTextureCommand { const Nova::Buffer* src; const Nova::Texture* dest; size_t srcOffset, srcSize; uint32_t arrayIndex, mipLevel; };
+    struct BlitCommand { const Nova::Texture* src; const Nova::Texture* dest; Filter filter; };
+    // Followed by the command buffer pointers
+    struct ExecuteCommandBuffersCommand { size_t count; };
+
+    static constexpr size_t CommandAlignment = 8;
+    static constexpr size_t MinStreamCapacity = 16 * 1024;
+
+    void CommandBufferStats::Add(const CommandBufferStats& other)
+    {
+        commandCount += other.commandCount;
+        drawCount += other.drawCount;
+        dispatchCount += other.dispatchCount;
+        vertexCount += other.vertexCount;
+        pipelineBindCount += other.pipelineBindCount;
+        bufferBindCount += other.bufferBindCount;
+        bindingSetBindCount += other.bindingSetBindCount;
+        stateChangeCount += other.stateChangeCount;
+        barrierCount += other.barrierCount;
+        renderPassCount += other.renderPassCount;
+        uploadedBytes += other.uploadedBytes;
+        pushConstantBytes += other.pushConstantBytes;
+        streamSize += other.streamSize;
+    }
+
+    CommandBuffer::~CommandBuffer()
+    {
+        Free();
+    }
+
+    bool CommandBuffer::Allocate(const CommandBufferAllocateInfo& allocateInfo)
+    {
+        m_Device = (RenderDevice*)allocateInfo.device;
+        m_CommandPool = allocateInfo.commandPool;
+        m_Level = allocateInfo.level;
+        return true;
+    }
+
+    void CommandBuffer::Free()
+    {
+        Memory::Free(m_Stream);
+        m_Stream = nullptr;
+        m_StreamSize = 0;
+        m_StreamCapacity = 0;
+        m_Recording = false;
+    }
+
+    void CommandBuffer::SetName(StringView name)
+    {
+        (void)name;
+    }
+
+    bool CommandBuffer::Begin(const CommandBufferBeginInfo& beginInfo)
+    {
+        (void)beginInfo;
+        // The stream keeps its capacity so re-recording a similar frame does not allocate
+        m_StreamSize = 0;
+        m_Stats = {};
+        m_Pipeline = nullptr;
+        m_VertexBuffer = nullptr;
+        m_VertexBufferOffset = 0;
+        m_IndexBuffer = nullptr;
+        m_IndexBufferOffset = 0;
+        std::fill_n(m_BindingSets, MaxBindingSets, nullptr);
+        std::fill_n(m_Viewport, 6, 0.0f);
+        std::fill_n(m_Scissor, 4, 0);
+        m_Recording = true;
+        return true;
+    }
+
+    void CommandBuffer::End()
+    {
+        m_Recording = false;
+    }
+
+    void CommandBuffer::ClearColor(const Color& color, const uint32_t attachmentIndex)
+    {
+        *Record<ClearColorCommand>(CommandType::ClearColor) = { color, attachmentIndex };
+    }
+
+    void CommandBuffer::ClearDepthStencil(const float depth, const uint32_t stencil)
+    {
+        *Record<ClearDepthStencilCommand>(CommandType::ClearDepthStencil) = { depth, stencil };
+    }
+
+    void CommandBuffer::BindGraphicsPipeline(const Nova::GraphicsPipeline& pipeline)
+    {
+        *Record<BindPipelineCommand>(CommandType::BindGraphicsPipeline) = { &pipeline };
+        m_Stats.pipelineBindCount++;
+        if (m_Pipeline != &pipeline)
+        {
+            m_Pipeline = &pipeline;
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::BindComputePipeline(const Nova::ComputePipeline& pipeline)
+    {
+        *Record<BindPipelineCommand>(CommandType::BindComputePipeline) = { &pipeline };
+        m_Stats.pipelineBindCount++;
+        if (m_Pipeline != &pipeline)
+        {
+            m_Pipeline = &pipeline;
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::BindVertexBuffer(const Nova::Buffer& vertexBuffer, const uint64_t offset)
+    {
+        *Record<BindBufferCommand>(CommandType::BindVertexBuffer) = { &vertexBuffer, offset, Format::None };
+        m_Stats.bufferBindCount++;
+        if (m_VertexBuffer != &vertexBuffer || m_VertexBufferOffset != offset)
+        {
+            m_VertexBuffer = &vertexBuffer;
+            m_VertexBufferOffset = offset;
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::BindIndexBuffer(const Nova::Buffer& indexBuffer, const uint64_t offset, const Format indexFormat)
+    {
+        *Record<BindBufferCommand>(CommandType::BindIndexBuffer) = { &indexBuffer, offset, indexFormat };
+        m_Stats.bufferBindCount++;
+        if (m_IndexBuffer != &indexBuffer || m_IndexBufferOffset != offset)
+        {
+            m_IndexBuffer = &indexBuffer;
+            m_IndexBufferOffset = offset;
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::BindShaderBindingSet(const Nova::Shader& shader, const Nova::ShaderBindingSet& bindingSet)
+    {
+        *Record<BindShaderBindingSetCommand>(CommandType::BindShaderBindingSet) = { &shader, &bindingSet };
+        m_Stats.bindingSetBindCount++;
+
+        const uint32_t setIndex = bindingSet.GetBindingSetLayout() ? bindingSet.GetSetIndex() : 0;
+        if (setIndex >= MaxBindingSets || m_BindingSets[setIndex] != &bindingSet)
+        {
+            if (setIndex < MaxBindingSets) m_BindingSets[setIndex] = &bindingSet;
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::BindMaterial(const Nova::Material& material)
+    {
+        *Record<BindMaterialCommand>(CommandType::BindMaterial) = { &material };
+        m_Stats.bindingSetBindCount++;
+
+        // Materials own the first binding set of their shader
+        const Nova::ShaderBindingSet* bindingSet = material.GetBindingSet().Get();
+        if (m_BindingSets[0] != bindingSet)
+        {
+            m_BindingSets[0] = bindingSet;
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::SetViewport(const float x, const float y, const float width, const float height, const float minDepth, const float maxDepth)
+    {
+        *Record<SetViewportCommand>(CommandType::SetViewport) = { x, y, width, height, minDepth, maxDepth };
+        const float viewport[6] = { x, y, width, height, minDepth, maxDepth };
+        if (!std::equal(viewport, viewport + 6, m_Viewport))
+        {
+            std::copy_n(viewport, 6, m_Viewport);
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::SetScissor(const int32_t x, const int32_t y, const int32_t width, const int32_t height)
+    {
+        *Record<SetScissorCommand>(CommandType::SetScissor) = { x, y, width, height };
+        const int32_t scissor[4] = { x, y, width, height };
+        if (!std::equal(scissor, scissor + 4, m_Scissor))
+        {
+            std::copy_n(scissor, 4, m_Scissor);
+            m_Stats.stateChangeCount++;
+        }
+    }
+
+    void CommandBuffer::Draw(const uint32_t vertexCount, const uint32_t instanceCount, const uint32_t firstVertex, const uint32_t firstInstance)
+    {
+        *Record<DrawCommand>(CommandType::Draw) = { vertexCount, instanceCount, firstVertex, firstInstance };
+        m_Stats.drawCount++;
+        m_Stats.vertexCount += (uint64_t)vertexCount * instanceCount;
+    }
+
+    void CommandBuffer::DrawIndexed(const uint32_t indexCount, const uint32_t instanceCount, const uint32_t firstIndex, const int32_t vertexOffset, const uint32_t firstInstance)
+    {
+        *Record<DrawIndexedCommand>(CommandType::DrawIndexed) = { indexCount, instanceCount, firstIndex, vertexOffset, firstInstance };
+        m_Stats.drawCount++;
+        m_Stats.vertexCount += (uint64_t)indexCount * instanceCount;
+    }
+
+    void CommandBuffer::DrawIndirect(const Nova::Buffer& buffer, const uint64_t offset, const uint32_t drawCount)
+    {
+        *Record<DrawIndirectCommand>(CommandType::DrawIndirect) = { &buffer, offset, drawCount };
+        m_Stats.drawCount += drawCount;
+    }
+
+    void CommandBuffer::DrawIndexedIndirect(const Nova::Buffer& buffer, const uint64_t offset, const uint32_t drawCount)
+    {
+        *Record<DrawIndirectCommand>(CommandType::DrawIndexedIndirect) = { &buffer, offset, drawCount };
+        m_Stats.drawCount += drawCount;
+    }
+
+    void CommandBuffer::BeginRenderPass(const Nova::RenderPassBeginInfo& beginInfo)
+    {
+        *Record<BeginRenderPassCommand>(CommandType::BeginRenderPass) = { beginInfo.renderArea, beginInfo.colorAttachmentCount, beginInfo.depthAttachment != nullptr };
+        m_Stats.renderPassCount++;
+    }
+
+    void CommandBuffer::EndRenderPass()
+    {
+        Record(CommandType::EndRenderPass, 0);
+    }
+
+    void CommandBuffer::PushConstants(const Nova::Shader& shader, const ShaderStageFlags stageFlags, const uint64_t offset, const size_t size, const void* values)
+    {
+        PushConstantsCommand* command = Record<PushConstantsCommand>(CommandType::PushConstants, size);
+        *command = { &shader, stageFlags, offset, size };
+        std::memcpy(command + 1, values, size);
+        m_Stats.pushConstantBytes += size;
+    }
+
+    void CommandBuffer::UpdateBuffer(const Nova::Buffer& buffer, const uint64_t offset, const size_t size, const void* data)
+    {
+        NOVA_ASSERT(offset + size <= buffer.GetSize(), "Buffer update out of bounds!");
+        UpdateBufferCommand* command = Record<UpdateBufferCommand>(CommandType::UpdateBuffer, size);
+        *command = { &buffer, offset, size };
+        std::memcpy(command + 1, data, size);
+        m_Stats.uploadedBytes += size;
+    }
+
+    void CommandBuffer::TextureBarrier(const Nova::TextureBarrier& barrier)
+    {
+        *Record<BarrierCommand>(CommandType::TextureBarrier) = { &barrier };
+        m_Stats.barrierCount++;
+    }
+
+    void CommandBuffer::BufferBarrier(const Nova::BufferBarrier& barrier)
+    {
+        *Record<BarrierCommand>(CommandType::BufferBarrier) = { &barrier };
+        m_Stats.barrierCount++;
+    }
+
+    void CommandBuffer::MemoryBarrier(const Nova::MemoryBarrier& barrier)
+    {
+        *Record<BarrierCommand>(CommandType::MemoryBarrier) = { &barrier };
+        m_Stats.barrierCount++;
+    }
+
+    void CommandBuffer::Dispatch(const uint32_t groupCountX, const uint32_t groupCountY, const uint32_t groupCountZ)
+    {
+        *Record<DispatchCommand>(CommandType::Dispatch) = { groupCountX, groupCountY, groupCountZ };
+        m_Stats.dispatchCount++;
+    }
+
+    void CommandBuffer::DispatchIndirect(const Nova::Buffer& buffer, const uint64_t offset)
+    {
+        *Record<DispatchIndirectCommand>(CommandType::DispatchIndirect) = { &buffer, offset };
+        m_Stats.dispatchCount++;
+    }
+
+    void CommandBuffer::BufferCopy(const Nova::Buffer& src, const Nova::Buffer& dest, const size_t srcOffset, const size_t destOffset, const size_t size)
+    {
+        NOVA_ASSERT(srcOffset + size <= src.GetSize() && destOffset + size <= dest.GetSize(), "Buffer copy out of bounds!");
+        *Record<BufferCopyCommand>(CommandType::BufferCopy) = { &src, &dest, srcOffset, destOffset, size };
+        m_Stats.uploadedBytes += size;
+    }
+
+    void CommandBuffer::CopyBufferToTexture(const Nova::Buffer& src, const Nova::Texture& dest, const size_t srcOffset, const size_t srcSize, const uint32_t arrayIndex, const uint32_t mipLevel)
+    {
+        *Record<CopyBufferToTextureCommand>(CommandType::CopyBufferToTexture) = { &src, &dest, srcOffset, srcSize, arrayIndex, mipLevel };
+        m_Stats.uploadedBytes += srcSize;
+    }
+
+    void CommandBuffer::Blit(const Nova::Texture& src, const BlitRegion& srcRegion, const Nova::Texture& dest, const BlitRegion& destRegion, const Filter filter)
+    {
+        (void)srcRegion;
+        (void)destRegion;
+        *Record<BlitCommand>(CommandType::Blit) = { &src, &dest, filter };
+    }
+
+    void CommandBuffer::Blit(const Nova::Texture& src, const Nova::Texture& dest, const Filter filter)
+    {
+        *Record<BlitCommand>(CommandType::Blit) = { &src, &dest, filter };
+    }
+
+    void CommandBuffer::ExecuteCommandBuffers(const Array<const Nova::CommandBuffer*>& commandBuffers)
+    {
+        const size_t count = commandBuffers.Count();
+        ExecuteCommandBuffersCommand* command = Record<ExecuteCommandBuffersCommand>(CommandType::ExecuteCommandBuffers, count * sizeof(void*));
+        command->count = count;
+        std::memcpy(command + 1, commandBuffers.Data(), count * sizeof(void*));
+
+        for (const Nova::CommandBuffer* commandBuffer : commandBuffers)
+            m_Stats.Add(((const CommandBuffer*)commandBuffer)->GetStats());
+    }
+
+    void CommandBuffer::Execute() const
+    {
+        ForEachCommand([](const CommandType type, const void* payload)
+        {
+            switch (type)
+            {
+            case CommandType::UpdateBuffer:
+                {
+                    const UpdateBufferCommand* command = (const UpdateBufferCommand*)payload;
+                    const Buffer* buffer = (const Buffer*)command->buffer;
+                    std::memcpy(buffer->GetData() + command->offset, command + 1, command->size);
+                }
+                break;
+            case CommandType::BufferCopy:
+                {
+                    const BufferCopyCommand* command = (const BufferCopyCommand*)payload;
+                    const Buffer* src = (const Buffer*)command->src;
+                    const Buffer* dest = (const Buffer*)command->dest;
+                    std::memmove(dest->GetData() + command->destOffset, src->GetData() + command->srcOffset, command->size);
+                }
+                break;
+            case CommandType::ExecuteCommandBuffers:
+                {
+                    const ExecuteCommandBuffersCommand* command = (const ExecuteCommandBuffersCommand*)payload;
+                    const CommandBuffer* const* commandBuffers = (const CommandBuffer* const*)(command + 1);
+                    for (size_t i = 0; i < command->count; ++i)
+                        commandBuffers[i]->Execute();
+                }
+                break;
+            default:
+                break;
+            }
+        });
+    }
+
+    void* CommandBuffer::Record(const CommandType type, const size_t payloadSize)
+    {
+        NOVA_ASSERT(m_Recording, "Command buffer is not recording!");
+        const size_t size = (sizeof(CommandHeader) + payloadSize + CommandAlignment - 1) & ~(CommandAlignment - 1);
+        if (m_StreamSize + size > m_StreamCapacity)
+        {
+            m_StreamCapacity = std::max({ MinStreamCapacity, m_StreamCapacity * 2, m_StreamSize + size });
+            m_Stream = Memory::Realloc<uint8_t>(m_Stream, m_StreamCapacity, MemoryTag::Rendering);
+        }
+
+        CommandHeader* header = (CommandHeader*)(m_Stream + m_StreamSize);
+        header->type = type;
+        header->size = (uint32_t)size;
+        m_StreamSize += size;
+        m_Stats.commandCount++;
+        m_Stats.streamSize += size;
+        return header + 1;
+    }
+}
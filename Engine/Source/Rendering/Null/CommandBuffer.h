@@ -0,0 +1,161 @@
+﻿#pragma once
+#include "Rendering/CommandBuffer.h"
+#include <cstdint>
+
+namespace Nova::Null
+{
+    class RenderDevice;
+
+    enum class CommandType : uint32_t
+    {
+        ClearColor,
+        ClearDepthStencil,
+        BindGraphicsPipeline,
+        BindComputePipeline,
+        BindVertexBuffer,
+        BindIndexBuffer,
+        BindShaderBindingSet,
+        BindMaterial,
+        SetViewport,
+        SetScissor,
+        Draw,
+        DrawIndexed,
+        DrawIndirect,
+        DrawIndexedIndirect,
+        BeginRenderPass,
+        EndRenderPass,
+        PushConstants,
+        UpdateBuffer,
+        TextureBarrier,
+        BufferBarrier,
+        MemoryBarrier,
+        Dispatch,
+        DispatchIndirect,
+        BufferCopy,
+        CopyBufferToTexture,
+        Blit,
+        ExecuteCommandBuffers,
+    };
+
+    // What was recorded since the last Begin. Executed secondary command buffers are included.
+    struct CommandBufferStats
+    {
+        uint32_t commandCount = 0;
+        uint32_t drawCount = 0;
+        uint32_t dispatchCount = 0;
+        uint64_t vertexCount = 0;
+        uint32_t pipelineBindCount = 0;
+        uint32_t bufferBindCount = 0;
+        uint32_t bindingSetBindCount = 0;
+        // Binds and dynamic states that differ from what was already set, the rest are redundant
+        uint32_t stateChangeCount = 0;
+        uint32_t barrierCount = 0;
+        uint32_t renderPassCount = 0;
+        // Buffer updates and copies, push constants are counted separately
+        uint64_t uploadedBytes = 0;
+        uint64_t pushConstantBytes = 0;
+        // Size of the recorded command stream
+        uint64_t streamSize = 0;
+
+        void Add(const CommandBufferStats& other);
+    };
+
+    // Records commands into a compact linear stream instead of sending them to a GPU.
+    // Executing the stream applies buffer updates and copies to the Null buffers, everything else is only counted.
+    class CommandBuffer final : public Nova::CommandBuffer
+    {
+    public:
+        CommandBuffer() = default;
+        ~CommandBuffer() override;
+
+        bool Allocate(const CommandBufferAllocateInfo& allocateInfo) override;
+        void Free() override;
+        void SetName(StringView name) override;
+        bool Begin(const CommandBufferBeginInfo& beginInfo) override;
+        void End() override;
+
+        void ClearColor(const Color& color, uint32_t attachmentIndex) override;
+        void ClearDepthStencil(float depth, uint32_t stencil) override;
+        void BindGraphicsPipeline(const Nova::GraphicsPipeline& pipeline) override;
+        void BindComputePipeline(const Nova::ComputePipeline& pipeline) override;
+        void BindVertexBuffer(const Nova::Buffer& vertexBuffer, uint64_t offset) override;
+        void BindIndexBuffer(const Nova::Buffer& indexBuffer, uint64_t offset, Format indexFormat) override;
+        void BindShaderBindingSet(const Nova::Shader& shader, const Nova::ShaderBindingSet& bindingSet) override;
+        void BindMaterial(const Nova::Material& material) override;
+        void SetViewport(float x, float y, float width, float height, float minDepth, float maxDepth) override;
+        void SetScissor(int32_t x, int32_t y, int32_t width, int32_t height) override;
+        void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override;
+        void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) override;
+        void DrawIndirect(const Nova::Buffer& buffer, uint64_t offset, uint32_t drawCount) override;
+        void DrawIndexedIndirect(const Nova::Buffer& buffer, uint64_t offset, uint32_t drawCount) override;
+        void BeginRenderPass(const Nova::RenderPassBeginInfo& beginInfo) override;
+        void EndRenderPass() override;
+        void PushConstants(const Nova::Shader& shader, ShaderStageFlags stageFlags, uint64_t offset, size_t size, const void* values) override;
+        void UpdateBuffer(const Nova::Buffer& buffer, uint64_t offset, size_t size, const void* data) override;
+        void TextureBarrier(const Nova::TextureBarrier& barrier) override;
+        void BufferBarrier(const Nova::BufferBarrier& barrier) override;
+        void MemoryBarrier(const Nova::MemoryBarrier& barrier) override;
+
+        void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+        void DispatchIndirect(const Nova::Buffer& buffer, uint64_t offset) override;
+
+        void BufferCopy(const Nova::Buffer& src, const Nova::Buffer& dest, size_t srcOffset, size_t destOffset, size_t size) override;
+        void CopyBufferToTexture(const Nova::Buffer& src, const Nova::Texture& dest, size_t srcOffset, size_t srcSize, uint32_t arrayIndex, uint32_t mipLevel) override;
+        void Blit(const Nova::Texture& src, const BlitRegion& srcRegion, const Nova::Texture& dest, const BlitRegion& destRegion, Filter filter) override;
+        void Blit(const Nova::Texture& src, const Nova::Texture& dest, Filter filter) override;
+
+        void ExecuteCommandBuffers(const Array<const Nova::CommandBuffer*>& commandBuffers) override;
+
+        // Replays the stream, called by the Null queue on submit
+        void Execute() const;
+
+        const CommandBufferStats& GetStats() const { return m_Stats; }
+        bool IsRecording() const { return m_Recording; }
+
+        // Walks the recorded commands, for tests and debugging tools
+        template<typename Visitor>
+        void ForEachCommand(Visitor&& visitor) const
+        {
+            const uint8_t* command = m_Stream;
+            while (command < m_Stream + m_StreamSize)
+            {
+                const CommandHeader* header = (const CommandHeader*)command;
+                visitor(header->type, (const void*)(header + 1));
+                command += header->size;
+            }
+        }
+    private:
+        struct CommandHeader
+        {
+            CommandType type;
+            uint32_t size;
+        };
+
+        static constexpr uint32_t MaxBindingSets = 8;
+
+        void* Record(CommandType type, size_t payloadSize);
+
+        template<typename T>
+        T* Record(const CommandType type, const size_t extraSize = 0)
+        {
+            return (T*)Record(type, sizeof(T) + extraSize);
+        }
+
+        RenderDevice* m_Device = nullptr;
+        uint8_t* m_Stream = nullptr;
+        size_t m_StreamSize = 0;
+        size_t m_StreamCapacity = 0;
+        bool m_Recording = false;
+        CommandBufferStats m_Stats;
+
+        // Currently bound state, to tell state changes from redundant binds
+        const void* m_Pipeline = nullptr;
+        const void* m_VertexBuffer = nullptr;
+        uint64_t m_VertexBufferOffset = 0;
+        const void* m_IndexBuffer = nullptr;
+        uint64_t m_IndexBufferOffset = 0;
+        const void* m_BindingSets[MaxBindingSets] = {};
+        float m_Viewport[6] = {};
+        int32_t m_Scissor[4] = {};
+    };
+}
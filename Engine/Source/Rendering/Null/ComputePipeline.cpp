@@ -0,0 +1,26 @@
+﻿#include "ComputePipeline.h"
+#include "Shader.h"
+
+namespace Nova::Null
+{
+    bool ComputePipeline::Initialize(const ComputePipelineCreateInfo& createInfo)
+    {
+        if (!createInfo.device)
+            return false;
+
+        if (!createInfo.shader)
+            return false;
+
+        const Shader* shader = (const Shader*)createInfo.shader;
+        if (!shader->GetShaderStageFlags().Contains(ShaderStageFlagBits::Compute))
+            return false;
+
+        m_Device = createInfo.device;
+        return true;
+    }
+
+    void ComputePipeline::Destroy()
+    {
+        m_Device = nullptr;
+    }
+}
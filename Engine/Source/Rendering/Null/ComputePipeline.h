@@ -0,0 +1,12 @@
+﻿#pragma once
+#include "Rendering/ComputePipeline.h"
+
+namespace Nova::Null
+{
+    class ComputePipeline final : public Nova::ComputePipeline
+    {
+    public:
+        bool Initialize(const ComputePipelineCreateInfo& createInfo) override;
+        void Destroy() override;
+    };
+}
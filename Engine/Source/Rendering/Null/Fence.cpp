@@ -0,0 +1,24 @@
+﻿#include "Fence.h"
+
+namespace Nova::Null
+{
+    bool Fence::Initialize(const FenceCreateInfo& createInfo)
+    {
+        m_Signaled = createInfo.flags & FenceCreateFlagBits::Signaled;
+        return true;
+    }
+
+    void Fence::Destroy()
+    {
+    }
+
+    void Fence::Wait(const uint64_t timeout)
+    {
+        (void)timeout;
+    }
+
+    void Fence::Reset()
+    {
+        m_Signaled = false;
+    }
+}
@@ -0,0 +1,20 @@
+﻿#pragma once
+#include "Rendering/Fence.h"
+
+namespace Nova::Null
+{
+    // Work submitted to the Null queue completes on submit, so waiting never blocks
+    class Fence final : public Nova::Fence
+    {
+    public:
+        bool Initialize(const FenceCreateInfo& createInfo) override;
+        void Destroy() override;
+        void Wait(uint64_t timeout) override;
+        void Reset() override;
+
+        void Signal() { m_Signaled = true; }
+        bool IsSignaled() const { return m_Signaled; }
+    private:
+        bool m_Signaled = false;
+    };
+}
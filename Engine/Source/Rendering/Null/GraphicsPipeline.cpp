@@ -0,0 +1,26 @@
+﻿#include "GraphicsPipeline.h"
+#include "Shader.h"
+
+namespace Nova::Null
+{
+    bool GraphicsPipeline::Initialize(const GraphicsPipelineCreateInfo& createInfo)
+    {
+        if (!createInfo.device)
+            return false;
+
+        if (!createInfo.shader)
+            return false;
+
+        const Shader* shader = (const Shader*)createInfo.shader;
+        if (!shader->GetShaderStageFlags().Contains(ShaderStageFlagBits::Vertex))
+            return false;
+
+        m_Device = (RenderDevice*)createInfo.device;
+        return true;
+    }
+
+    void GraphicsPipeline::Destroy()
+    {
+        m_Device = nullptr;
+    }
+}
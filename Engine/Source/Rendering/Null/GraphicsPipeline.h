@@ -0,0 +1,16 @@
+﻿#pragma once
+#include "Rendering/GraphicsPipeline.h"
+
+namespace Nova::Null
+{
+    class RenderDevice;
+
+    class GraphicsPipeline final : public Nova::GraphicsPipeline
+    {
+    public:
+        bool Initialize(const GraphicsPipelineCreateInfo& createInfo) override;
+        void Destroy() override;
+    private:
+        RenderDevice* m_Device = nullptr;
+    };
+}
@@ -0,0 +1,90 @@
+﻿#include "ImGuiRenderer.h"
+#include "RenderDevice.h"
+#include "Runtime/DesktopWindow.h"
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+
+namespace Nova::Null
+{
+    bool ImGuiRenderer::Initialize(const ImGuiRendererCreateInfo& createInfo)
+    {
+        if (!Nova::ImGuiRenderer::Initialize(createInfo))
+            return false;
+
+        if (DesktopWindow* desktopWindow = dynamic_cast<DesktopWindow*>(createInfo.window))
+        {
+            if (!ImGui_ImplGlfw_InitForOther(desktopWindow->GetHandle(), true))
+                return false;
+            m_HasPlatformBackend = true;
+        }
+
+        // There is no texture to upload the font atlas to, building it is enough for ImGui to run
+        ImGuiIO& io = ImGui::GetIO();
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+        m_Device = (RenderDevice*)createInfo.device;
+        return true;
+    }
+
+    void ImGuiRenderer::Destroy()
+    {
+        if (m_HasPlatformBackend)
+            ImGui_ImplGlfw_Shutdown();
+        ImGui::DestroyContext(m_Context);
+        m_HasPlatformBackend = false;
+    }
+
+    void ImGuiRenderer::BeginFrame()
+    {
+        if (m_HasPlatformBackend)
+        {
+            ImGui_ImplGlfw_NewFrame();
+        }
+        else
+        {
+            const Nova::Swapchain* swapchain = m_Device->GetSwapchain();
+            ImGuiIO& io = ImGui::GetIO();
+            io.DisplaySize = ImVec2((float)swapchain->GetWidth(), (float)swapchain->GetHeight());
+            io.DeltaTime = 1.0f / 60.0f;
+        }
+        ImGui::NewFrame();
+    }
+
+    void ImGuiRenderer::EndFrame()
+    {
+        ImGui::EndFrame();
+    }
+
+    void ImGuiRenderer::Render(Nova::CommandBuffer& commandBuffer)
+    {
+        ImGui::Render();
+        const ImDrawData* drawData = ImGui::GetDrawData();
+        if (!drawData) return;
+
+        const uint32_t width = m_Device->GetSwapchain()->GetWidth();
+        const uint32_t height = m_Device->GetSwapchain()->GetHeight();
+        commandBuffer.SetViewport(0, 0, width, height, 0.0f, 1.0f);
+
+        // Same command layout as the real backends: a scissor and an indexed draw per ImGui command
+        for (int listIndex = 0; listIndex < drawData->CmdListsCount; ++listIndex)
+        {
+            const ImDrawList* drawList = drawData->CmdLists[listIndex];
+            for (const ImDrawCmd& drawCommand : drawList->CmdBuffer)
+            {
+                if (drawCommand.UserCallback) continue;
+
+                const ImVec4& clipRect = drawCommand.ClipRect;
+                commandBuffer.SetScissor((int32_t)clipRect.x, (int32_t)clipRect.y, (int32_t)(clipRect.z - clipRect.x), (int32_t)(clipRect.w - clipRect.y));
+                commandBuffer.DrawIndexed(drawCommand.ElemCount, 1, drawCommand.IdxOffset, (int32_t)drawCommand.VtxOffset, 0);
+            }
+        }
+    }
+
+    void ImGuiRenderer::DrawTexture(const Nova::TextureView& texture, const uint32_t width, const uint32_t height)
+    {
+        const ImTextureID textureId = (ImTextureID)(uintptr_t)&texture;
+        ImGui::Image(textureId, ImVec2((float)width, (float)height));
+    }
+}
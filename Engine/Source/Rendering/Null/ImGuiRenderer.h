@@ -0,0 +1,22 @@
+﻿#pragma once
+#include "Rendering/ImGuiRenderer.h"
+
+namespace Nova::Null
+{
+    class RenderDevice;
+
+    // Builds the ImGui frames and records one draw per ImGui draw command, so UI cost shows up in the frame stats
+    class ImGuiRenderer final : public Nova::ImGuiRenderer
+    {
+    public:
+        bool Initialize(const ImGuiRendererCreateInfo& createInfo) override;
+        void Destroy() override;
+        void BeginFrame() override;
+        void EndFrame() override;
+        void Render(CommandBuffer& commandBuffer) override;
+        void DrawTexture(const Nova::TextureView& texture, uint32_t width, uint32_t height) override;
+    private:
+        RenderDevice* m_Device = nullptr;
+        bool m_HasPlatformBackend = false;
+    };
+}
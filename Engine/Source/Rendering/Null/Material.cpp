@@ -0,0 +1,55 @@
+﻿#include "Material.h"
+#include "Rendering/Shader.h"
+#include "Rendering/ShaderBindingSet.h"
+
+namespace Nova::Null
+{
+    static constexpr uint32_t MATERIAL_DESCRIPTOR_SET_INDEX = 0;
+
+    bool Material::Initialize(const MaterialCreateInfo& createInfo)
+    {
+        if (!createInfo.device || !createInfo.shader) return false;
+
+        m_Device = createInfo.device;
+        m_Shader = createInfo.shader;
+
+        if (m_BindingSet) m_BindingSet->Destroy();
+
+        m_BindingSet = m_Shader->CreateBindingSet(MATERIAL_DESCRIPTOR_SET_INDEX);
+        return m_BindingSet != nullptr;
+    }
+
+    void Material::Destroy()
+    {
+        if (m_BindingSet) m_BindingSet->Destroy();
+        m_Shader = nullptr;
+    }
+
+    // Null shaders are not reflected, there is no binding to resolve the names to
+    void Material::SetSampler(const StringView name, Ref<Nova::Sampler> sampler)
+    {
+        (void)name;
+        (void)sampler;
+    }
+
+    void Material::SetTexture(const StringView name, Ref<Nova::Texture> texture)
+    {
+        (void)name;
+        (void)texture;
+    }
+
+    void Material::SetSamplerAndTexture(const StringView name, Ref<Nova::Sampler> sampler, Ref<Nova::Texture> texture)
+    {
+        (void)name;
+        (void)sampler;
+        (void)texture;
+    }
+
+    void Material::SetBuffer(const StringView name, Ref<Nova::Buffer> buffer, const size_t offset, const size_t size)
+    {
+        (void)name;
+        (void)buffer;
+        (void)offset;
+        (void)size;
+    }
+}
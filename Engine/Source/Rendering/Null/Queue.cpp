@@ -0,0 +1,38 @@
+﻿#include "Queue.h"
+#include "CommandBuffer.h"
+#include "Fence.h"
+
+namespace Nova::Null
+{
+    void Queue::Submit(Nova::CommandBuffer* commandBuffer, Nova::Semaphore* waitSemaphore, Nova::Semaphore* signalSemaphore, Nova::Fence* fence, const uint32_t waitStagesMask) const
+    {
+        (void)waitSemaphore;
+        (void)signalSemaphore;
+        (void)waitStagesMask;
+
+        if (commandBuffer)
+            ((const CommandBuffer*)commandBuffer)->Execute();
+        if (fence)
+            ((Fence*)fence)->Signal();
+    }
+
+    void Queue::Submit(const Array<Nova::CommandBuffer*>& commandBuffers, const Array<Nova::Semaphore*>& waitSemaphores, const Array<Nova::Semaphore*>& signalSemaphores, Nova::Fence* fence, const uint32_t waitStagesMask) const
+    {
+        (void)waitSemaphores;
+        (void)signalSemaphores;
+        (void)waitStagesMask;
+
+        for (Nova::CommandBuffer* commandBuffer : commandBuffers)
+            ((const CommandBuffer*)commandBuffer)->Execute();
+        if (fence)
+            ((Fence*)fence)->Signal();
+    }
+
+    bool Queue::Present(const Nova::Swapchain& swapchain, const Nova::Semaphore* waitSemaphore, const uint32_t imageIndex) const
+    {
+        (void)swapchain;
+        (void)waitSemaphore;
+        (void)imageIndex;
+        return true;
+    }
+}
@@ -0,0 +1,15 @@
+﻿#pragma once
+#include "Rendering/Queue.h"
+#include <cstdint>
+
+namespace Nova::Null
+{
+    // Executes command buffers right away on the calling thread
+    class Queue final : public Nova::Queue
+    {
+    public:
+        void Submit(Nova::CommandBuffer* commandBuffer, Nova::Semaphore* waitSemaphore, Nova::Semaphore* signalSemaphore, Nova::Fence* fence = nullptr, uint32_t waitStagesMask = 0) const override;
+        void Submit(const Array<Nova::CommandBuffer*>& commandBuffers, const Array<Nova::Semaphore*>& waitSemaphores, const Array<Nova::Semaphore*>& signalSemaphores, Nova::Fence* fence, uint32_t waitStagesMask) const override;
+        bool Present(const Nova::Swapchain& swapchain, const Nova::Semaphore* waitSemaphore, uint32_t imageIndex) const override;
+    };
+}
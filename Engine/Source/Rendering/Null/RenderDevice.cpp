@@ -1,27 +1,110 @@
 ﻿#include "RenderDevice.h"
+#include "Buffer.h"
+#include "ComputePipeline.h"
+#include "Fence.h"
+#include "GraphicsPipeline.h"
+#include "Material.h"
+#include "Sampler.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "TextureView.h"
+#include "Runtime/Log.h"
+#include "Runtime/Window.h"
 
 namespace Nova::Null
 {
     bool RenderDevice::Initialize(const RenderDeviceCreateInfo& createInfo)
     {
+        m_Window = createInfo.window;
+        m_DeviceVendor = "Null";
+        m_VSync = createInfo.vSync;
+
+        m_Queue.SetQueueType(QueueType::Graphics);
+
+        SwapchainCreateInfo swapchainCreateInfo;
+        swapchainCreateInfo.device = this;
+        swapchainCreateInfo.surface = nullptr;
+        swapchainCreateInfo.recycle = false;
+        swapchainCreateInfo.buffering = createInfo.buffering;
+        swapchainCreateInfo.format = Format::R8G8B8A8_SRGB;
+        swapchainCreateInfo.width = m_Window ? m_Window->GetWidth() : DefaultWidth;
+        swapchainCreateInfo.height = m_Window ? m_Window->GetHeight() : DefaultHeight;
+        swapchainCreateInfo.presentMode = createInfo.vSync ? PresentMode::Fifo : PresentMode::Immediate;
+
+        if (!m_Swapchain.Initialize(swapchainCreateInfo))
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to create swapchain!");
+            return false;
+        }
+
+        for (CommandBuffer& commandBuffer : m_CommandBuffers)
+        {
+            if (!commandBuffer.Allocate({ this, nullptr, CommandBufferLevel::Primary }))
+                return false;
+        }
+
+        BindlessHeapCreateInfo bindlessHeapCreateInfo;
+        bindlessHeapCreateInfo.device = this;
+        if (!m_BindlessHeap.Initialize(bindlessHeapCreateInfo))
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to create bindless heap!");
+            return false;
+        }
+
+        m_ParallelRecording = true;
         return true;
     }
 
     void RenderDevice::Destroy()
     {
+        Nova::RenderDevice::Destroy();
+        for (CommandBuffer& commandBuffer : m_CommandBuffers)
+            commandBuffer.Free();
+
+        for (auto& frameCommandBuffers : m_ThreadCommandBuffers)
+        {
+            for (ThreadCommandBuffers& threadCommandBuffers : frameCommandBuffers)
+            {
+                for (CommandBuffer* commandBuffer : threadCommandBuffers.commandBuffers)
+                    delete commandBuffer;
+                threadCommandBuffers.commandBuffers.Clear();
+                threadCommandBuffers.usedCount = 0;
+            }
+        }
+        m_BindlessHeap.Destroy();
+        m_Swapchain.Destroy();
     }
 
     bool RenderDevice::BeginFrame()
     {
-        return true;
+        if (!m_Swapchain.IsValid())
+        {
+            m_Swapchain.Recreate();
+            m_CurrentFrameIndex = 0;
+            return false;
+        }
+
+        for (ThreadCommandBuffers& threadCommandBuffers : m_ThreadCommandBuffers[m_CurrentFrameIndex])
+            threadCommandBuffers.usedCount = 0;
+        m_BindlessHeap.NewFrame();
+
+        CommandBuffer& commandBuffer = m_CommandBuffers[m_CurrentFrameIndex];
+        return commandBuffer.Begin({ CommandBufferUsageFlagBits::OneTimeSubmit });
     }
 
     void RenderDevice::EndFrame()
     {
+        CommandBuffer& commandBuffer = m_CommandBuffers[m_CurrentFrameIndex];
+        commandBuffer.End();
+        m_LastFrameStats = commandBuffer.GetStats();
+        m_Queue.Submit(&commandBuffer, nullptr, nullptr);
     }
 
     void RenderDevice::Present()
     {
+        if (!m_Queue.Present(m_Swapchain, nullptr, m_CurrentFrameIndex))
+            m_Swapchain.Invalidate();
+        m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % GetImageCount();
     }
 
     void RenderDevice::WaitIdle() const
@@ -38,86 +121,200 @@ namespace Nova::Null
         return RenderDeviceType::Null;
     }
 
-    Ref<Texture> RenderDevice::CreateTexture(const TextureCreateInfo& createInfo)
+    Ref<Nova::Texture> RenderDevice::CreateTexture(const TextureCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        Texture* texture = new Texture();
+        TextureCreateInfo textureCreateInfo(createInfo);
+        textureCreateInfo.device = this;
+        if (!texture->Initialize(textureCreateInfo))
+        {
+            delete texture;
+            return nullptr;
+        }
+        return Ref(texture);
     }
 
-    Ref<Texture> RenderDevice::CreateTextureUnitialized()
+    Ref<Nova::Texture> RenderDevice::CreateTextureUnitialized()
     {
-        return nullptr;
+        return MakeRef<Texture>();
     }
 
     Ref<Nova::TextureView> RenderDevice::CreateTextureView(const TextureViewCreateInfo& createInfo)
     {
-        return nullptr;
+        TextureView* view = new TextureView();
+        TextureViewCreateInfo viewCreateInfo(createInfo);
+        viewCreateInfo.device = this;
+        if (!view->Initialize(viewCreateInfo))
+        {
+            delete view;
+            return nullptr;
+        }
+        return Ref(view);
     }
 
-    Ref<Sampler> RenderDevice::CreateSampler(const SamplerCreateInfo& createInfo)
+    Ref<Nova::Sampler> RenderDevice::CreateSampler(const SamplerCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        Sampler* sampler = new Sampler();
+        SamplerCreateInfo samplerCreateInfo(createInfo);
+        if (!sampler->Initialize(samplerCreateInfo.WithDevice(this)))
+        {
+            delete sampler;
+            return nullptr;
+        }
+        return Ref(sampler);
     }
 
-    Ref<Buffer> RenderDevice::CreateBuffer(const BufferCreateInfo& createInfo)
+    Ref<Nova::Buffer> RenderDevice::CreateBuffer(const BufferCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        Buffer* buffer = new Buffer();
+        BufferCreateInfo bufferCreateInfo(createInfo);
+        if (!buffer->Initialize(bufferCreateInfo.WithDevice(this)))
+        {
+            delete buffer;
+            return nullptr;
+        }
+        return Ref(buffer);
     }
 
-    Ref<Shader> RenderDevice::CreateShader(const ShaderCreateInfo& createInfo)
+    Ref<Nova::Shader> RenderDevice::CreateShader(const ShaderCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        Shader* shader = new Shader();
+        ShaderCreateInfo shaderCreateInfo(createInfo);
+        if (!shader->Initialize(shaderCreateInfo.WithDevice(this)))
+        {
+            delete shader;
+            return nullptr;
+        }
+        return Ref(shader);
     }
 
-    Ref<GraphicsPipeline> RenderDevice::CreateGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo)
+    Ref<Nova::GraphicsPipeline> RenderDevice::CreateGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        GraphicsPipeline* pipeline = new GraphicsPipeline();
+        GraphicsPipelineCreateInfo pipelineCreateInfo(createInfo);
+        if (!pipeline->Initialize(pipelineCreateInfo.SetDevice(this)))
+        {
+            delete pipeline;
+            return nullptr;
+        }
+        return Ref(pipeline);
     }
 
-    Ref<ComputePipeline> RenderDevice::CreateComputePipeline(const ComputePipelineCreateInfo& createInfo)
+    Ref<Nova::ComputePipeline> RenderDevice::CreateComputePipeline(const ComputePipelineCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        ComputePipeline* pipeline = new ComputePipeline();
+        ComputePipelineCreateInfo pipelineCreateInfo(createInfo);
+        if (!pipeline->Initialize(pipelineCreateInfo.WithDevice(this)))
+        {
+            delete pipeline;
+            return nullptr;
+        }
+        return Ref(pipeline);
     }
 
-    Ref<Material> RenderDevice::CreateMaterial(const MaterialCreateInfo& createInfo)
+    Ref<Nova::Material> RenderDevice::CreateMaterial(const MaterialCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        Material* material = new Material();
+        MaterialCreateInfo matCreateInfo(createInfo);
+        if (!material->Initialize(matCreateInfo.WithDevice(this)))
+        {
+            delete material;
+            return nullptr;
+        }
+        return Ref(material);
     }
 
-    Ref<Fence> RenderDevice::CreateFence(const FenceCreateInfo& createInfo)
+    Ref<Nova::Fence> RenderDevice::CreateFence(const FenceCreateInfo& createInfo)
     {
-        (void)createInfo;
-        return nullptr;
+        Fence* fence = new Fence();
+        FenceCreateInfo fenceCreateInfo(createInfo);
+        if (!fence->Initialize(fenceCreateInfo.WithDevice(this)))
+        {
+            delete fence;
+            return nullptr;
+        }
+        return Ref(fence);
     }
 
     uint32_t RenderDevice::GetImageCount() const
     {
-        return 0;
+        return m_Swapchain.GetImageCount();
     }
 
     Ref<Nova::CommandBuffer> RenderDevice::CreateCommandBuffer()
     {
-        return nullptr;
+        CommandBuffer* commandBuffer = new CommandBuffer();
+        if (!commandBuffer->Allocate({ this, nullptr, CommandBufferLevel::Primary }))
+        {
+            delete commandBuffer;
+            return nullptr;
+        }
+        return Ref(commandBuffer);
     }
 
     Ref<Nova::CommandBuffer> RenderDevice::CreateTransferCommandBuffer()
     {
-        return nullptr;
+        return CreateCommandBuffer();
     }
 
     Ref<Nova::CommandBuffer> RenderDevice::CreateComputeCommandBuffer()
     {
-        return nullptr;
+        return CreateCommandBuffer();
     }
 
     uint32_t RenderDevice::GetCurrentFrameIndex() const
     {
-        return 0;
+        return m_CurrentFrameIndex;
+    }
+
+    Nova::Swapchain* RenderDevice::GetSwapchain()
+    {
+        return &m_Swapchain;
+    }
+
+    Queue* RenderDevice::GetGraphicsQueue()
+    {
+        return &m_Queue;
+    }
+
+    Queue* RenderDevice::GetComputeQueue()
+    {
+        return &m_Queue;
+    }
+
+    Queue* RenderDevice::GetTransferQueue()
+    {
+        return &m_Queue;
+    }
+
+    Nova::CommandBuffer* RenderDevice::GetCurrentCommandBuffer()
+    {
+        return &m_CommandBuffers[m_CurrentFrameIndex];
+    }
+
+    Nova::BindlessHeap* RenderDevice::GetBindlessHeap()
+    {
+        return &m_BindlessHeap;
+    }
+
+    Nova::CommandBuffer* RenderDevice::AllocateSecondaryCommandBuffer(const uint32_t threadIndex)
+    {
+        NOVA_ASSERT(threadIndex < MaxRecordingThreads, "Recording thread index out of range!");
+        ThreadCommandBuffers& threadCommandBuffers = m_ThreadCommandBuffers[m_CurrentFrameIndex][threadIndex];
+
+        // Streams keep their capacity, so a thread recording the same amount every frame stops allocating
+        if (threadCommandBuffers.usedCount < threadCommandBuffers.commandBuffers.Count())
+            return threadCommandBuffers.commandBuffers[threadCommandBuffers.usedCount++];
+
+        CommandBuffer* commandBuffer = new CommandBuffer();
+        if (!commandBuffer->Allocate({ this, nullptr, CommandBufferLevel::Secondary }))
+        {
+            delete commandBuffer;
+            return nullptr;
+        }
+
+        threadCommandBuffers.commandBuffers.Add(commandBuffer);
+        threadCommandBuffers.usedCount++;
+        return commandBuffer;
     }
 }
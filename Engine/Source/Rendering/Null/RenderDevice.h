@@ -1,11 +1,27 @@
 ﻿#pragma once
 #include "Rendering/RenderDevice.h"
+#include "BindlessHeap.h"
+#include "CommandBuffer.h"
+#include "Queue.h"
+#include "Swapchain.h"
 
 namespace Nova::Null
 {
+    // Secondary command buffers recorded by one thread for one frame in flight
+    struct ThreadCommandBuffers
+    {
+        Array<CommandBuffer*> commandBuffers;
+        uint32_t usedCount = 0;
+    };
+
+    // Render device that records everything and draws nothing.
+    // Lets the engine run its whole frame without a GPU, for headless runs and CPU side benchmarks of the renderers.
     class RenderDevice final : public Nova::RenderDevice
     {
     public:
+        static constexpr uint32_t DefaultWidth = 1280;
+        static constexpr uint32_t DefaultHeight = 720;
+
         bool Initialize(const RenderDeviceCreateInfo& createInfo) override;
         void Destroy() override;
         bool BeginFrame() override;
@@ -14,20 +30,42 @@ namespace Nova::Null
         void WaitIdle() const override;
         void SetName(StringView name) override;
         RenderDeviceType GetDeviceType() override;
-        Ref<Texture> CreateTexture(const TextureCreateInfo& createInfo) override;
-        Ref<Texture> CreateTextureUnitialized() override;
+        Ref<Nova::Texture> CreateTexture(const TextureCreateInfo& createInfo) override;
+        Ref<Nova::Texture> CreateTextureUnitialized() override;
         Ref<Nova::TextureView> CreateTextureView(const TextureViewCreateInfo& createInfo) override;
-        Ref<Sampler> CreateSampler(const SamplerCreateInfo& createInfo) override;
-        Ref<Buffer> CreateBuffer(const BufferCreateInfo& createInfo) override;
-        Ref<Shader> CreateShader(const ShaderCreateInfo& createInfo) override;
-        Ref<GraphicsPipeline> CreateGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override;
-        Ref<ComputePipeline> CreateComputePipeline(const ComputePipelineCreateInfo& createInfo) override;
-        Ref<Material> CreateMaterial(const MaterialCreateInfo& createInfo) override;
-        Ref<Fence> CreateFence(const FenceCreateInfo& createInfo) override;
+        Ref<Nova::Sampler> CreateSampler(const SamplerCreateInfo& createInfo) override;
+        Ref<Nova::Buffer> CreateBuffer(const BufferCreateInfo& createInfo) override;
+        Ref<Nova::Shader> CreateShader(const ShaderCreateInfo& createInfo) override;
+        Ref<Nova::GraphicsPipeline> CreateGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override;
+        Ref<Nova::ComputePipeline> CreateComputePipeline(const ComputePipelineCreateInfo& createInfo) override;
+        Ref<Nova::Material> CreateMaterial(const MaterialCreateInfo& createInfo) override;
+        Ref<Nova::Fence> CreateFence(const FenceCreateInfo& createInfo) override;
         uint32_t GetImageCount() const override;
         Ref<Nova::CommandBuffer> CreateCommandBuffer() override;
         Ref<Nova::CommandBuffer> CreateTransferCommandBuffer() override;
         Ref<Nova::CommandBuffer> CreateComputeCommandBuffer() override;
         uint32_t GetCurrentFrameIndex() const override;
+
+        Nova::Swapchain* GetSwapchain() override;
+        Queue* GetGraphicsQueue() override;
+        Queue* GetComputeQueue() override;
+        Queue* GetTransferQueue() override;
+        Nova::CommandBuffer* GetCurrentCommandBuffer() override;
+        Nova::CommandBuffer* AllocateSecondaryCommandBuffer(uint32_t threadIndex) override;
+        Nova::BindlessHeap* GetBindlessHeap() override;
+
+        const Window* GetWindow() const { return m_Window; }
+
+        // Stats of the last submitted frame command buffer
+        const CommandBufferStats& GetLastFrameStats() const { return m_LastFrameStats; }
+    private:
+        Window* m_Window = nullptr;
+        Swapchain m_Swapchain;
+        Queue m_Queue;
+        BindlessHeap m_BindlessHeap;
+        CommandBuffer m_CommandBuffers[3];
+        ThreadCommandBuffers m_ThreadCommandBuffers[3][MaxRecordingThreads];
+        CommandBufferStats m_LastFrameStats;
+        uint32_t m_CurrentFrameIndex = 0;
     };
 }
@@ -0,0 +1,30 @@
+﻿#include "Sampler.h"
+#include "Rendering/BindlessHeap.h"
+#include "Rendering/RenderDevice.h"
+
+namespace Nova::Null
+{
+    bool Sampler::Initialize(const SamplerCreateInfo& createInfo)
+    {
+        m_Device = createInfo.device;
+        m_AddressModeU = createInfo.addressModeU;
+        m_AddressModeV = createInfo.addressModeV;
+        m_AddressModeW = createInfo.addressModeW;
+        m_MinFilter = createInfo.minFilter;
+        m_MagFilter = createInfo.magFilter;
+        m_AnisotropyEnable = createInfo.anisotropyEnable;
+        m_CompareEnable = createInfo.compareEnable;
+        m_CompareOp = createInfo.compareOp;
+        m_UnnormalizedCoordinates = createInfo.unnormalizedCoordinates;
+        m_MinLod = createInfo.minLod;
+        m_MaxLod = createInfo.maxLod;
+        m_MipmapFilter = createInfo.mipmapFilter;
+        return true;
+    }
+
+    void Sampler::Destroy()
+    {
+        if (m_Device && GetBindlessIndex() != InvalidBindlessIndex)
+            m_Device->GetBindlessHeap()->Release(*this);
+    }
+}
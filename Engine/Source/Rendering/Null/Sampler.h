@@ -0,0 +1,14 @@
+﻿#pragma once
+#include "Rendering/Sampler.h"
+
+namespace Nova::Null
+{
+    class Sampler final : public Nova::Sampler
+    {
+    public:
+        bool Initialize(const SamplerCreateInfo& createInfo) override;
+        void Destroy() override;
+    private:
+        Nova::RenderDevice* m_Device = nullptr;
+    };
+}
@@ -0,0 +1,59 @@
+﻿#include "Shader.h"
+#include "ShaderBindingSet.h"
+#include "RenderDevice.h"
+
+namespace Nova::Null
+{
+    bool Shader::Initialize(const ShaderCreateInfo& createInfo)
+    {
+        if (!createInfo.device) return false;
+        if (createInfo.entryPoints.IsEmpty()) return false;
+
+        m_Device = (RenderDevice*)createInfo.device;
+        m_StageFlags = ShaderStageFlagBits::None;
+        for (const ShaderEntryPoint& entryPoint : createInfo.entryPoints)
+            m_StageFlags |= entryPoint.stage;
+
+        m_BindingSetLayouts.Clear();
+        for (uint32_t setIndex = 0; setIndex < MaxBindingSets; ++setIndex)
+        {
+            Ref<ShaderBindingSetLayout> setLayout = new ShaderBindingSetLayout();
+            if (!setLayout->Initialize(createInfo.device, setIndex))
+                return false;
+            m_BindingSetLayouts.Add(setLayout);
+        }
+        return true;
+    }
+
+    void Shader::Destroy()
+    {
+        m_BindingSetLayouts.Clear();
+        m_Device = nullptr;
+    }
+
+    Ref<Nova::ShaderBindingSet> Shader::CreateBindingSet(const size_t setIndex) const
+    {
+        if (setIndex >= m_BindingSetLayouts.Count()) return nullptr;
+
+        ShaderBindingSetCreateInfo createInfo;
+        createInfo.device = (Nova::RenderDevice*)m_Device;
+        createInfo.layout = m_BindingSetLayouts[setIndex].Get();
+
+        ShaderBindingSet* bindingSet = new ShaderBindingSet();
+        if (!bindingSet->Initialize(createInfo))
+        {
+            delete bindingSet;
+            return nullptr;
+        }
+
+        return Ref(bindingSet);
+    }
+
+    Array<Ref<Nova::ShaderBindingSet>> Shader::CreateBindingSets() const
+    {
+        Array<Ref<Nova::ShaderBindingSet>> bindingSets;
+        for (size_t setIndex = 0; setIndex < m_BindingSetLayouts.Count(); ++setIndex)
+            bindingSets.Add(CreateBindingSet(setIndex));
+        return bindingSets;
+    }
+}
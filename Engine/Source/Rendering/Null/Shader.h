@@ -0,0 +1,30 @@
+﻿#pragma once
+#include "Rendering/Shader.h"
+#include "ShaderBindingSetLayout.h"
+
+namespace Nova::Null
+{
+    class RenderDevice;
+
+    // Nothing is compiled or reflected, every shader exposes the same empty binding set layouts
+    class Shader final : public Nova::Shader
+    {
+    public:
+        static constexpr uint32_t MaxBindingSets = 4;
+
+        Shader() = default;
+        ~Shader() override = default;
+
+        bool Initialize(const ShaderCreateInfo& createInfo) override;
+        void Destroy() override;
+        Ref<Nova::ShaderBindingSet> CreateBindingSet(size_t setIndex) const override;
+        Array<Ref<Nova::ShaderBindingSet>> CreateBindingSets() const override;
+
+        const Array<Ref<ShaderBindingSetLayout>>& GetBindingSetLayouts() const { return m_BindingSetLayouts; }
+        ShaderStageFlags GetShaderStageFlags() const { return m_StageFlags; }
+    private:
+        RenderDevice* m_Device = nullptr;
+        Array<Ref<ShaderBindingSetLayout>> m_BindingSetLayouts;
+        ShaderStageFlags m_StageFlags = ShaderStageFlagBits::None;
+    };
+}
@@ -0,0 +1,59 @@
+﻿#include "ShaderBindingSet.h"
+#include "Rendering/Buffer.h"
+
+namespace Nova::Null
+{
+    bool ShaderBindingSet::Initialize(const ShaderBindingSetCreateInfo& createInfo)
+    {
+        if (!createInfo.layout) return false;
+        m_BindingSetLayout = (Nova::ShaderBindingSetLayout*)createInfo.layout;
+        return true;
+    }
+
+    void ShaderBindingSet::Destroy()
+    {
+    }
+
+    bool ShaderBindingSet::BindTextures(const uint32_t binding, const Nova::Texture* const* textures, const size_t textureCount, const BindingType bindingType)
+    {
+        (void)binding;
+        (void)bindingType;
+        return textures && textureCount;
+    }
+
+    bool ShaderBindingSet::BindTexture(const uint32_t binding, const Nova::Texture& texture, const BindingType bindingType)
+    {
+        (void)binding;
+        (void)texture;
+        (void)bindingType;
+        return true;
+    }
+
+    bool ShaderBindingSet::BindSampler(const uint32_t binding, const Nova::Sampler& sampler)
+    {
+        (void)binding;
+        (void)sampler;
+        return true;
+    }
+
+    bool ShaderBindingSet::BindCombinedSamplerTexture(const uint32_t binding, const Nova::Sampler& sampler, const Nova::Texture& texture)
+    {
+        (void)binding;
+        (void)sampler;
+        (void)texture;
+        return true;
+    }
+
+    bool ShaderBindingSet::BindCombinedSamplerTextures(const uint32_t binding, const Nova::Sampler& sampler, const Nova::Texture* const* textures, const size_t textureCount)
+    {
+        (void)binding;
+        (void)sampler;
+        return textures && textureCount;
+    }
+
+    bool ShaderBindingSet::BindBuffer(const uint32_t binding, const Nova::Buffer& buffer, const size_t offset, const size_t size)
+    {
+        (void)binding;
+        return offset + size <= buffer.GetSize();
+    }
+}
@@ -0,0 +1,19 @@
+﻿#pragma once
+#include "Rendering/ShaderBindingSet.h"
+
+namespace Nova::Null
+{
+    class ShaderBindingSet final : public Nova::ShaderBindingSet
+    {
+    public:
+        bool Initialize(const ShaderBindingSetCreateInfo& createInfo) override;
+        void Destroy() override;
+
+        bool BindTextures(uint32_t binding, const Nova::Texture* const* textures, size_t textureCount, BindingType bindingType) override;
+        bool BindTexture(uint32_t binding, const Nova::Texture& texture, BindingType bindingType) override;
+        bool BindSampler(uint32_t binding, const Nova::Sampler& sampler) override;
+        bool BindCombinedSamplerTexture(uint32_t binding, const Nova::Sampler& sampler, const Nova::Texture& texture) override;
+        bool BindCombinedSamplerTextures(uint32_t binding, const Nova::Sampler& sampler, const Nova::Texture* const* textures, size_t textureCount) override;
+        bool BindBuffer(uint32_t binding, const Nova::Buffer& buffer, size_t offset, size_t size) override;
+    };
+}
@@ -0,0 +1,20 @@
+﻿#include "ShaderBindingSetLayout.h"
+
+namespace Nova::Null
+{
+    bool ShaderBindingSetLayout::Initialize(Nova::RenderDevice* device, const uint32_t setIndex)
+    {
+        if (!device) return false;
+        m_SetIndex = setIndex;
+        return true;
+    }
+
+    void ShaderBindingSetLayout::Destroy()
+    {
+    }
+
+    bool ShaderBindingSetLayout::Build()
+    {
+        return true;
+    }
+}
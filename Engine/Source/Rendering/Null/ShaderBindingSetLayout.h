@@ -0,0 +1,13 @@
+﻿#pragma once
+#include "Rendering/ShaderBindingSetLayout.h"
+
+namespace Nova::Null
+{
+    class ShaderBindingSetLayout final : public Nova::ShaderBindingSetLayout
+    {
+    public:
+        bool Initialize(Nova::RenderDevice* device, uint32_t setIndex) override;
+        void Destroy() override;
+        bool Build() override;
+    };
+}
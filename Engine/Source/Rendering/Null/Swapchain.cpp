@@ -0,0 +1,86 @@
+﻿#include "Swapchain.h"
+#include "RenderDevice.h"
+#include "Runtime/Window.h"
+
+namespace Nova::Null
+{
+    bool Swapchain::Initialize(const SwapchainCreateInfo& createInfo)
+    {
+        if (createInfo.width == 0 || createInfo.height == 0)
+            return false;
+
+        const uint32_t imageCount = (uint32_t)createInfo.buffering;
+        if (imageCount == 0 || imageCount > 3)
+            return false;
+
+        TextureCreateInfo textureCreateInfo = TextureCreateInfo::Texture2D(createInfo.width, createInfo.height, createInfo.format);
+        textureCreateInfo.device = createInfo.device;
+        textureCreateInfo.usageFlags = TextureUsageFlagBits::ColorAttachment;
+
+        for (uint32_t imageIndex = 0; imageIndex < imageCount; ++imageIndex)
+        {
+            if (!m_Textures[imageIndex].Initialize(textureCreateInfo))
+                return false;
+        }
+
+        m_Device = createInfo.device;
+        m_Surface = createInfo.surface;
+        m_ImageFormat = createInfo.format;
+        m_Buffering = createInfo.buffering;
+        m_ImagePresentMode = createInfo.presentMode;
+        m_ImageWidth = createInfo.width;
+        m_ImageHeight = createInfo.height;
+        m_HasVSync = createInfo.presentMode == PresentMode::Fifo;
+        m_Valid = true;
+        return true;
+    }
+
+    void Swapchain::Destroy()
+    {
+        for (Texture& texture : m_Textures)
+            texture.Destroy();
+    }
+
+    bool Swapchain::Recreate()
+    {
+        const RenderDevice* device = (RenderDevice*)m_Device;
+        const Window* window = device->GetWindow();
+
+        SwapchainCreateInfo createInfo;
+        createInfo.device = m_Device;
+        createInfo.surface = m_Surface;
+        createInfo.width = window ? window->GetWidth() : m_ImageWidth;
+        createInfo.height = window ? window->GetHeight() : m_ImageHeight;
+        createInfo.format = m_ImageFormat;
+        createInfo.buffering = m_Buffering;
+        createInfo.presentMode = m_ImagePresentMode;
+        createInfo.recycle = true;
+
+        // A minimized window has no area, keep the current images until it comes back
+        if (createInfo.width == 0 || createInfo.height == 0)
+            return false;
+
+        const bool shouldBroadcast = m_ImageWidth != createInfo.width || m_ImageHeight != createInfo.height;
+        if (!Initialize(createInfo))
+            return false;
+
+        if (shouldBroadcast)
+            ResizedEvent.Broadcast(createInfo.width, createInfo.height);
+        return true;
+    }
+
+    void Swapchain::SetName(StringView name)
+    {
+        (void)name;
+    }
+
+    const Nova::Texture* Swapchain::GetTexture()
+    {
+        return &m_Textures[m_Device->GetCurrentFrameIndex()];
+    }
+
+    const Nova::TextureView* Swapchain::GetTextureView()
+    {
+        return GetTexture()->GetView().Get();
+    }
+}
@@ -0,0 +1,24 @@
+﻿#pragma once
+#include "Texture.h"
+#include "TextureView.h"
+#include "Rendering/Swapchain.h"
+
+namespace Nova::Null
+{
+    class RenderDevice;
+
+    // Swapchain images are plain Null textures sized after the window, or a fixed size when running without one
+    class Swapchain final : public Nova::Swapchain
+    {
+    public:
+        bool Initialize(const SwapchainCreateInfo& createInfo) override;
+        void Destroy() override;
+        bool Recreate() override;
+        void SetName(StringView name) override;
+
+        const Nova::Texture* GetTexture() override;
+        const Nova::TextureView* GetTextureView() override;
+    private:
+        Texture m_Textures[3];
+    };
+}
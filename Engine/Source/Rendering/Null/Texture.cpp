@@ -0,0 +1,87 @@
+﻿#include "Texture.h"
+#include "TextureView.h"
+#include "RenderDevice.h"
+#include "Rendering/BindlessHeap.h"
+#include "Utils/TextureUtils.h"
+
+namespace Nova::Null
+{
+    bool Texture::Initialize(const TextureCreateInfo& createInfo)
+    {
+        if (createInfo.format == Format::None) return false;
+        if (createInfo.sampleCount <= 0) return false;
+        if (createInfo.mipCount <= 0) return false;
+        if (createInfo.width <= 0 || createInfo.height <= 0) return false;
+        if (createInfo.arrayCount <= 0) return false;
+        if (createInfo.depth == 0) return false;
+
+        RenderDevice* device = static_cast<RenderDevice*>(createInfo.device);
+        // Recreated in place, the previous description stops counting
+        if (m_Device)
+            m_Device->GetResidencyManager().OnFree(GetMemoryCategory(), GetSize());
+
+        const auto& usageFlags = createInfo.usageFlags;
+        const bool isColorAttachment = usageFlags & TextureUsageFlagBits::ColorAttachment;
+        const bool isDepthAttachment = usageFlags & TextureUsageFlagBits::DepthStencilAttachment;
+        const bool isSampled = usageFlags & TextureUsageFlagBits::Sampled;
+
+        TextureAspectFlags aspectFlags = TextureAspectFlags::None();
+        if (isColorAttachment || isSampled) aspectFlags |= TextureAspectFlagBits::Color;
+        if (isDepthAttachment)
+        {
+            aspectFlags |= TextureAspectFlagBits::Depth;
+            aspectFlags |= TextureAspectFlagBits::Stencil;
+        }
+
+        m_Device = device;
+        m_Format = createInfo.format;
+        m_Width = createInfo.width;
+        m_Height = createInfo.height;
+        m_Depth = createInfo.depth;
+        m_Mips = createInfo.mipCount;
+        m_ArrayCount = createInfo.arrayCount;
+        m_SampleCount = createInfo.sampleCount;
+        m_UsageFlags = createInfo.usageFlags;
+        m_Dimension = TextureUtils::GetTextureDimension(createInfo.width, createInfo.height, createInfo.depth);
+        m_State = isColorAttachment ? ResourceState::ColorAttachment :
+            isDepthAttachment ? ResourceState::DepthStencilAttachment :
+            isSampled ? ResourceState::ShaderRead : ResourceState::General;
+
+        TextureViewCreateInfo tvCreateInfo;
+        tvCreateInfo.device = device;
+        tvCreateInfo.texture = this;
+        tvCreateInfo.width = createInfo.width;
+        tvCreateInfo.height = createInfo.height;
+        tvCreateInfo.depth = createInfo.depth;
+        tvCreateInfo.format = createInfo.format;
+        tvCreateInfo.baseMipLevel = 0;
+        tvCreateInfo.mipCount = createInfo.mipCount;
+        tvCreateInfo.baseArray = 0;
+        tvCreateInfo.arrayCount = createInfo.arrayCount;
+        tvCreateInfo.aspectFlags = aspectFlags;
+
+        // Nothing is allocated, the estimate keeps the residency manager meaningful on this device
+        device->GetResidencyManager().OnAllocate(GetMemoryCategory(), GetSize());
+
+        if (m_View)
+            return m_View->Initialize(tvCreateInfo);
+
+        m_View = device->CreateTextureView(tvCreateInfo);
+        return m_View != nullptr;
+    }
+
+    void Texture::Destroy()
+    {
+        if (m_View) m_View->Destroy();
+        if (m_Device && GetBindlessIndex() != InvalidBindlessIndex)
+            m_Device->GetBindlessHeap()->Release(*this);
+        if (m_Device)
+            m_Device->GetResidencyManager().OnFree(GetMemoryCategory(), GetSize());
+        m_Device = nullptr;
+    }
+
+    bool Texture::IsValid()
+    {
+        return m_Device && m_Format != Format::None;
+    }
+}
@@ -0,0 +1,23 @@
+﻿#pragma once
+#include "Rendering/Texture.h"
+
+namespace Nova::Null
+{
+    class RenderDevice;
+    class Swapchain;
+
+    // Texture description without any storage, uploads to it are only counted
+    class Texture final : public Nova::Texture
+    {
+    public:
+        Texture() = default;
+        ~Texture() override = default;
+
+        bool Initialize(const TextureCreateInfo& createInfo) override;
+        void Destroy() override;
+        bool IsValid() override;
+    private:
+        friend Swapchain;
+        RenderDevice* m_Device = nullptr;
+    };
+}
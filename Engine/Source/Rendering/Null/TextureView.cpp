@@ -0,0 +1,25 @@
+﻿#include "TextureView.h"
+
+namespace Nova::Null
+{
+    bool TextureView::Initialize(const TextureViewCreateInfo& createInfo)
+    {
+        if (!createInfo.texture) return false;
+
+        m_Device = createInfo.device;
+        m_Texture = createInfo.texture;
+        m_Format = createInfo.format;
+        m_AspectFlags = createInfo.aspectFlags;
+        m_Width = createInfo.width;
+        m_Height = createInfo.height;
+        m_Depth = createInfo.depth;
+        m_BaseMipLevel = createInfo.baseMipLevel;
+        m_MipCount = createInfo.mipCount;
+        return true;
+    }
+
+    void TextureView::Destroy()
+    {
+        m_Texture = nullptr;
+    }
+}
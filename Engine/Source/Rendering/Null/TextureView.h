@@ -0,0 +1,12 @@
+﻿#pragma once
+#include "Rendering/TextureView.h"
+
+namespace Nova::Null
+{
+    class TextureView final : public Nova::TextureView
+    {
+    public:
+        bool Initialize(const TextureViewCreateInfo& createInfo) override;
+        void Destroy() override;
+    };
+}
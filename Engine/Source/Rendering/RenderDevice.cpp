@@ -7,6 +7,7 @@
 #include "ResourceBarrier.h"
 #include "Shader.h"
 #include "Runtime/Common.h"
+#include "Null/RenderDevice.h"
 
 #ifdef NOVA_HAS_VULKAN
 #include "Vulkan/RenderDevice.h"
@@ -42,7 +43,16 @@ namespace Nova
         RenderDevice* device = nullptr;
         switch (type)
         {
-        case RenderDeviceType::Null: return nullptr;
+        case RenderDeviceType::Null:
+            {
+                device = new Null::RenderDevice();
+                if (!device->Initialize(createInfo))
+                {
+                    delete device;
+                    return nullptr;
+                }
+            }
+            break;
 #ifdef NOVA_HAS_VULKAN
         case RenderDeviceType::Vulkan:
             {
@@ -86,6 +96,8 @@ namespace Nova
 
     void RenderDevice::Destroy()
     {
+        m_ResidencyManager.Destroy();
+        m_GeometryBuffer.Destroy();
         for (auto& [_, sampler] : m_Samplers)
             sampler->Destroy();
     }
@@ -162,6 +174,18 @@ namespace Nova
         return m_Samplers[createInfo];
     }
 
+    GeometryBuffer& RenderDevice::GetGeometryBuffer()
+    {
+        // Meshes may load from several threads, the first one creates it
+        std::call_once(m_GeometryBufferInitialized, [this]
+        {
+            GeometryBufferCreateInfo createInfo;
+            createInfo.device = this;
+            m_GeometryBuffer.Initialize(createInfo);
+        });
+        return m_GeometryBuffer;
+    }
+
     void RenderDevice::ImmediateTextureBarrier(RenderDevice* device, const TextureBarrier& barrier)
     {
         if (!device) return;
@@ -11,8 +11,11 @@
 #include "BufferUsage.h"
 #include "TextureUsage.h"
 #include "Sampler.h"
+#include "GeometryBuffer.h"
+#include "ResidencyManager.h"
 
 #include <cstdint>
+#include <mutex>
 
 NOVA_DECLARE_LOG_CATEGORY_STATIC(RenderDevice, "RENDER DEVICE")
 
@@ -42,6 +45,7 @@ namespace Nova
     class TextureView;
     struct TextureViewCreateInfo;
     class Queue;
+    class BindlessHeap;
     struct TextureBarrier;
 
     struct RenderDeviceCreateInfo
@@ -55,9 +59,13 @@ namespace Nova
     class RenderDevice : public RefCounted
     {
     public:
+        // Thread indices passed to AllocateSecondaryCommandBuffer must be below this
+        static constexpr uint32_t MaxRecordingThreads = 64;
+
         RenderDevice()
         {
             if (!s_Instance) s_Instance = this;
+            m_ResidencyManager.Initialize({ this });
         }
 
         ~RenderDevice() override { s_Instance = nullptr; }
@@ -91,6 +99,24 @@ namespace Nova
         virtual Ref<Nova::Fence> CreateFence(const FenceCreateInfo& createInfo) = 0;
         virtual Nova::CommandBuffer* GetCurrentCommandBuffer() { return nullptr; }
 
+        // Secondary command buffer recorded by the given worker thread during the current frame.
+        // Each thread index has its own pools per frame in flight so threads never share one, the buffers are
+        // recycled once their frame completed. Returns nullptr when the device records everything on one thread.
+        virtual Nova::CommandBuffer* AllocateSecondaryCommandBuffer(uint32_t threadIndex) { (void)threadIndex; return nullptr; }
+        bool SupportsParallelRecording() const { return m_ParallelRecording; }
+
+        // Descriptor heap shared by every shader importing Bindless.slang, nullptr when the device has none
+        virtual Nova::BindlessHeap* GetBindlessHeap() { return nullptr; }
+
+        // Vertex and index buffers shared by every static mesh
+        GeometryBuffer& GetGeometryBuffer();
+
+        // Device memory accounting and texture streaming shared by every backend
+        ResidencyManager& GetResidencyManager() { return m_ResidencyManager; }
+
+        // Fills one entry per memory heap, returns false when the device cannot report budgets
+        virtual bool GetMemoryHeapBudgets(Array<DeviceHeapBudget>& heaps) const { (void)heaps; return false; }
+
         Ref<Nova::RenderTarget> CreateRenderTarget(const RenderTargetCreateInfo& createInfo);
         Ref<Nova::Fence> CreateFence();
         Ref<Nova::Buffer> CreateBuffer(BufferUsage usage, size_t size);
@@ -116,8 +142,12 @@ namespace Nova
     protected:
         String m_DeviceVendor;
         bool m_VSync = false;
+        bool m_ParallelRecording = false;
     private:
         Map<SamplerCreateInfo, Ref<Nova::Sampler>> m_Samplers;
+        GeometryBuffer m_GeometryBuffer;
+        std::once_flag m_GeometryBufferInitialized;
+        ResidencyManager m_ResidencyManager;
         static inline RenderDevice* s_Instance = nullptr;
     };
 
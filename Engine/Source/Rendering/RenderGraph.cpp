@@ -0,0 +1,619 @@
+﻿#include "RenderGraph.h"
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "RenderDevice.h"
+#include "Texture.h"
+#include "Containers/StringFormat.h"
+#include "Runtime/Log.h"
+#include "Runtime/LogCategory.h"
+
+NOVA_DECLARE_LOG_CATEGORY_STATIC(RenderGraph, "RENDER GRAPH")
+
+namespace Nova
+{
+    static constexpr uint32_t NoPass = ~0u;
+    static constexpr uint32_t NoPhysicalTexture = ~0u;
+
+    static void HashCombine(uint64_t& hash, const uint64_t value)
+    {
+        hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    }
+
+    static bool IsWriteState(const ResourceState state)
+    {
+        switch (state)
+        {
+        case ResourceState::General:
+        case ResourceState::ShaderWrite:
+        case ResourceState::ColorAttachment:
+        case ResourceState::DepthStencilAttachment:
+        case ResourceState::TransferDest:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static const char* GetResourceStateName(const ResourceState state)
+    {
+        switch (state)
+        {
+        case ResourceState::Undefined: return "Undefined";
+        case ResourceState::General: return "General";
+        case ResourceState::ShaderRead: return "ShaderRead";
+        case ResourceState::ShaderWrite: return "ShaderWrite";
+        case ResourceState::ColorAttachment: return "ColorAttachment";
+        case ResourceState::DepthStencilAttachment: return "DepthStencilAttachment";
+        case ResourceState::TransferSource: return "TransferSource";
+        case ResourceState::TransferDest: return "TransferDest";
+        case ResourceState::Present: return "Present";
+        default: return "Unknown";
+        }
+    }
+
+    bool RenderGraphTextureDesc::operator==(const RenderGraphTextureDesc& other) const
+    {
+        return format == other.format
+            && width == other.width
+            && height == other.height
+            && sampleCount == other.sampleCount
+            && usageFlags == other.usageFlags;
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::Read(const RenderGraphHandle resource, const ResourceState state)
+    {
+        NOVA_ASSERT(resource < m_Graph.m_Resources.Count(), "Invalid render graph resource!");
+        m_Graph.m_Accesses.Add({ resource, state, false });
+        m_Graph.m_Passes[m_PassIndex].accessCount++;
+        return *this;
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::Write(const RenderGraphHandle resource, const ResourceState state)
+    {
+        NOVA_ASSERT(resource < m_Graph.m_Resources.Count(), "Invalid render graph resource!");
+        m_Graph.m_Accesses.Add({ resource, state, true });
+        m_Graph.m_Passes[m_PassIndex].accessCount++;
+        return *this;
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::SetSideEffects()
+    {
+        m_Graph.m_Passes[m_PassIndex].sideEffects = true;
+        return *this;
+    }
+
+    RenderGraph::~RenderGraph()
+    {
+        Destroy();
+    }
+
+    bool RenderGraph::Initialize(RenderDevice* device)
+    {
+        if (!device) return false;
+        m_Device = device;
+        return true;
+    }
+
+    void RenderGraph::Destroy()
+    {
+        Reset();
+        for (PhysicalTexture& physicalTexture : m_PhysicalTextures)
+        {
+            if (!physicalTexture.texture) continue;
+            physicalTexture.texture->Destroy();
+            physicalTexture.texture = nullptr;
+        }
+        m_PhysicalTextures.Clear();
+        m_IsCompiled = false;
+        m_TopologyHash = 0;
+        m_Device = nullptr;
+    }
+
+    void RenderGraph::Reset()
+    {
+        m_Resources.Clear();
+        m_Passes.Clear();
+        m_Accesses.Clear();
+    }
+
+    RenderGraphHandle RenderGraph::CreateTexture(const Name name, const RenderGraphTextureDesc& desc)
+    {
+        NOVA_ASSERT(desc.width != 0 && desc.height != 0, "Render graph textures can't be empty!");
+        Resource resource;
+        resource.name = name;
+        resource.type = ResourceType::Texture;
+        resource.desc = desc;
+        m_Resources.Add(resource);
+        return (RenderGraphHandle)m_Resources.Count() - 1;
+    }
+
+    RenderGraphHandle RenderGraph::ImportTexture(const Name name, Texture* texture, const ResourceState finalState)
+    {
+        if (!texture) return InvalidRenderGraphHandle;
+
+        Resource resource;
+        resource.name = name;
+        resource.type = ResourceType::Texture;
+        resource.imported = true;
+        resource.finalState = finalState;
+        resource.desc = { texture->GetFormat(), texture->GetWidth(), texture->GetHeight(), texture->GetSampleCount(), texture->GetUsageFlags() };
+        resource.texture = texture;
+        m_Resources.Add(resource);
+        return (RenderGraphHandle)m_Resources.Count() - 1;
+    }
+
+    RenderGraphHandle RenderGraph::ImportBuffer(const Name name, Buffer* buffer)
+    {
+        if (!buffer) return InvalidRenderGraphHandle;
+
+        Resource resource;
+        resource.name = name;
+        resource.type = ResourceType::Buffer;
+        resource.imported = true;
+        resource.buffer = buffer;
+        m_Resources.Add(resource);
+        return (RenderGraphHandle)m_Resources.Count() - 1;
+    }
+
+    RenderGraphBuilder RenderGraph::AddPass(const Name name, const RenderGraphExecuteFunc& execute)
+    {
+        Pass pass;
+        pass.name = name;
+        pass.execute = execute;
+        pass.firstAccess = (uint32_t)m_Accesses.Count();
+        m_Passes.Add(pass);
+        return RenderGraphBuilder(*this, (uint32_t)m_Passes.Count() - 1);
+    }
+
+    bool RenderGraph::Compile()
+    {
+        if (!m_Device) return false;
+
+        const uint64_t topologyHash = ComputeTopologyHash();
+        if (m_IsCompiled && topologyHash == m_TopologyHash)
+            return true;
+
+        m_IsCompiled = false;
+        m_CompiledPasses.Clear();
+        m_Transitions.Clear();
+        m_CulledPasses.Clear();
+
+        const size_t resourceCount = m_Resources.Count();
+        Array<bool> livePasses;
+        CullPasses(livePasses);
+
+        Array<uint32_t> firstUses;
+        Array<uint32_t> lastUses;
+        for (size_t resourceIndex = 0; resourceIndex < resourceCount; resourceIndex++)
+        {
+            firstUses.Add(NoPass);
+            lastUses.Add(0);
+        }
+
+        for (uint32_t passIndex = 0; passIndex < m_Passes.Count(); passIndex++)
+        {
+            if (!livePasses[passIndex])
+            {
+                m_CulledPasses.Add(passIndex);
+                continue;
+            }
+
+            const uint32_t compiledIndex = (uint32_t)m_CompiledPasses.Count();
+            m_CompiledPasses.Add({ passIndex, 0, 0 });
+
+            const Pass& pass = m_Passes[passIndex];
+            for (uint32_t accessIndex = pass.firstAccess; accessIndex < pass.firstAccess + pass.accessCount; accessIndex++)
+            {
+                const RenderGraphHandle resource = m_Accesses[accessIndex].resource;
+                if (firstUses[resource] == NoPass)
+                    firstUses[resource] = compiledIndex;
+                lastUses[resource] = compiledIndex;
+            }
+        }
+
+        if (!AssignPhysicalTextures(firstUses, lastUses))
+            return false;
+
+        // States are tracked per physical resource, transient textures sharing a texture share its state
+        const auto getStateIndex = [this, resourceCount](const RenderGraphHandle resource) -> size_t
+        {
+            const uint32_t physicalIndex = m_PhysicalIndices[resource];
+            return physicalIndex == NoPhysicalTexture ? resource : resourceCount + physicalIndex;
+        };
+
+        Array<ResourceState> states;
+        Array<bool> knownStates;
+        for (size_t stateIndex = 0; stateIndex < resourceCount + m_PhysicalTextures.Count(); stateIndex++)
+        {
+            states.Add(ResourceState::Undefined);
+            knownStates.Add(false);
+        }
+
+        for (CompiledPass& compiledPass : m_CompiledPasses)
+        {
+            const Pass& pass = m_Passes[compiledPass.passIndex];
+            compiledPass.firstTransition = (uint32_t)m_Transitions.Count();
+
+            for (uint32_t accessIndex = pass.firstAccess; accessIndex < pass.firstAccess + pass.accessCount; accessIndex++)
+            {
+                const Access& access = m_Accesses[accessIndex];
+                const size_t stateIndex = getStateIndex(access.resource);
+
+                // A resource both read and written by a pass is transitioned once, to the state it is written in
+                bool merged = false;
+                for (uint32_t transitionIndex = compiledPass.firstTransition; transitionIndex < m_Transitions.Count(); transitionIndex++)
+                {
+                    Transition& transition = m_Transitions[transitionIndex];
+                    if (getStateIndex(transition.resource) != stateIndex) continue;
+                    if (access.write) transition.state = access.state;
+                    states[stateIndex] = transition.state;
+                    merged = true;
+                    break;
+                }
+                if (merged) continue;
+
+                // Reading again in the same state needs no synchronization, writing always does
+                if (knownStates[stateIndex] && states[stateIndex] == access.state && !IsWriteState(access.state))
+                    continue;
+
+                const bool firstUse = !knownStates[stateIndex] && m_Resources[access.resource].imported;
+                m_Transitions.Add({ access.resource, access.state, firstUse });
+                states[stateIndex] = access.state;
+                knownStates[stateIndex] = true;
+            }
+
+            compiledPass.transitionCount = (uint32_t)m_Transitions.Count() - compiledPass.firstTransition;
+        }
+
+        CompiledPass finalTransitions = { NoPass, (uint32_t)m_Transitions.Count(), 0 };
+        for (RenderGraphHandle resource = 0; resource < resourceCount; resource++)
+        {
+            const Resource& declared = m_Resources[resource];
+            if (!declared.imported || declared.type != ResourceType::Texture) continue;
+            if (declared.finalState == ResourceState::Undefined) continue;
+            m_Transitions.Add({ resource, declared.finalState, !knownStates[resource] });
+            finalTransitions.transitionCount++;
+        }
+        if (finalTransitions.transitionCount)
+            m_CompiledPasses.Add(finalTransitions);
+
+        m_Stats.passCount = (uint32_t)(m_Passes.Count() - m_CulledPasses.Count());
+        m_Stats.culledPassCount = (uint32_t)m_CulledPasses.Count();
+        m_Stats.compileCount++;
+        m_TopologyHash = topologyHash;
+        m_IsCompiled = true;
+
+        NOVA_LOG(RenderGraph, Verbosity::Trace, "Compiled {} passes ({} culled), {} transient textures in {} physical textures, {} bytes saved",
+            m_Stats.passCount, m_Stats.culledPassCount, m_Stats.transientTextureCount, m_Stats.physicalTextureCount, m_Stats.GetSavedMemory());
+        return true;
+    }
+
+    void RenderGraph::Execute(CommandBuffer& cmdBuffer)
+    {
+        NOVA_ASSERT(m_IsCompiled, "Render graph must be compiled before being executed!");
+        if (!m_IsCompiled) return;
+
+        const size_t resourceCount = m_Resources.Count();
+        const auto getStateIndex = [this, resourceCount](const RenderGraphHandle resource) -> size_t
+        {
+            const uint32_t physicalIndex = m_PhysicalIndices[resource];
+            return physicalIndex == NoPhysicalTexture ? resource : resourceCount + physicalIndex;
+        };
+
+        m_TrackedStates.Clear();
+        for (const Resource& resource : m_Resources)
+        {
+            const ResourceState state = resource.texture ? resource.texture->GetState()
+                : resource.buffer ? resource.buffer->GetState()
+                : ResourceState::Undefined;
+            m_TrackedStates.Add(state);
+        }
+
+        for (const PhysicalTexture& physicalTexture : m_PhysicalTextures)
+            m_TrackedStates.Add(physicalTexture.texture ? physicalTexture.texture->GetState() : ResourceState::Undefined);
+
+        // The batches point into the barrier arrays, so every barrier of the frame is gathered before recording
+        m_TextureBarriers.Clear();
+        m_BufferBarriers.Clear();
+        m_BarrierBatches.Clear();
+        for (const CompiledPass& compiledPass : m_CompiledPasses)
+        {
+            MemoryBarrier batch;
+            for (uint32_t transitionIndex = compiledPass.firstTransition; transitionIndex < compiledPass.firstTransition + compiledPass.transitionCount; transitionIndex++)
+            {
+                const Transition& transition = m_Transitions[transitionIndex];
+                ResourceState& currentState = m_TrackedStates[getStateIndex(transition.resource)];
+
+                // Whoever left an imported resource in the state the graph wants it in already made it visible
+                if (currentState == transition.state && (transition.firstUse || !IsWriteState(transition.state)))
+                    continue;
+
+                if (Texture* texture = GetTexture(transition.resource))
+                {
+                    TextureBarrier barrier;
+                    barrier.texture = texture;
+                    barrier.destState = transition.state;
+                    barrier.sourceAccess = GetSourceAccessFlags(currentState);
+                    barrier.destAccess = GetDestAccessFlags(transition.state);
+                    m_TextureBarriers.Add(barrier);
+                    batch.textureBarrierCount++;
+                }
+                else if (Buffer* buffer = GetBuffer(transition.resource))
+                {
+                    BufferBarrier barrier;
+                    barrier.buffer = buffer;
+                    barrier.offset = 0;
+                    barrier.size = buffer->GetSize();
+                    barrier.destState = transition.state;
+                    barrier.sourceAccess = GetSourceAccessFlags(currentState);
+                    barrier.destAccess = GetDestAccessFlags(transition.state);
+                    m_BufferBarriers.Add(barrier);
+                    batch.bufferBarrierCount++;
+                }
+                currentState = transition.state;
+            }
+            m_BarrierBatches.Add(batch);
+        }
+
+        m_Stats.barrierCount = (uint32_t)(m_TextureBarriers.Count() + m_BufferBarriers.Count());
+        m_Stats.barrierBatchCount = 0;
+
+        uint32_t textureBarrierOffset = 0;
+        uint32_t bufferBarrierOffset = 0;
+        for (size_t compiledIndex = 0; compiledIndex < m_CompiledPasses.Count(); compiledIndex++)
+        {
+            MemoryBarrier& batch = m_BarrierBatches[compiledIndex];
+            if (batch.textureBarrierCount || batch.bufferBarrierCount)
+            {
+                batch.textureBarriers = batch.textureBarrierCount ? m_TextureBarriers.Data() + textureBarrierOffset : nullptr;
+                batch.bufferBarriers = batch.bufferBarrierCount ? m_BufferBarriers.Data() + bufferBarrierOffset : nullptr;
+                cmdBuffer.MemoryBarrier(batch);
+
+                // Not every backend updates the states when recording a memory barrier
+                for (uint32_t index = 0; index < batch.textureBarrierCount; index++)
+                    batch.textureBarriers[index].texture->SetState(batch.textureBarriers[index].destState);
+                for (uint32_t index = 0; index < batch.bufferBarrierCount; index++)
+                    batch.bufferBarriers[index].buffer->SetState(batch.bufferBarriers[index].destState);
+
+                textureBarrierOffset += batch.textureBarrierCount;
+                bufferBarrierOffset += batch.bufferBarrierCount;
+                m_Stats.barrierBatchCount++;
+            }
+
+            const uint32_t passIndex = m_CompiledPasses[compiledIndex].passIndex;
+            if (passIndex == NoPass) continue;
+
+            const Pass& pass = m_Passes[passIndex];
+            if (pass.execute) pass.execute(*this, cmdBuffer);
+        }
+    }
+
+    Texture* RenderGraph::GetTexture(const RenderGraphHandle handle) const
+    {
+        if (handle >= m_Resources.Count()) return nullptr;
+        const Resource& resource = m_Resources[handle];
+        if (resource.type != ResourceType::Texture) return nullptr;
+        if (resource.imported) return resource.texture;
+
+        if (handle >= m_PhysicalIndices.Count()) return nullptr;
+        const uint32_t physicalIndex = m_PhysicalIndices[handle];
+        if (physicalIndex == NoPhysicalTexture) return nullptr;
+        return m_PhysicalTextures[physicalIndex].texture.Get();
+    }
+
+    Buffer* RenderGraph::GetBuffer(const RenderGraphHandle handle) const
+    {
+        if (handle >= m_Resources.Count()) return nullptr;
+        return m_Resources[handle].buffer;
+    }
+
+    String RenderGraph::Dump() const
+    {
+        if (!m_IsCompiled) return "Render graph not compiled\n";
+
+        String result = StringFormat("Render graph: {} passes, {} culled, {} barriers in {} batches last frame\n",
+            m_Stats.passCount, m_Stats.culledPassCount, m_Stats.barrierCount, m_Stats.barrierBatchCount);
+
+        for (const CompiledPass& compiledPass : m_CompiledPasses)
+        {
+            const StringView passName = compiledPass.passIndex == NoPass ? StringView("<final transitions>") : m_Passes[compiledPass.passIndex].name.GetString();
+            result.Append(StringFormat("  {}\n", passName));
+
+            for (uint32_t transitionIndex = compiledPass.firstTransition; transitionIndex < compiledPass.firstTransition + compiledPass.transitionCount; transitionIndex++)
+            {
+                const Transition& transition = m_Transitions[transitionIndex];
+                const Resource& resource = m_Resources[transition.resource];
+                const uint32_t physicalIndex = m_PhysicalIndices[transition.resource];
+                if (physicalIndex == NoPhysicalTexture)
+                    result.Append(StringFormat("    -> {} {}\n", GetResourceStateName(transition.state), resource.name));
+                else
+                    result.Append(StringFormat("    -> {} {} (physical texture {})\n", GetResourceStateName(transition.state), resource.name, physicalIndex));
+            }
+        }
+
+        for (const uint32_t passIndex : m_CulledPasses)
+            result.Append(StringFormat("  culled {}\n", m_Passes[passIndex].name));
+
+        result.Append(StringFormat("{} transient textures in {} physical textures: {} bytes declared, {} bytes allocated, {} bytes saved\n",
+            m_Stats.transientTextureCount, m_Stats.physicalTextureCount, m_Stats.transientMemory, m_Stats.allocatedMemory, m_Stats.GetSavedMemory()));
+        return result;
+    }
+
+    uint64_t RenderGraph::ComputeTopologyHash() const
+    {
+        // Imported resources are hashed by declaration only, importing another texture every frame keeps the graph compiled
+        uint64_t hash = 0xCBF29CE484222325ull;
+        HashCombine(hash, m_Resources.Count());
+        for (const Resource& resource : m_Resources)
+        {
+            HashCombine(hash, resource.name.GetId());
+            HashCombine(hash, (uint64_t)resource.type | (uint64_t)resource.imported << 8 | (uint64_t)resource.finalState << 16);
+            if (resource.imported) continue;
+            HashCombine(hash, (uint64_t)resource.desc.format | (uint64_t)resource.desc.sampleCount << 32);
+            HashCombine(hash, (uint64_t)resource.desc.width | (uint64_t)resource.desc.height << 32);
+            HashCombine(hash, (uint32_t)resource.desc.usageFlags.As<int32_t>());
+        }
+
+        HashCombine(hash, m_Passes.Count());
+        for (const Pass& pass : m_Passes)
+        {
+            HashCombine(hash, pass.name.GetId());
+            HashCombine(hash, (uint64_t)pass.accessCount | (uint64_t)pass.sideEffects << 32);
+            for (uint32_t accessIndex = pass.firstAccess; accessIndex < pass.firstAccess + pass.accessCount; accessIndex++)
+            {
+                const Access& access = m_Accesses[accessIndex];
+                HashCombine(hash, (uint64_t)access.resource | (uint64_t)access.state << 32 | (uint64_t)access.write << 48);
+            }
+        }
+        return hash;
+    }
+
+    void RenderGraph::CullPasses(Array<bool>& livePasses) const
+    {
+        Array<bool> neededResources;
+        for (const Resource& resource : m_Resources)
+            neededResources.Add(resource.imported);
+
+        for (size_t passIndex = 0; passIndex < m_Passes.Count(); passIndex++)
+            livePasses.Add(false);
+
+        // Walking backwards, a pass is live if it has side effects or writes something a live pass after it uses
+        for (size_t passIndex = m_Passes.Count(); passIndex-- > 0;)
+        {
+            const Pass& pass = m_Passes[passIndex];
+            bool isLive = pass.sideEffects;
+            for (uint32_t accessIndex = pass.firstAccess; accessIndex < pass.firstAccess + pass.accessCount && !isLive; accessIndex++)
+            {
+                const Access& access = m_Accesses[accessIndex];
+                isLive = access.write && neededResources[access.resource];
+            }
+
+            if (!isLive) continue;
+            livePasses[passIndex] = true;
+
+            for (uint32_t accessIndex = pass.firstAccess; accessIndex < pass.firstAccess + pass.accessCount; accessIndex++)
+                neededResources[m_Accesses[accessIndex].resource] = true;
+        }
+    }
+
+    bool RenderGraph::AssignPhysicalTextures(const Array<uint32_t>& firstUses, const Array<uint32_t>& lastUses)
+    {
+        m_PhysicalIndices.Clear();
+        for (size_t resourceIndex = 0; resourceIndex < m_Resources.Count(); resourceIndex++)
+            m_PhysicalIndices.Add(NoPhysicalTexture);
+
+        Array<uint32_t> transientTextures;
+        for (uint32_t resourceIndex = 0; resourceIndex < m_Resources.Count(); resourceIndex++)
+        {
+            const Resource& resource = m_Resources[resourceIndex];
+            if (resource.imported || resource.type != ResourceType::Texture) continue;
+            if (firstUses[resourceIndex] == NoPass) continue;
+            transientTextures.Add(resourceIndex);
+        }
+
+        // Assigning by first use, a texture whose last user ran before another texture's first user hands it over
+        transientTextures.Sort([&firstUses](const uint32_t& lhs, const uint32_t& rhs)
+        {
+            return firstUses[lhs] != firstUses[rhs] ? firstUses[lhs] < firstUses[rhs] : lhs < rhs;
+        });
+
+        Array<bool> usedTextures;
+        for (size_t physicalIndex = 0; physicalIndex < m_PhysicalTextures.Count(); physicalIndex++)
+            usedTextures.Add(false);
+
+        m_Stats.transientTextureCount = (uint32_t)transientTextures.Count();
+        m_Stats.transientMemory = 0;
+        for (const uint32_t resourceIndex : transientTextures)
+        {
+            const RenderGraphTextureDesc& desc = m_Resources[resourceIndex].desc;
+            m_Stats.transientMemory += GetTextureMemory(desc);
+
+            // Reuse a texture already used this frame first, then one left from the previous compilation
+            uint32_t assigned = NoPhysicalTexture;
+            for (uint32_t physicalIndex = 0; physicalIndex < m_PhysicalTextures.Count(); physicalIndex++)
+            {
+                const PhysicalTexture& physicalTexture = m_PhysicalTextures[physicalIndex];
+                if (!physicalTexture.texture || !(physicalTexture.desc == desc)) continue;
+                if (usedTextures[physicalIndex] && physicalTexture.lastUse < firstUses[resourceIndex])
+                {
+                    assigned = physicalIndex;
+                    break;
+                }
+                if (!usedTextures[physicalIndex] && assigned == NoPhysicalTexture)
+                    assigned = physicalIndex;
+            }
+
+            if (assigned == NoPhysicalTexture)
+            {
+                for (uint32_t physicalIndex = 0; physicalIndex < m_PhysicalTextures.Count(); physicalIndex++)
+                {
+                    if (m_PhysicalTextures[physicalIndex].texture) continue;
+                    assigned = physicalIndex;
+                    break;
+                }
+
+                if (assigned == NoPhysicalTexture)
+                {
+                    assigned = (uint32_t)m_PhysicalTextures.Count();
+                    m_PhysicalTextures.Add(PhysicalTexture());
+                    usedTextures.Add(false);
+                }
+
+                TextureCreateInfo createInfo;
+                createInfo.device = m_Device;
+                createInfo.usageFlags = desc.usageFlags;
+                createInfo.format = desc.format;
+                createInfo.width = desc.width;
+                createInfo.height = desc.height;
+                createInfo.depth = 1;
+                createInfo.mipCount = 1;
+                createInfo.sampleCount = desc.sampleCount;
+                createInfo.arrayCount = 1;
+
+                PhysicalTexture& physicalTexture = m_PhysicalTextures[assigned];
+                physicalTexture.texture = m_Device->CreateTexture(createInfo);
+                if (!physicalTexture.texture)
+                {
+                    NOVA_LOG(RenderGraph, Verbosity::Error, "Failed to create transient texture {}", m_Resources[resourceIndex].name);
+                    return false;
+                }
+                physicalTexture.desc = desc;
+            }
+
+            m_PhysicalTextures[assigned].lastUse = lastUses[resourceIndex];
+            usedTextures[assigned] = true;
+            m_PhysicalIndices[resourceIndex] = assigned;
+        }
+
+        // Textures no transient texture maps to anymore are released, the previous frames may still use them
+        bool waitedIdle = false;
+        m_Stats.physicalTextureCount = 0;
+        m_Stats.allocatedMemory = 0;
+        for (size_t physicalIndex = 0; physicalIndex < m_PhysicalTextures.Count(); physicalIndex++)
+        {
+            PhysicalTexture& physicalTexture = m_PhysicalTextures[physicalIndex];
+            if (!physicalTexture.texture) continue;
+
+            if (usedTextures[physicalIndex])
+            {
+                m_Stats.physicalTextureCount++;
+                m_Stats.allocatedMemory += GetTextureMemory(physicalTexture.desc);
+                continue;
+            }
+
+            if (!waitedIdle)
+            {
+                m_Device->WaitIdle();
+                waitedIdle = true;
+            }
+            physicalTexture.texture->Destroy();
+            physicalTexture.texture = nullptr;
+        }
+        return true;
+    }
+
+    size_t RenderGraph::GetTextureMemory(const RenderGraphTextureDesc& desc)
+    {
+        return (size_t)desc.width * desc.height * desc.sampleCount * GetFormatSize(desc.format);
+    }
+}
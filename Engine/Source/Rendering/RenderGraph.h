@@ -0,0 +1,200 @@
+﻿#pragma once
+#include "ResourceBarrier.h"
+#include "ResourceState.h"
+#include "TextureUsage.h"
+#include "Containers/Array.h"
+#include "Containers/Function.h"
+#include "Containers/String.h"
+#include "Runtime/Format.h"
+#include "Runtime/Name.h"
+#include "Runtime/Ref.h"
+#include <cstdint>
+
+namespace Nova
+{
+    class RenderDevice;
+    class RenderGraph;
+    class CommandBuffer;
+    class Texture;
+    class Buffer;
+
+    // Index of a resource declared in a render graph, only meaningful to the graph that returned it
+    using RenderGraphHandle = uint32_t;
+    static constexpr RenderGraphHandle InvalidRenderGraphHandle = ~0u;
+
+    using RenderGraphExecuteFunc = Function<void(const RenderGraph& graph, CommandBuffer& cmdBuffer)>;
+
+    struct RenderGraphTextureDesc
+    {
+        Format format = Format::None;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t sampleCount = 1;
+        TextureUsageFlags usageFlags = TextureUsageFlagBits::None;
+
+        bool operator==(const RenderGraphTextureDesc& other) const;
+    };
+
+    struct RenderGraphStats
+    {
+        uint32_t passCount = 0;
+        uint32_t culledPassCount = 0;
+        uint32_t compileCount = 0;
+        uint32_t transientTextureCount = 0;
+        uint32_t physicalTextureCount = 0;
+        size_t transientMemory = 0;
+        size_t allocatedMemory = 0;
+        // Filled by the last Execute
+        uint32_t barrierCount = 0;
+        uint32_t barrierBatchCount = 0;
+
+        size_t GetSavedMemory() const { return transientMemory - allocatedMemory; }
+    };
+
+    // Declares what a pass reads and writes, returned by RenderGraph::AddPass
+    class RenderGraphBuilder
+    {
+    public:
+        RenderGraphBuilder& Read(RenderGraphHandle resource, ResourceState state = ResourceState::ShaderRead);
+        // A written resource keeps its previous contents, so earlier writers are not culled
+        RenderGraphBuilder& Write(RenderGraphHandle resource, ResourceState state);
+        // The pass is kept even if nothing reads what it writes
+        RenderGraphBuilder& SetSideEffects();
+    private:
+        friend RenderGraph;
+        RenderGraphBuilder(RenderGraph& graph, const uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+
+        RenderGraph& m_Graph;
+        uint32_t m_PassIndex = 0;
+    };
+
+    // Frame graph rebuilt every frame by declaring its passes in submission order.
+    // Compiling culls the passes whose outputs are never used, orders the state transitions and assigns
+    // the transient textures to physical ones. The result is kept until the declared topology changes, so
+    // a graph redeclared identically every frame only pays for hashing it.
+    // Transient textures whose lifetimes don't overlap share the same physical texture when their
+    // descriptions match.
+    class RenderGraph
+    {
+    public:
+        RenderGraph() = default;
+        ~RenderGraph();
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        bool Initialize(RenderDevice* device);
+        void Destroy();
+
+        // Clears the declared passes and resources, the compiled graph and physical textures are kept
+        void Reset();
+
+        RenderGraphHandle CreateTexture(Name name, const RenderGraphTextureDesc& desc);
+        // Imported resources are owned outside the graph. Passes writing to them are never culled.
+        // When finalState is not Undefined the texture is transitioned to it after the last pass.
+        RenderGraphHandle ImportTexture(Name name, Texture* texture, ResourceState finalState = ResourceState::Undefined);
+        RenderGraphHandle ImportBuffer(Name name, Buffer* buffer);
+        RenderGraphBuilder AddPass(Name name, const RenderGraphExecuteFunc& execute);
+
+        bool Compile();
+        void Execute(CommandBuffer& cmdBuffer);
+
+        // Only valid while executing the graph
+        Texture* GetTexture(RenderGraphHandle handle) const;
+        Buffer* GetBuffer(RenderGraphHandle handle) const;
+
+        const RenderGraphStats& GetStats() const { return m_Stats; }
+        bool IsCompiled() const { return m_IsCompiled; }
+
+        // Human readable description of the compiled graph: passes, transitions and texture assignments
+        String Dump() const;
+    private:
+        friend RenderGraphBuilder;
+
+        enum class ResourceType : uint8_t
+        {
+            Texture,
+            Buffer,
+        };
+
+        struct Resource
+        {
+            Name name;
+            ResourceType type = ResourceType::Texture;
+            bool imported = false;
+            ResourceState finalState = ResourceState::Undefined;
+            RenderGraphTextureDesc desc;
+            Texture* texture = nullptr;
+            Buffer* buffer = nullptr;
+        };
+
+        struct Access
+        {
+            RenderGraphHandle resource = InvalidRenderGraphHandle;
+            ResourceState state = ResourceState::Undefined;
+            bool write = false;
+        };
+
+        struct Pass
+        {
+            Name name;
+            RenderGraphExecuteFunc execute;
+            uint32_t firstAccess = 0;
+            uint32_t accessCount = 0;
+            bool sideEffects = false;
+        };
+
+        // Transition of a resource before a pass. Transitions known to be redundant are dropped when compiling,
+        // the others are checked against the actual state when executing.
+        struct Transition
+        {
+            RenderGraphHandle resource = InvalidRenderGraphHandle;
+            ResourceState state = ResourceState::Undefined;
+            // First transition of an imported resource, skipped if the resource is already in the state
+            bool firstUse = false;
+        };
+
+        struct CompiledPass
+        {
+            uint32_t passIndex = 0;
+            uint32_t firstTransition = 0;
+            uint32_t transitionCount = 0;
+        };
+
+        struct PhysicalTexture
+        {
+            RenderGraphTextureDesc desc;
+            Ref<Texture> texture = nullptr;
+            // Last compiled pass using it, the next transient texture assigned to it must start after
+            uint32_t lastUse = 0;
+        };
+
+        uint64_t ComputeTopologyHash() const;
+        void CullPasses(Array<bool>& livePasses) const;
+        bool AssignPhysicalTextures(const Array<uint32_t>& firstUses, const Array<uint32_t>& lastUses);
+        static size_t GetTextureMemory(const RenderGraphTextureDesc& desc);
+
+        RenderDevice* m_Device = nullptr;
+
+        // Declared this frame
+        Array<Resource> m_Resources;
+        Array<Pass> m_Passes;
+        Array<Access> m_Accesses;
+
+        // Compiled
+        uint64_t m_TopologyHash = 0;
+        bool m_IsCompiled = false;
+        Array<CompiledPass> m_CompiledPasses;
+        Array<Transition> m_Transitions;
+        Array<uint32_t> m_CulledPasses;
+        Array<uint32_t> m_PhysicalIndices;
+        Array<PhysicalTexture> m_PhysicalTextures;
+
+        // Storage of the barriers recorded by Execute, they stay alive until the next one
+        Array<TextureBarrier> m_TextureBarriers;
+        Array<BufferBarrier> m_BufferBarriers;
+        Array<MemoryBarrier> m_BarrierBatches;
+        Array<ResourceState> m_TrackedStates;
+
+        RenderGraphStats m_Stats;
+    };
+}
@@ -36,11 +36,20 @@ namespace Nova
         const TextureView* resolveTextureView = nullptr;
     };
 
+    enum class RenderPassContents
+    {
+        // Commands are recorded directly into the command buffer that began the pass
+        Inline,
+        // The pass only executes secondary command buffers begun with RenderPassContinue
+        SecondaryCommandBuffers,
+    };
+
     struct RenderPassBeginInfo
     {
         RenderPassAttachmentInfo* colorAttachments = nullptr;
         uint32_t colorAttachmentCount = 0;
         RenderPassAttachmentInfo* depthAttachment = nullptr;
         Rect2D<uint32_t> renderArea;
+        RenderPassContents contents = RenderPassContents::Inline;
     };
 }
@@ -0,0 +1,260 @@
+﻿#include "ResidencyManager.h"
+#include "RenderDevice.h"
+#include "Texture.h"
+#include "Runtime/Log.h"
+#include <algorithm>
+
+namespace Nova
+{
+    const char* GetDeviceMemoryCategoryName(const DeviceMemoryCategory category)
+    {
+        switch (category)
+        {
+        case DeviceMemoryCategory::Textures: return "Textures";
+        case DeviceMemoryCategory::RenderTargets: return "Render Targets";
+        case DeviceMemoryCategory::Buffers: return "Buffers";
+        default: return "Unknown";
+        }
+    }
+
+    bool ResidencyManager::Initialize(const ResidencyManagerCreateInfo& createInfo)
+    {
+        if (!createInfo.device) return false;
+        if (createInfo.heapBudgetShare <= 0.0f) return false;
+
+        std::scoped_lock lock(m_Mutex);
+        m_Device = createInfo.device;
+        m_HeapBudgetShare = createInfo.heapBudgetShare;
+        m_RestoreBudgetShare = std::min(createInfo.restoreBudgetShare, createInfo.heapBudgetShare);
+        m_RestoreFrameWindow = createInfo.restoreFrameWindow;
+        m_RestoreInterval = createInfo.restoreInterval;
+        m_NextRestoreFrame = 0;
+        return true;
+    }
+
+    void ResidencyManager::Destroy()
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Textures = Array<StreamedTexture>();
+        m_Requests = Array<StreamRequest>();
+        m_Heaps = Array<DeviceHeapBudget>();
+        m_Device = nullptr;
+    }
+
+    void ResidencyManager::OnAllocate(const DeviceMemoryCategory category, const uint64_t size)
+    {
+        m_Usage[(size_t)category].fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void ResidencyManager::OnFree(const DeviceMemoryCategory category, const uint64_t size)
+    {
+        m_Usage[(size_t)category].fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    uint64_t ResidencyManager::GetUsage(const DeviceMemoryCategory category) const
+    {
+        return m_Usage[(size_t)category].load(std::memory_order_relaxed);
+    }
+
+    void ResidencyManager::SetBudget(const DeviceMemoryCategory category, const uint64_t budget)
+    {
+        m_Budgets[(size_t)category].store(budget, std::memory_order_relaxed);
+    }
+
+    uint64_t ResidencyManager::GetBudget(const DeviceMemoryCategory category) const
+    {
+        return m_Budgets[(size_t)category].load(std::memory_order_relaxed);
+    }
+
+    void ResidencyManager::RegisterTexture(Texture& texture, TextureStreamSource& source, const uint32_t maxMip)
+    {
+        if (maxMip == 0) return;
+
+        std::scoped_lock lock(m_Mutex);
+        for (StreamedTexture& streamedTexture : m_Textures)
+        {
+            if (streamedTexture.texture != &texture) continue;
+            streamedTexture.source = &source;
+            streamedTexture.maxMip = maxMip;
+            return;
+        }
+
+        m_Textures.Add({ &texture, &source, maxMip });
+    }
+
+    void ResidencyManager::UnregisterTexture(const Texture& texture)
+    {
+        std::scoped_lock lock(m_Mutex);
+        for (size_t index = 0; index < m_Textures.Count(); index++)
+        {
+            if (m_Textures[index].texture != &texture) continue;
+            // Order does not matter, the last entry fills the hole
+            m_Textures[index] = m_Textures.Last();
+            m_Textures.PopBack();
+            return;
+        }
+    }
+
+    void ResidencyManager::Update()
+    {
+        const uint64_t frameIndex = m_FrameIndex.fetch_add(1, std::memory_order_relaxed);
+
+        std::scoped_lock lock(m_Mutex);
+        if (!m_Device || m_Textures.IsEmpty()) return;
+
+        m_Heaps.Clear();
+        m_Device->GetMemoryHeapBudgets(m_Heaps);
+        m_Requests.Clear();
+
+        if (const uint64_t requiredBytes = GetRequiredBytes(m_Heaps))
+        {
+            // Least recently drawn first, each texture gives up one mip per update
+            for (StreamedTexture& streamedTexture : m_Textures)
+            {
+                // Never marked used means it is bound through descriptor sets that would not see the new image
+                if (streamedTexture.texture->GetLastUsedFrame() == 0) continue;
+                if (streamedTexture.texture->GetResidentMip() < streamedTexture.maxMip)
+                    m_Requests.Add({ &streamedTexture, streamedTexture.texture->GetResidentMip() + 1 });
+            }
+
+            std::sort(m_Requests.Data(), m_Requests.Data() + m_Requests.Count(), [](const StreamRequest& lhs, const StreamRequest& rhs)
+            {
+                return lhs.streamedTexture->texture->GetLastUsedFrame() < rhs.streamedTexture->texture->GetLastUsedFrame();
+            });
+
+            // Halving both sides frees three quarters of a texture
+            uint64_t freedBytes = 0;
+            size_t requestCount = 0;
+            while (requestCount < m_Requests.Count() && freedBytes < requiredBytes)
+            {
+                const uint64_t size = m_Requests[requestCount].streamedTexture->texture->GetSize();
+                freedBytes += size - size / 4;
+                requestCount++;
+            }
+
+            while (m_Requests.Count() > requestCount)
+                m_Requests.PopBack();
+
+            if (!m_Requests.IsEmpty())
+            {
+                NOVA_LOG(RenderDevice, Verbosity::Warning, "Device memory over budget by {} KiB, streaming out a mip of {} textures",
+                    requiredBytes / 1024, m_Requests.Count());
+                // Mips do not come back right after being evicted
+                m_NextRestoreFrame = frameIndex + m_RestoreInterval;
+            }
+        }
+        else if (frameIndex >= m_NextRestoreFrame)
+        {
+            // Degraded textures drawn recently get back as many mips as the budgets allow, most recently drawn first.
+            // Restoring them together costs one device wait instead of one per mip.
+            for (StreamedTexture& streamedTexture : m_Textures)
+            {
+                const Texture& texture = *streamedTexture.texture;
+                if (texture.GetResidentMip() == 0) continue;
+                if (texture.GetLastUsedFrame() + m_RestoreFrameWindow < frameIndex) continue;
+                m_Requests.Add({ &streamedTexture, texture.GetResidentMip() });
+            }
+
+            std::sort(m_Requests.Data(), m_Requests.Data() + m_Requests.Count(), [](const StreamRequest& lhs, const StreamRequest& rhs)
+            {
+                return lhs.streamedTexture->texture->GetLastUsedFrame() > rhs.streamedTexture->texture->GetLastUsedFrame();
+            });
+
+            uint64_t grownBytes = 0;
+            size_t requestCount = 0;
+            for (size_t index = 0; index < m_Requests.Count(); index++)
+            {
+                StreamRequest request = m_Requests[index];
+                const uint64_t size = request.streamedTexture->texture->GetSize();
+
+                // Doubling both sides makes the texture four times larger
+                uint64_t restoredSize = size;
+                while (request.mipLevel > 0 && CanAfford(m_Heaps, grownBytes + restoredSize * 4 - size))
+                {
+                    restoredSize *= 4;
+                    request.mipLevel--;
+                }
+
+                if (restoredSize == size) continue;
+                grownBytes += restoredSize - size;
+                m_Requests[requestCount++] = request;
+            }
+
+            while (m_Requests.Count() > requestCount)
+                m_Requests.PopBack();
+
+            if (!m_Requests.IsEmpty())
+                m_NextRestoreFrame = frameIndex + m_RestoreInterval;
+        }
+
+        if (m_Requests.IsEmpty()) return;
+
+        // Textures are recreated in place, the device may still be reading the previous images
+        m_Device->WaitIdle();
+        for (const StreamRequest& request : m_Requests)
+        {
+            Texture& texture = *request.streamedTexture->texture;
+            const uint32_t residentMip = texture.GetResidentMip();
+            if (!request.streamedTexture->source->StreamMip(request.mipLevel))
+            {
+                NOVA_LOG(RenderDevice, Verbosity::Warning, "Failed to stream texture to mip {}", request.mipLevel);
+                continue;
+            }
+
+            if (request.mipLevel > residentMip) m_EvictedMipCount += request.mipLevel - residentMip;
+            else m_RestoredMipCount += residentMip - request.mipLevel;
+        }
+    }
+
+    ResidencyStats ResidencyManager::GetStats() const
+    {
+        std::scoped_lock lock(m_Mutex);
+        ResidencyStats stats;
+        stats.streamedTextureCount = (uint32_t)m_Textures.Count();
+        for (const StreamedTexture& streamedTexture : m_Textures)
+        {
+            if (streamedTexture.texture->GetResidentMip() > 0)
+                stats.degradedTextureCount++;
+            stats.residentTextureBytes += streamedTexture.texture->GetSize();
+        }
+        stats.evictedMipCount = m_EvictedMipCount;
+        stats.restoredMipCount = m_RestoredMipCount;
+        return stats;
+    }
+
+    uint64_t ResidencyManager::GetRequiredBytes(const Array<DeviceHeapBudget>& heaps) const
+    {
+        uint64_t requiredBytes = 0;
+
+        const uint64_t textureBudget = GetBudget(DeviceMemoryCategory::Textures);
+        const uint64_t textureUsage = GetUsage(DeviceMemoryCategory::Textures);
+        if (textureBudget && textureUsage > textureBudget)
+            requiredBytes = textureUsage - textureBudget;
+
+        // Textures live in device local memory, other heaps are not ours to relieve
+        for (const DeviceHeapBudget& heap : heaps)
+        {
+            if (!heap.deviceLocal) continue;
+            const uint64_t limit = (uint64_t)((double)heap.budget * m_HeapBudgetShare);
+            if (heap.usage > limit)
+                requiredBytes = std::max(requiredBytes, heap.usage - limit);
+        }
+        return requiredBytes;
+    }
+
+    bool ResidencyManager::CanAfford(const Array<DeviceHeapBudget>& heaps, const uint64_t size) const
+    {
+        const uint64_t textureBudget = GetBudget(DeviceMemoryCategory::Textures);
+        const uint64_t textureUsage = GetUsage(DeviceMemoryCategory::Textures);
+        if (textureBudget && (double)(textureUsage + size) > (double)textureBudget * m_RestoreBudgetShare)
+            return false;
+
+        for (const DeviceHeapBudget& heap : heaps)
+        {
+            if (!heap.deviceLocal) continue;
+            if ((double)(heap.usage + size) > (double)heap.budget * m_RestoreBudgetShare)
+                return false;
+        }
+        return true;
+    }
+}
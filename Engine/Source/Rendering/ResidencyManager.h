@@ -0,0 +1,137 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace Nova
+{
+    class RenderDevice;
+    class Texture;
+
+    enum class DeviceMemoryCategory : uint8_t
+    {
+        Textures,
+        RenderTargets,
+        Buffers,
+        Count
+    };
+
+    const char* GetDeviceMemoryCategoryName(DeviceMemoryCategory category);
+
+    // One memory heap of the device as reported by the driver
+    struct DeviceHeapBudget
+    {
+        uint64_t size = 0;
+        // What the process can use before the driver starts failing or paging allocations
+        uint64_t budget = 0;
+        uint64_t usage = 0;
+        bool deviceLocal = false;
+    };
+
+    // Reloads a streamed texture at another resolution, implemented by TextureAsset
+    class TextureStreamSource
+    {
+    public:
+        virtual ~TextureStreamSource() = default;
+
+        // Recreates the texture in place with the given mip of its source image as the most detailed level
+        virtual bool StreamMip(uint32_t mipLevel) = 0;
+    };
+
+    struct ResidencyManagerCreateInfo
+    {
+        RenderDevice* device = nullptr;
+        // Share of each device local heap budget usage is kept under
+        float heapBudgetShare = 0.9f;
+        // Mips only come back while usage stays under this share of the budgets, so textures do not bounce
+        float restoreBudgetShare = 0.75f;
+        // Degraded textures drawn within this many frames get their mips back first
+        uint32_t restoreFrameWindow = 4;
+        // Frames between two batches of streaming, each batch waits for the device once
+        uint32_t restoreInterval = 30;
+    };
+
+    struct ResidencyStats
+    {
+        uint32_t streamedTextureCount = 0;
+        uint32_t degradedTextureCount = 0;
+        uint64_t residentTextureBytes = 0;
+        uint64_t evictedMipCount = 0;
+        uint64_t restoredMipCount = 0;
+    };
+
+    // Keeps device memory within budget. Backends report every allocation with its category and streamed textures
+    // remember the frame they were last drawn in. When the texture budget or a device local heap is exceeded, the
+    // least recently used textures drop their most detailed mip, and get their mips back once there is room again.
+    // Only textures whose users call Texture::MarkUsed are streamed, material descriptor sets keep their image.
+    // Update recreates textures in place after waiting for the device, it may not run while a frame is being recorded.
+    // Every texture streamed by an update shares that wait, and restores only run every restoreInterval frames.
+    class ResidencyManager
+    {
+    public:
+        ResidencyManager() = default;
+        ~ResidencyManager() = default;
+        ResidencyManager(const ResidencyManager&) = delete;
+        ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+        bool Initialize(const ResidencyManagerCreateInfo& createInfo);
+        void Destroy();
+
+        // Called by the backends for every texture and buffer, from any thread
+        void OnAllocate(DeviceMemoryCategory category, uint64_t size);
+        void OnFree(DeviceMemoryCategory category, uint64_t size);
+        uint64_t GetUsage(DeviceMemoryCategory category) const;
+
+        // A budget of 0 leaves the category only bound by the heap budgets
+        void SetBudget(DeviceMemoryCategory category, uint64_t budget);
+        uint64_t GetBudget(DeviceMemoryCategory category) const;
+
+        // maxMip is the lowest resolution the texture may be streamed down to
+        void RegisterTexture(Texture& texture, TextureStreamSource& source, uint32_t maxMip);
+        void UnregisterTexture(const Texture& texture);
+
+        // Frame textures are marked as used with, advanced by Update
+        uint64_t GetFrameIndex() const { return m_FrameIndex.load(std::memory_order_relaxed); }
+
+        // Evicts or restores mips to follow the budgets, once per frame before recording starts
+        void Update();
+
+        ResidencyStats GetStats() const;
+    private:
+        struct StreamedTexture
+        {
+            Texture* texture = nullptr;
+            TextureStreamSource* source = nullptr;
+            uint32_t maxMip = 0;
+        };
+
+        struct StreamRequest
+        {
+            StreamedTexture* streamedTexture = nullptr;
+            uint32_t mipLevel = 0;
+        };
+
+        // Expect m_Mutex to be locked
+        uint64_t GetRequiredBytes(const Array<DeviceHeapBudget>& heaps) const;
+        bool CanAfford(const Array<DeviceHeapBudget>& heaps, uint64_t size) const;
+
+        RenderDevice* m_Device = nullptr;
+        float m_HeapBudgetShare = 0.0f;
+        float m_RestoreBudgetShare = 0.0f;
+        uint32_t m_RestoreFrameWindow = 0;
+        uint32_t m_RestoreInterval = 0;
+        uint64_t m_NextRestoreFrame = 0;
+
+        std::atomic<uint64_t> m_Usage[(size_t)DeviceMemoryCategory::Count] = {};
+        std::atomic<uint64_t> m_Budgets[(size_t)DeviceMemoryCategory::Count] = {};
+        std::atomic<uint64_t> m_FrameIndex = 1;
+
+        mutable std::mutex m_Mutex;
+        Array<StreamedTexture> m_Textures;
+        Array<StreamRequest> m_Requests;
+        Array<DeviceHeapBudget> m_Heaps;
+        uint64_t m_EvictedMipCount = 0;
+        uint64_t m_RestoredMipCount = 0;
+    };
+}
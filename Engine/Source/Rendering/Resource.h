@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Runtime/RefCounted.h"
+#include <cstdint>
 
 #define NOVA_CONCAT_IMPL(a,b) a##b
 #define NOVA_CONCAT(a, b) NOVA_CONCAT_IMPL(a, b)
@@ -15,6 +16,10 @@ namespace Nova
         Buffer,
     };
 
+    // Slot of a resource in the bindless heap, the same for the whole lifetime of the registration
+    using BindlessIndex = uint32_t;
+    static constexpr BindlessIndex InvalidBindlessIndex = ~0u;
+
     class Resource : public RefCounted
     {
     public:
@@ -25,5 +30,10 @@ namespace Nova
         Resource& operator=(const Resource&&) = delete;
 
         virtual ResourceType GetResourceType() = 0;
+
+        BindlessIndex GetBindlessIndex() const { return m_BindlessIndex; }
+    private:
+        friend class BindlessHeap;
+        BindlessIndex m_BindlessIndex = InvalidBindlessIndex;
     };
 }
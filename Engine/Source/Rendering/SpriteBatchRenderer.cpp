@@ -1,160 +1,380 @@
 ﻿#include "SpriteBatchRenderer.h"
+#include "BindlessHeap.h"
 #include "GraphicsPipeline.h"
 #include "Buffer.h"
 #include "CommandBuffer.h"
+#include "RenderDevice.h"
 #include "Sampler.h"
 #include "Shader.h"
 #include "ShaderBindingSet.h"
-#include "Components/Transform.h"
-#include "Math/Matrix2.h"
+#include "Texture.h"
+#include "Math/Functions.h"
 #include "Math/Matrix4.h"
 #include "Math/Vector2.h"
+#include "Math/Vector3.h"
 #include "Runtime/Application.h"
+#include "Runtime/Profiler.h"
+#include "Runtime/Color.h"
+#include "Runtime/Window.h"
+#include <bit>
+#include <utility>
 
 namespace Nova
 {
-    struct SpriteData
-    {
-        uint32_t id;
-        int32_t frameIndex;
-        int32_t cols;
-        int32_t rows;
-        int32_t flags;
-        uint32_t padding0;
-        Vector2 tiling;
-        Vector2 offset;
-        Matrix2 scale;
-        Color color;
-        Matrix4 worldToClip;
+    // Sprites are flat, a 2D affine transform is enough to place them. Mirrored in SpriteBatch.slang
+    struct SpriteInstance
+    {
+        Vector2 axisX;
+        Vector2 axisY;
+        Vector3 translation;
+        uint32_t color;
+        Vector2 uvMin;
+        Vector2 uvSize;
+        uint32_t textureIndex;
+        uint32_t padding;
+    };
+
+    static_assert(sizeof(SpriteInstance) == 56, "SpriteInstance must match SpriteBatch.slang");
+
+    struct SpriteSortKey
+    {
+        uint32_t key;
+        uint32_t index;
     };
 
-    static Matrix4 viewProjection;
-    static Ref<Device> device = nullptr;
-    static Ref<GraphicsPipeline> graphicsPipeline = nullptr;
-    static Ref<Buffer> storageBuffer = nullptr;
-    static Ref<ShaderBindingSet> bindingSet = nullptr;
-    static Ref<Sampler> sampler = nullptr;
-    static RenderPass* renderPass = nullptr;
-    static Shader* shader = nullptr;
-    static bool begin = false;
-    static Array<Texture*> textures;
-    static Array<SpriteData> spriteData;
+    struct SpriteBatchPushConstants
+    {
+        Matrix4 viewProjection;
+        uint32_t spriteBufferIndex;
+        uint32_t samplerIndex;
+        uint32_t firstSprite;
+        uint32_t padding;
+    };
+
+    static Matrix4 s_ViewProjection = Matrix4::Identity;
+    static Ref<RenderDevice> s_Device = nullptr;
+    static Ref<GraphicsPipeline> s_Pipeline = nullptr;
+    static Ref<Buffer> s_InstanceBuffer = nullptr;
+    static Ref<Sampler> s_Sampler = nullptr;
+    static Shader* s_Shader = nullptr;
+    static BindlessHeap* s_BindlessHeap = nullptr;
+    static Array<SpriteInstance> s_Instances;
+    static Array<SpriteSortKey> s_SortKeys;
+    static Array<SpriteSortKey> s_SortScratch;
+    static SpriteSortMode s_SortMode = SpriteSortMode::None;
+    static uint32_t s_Capacity = 0;
+    static uint32_t s_FrameCount = 0;
+    static uint32_t s_FirstSprite = 0;
+    static uint32_t s_SpriteCount = 0;
+    static uint64_t s_ResidencyFrame = 0;
+    static bool s_Begin = false;
+
+    static uint32_t PackColor(const Color& color)
+    {
+        const auto pack = [](const float value) { return (uint32_t)(Math::Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return pack(color.r) | pack(color.g) << 8 | pack(color.b) << 16 | pack(color.a) << 24;
+    }
+
+    // Maps a float to an unsigned integer with the same ordering
+    static uint32_t GetSortableBits(const float value)
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+    }
+
+    // Stable LSD radix sort, one pass per byte of the key
+    static void SortSprites(SpriteSortKey* keys, SpriteSortKey* scratch, const uint32_t count)
+    {
+        SpriteSortKey* source = keys;
+        SpriteSortKey* destination = scratch;
+        for (uint32_t shift = 0; shift < 32; shift += 8)
+        {
+            uint32_t histogram[256] = {};
+            for (uint32_t i = 0; i < count; i++)
+                histogram[source[i].key >> shift & 0xFF]++;
+
+            // Every key shares this byte, the pass would not move anything
+            if (histogram[source[0].key >> shift & 0xFF] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (uint32_t& bucket : histogram)
+            {
+                const uint32_t bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+                destination[histogram[source[i].key >> shift & 0xFF]++] = source[i];
+            std::swap(source, destination);
+        }
+
+        if (source != keys)
+            Memory::Memcpy(keys, source, count * sizeof(SpriteSortKey));
+    }
+
+    static bool CreateInstanceBuffer(const uint32_t capacity)
+    {
+        // One region per frame in flight, a frame never writes where the GPU may still be reading
+        const uint32_t frameCount = s_Device->GetImageCount();
+
+        BufferCreateInfo bufferCreateInfo;
+        bufferCreateInfo.device = s_Device;
+        bufferCreateInfo.usage = BufferUsage::StorageBuffer;
+        bufferCreateInfo.size = (size_t)capacity * frameCount * sizeof(SpriteInstance);
+        bufferCreateInfo.mapped = true;
+        Ref<Buffer> buffer = s_Device->CreateBuffer(bufferCreateInfo);
+        if (!buffer) return false;
+
+        if (s_BindlessHeap->Register(*buffer) == InvalidBindlessIndex)
+        {
+            buffer->Destroy();
+            return false;
+        }
+
+        if (s_InstanceBuffer)
+            s_InstanceBuffer->Destroy();
+
+        s_InstanceBuffer = buffer;
+        s_Capacity = capacity;
+        s_FrameCount = frameCount;
+        return true;
+    }
 
     bool SpriteBatchRenderer::Initialize(const SpriteBatchRendererCreateInfo& createInfo)
     {
         if (!createInfo.device) return false;
-        if (!createInfo.renderPass) return false;
         if (!createInfo.shader) return false;
 
-        const GraphicsPipelineCreateInfo pipelineCreateInfo = GraphicsPipelineCreateInfo()
-        .SetDevice(createInfo.device)
-        .SetRenderPass(createInfo.renderPass)
-        .SetShader(createInfo.shader)
-        .SetMultisampleInfo({8})
-        .SetViewportInfo({0, 0, createInfo.renderPass->GetWidth(), createInfo.renderPass->GetHeight()})
-        .SetScissorInfo({0, 0, createInfo.renderPass->GetWidth(), createInfo.renderPass->GetHeight()});
+        s_BindlessHeap = createInfo.device->GetBindlessHeap();
+        if (!s_BindlessHeap) return false;
 
-        graphicsPipeline = createInfo.device->CreateGraphicsPipeline(pipelineCreateInfo);
-        if (!graphicsPipeline) return false;
+        s_Device = createInfo.device;
+        s_Shader = createInfo.shader;
+        s_SortMode = createInfo.sortMode;
 
-        bindingSet = createInfo.shader->CreateBindingSet(0);
-        if (!bindingSet) return false;
+        // Quads are generated from the vertex index, there is no vertex input
+        GraphicsPipelineCreateInfo pipelineCreateInfo;
+        pipelineCreateInfo.device = s_Device;
+        pipelineCreateInfo.shader = s_Shader;
+        pipelineCreateInfo.colorAttachmentFormats = { Format::R8G8B8A8_UNORM };
+        pipelineCreateInfo.depthAttachmentFormat = Format::D32_FLOAT_S8_UINT;
+        pipelineCreateInfo.colorBlendStates.Add(ColorBlendState(true, BlendFunction::AlphaBlend(), ColorChannelFlags::All()));
+        pipelineCreateInfo.rasterizationState.cullMode = CullMode::None;
+        pipelineCreateInfo.multisampleState.sampleCount = 8;
+        s_Pipeline = s_Device->CreateGraphicsPipeline(pipelineCreateInfo);
+        if (!s_Pipeline) return false;
 
-        sampler = createInfo.device->GetOrCreateSampler(SamplerCreateInfo());
-        device = createInfo.device;
-        renderPass = createInfo.renderPass;
-        shader = createInfo.shader;
-        return true;
+        SamplerCreateInfo samplerCreateInfo;
+        samplerCreateInfo.device = s_Device;
+        s_Sampler = s_Device->GetOrCreateSampler(samplerCreateInfo);
+        if (!s_Sampler) return false;
+        s_BindlessHeap->Register(*s_Sampler);
+
+        return CreateInstanceBuffer(Math::Max(createInfo.maxSprites, 1u));
     }
 
     void SpriteBatchRenderer::Destroy()
     {
-        if (bindingSet) bindingSet->Destroy();
-        if (graphicsPipeline) graphicsPipeline->Destroy();
-        if (storageBuffer) storageBuffer->Destroy();
-        renderPass = nullptr;
-        device = nullptr;
-        shader = nullptr;
+        if (s_Device) s_Device->WaitIdle();
+        if (s_Pipeline) s_Pipeline->Destroy();
+        if (s_InstanceBuffer) s_InstanceBuffer->Destroy();
+        s_Pipeline = nullptr;
+        s_InstanceBuffer = nullptr;
+        s_Sampler = nullptr;
+        s_Device = nullptr;
+        s_Shader = nullptr;
+        s_BindlessHeap = nullptr;
+        s_Instances.Free();
+        s_SortKeys.Free();
+        s_SortScratch.Free();
+        s_Capacity = 0;
+        s_SpriteCount = 0;
     }
 
     bool SpriteBatchRenderer::BeginFrame(const Matrix4& inViewProjection)
     {
-        NOVA_ASSERT(!begin, "SpriteBatchRenderer::Begin/End call mismatch!");
-        viewProjection = inViewProjection;
-        textures.Clear();
-        spriteData.Clear();
-        begin = true;
+        NOVA_ASSERT(!s_Begin, "SpriteBatchRenderer::Begin/End call mismatch!");
+        s_ViewProjection = inViewProjection;
+        s_Instances.Clear();
+        s_SortKeys.Clear();
+        s_SpriteCount = 0;
+        s_ResidencyFrame = s_Device ? s_Device->GetResidencyManager().GetFrameIndex() : 0;
+        s_Begin = true;
         return true;
     }
 
     bool SpriteBatchRenderer::EndFrame(CommandBuffer& cmdBuffer)
     {
-        NOVA_ASSERT(begin, "SpriteBatchRenderer::End/End call mismatch!");
-        if (!begin) return false;
+        NOVA_ASSERT(s_Begin, "SpriteBatchRenderer::End/End call mismatch!");
+        if (!s_Begin) return false;
+        s_Begin = false;
+
+        const uint32_t count = s_Instances.Count();
+        if (count == 0) return true;
 
-        if (!bindingSet->BindCombinedSamplerTextures(1, *sampler, textures.Data(), textures.Count()))
+        if (count > s_Capacity || s_Device->GetImageCount() != s_FrameCount)
         {
-            begin = false;
-            return false;
+            const uint32_t capacity = Math::Max(s_Capacity, Math::NearestPowerOfTwo<uint32_t>(count));
+            if (!CreateInstanceBuffer(capacity))
+                return false;
         }
 
-        if (!storageBuffer || storageBuffer->GetSize() < spriteData.Size())
+        const uint32_t frameIndex = s_Device->GetCurrentFrameIndex() % s_FrameCount;
+        s_FirstSprite = frameIndex * s_Capacity;
+
+        SpriteInstance* mapped = (SpriteInstance*)s_InstanceBuffer->Map();
+        if (!mapped) return false;
+
+        // The mapped memory may be write combined, only ever write it sequentially
+        SpriteInstance* instances = mapped + s_FirstSprite;
+        if (s_SortMode == SpriteSortMode::None || s_SortKeys.Count() != count)
         {
-            Ref<Buffer> buffer = device->CreateBuffer(BufferUsage::StorageBuffer, spriteData.Size());
-            if (!buffer)
-            {
-                begin = false;
-                return false;
-            }
+            Memory::Memcpy(instances, s_Instances.Data(), s_Instances.Size());
+        }
+        else
+        {
+            if (s_SortScratch.Count() < count)
+                s_SortScratch = Array<SpriteSortKey>((size_t)count);
+            SortSprites(s_SortKeys.Data(), s_SortScratch.Data(), count);
 
-            if (storageBuffer)
-                storageBuffer->Destroy();
-            storageBuffer = buffer;
-            bindingSet->BindBuffer(2, *storageBuffer, 0, spriteData.Size());
+            const SpriteInstance* unsorted = s_Instances.Data();
+            const SpriteSortKey* sortKeys = s_SortKeys.Data();
+            for (uint32_t i = 0; i < count; i++)
+                instances[i] = unsorted[sortKeys[i].index];
         }
 
-        cmdBuffer.UpdateBuffer(*storageBuffer, 0, spriteData.Size(), spriteData.Data());
-        begin = false;
+        s_InstanceBuffer->Unmap(mapped);
+        s_SpriteCount = count;
         return true;
     }
 
     void SpriteBatchRenderer::Render(CommandBuffer& cmdBuffer)
     {
-        if (spriteData.IsEmpty()) return;
+        if (s_SpriteCount == 0) return;
+
+        const Application& application = Application::GetCurrentApplication();
+        const auto window = application.GetWindow();
+        const auto viewport = window->GetBounds();
+
+        SpriteBatchPushConstants pushConstants;
+        pushConstants.viewProjection = s_ViewProjection;
+        pushConstants.spriteBufferIndex = s_InstanceBuffer->GetBindlessIndex();
+        pushConstants.samplerIndex = s_Sampler->GetBindlessIndex();
+        pushConstants.firstSprite = s_FirstSprite;
+        pushConstants.padding = 0;
 
-        cmdBuffer.BindGraphicsPipeline(*graphicsPipeline);
-        cmdBuffer.BindShaderBindingSet(*shader, *bindingSet);
-        cmdBuffer.SetViewport(renderPass->GetOffsetX(), renderPass->GetOffsetY(), renderPass->GetWidth(), renderPass->GetHeight(), 0.0f, 1.0f);
-        cmdBuffer.SetScissor(renderPass->GetOffsetX(), renderPass->GetOffsetY(), renderPass->GetWidth(), renderPass->GetHeight());
-        cmdBuffer.Draw(6, spriteData.Count(), 0, 0);
+        // Textures are reached through the bindless heap, the whole batch is a single draw
+        cmdBuffer.BindGraphicsPipeline(*s_Pipeline);
+        cmdBuffer.BindShaderBindingSet(*s_Shader, *s_BindlessHeap->GetBindingSet());
+        cmdBuffer.PushConstants(*s_Shader, ShaderStageFlagBits::Vertex | ShaderStageFlagBits::Fragment, 0, sizeof(SpriteBatchPushConstants), &pushConstants);
+        cmdBuffer.SetViewport(viewport.x, viewport.y, viewport.width, viewport.height, 0.0f, 1.0f);
+        cmdBuffer.SetScissor(viewport.x, viewport.y, viewport.width, viewport.height);
+        cmdBuffer.Draw(6, s_SpriteCount, 0, 0);
+
+        NOVA_PROFILE_COUNTER("Sprite Draw Calls", 1);
+        NOVA_PROFILE_COUNTER("Sprites", s_SpriteCount);
     }
 
     void SpriteBatchRenderer::DrawSprite(Sprite sprite, const Matrix4& transform, const SpriteRendererFlags flags, const Color& colorTint, Vector2 tiling, Vector2 offset, float pixelsPerUnit)
     {
-        if (!sprite.texture) return;
-        textures.AddUnique(sprite.texture);
-
-        const Matrix4 mvp = viewProjection * transform;
-        Vector3 scale;
-        transform.Decompose(&scale, nullptr, nullptr);
-
-        const Vector2 finalTiling = flags.Contains(SpriteRendererFlagBits::TileWithScale)
-        ? static_cast<Vector2>(scale)
-        : tiling;
-
-        const Matrix2 spriteScale = Math::Scale(Matrix2::Identity, Vector2(sprite.width, sprite.height) / pixelsPerUnit);
-
-        SpriteData data;
-        data.id = textures.Find(sprite.texture);
-        data.frameIndex = 0;
-        data.rows = 0;
-        data.cols = 0;
-        data.flags = flags.As<int32_t>();
-        data.tiling = finalTiling;
-        data.offset = offset;
-        data.scale = spriteScale;
-        data.color = colorTint;
-        data.worldToClip = mvp;
-        spriteData.Add(data);
+        NOVA_ASSERT(s_Begin, "Cannot draw outside a SpriteBatchRenderer::BeginFrame/EndFrame scope!");
+        if (!sprite.texture || !s_InstanceBuffer) return;
+
+        // The index is stored on the texture, the heap is only locked the first time a texture is drawn
+        Texture& texture = *sprite.texture;
+        BindlessIndex textureIndex = texture.GetBindlessIndex();
+        if (textureIndex == InvalidBindlessIndex)
+            textureIndex = s_BindlessHeap->Register(texture);
+        if (textureIndex == InvalidBindlessIndex) return;
+        texture.MarkUsed(s_ResidencyFrame);
+
+        // Called for every sprite of the frame, this sticks to plain float math.
+        // Sprites are in source pixels, a streamed texture keeps its UVs whatever mip is resident
+        const float* matrix = transform.ValuePtr();
+        const float width = (float)sprite.width / pixelsPerUnit;
+        const float height = (float)sprite.height / pixelsPerUnit;
+
+        Vector2 finalTiling = tiling;
+        if (flags.Contains(SpriteRendererFlagBits::TileWithScale))
+        {
+            finalTiling.x = Math::Sqrt(matrix[0] * matrix[0] + matrix[1] * matrix[1] + matrix[2] * matrix[2]);
+            finalTiling.y = Math::Sqrt(matrix[4] * matrix[4] + matrix[5] * matrix[5] + matrix[6] * matrix[6]);
+        }
+
+        const float textureWidth = (float)texture.GetSourceWidth();
+        const float textureHeight = (float)texture.GetSourceHeight();
+        float uvMinX = (float)sprite.x / textureWidth;
+        float uvMinY = (float)sprite.y / textureHeight;
+        float uvSizeX = (float)sprite.width / textureWidth;
+        float uvSizeY = (float)sprite.height / textureHeight;
+
+        if (flags.Contains(SpriteRendererFlagBits::FlipHorizontal))
+        {
+            uvMinX += uvSizeX;
+            uvSizeX = -uvSizeX;
+        }
+
+        if (flags.Contains(SpriteRendererFlagBits::FlipVertical))
+        {
+            uvMinY += uvSizeY;
+            uvSizeY = -uvSizeY;
+        }
+
+        SpriteInstance instance;
+        instance.axisX.x = matrix[0] * width;
+        instance.axisX.y = matrix[1] * width;
+        instance.axisY.x = matrix[4] * height;
+        instance.axisY.y = matrix[5] * height;
+        instance.translation.x = matrix[12];
+        instance.translation.y = matrix[13];
+        instance.translation.z = matrix[14];
+        instance.color = PackColor(colorTint);
+        instance.uvMin.x = finalTiling.x * uvMinX + offset.x;
+        instance.uvMin.y = finalTiling.y * uvMinY + offset.y;
+        instance.uvSize.x = finalTiling.x * uvSizeX;
+        instance.uvSize.y = finalTiling.y * uvSizeY;
+        instance.textureIndex = textureIndex;
+        instance.padding = 0;
+
+        switch (s_SortMode)
+        {
+        case SpriteSortMode::None:
+            break;
+        case SpriteSortMode::Texture:
+            s_SortKeys.Add({ textureIndex, s_Instances.Count() });
+            break;
+        case SpriteSortMode::BackToFront:
+            {
+                const Vector4 clipPosition = s_ViewProjection * Vector4(matrix[12], matrix[13], matrix[14], 1.0f);
+                const float depth = clipPosition.w != 0.0f ? clipPosition.z / clipPosition.w : clipPosition.z;
+                s_SortKeys.Add({ ~GetSortableBits(depth), s_Instances.Count() });
+            }
+            break;
+        }
+
+        s_Instances.Add(instance);
+    }
+
+    void SpriteBatchRenderer::SetSortMode(const SpriteSortMode sortMode)
+    {
+        NOVA_ASSERT(!s_Begin, "Cannot change the sort mode inside a SpriteBatchRenderer::BeginFrame/EndFrame scope!");
+        s_SortMode = sortMode;
+    }
+
+    SpriteSortMode SpriteBatchRenderer::GetSortMode()
+    {
+        return s_SortMode;
+    }
+
+    uint32_t SpriteBatchRenderer::GetSpriteCount()
+    {
+        return s_SpriteCount;
+    }
+
+    uint32_t SpriteBatchRenderer::GetCapacity()
+    {
+        return s_Capacity;
     }
 }
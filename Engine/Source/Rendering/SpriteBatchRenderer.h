@@ -1,27 +1,39 @@
 ﻿#pragma once
 #include "SpriteRendererFlags.h"
-#include "Math/Quaternion.h"
 #include "Math/Vector2.h"
 #include "Runtime/Sprite.h"
+#include <cstdint>
 
 namespace Nova
 {
-    class Camera;
     class Matrix4;
     struct Color;
     class CommandBuffer;
-    class Device;
-    class RenderPass;
-    class Transform;
+    class RenderDevice;
     class Shader;
 
+    enum class SpriteSortMode
+    {
+        // Sprites are drawn in submission order, later sprites are drawn over earlier ones
+        None,
+        // Sprites sharing a texture are drawn next to each other. This reorders overlapping sprites,
+        // only use it when they do not overlap or when depth testing decides what is in front
+        Texture,
+        // Farthest sprites first, for alpha blending with a depth-less pass
+        BackToFront,
+    };
+
     struct SpriteBatchRendererCreateInfo
     {
         RenderDevice* device = nullptr;
-        RenderPass* renderPass = nullptr;
         Shader* shader = nullptr;
+        uint32_t maxSprites = 4096;
+        SpriteSortMode sortMode = SpriteSortMode::None;
     };
 
+    // Collects the sprites of a frame and draws them in a single instanced draw call.
+    // Instances are written into a persistently mapped buffer holding one region per frame in flight,
+    // the regions grow when a frame submits more sprites than they can hold.
     class SpriteBatchRenderer
     {
     public:
@@ -34,5 +46,10 @@ namespace Nova
         static void Render(CommandBuffer& cmdBuffer);
 
         static void DrawSprite(Sprite sprite, const Matrix4& transform, SpriteRendererFlags flags, const Color& colorTint, Vector2 tiling, Vector2 offset, float pixelsPerUnit);
+
+        static void SetSortMode(SpriteSortMode sortMode);
+        static SpriteSortMode GetSortMode();
+        static uint32_t GetSpriteCount();
+        static uint32_t GetCapacity();
     };
 }
@@ -4,8 +4,10 @@
 #include "TextureUsage.h"
 #include "TextureDimension.h"
 #include "ResourceState.h"
+#include "ResidencyManager.h"
 #include "Runtime/Ref.h"
 #include "Math/Functions.h"
+#include <atomic>
 #include <cstdint>
 
 
@@ -102,6 +104,47 @@ namespace Nova
                 *depth = Math::Max(1u, m_Depth >> mipLevel);
         }
         const Ref<TextureView>& GetView() const { return m_View; }
+
+        DeviceMemoryCategory GetMemoryCategory() const
+        {
+            const bool isAttachment = m_UsageFlags.Contains(TextureUsageFlagBits::ColorAttachment)
+                || m_UsageFlags.Contains(TextureUsageFlagBits::DepthStencilAttachment);
+            return isAttachment ? DeviceMemoryCategory::RenderTargets : DeviceMemoryCategory::Textures;
+        }
+
+        // Estimated device memory of every mip and layer, without alignment or padding
+        uint64_t GetSize() const
+        {
+            uint64_t size = 0;
+            for (uint32_t mipLevel = 0; mipLevel < m_Mips; mipLevel++)
+            {
+                const uint64_t width = Math::Max(1u, m_Width >> mipLevel);
+                const uint64_t height = Math::Max(1u, m_Height >> mipLevel);
+                const uint64_t depth = Math::Max(1u, m_Depth >> mipLevel);
+                size += width * height * depth * GetFormatSize(m_Format);
+            }
+            return size * m_ArrayCount * Math::Max(1u, m_SampleCount);
+        }
+
+        // Frame of the residency manager the texture was last drawn in, streaming evicts the oldest first
+        void MarkUsed(const uint64_t frameIndex)
+        {
+            // Skip the store when already marked, many draws share a texture each frame
+            if (m_LastUsedFrame.load(std::memory_order_relaxed) != frameIndex)
+                m_LastUsedFrame.store(frameIndex, std::memory_order_relaxed);
+        }
+        uint64_t GetLastUsedFrame() const { return m_LastUsedFrame.load(std::memory_order_relaxed); }
+
+        // Streamed textures may hold a lower mip of their source image, sprites and UVs keep using the source size
+        uint32_t GetResidentMip() const { return m_ResidentMip; }
+        uint32_t GetSourceWidth() const { return m_ResidentMip ? m_SourceWidth : m_Width; }
+        uint32_t GetSourceHeight() const { return m_ResidentMip ? m_SourceHeight : m_Height; }
+        void SetResidentMip(const uint32_t mipLevel, const uint32_t sourceWidth, const uint32_t sourceHeight)
+        {
+            m_ResidentMip = mipLevel;
+            m_SourceWidth = sourceWidth;
+            m_SourceHeight = sourceHeight;
+        }
     protected:
         Format m_Format = Format::None;
         uint32_t m_Width = 0;
@@ -114,6 +157,10 @@ namespace Nova
         TextureUsageFlags m_UsageFlags = TextureUsageFlagBits::None;
         TextureDimension m_Dimension = TextureDimension::None;
         Ref<TextureView> m_View = nullptr;
+        std::atomic<uint64_t> m_LastUsedFrame = 0;
+        uint32_t m_ResidentMip = 0;
+        uint32_t m_SourceWidth = 0;
+        uint32_t m_SourceHeight = 0;
     };
 
     using TextureHandle = Ref<Texture>;
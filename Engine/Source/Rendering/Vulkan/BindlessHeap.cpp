@@ -0,0 +1,146 @@
+﻿#include "BindlessHeap.h"
+#include "Buffer.h"
+#include "Conversions.h"
+#include "RenderDevice.h"
+#include "Sampler.h"
+#include "Texture.h"
+#include "TextureView.h"
+#include "Runtime/Log.h"
+
+#include <vulkan/vulkan.h>
+#include <algorithm>
+
+namespace Nova::Vulkan
+{
+    bool BindlessHeap::Initialize(const BindlessHeapCreateInfo& createInfo)
+    {
+        RenderDevice* device = (RenderDevice*)createInfo.device;
+        if (!device) return false;
+
+        // Update after bind arrays have their own limits, usually far above the regular per stage ones
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES };
+        VkPhysicalDeviceProperties2 properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+        properties.pNext = &indexingProperties;
+        vkGetPhysicalDeviceProperties2(device->GetPhysicalDevice(), &properties);
+
+        BindlessHeapCreateInfo clampedCreateInfo = createInfo;
+        clampedCreateInfo.textureCount = std::min(createInfo.textureCount, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages);
+        clampedCreateInfo.bufferCount = std::min(createInfo.bufferCount, indexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers);
+        clampedCreateInfo.samplerCount = std::min(createInfo.samplerCount, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers);
+
+        const ShaderStageFlags stageFlags = ShaderStageFlagBits::Vertex | ShaderStageFlagBits::Fragment | ShaderStageFlagBits::Compute | ShaderStageFlagBits::Mesh;
+        m_BindingSetLayout.Initialize(device, SetIndex);
+        m_BindingSetLayout.SetUpdateAfterBind(true);
+        m_BindingSetLayout.SetBinding(TextureBinding, { "Textures", stageFlags, BindingType::SampledTexture, clampedCreateInfo.textureCount });
+        m_BindingSetLayout.SetBinding(BufferBinding, { "Buffers", stageFlags, BindingType::StorageBuffer, clampedCreateInfo.bufferCount });
+        m_BindingSetLayout.SetBinding(SamplerBinding, { "Samplers", stageFlags, BindingType::Sampler, clampedCreateInfo.samplerCount });
+        if (!m_BindingSetLayout.Build())
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to create bindless heap layout!");
+            return false;
+        }
+
+        m_EmptySetLayout.Initialize(device, 0);
+        if (!m_EmptySetLayout.Build())
+            return false;
+
+        DescriptorPoolCreateInfo descriptorPoolCreateInfo = DescriptorPoolCreateInfo()
+        .SetDevice(device)
+        .SetBindingTypeSize(BindingType::SampledTexture, clampedCreateInfo.textureCount)
+        .SetBindingTypeSize(BindingType::StorageBuffer, clampedCreateInfo.bufferCount)
+        .SetBindingTypeSize(BindingType::Sampler, clampedCreateInfo.samplerCount)
+        .SetMaxSets(1)
+        .SetUpdateAfterBind(true);
+        if (!m_DescriptorPool.Initialize(descriptorPoolCreateInfo))
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to create bindless heap descriptor pool!");
+            return false;
+        }
+
+        ShaderBindingSetCreateInfo bindingSetCreateInfo;
+        bindingSetCreateInfo.device = device;
+        bindingSetCreateInfo.pool = &m_DescriptorPool;
+        bindingSetCreateInfo.layout = &m_BindingSetLayout;
+        if (!m_BindingSet.Initialize(bindingSetCreateInfo))
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to allocate bindless heap descriptor set!");
+            return false;
+        }
+
+        m_Device = device;
+        InitializeSlots(clampedCreateInfo);
+        return true;
+    }
+
+    void BindlessHeap::Destroy()
+    {
+        if (!m_Device) return;
+        ReleaseSlots();
+        m_BindingSet.Destroy();
+        m_DescriptorPool.Destroy();
+        m_BindingSetLayout.Destroy();
+        m_EmptySetLayout.Destroy();
+        m_Device = nullptr;
+    }
+
+    Nova::ShaderBindingSet* BindlessHeap::GetBindingSet()
+    {
+        return &m_BindingSet;
+    }
+
+    const ShaderBindingSetLayout& BindlessHeap::GetBindingSetLayout() const
+    {
+        return m_BindingSetLayout;
+    }
+
+    const ShaderBindingSetLayout& BindlessHeap::GetEmptySetLayout() const
+    {
+        return m_EmptySetLayout;
+    }
+
+    void BindlessHeap::WriteDescriptor(const ResourceType type, const BindlessIndex index, Resource& resource)
+    {
+        VkDescriptorImageInfo imageInfo = {};
+        VkDescriptorBufferInfo bufferInfo = {};
+
+        VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+        write.dstSet = m_BindingSet.GetHandle();
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+
+        switch (type)
+        {
+        case ResourceType::Texture:
+            {
+                // Heap textures are only ever sampled, render graph and uploads leave them in ShaderRead
+                const Texture& texture = (const Texture&)resource;
+                imageInfo.imageView = ((const TextureView*)texture.GetView().Get())->GetHandle();
+                imageInfo.imageLayout = Convert<VkImageLayout>(ResourceState::ShaderRead);
+                write.dstBinding = TextureBinding;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                write.pImageInfo = &imageInfo;
+            }
+            break;
+        case ResourceType::Buffer:
+            {
+                bufferInfo.buffer = ((const Buffer&)resource).GetHandle();
+                bufferInfo.offset = 0;
+                bufferInfo.range = VK_WHOLE_SIZE;
+                write.dstBinding = BufferBinding;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                write.pBufferInfo = &bufferInfo;
+            }
+            break;
+        case ResourceType::Sampler:
+            {
+                imageInfo.sampler = ((const Sampler&)resource).GetHandle();
+                write.dstBinding = SamplerBinding;
+                write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+                write.pImageInfo = &imageInfo;
+            }
+            break;
+        }
+
+        vkUpdateDescriptorSets(m_Device->GetHandle(), 1, &write, 0, nullptr);
+    }
+}
@@ -0,0 +1,32 @@
+﻿#pragma once
+#include "Rendering/BindlessHeap.h"
+#include "DescriptorPool.h"
+#include "ShaderBindingSet.h"
+#include "ShaderBindingSetLayout.h"
+
+namespace Nova::Vulkan
+{
+    class RenderDevice;
+
+    // Update after bind descriptor set, registering a resource writes its slot even while frames using the set are in flight
+    class BindlessHeap final : public Nova::BindlessHeap
+    {
+    public:
+        bool Initialize(const BindlessHeapCreateInfo& createInfo) override;
+        void Destroy() override;
+
+        Nova::ShaderBindingSet* GetBindingSet() override;
+        const ShaderBindingSetLayout& GetBindingSetLayout() const;
+
+        // Fills the sets below SetIndex that a shader using the heap does not declare
+        const ShaderBindingSetLayout& GetEmptySetLayout() const;
+    protected:
+        void WriteDescriptor(ResourceType type, BindlessIndex index, Resource& resource) override;
+    private:
+        RenderDevice* m_Device = nullptr;
+        DescriptorPool m_DescriptorPool;
+        ShaderBindingSetLayout m_BindingSetLayout;
+        ShaderBindingSetLayout m_EmptySetLayout;
+        ShaderBindingSet m_BindingSet;
+    };
+}
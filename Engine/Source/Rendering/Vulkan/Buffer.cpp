@@ -1,5 +1,7 @@
 ﻿#include "Buffer.h"
 #include "RenderDevice.h"
+#include "Rendering/BindlessHeap.h"
+#include "Runtime/Log.h"
 #include <vulkan/vulkan.h>
 #include <vma/vk_mem_alloc.h>
 
@@ -11,8 +13,9 @@ namespace Nova::Vulkan
         switch (usage)
         {
         case BufferUsage::None: return 0;
-        case BufferUsage::VertexBuffer: return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        case BufferUsage::IndexBuffer: return VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        // Geometry buffers copy their content into a new buffer when they grow or compact
+        case BufferUsage::VertexBuffer: return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        case BufferUsage::IndexBuffer: return VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         case BufferUsage::UniformBuffer: return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
         case BufferUsage::StorageBuffer: return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         case BufferUsage::StagingBuffer: return VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -66,25 +69,51 @@ namespace Nova::Vulkan
 
         RenderDevice* device = static_cast<RenderDevice*>(createInfo.device);
         const VmaAllocator allocatorHandle = device->GetAllocator();
-        vmaDestroyBuffer(allocatorHandle, m_Handle, m_Allocation);
+        if (m_Allocation)
+        {
+            vmaDestroyBuffer(allocatorHandle, m_Handle, m_Allocation);
+            device->GetResidencyManager().OnFree(DeviceMemoryCategory::Buffers, m_AllocationSize);
+            m_Handle = nullptr;
+            m_Allocation = nullptr;
+            m_AllocationSize = 0;
+        }
+
         VmaAllocationInfo allocationInfo;
         const VkResult result = vmaCreateBuffer(allocatorHandle, &bufferCreateInfo, &bufferAllocationCreateInfo, &m_Handle, &m_Allocation, &allocationInfo);
         if (result != VK_SUCCESS)
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Warning, "Failed to allocate a buffer of {} bytes: {}", createInfo.size, (int32_t)result);
+            m_Handle = nullptr;
+            m_Allocation = nullptr;
             return false;
+        }
+
+        m_AllocationSize = allocationInfo.size;
+        device->GetResidencyManager().OnAllocate(DeviceMemoryCategory::Buffers, m_AllocationSize);
 
         m_Device = device;
         m_Size = createInfo.size;
         m_Usage = createInfo.usage;
         m_Mapped = createInfo.mapped;
         m_MappedData = m_Mapped ? allocationInfo.pMappedData : nullptr;
+
+        if (Nova::BindlessHeap* bindlessHeap = device->GetBindlessHeap())
+            bindlessHeap->Update(*this);
         return true;
     }
 
     void Buffer::Destroy()
     {
         m_Device->WaitIdle();
+        if (Nova::BindlessHeap* bindlessHeap = m_Device->GetBindlessHeap())
+            bindlessHeap->Release(*this);
         const VmaAllocator allocatorHandle = m_Device->GetAllocator();
         vmaDestroyBuffer(allocatorHandle, m_Handle, m_Allocation);
+        if (m_Allocation)
+            m_Device->GetResidencyManager().OnFree(DeviceMemoryCategory::Buffers, m_AllocationSize);
+        m_Handle = nullptr;
+        m_Allocation = nullptr;
+        m_AllocationSize = 0;
     }
 
     void* Buffer::Map()
@@ -98,8 +127,13 @@ namespace Nova::Vulkan
 
     void Buffer::Unmap(const void* ptr)
     {
-        if (m_Mapped) return;
         const VmaAllocator allocatorHandle = m_Device->GetAllocator();
+        if (m_Mapped)
+        {
+            // Persistently mapped memory is not always host coherent, this makes the writes visible
+            vmaFlushAllocation(allocatorHandle, m_Allocation, 0, VK_WHOLE_SIZE);
+            return;
+        }
         vmaUnmapMemory(allocatorHandle, m_Allocation);
     }
 
@@ -12,6 +12,7 @@
 #include "Shader.h"
 #include "TextureView.h"
 #include "Rendering/ResourceBarrier.h"
+#include "Rendering/Texture.h"
 #include "Utils/VulkanUtils.h"
 
 #include <vulkan/vulkan.h>
@@ -19,8 +20,6 @@
 
 namespace Nova::Vulkan
 {
-    static RenderPassBeginInfo* s_RenderPass = nullptr;
-
     bool CommandBuffer::Allocate(const CommandBufferAllocateInfo& allocateInfo)
     {
         RenderDevice* device = static_cast<RenderDevice*>(allocateInfo.device);
@@ -69,10 +68,39 @@ namespace Nova::Vulkan
         VkCommandBufferBeginInfo info { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
         info.flags = beginInfo.flags;
 
+        VkCommandBufferInheritanceInfo inheritanceInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+        VkCommandBufferInheritanceRenderingInfo renderingInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO };
+        Array<VkFormat> colorFormats;
+
         if (m_Level == CommandBufferLevel::Secondary)
         {
-            VkCommandBufferInheritanceInfo inheritanceInfo { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
-            // TODO: Write api for secondary command buffers
+            // Secondary command buffers continue a dynamic rendering pass, which only needs the attachment formats
+            if (const RenderPassBeginInfo* renderPass = beginInfo.renderPass)
+            {
+                uint32_t sampleCount = 1;
+                for (uint32_t i = 0; i < renderPass->colorAttachmentCount; i++)
+                {
+                    const Nova::TextureView* textureView = renderPass->colorAttachments[i].textureView;
+                    colorFormats.Add(Convert<VkFormat>(textureView->GetFormat()));
+                    sampleCount = textureView->GetTexture()->GetSampleCount();
+                }
+
+                if (renderPass->depthAttachment)
+                {
+                    const Nova::TextureView* textureView = renderPass->depthAttachment->textureView;
+                    renderingInfo.depthAttachmentFormat = Convert<VkFormat>(textureView->GetFormat());
+                    sampleCount = textureView->GetTexture()->GetSampleCount();
+                }
+
+                renderingInfo.colorAttachmentCount = colorFormats.Count();
+                renderingInfo.pColorAttachmentFormats = colorFormats.Data();
+                renderingInfo.rasterizationSamples = (VkSampleCountFlagBits)sampleCount;
+                inheritanceInfo.pNext = &renderingInfo;
+                info.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+                m_RenderArea = renderPass->renderArea;
+            }
+
+            info.pInheritanceInfo = &inheritanceInfo;
         }
 
         if (vkBeginCommandBuffer(m_Handle, &info) != VK_SUCCESS)
@@ -103,8 +131,8 @@ namespace Nova::Vulkan
         clearAttachment.clearValue.color = VkClearColorValue{ { color.r, color.g, color.b, color.a }};
 
         VkClearRect clearRect;
-        clearRect.rect.extent = VkExtent2D{ s_RenderPass->renderArea.width, s_RenderPass->renderArea.height };
-        clearRect.rect.offset = VkOffset2D{ static_cast<int32_t>(s_RenderPass->renderArea.x), static_cast<int32_t>(s_RenderPass->renderArea.y) };
+        clearRect.rect.extent = VkExtent2D{ m_RenderArea.width, m_RenderArea.height };
+        clearRect.rect.offset = VkOffset2D{ static_cast<int32_t>(m_RenderArea.x), static_cast<int32_t>(m_RenderArea.y) };
         clearRect.baseArrayLayer = 0;
         clearRect.layerCount = 1;
         vkCmdClearAttachments(m_Handle, 1, &clearAttachment, 1, &clearRect);
@@ -117,8 +145,8 @@ namespace Nova::Vulkan
         clearAttachment.clearValue.depthStencil = { depth, stencil };
 
         VkClearRect clearRect;
-        clearRect.rect.extent = VkExtent2D{ s_RenderPass->renderArea.width, s_RenderPass->renderArea.height };
-        clearRect.rect.offset = VkOffset2D{ static_cast<int32_t>(s_RenderPass->renderArea.x), static_cast<int32_t>(s_RenderPass->renderArea.y) };
+        clearRect.rect.extent = VkExtent2D{ m_RenderArea.width, m_RenderArea.height };
+        clearRect.rect.offset = VkOffset2D{ static_cast<int32_t>(m_RenderArea.x), static_cast<int32_t>(m_RenderArea.y) };
         clearRect.baseArrayLayer = 0;
         clearRect.layerCount = 1;
         vkCmdClearAttachments(m_Handle, 1, &clearAttachment, 1, &clearRect);
@@ -257,6 +285,9 @@ namespace Nova::Vulkan
 
     void CommandBuffer::MemoryBarrier(const Nova::MemoryBarrier& memoryBarrier)
     {
+        // The whole batch goes in one pipeline barrier, waiting on the union of the stages involved
+        VkPipelineStageFlags srcStageFlags = 0;
+        VkPipelineStageFlags dstStageFlags = 0;
 
         Array<VkImageMemoryBarrier> textureBarriers;
         for (uint32_t i = 0; i < memoryBarrier.textureBarrierCount; i++)
@@ -264,14 +295,26 @@ namespace Nova::Vulkan
             const Nova::TextureBarrier& barrier = memoryBarrier.textureBarriers[i];
             Texture* texture = static_cast<Texture*>(barrier.texture);
             textureBarriers.Add(MakeTextureBarrier(barrier));
+            srcStageFlags |= GetSourcePipelineStageFlags(barrier.sourceAccess);
+            dstStageFlags |= GetDestPipelineStageFlags(barrier.destAccess);
             texture->SetState(barrier.destState);
         }
 
         Array<VkBufferMemoryBarrier> bufferBarriers;
         for (uint32_t i = 0; i < memoryBarrier.bufferBarrierCount; i++)
-            bufferBarriers.Add(MakeBufferBarrier(memoryBarrier.bufferBarriers[i]));
+        {
+            const Nova::BufferBarrier& barrier = memoryBarrier.bufferBarriers[i];
+            Buffer* buffer = static_cast<Buffer*>(barrier.buffer);
+            bufferBarriers.Add(MakeBufferBarrier(barrier));
+            srcStageFlags |= GetSourcePipelineStageFlags(barrier.sourceAccess);
+            dstStageFlags |= GetDestPipelineStageFlags(barrier.destAccess);
+            buffer->SetState(barrier.destState);
+        }
+
+        if (textureBarriers.IsEmpty() && bufferBarriers.IsEmpty())
+            return;
 
-        vkCmdPipelineBarrier(m_Handle, 0, 0, 0, 0, nullptr, bufferBarriers.Count(), bufferBarriers.Data(), textureBarriers.Count(), textureBarriers.Data());
+        vkCmdPipelineBarrier(m_Handle, srcStageFlags, dstStageFlags, 0, 0, nullptr, bufferBarriers.Count(), bufferBarriers.Data(), textureBarriers.Count(), textureBarriers.Data());
     }
 
     void CommandBuffer::BufferCopy(const Nova::Buffer& src, const Nova::Buffer& dest, const size_t srcOffset, const size_t destOffset, const size_t size)
@@ -472,10 +515,7 @@ namespace Nova::Vulkan
 
     void CommandBuffer::BeginRenderPass(const RenderPassBeginInfo& beginInfo)
     {
-        if (!s_RenderPass)
-        {
-            s_RenderPass = new RenderPassBeginInfo(beginInfo);
-        }
+        m_RenderArea = beginInfo.renderArea;
         Array<VkRenderingAttachmentInfo> colorAttachments;
         VkRenderingAttachmentInfo depthAttachment;
         for (uint32_t i = 0; i < beginInfo.colorAttachmentCount; i++)
@@ -487,6 +527,7 @@ namespace Nova::Vulkan
         VkRenderingInfo renderingInfo { VK_STRUCTURE_TYPE_RENDERING_INFO };
         renderingInfo.layerCount = 1;
         renderingInfo.viewMask = 0;
+        renderingInfo.flags = beginInfo.contents == RenderPassContents::SecondaryCommandBuffers ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
         renderingInfo.renderArea.extent = { beginInfo.renderArea.width, beginInfo.renderArea.height };
         renderingInfo.renderArea.offset = { (int32_t)beginInfo.renderArea.x, (int32_t)beginInfo.renderArea.y };
         renderingInfo.colorAttachmentCount = colorAttachments.Count();
@@ -507,8 +548,6 @@ namespace Nova::Vulkan
     void CommandBuffer::EndRenderPass()
     {
         vkCmdEndRendering(m_Handle);
-        delete s_RenderPass;
-        s_RenderPass = nullptr;
     }
 
     VkCommandBuffer CommandBuffer::GetHandle() const
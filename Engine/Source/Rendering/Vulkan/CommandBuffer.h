@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Rendering/CommandBuffer.h"
 #include "Rendering/ShaderStage.h"
+#include "Math/Rect.h"
 
 typedef struct VkCommandBuffer_T* VkCommandBuffer;
 
@@ -58,5 +59,7 @@ namespace Nova::Vulkan
     private:
         RenderDevice* m_Device = nullptr;
         VkCommandBuffer m_Handle = nullptr;
+        // Area of the render pass begun or continued by this command buffer, used by the clears
+        Rect2D<uint32_t> m_RenderArea;
     };
 }
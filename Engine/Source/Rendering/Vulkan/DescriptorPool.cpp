@@ -21,6 +21,8 @@ namespace Nova::Vulkan
 
         VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
         descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        if (createInfo.updateAfterBind)
+            descriptorPoolCreateInfo.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
         descriptorPoolCreateInfo.maxSets = createInfo.maxSets;
         descriptorPoolCreateInfo.pPoolSizes = poolSizes.Data();
         descriptorPoolCreateInfo.poolSizeCount = poolSizes.Count();
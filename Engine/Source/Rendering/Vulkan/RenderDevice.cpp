@@ -21,6 +21,7 @@
 #include <GLFW/glfw3.h>
 #include <vma/vk_mem_alloc.h>
 #include <print>
+#include <cstring>
 
 
 #ifndef VK_LAYER_KHRONOS_VALIDATION_NAME
@@ -238,6 +239,20 @@ namespace Nova::Vulkan
         deviceExtensions.Add(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
         deviceExtensions.Add(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
 
+        // Lets the allocator report per heap budgets from the driver instead of estimating them
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &extensionCount, nullptr);
+        Array<VkExtensionProperties> extensionProperties(extensionCount);
+        vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &extensionCount, extensionProperties.Data());
+        for (uint32_t extensionIndex = 0; extensionIndex < extensionCount; extensionIndex++)
+        {
+            if (std::strcmp(extensionProperties[extensionIndex].extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) != 0)
+                continue;
+            deviceExtensions.Add(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            m_MemoryBudgetSupported = true;
+            break;
+        }
+
         VkPhysicalDeviceShaderDrawParametersFeatures shaderDrawParametersFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DRAW_PARAMETERS_FEATURES };
         shaderDrawParametersFeatures.shaderDrawParameters = true;
 
@@ -251,6 +266,10 @@ namespace Nova::Vulkan
         indexingFeatures.descriptorBindingVariableDescriptorCount = true;
         indexingFeatures.descriptorBindingPartiallyBound = true;
         indexingFeatures.shaderSampledImageArrayNonUniformIndexing = true;
+        indexingFeatures.shaderStorageBufferArrayNonUniformIndexing = true;
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = true;
+        indexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = true;
+        indexingFeatures.descriptorBindingUpdateUnusedWhilePending = true;
 
         VkPhysicalDeviceIndexTypeUint8Features uint8Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INDEX_TYPE_UINT8_FEATURES };
         uint8Features.indexTypeUint8 = true;
@@ -324,6 +343,8 @@ namespace Nova::Vulkan
         allocatorCreateInfo.instance = s_Instance;
         allocatorCreateInfo.physicalDevice = m_PhysicalDevice;
         allocatorCreateInfo.vulkanApiVersion = VK_API_VERSION_1_4;
+        if (m_MemoryBudgetSupported)
+            allocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
         if (vmaCreateAllocator(&allocatorCreateInfo, &m_Allocator) != VK_SUCCESS)
         {
             NOVA_LOG(RenderDevice, Verbosity::Error,"Failed to create allocator!");
@@ -433,6 +454,16 @@ namespace Nova::Vulkan
         .SetBindingTypeSize(BindingType::StorageBuffer, 32)
         .SetMaxSets(4096);
         m_DescriptorPool.Initialize(descriptorPoolCreateInfo);
+
+        BindlessHeapCreateInfo bindlessHeapCreateInfo;
+        bindlessHeapCreateInfo.device = this;
+        if (!m_BindlessHeap.Initialize(bindlessHeapCreateInfo))
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to create bindless heap!");
+            return false;
+        }
+
+        m_ParallelRecording = true;
         return true;
     }
 
@@ -448,6 +479,23 @@ namespace Nova::Vulkan
             m_Frames[imageIndex].commandBuffer.Free();
         }
 
+        for (auto& frameCommandPools : m_ThreadCommandPools)
+        {
+            for (ThreadCommandPool& threadCommandPool : frameCommandPools)
+            {
+                if (!threadCommandPool.pool.GetHandle())
+                    continue;
+
+                // Destroying the pool frees its command buffers
+                for (CommandBuffer* commandBuffer : threadCommandPool.commandBuffers)
+                    delete commandBuffer;
+                threadCommandPool.commandBuffers.Clear();
+                threadCommandPool.usedCount = 0;
+                threadCommandPool.pool.Destroy();
+            }
+        }
+
+        m_BindlessHeap.Destroy();
         m_CommandPool.Destroy();
         m_TransferPool.Destroy();
         m_ComputePool.Destroy();
@@ -479,6 +527,9 @@ namespace Nova::Vulkan
         Fence& fence = m_Frames[m_LastFrameIndex].fence;
         fence.Wait(FENCE_WAIT_INFINITE);
         fence.Reset();
+        m_BindlessHeap.NewFrame();
+        // Budgets are cached by the allocator and refreshed when the frame index changes
+        vmaSetCurrentFrameIndex(m_Allocator, (uint32_t)GetResidencyManager().GetFrameIndex());
 
         const Semaphore& presentSemaphore = m_Frames[m_LastFrameIndex].presentSemaphore;
         if (!m_Swapchain.AcquireNextImage(&presentSemaphore, nullptr, m_CurrentFrameIndex))
@@ -487,6 +538,15 @@ namespace Nova::Vulkan
             return false;
         }
 
+        // The fence wait above guarantees the secondary command buffers last recorded for this frame are done
+        for (ThreadCommandPool& threadCommandPool : m_ThreadCommandPools[m_CurrentFrameIndex])
+        {
+            if (threadCommandPool.usedCount == 0)
+                continue;
+            threadCommandPool.pool.Reset();
+            threadCommandPool.usedCount = 0;
+        }
+
         CommandBuffer& commandBuffer = m_Frames[m_CurrentFrameIndex].commandBuffer;
         if (!commandBuffer.Begin({ CommandBufferUsageFlagBits::OneTimeSubmit }))
             return false;
@@ -749,6 +809,28 @@ namespace Nova::Vulkan
         return m_Allocator;
     }
 
+    bool RenderDevice::GetMemoryHeapBudgets(Array<DeviceHeapBudget>& heaps) const
+    {
+        if (!m_Allocator) return false;
+
+        const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+        vmaGetMemoryProperties(m_Allocator, &memoryProperties);
+
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+        vmaGetHeapBudgets(m_Allocator, budgets);
+
+        for (uint32_t heapIndex = 0; heapIndex < memoryProperties->memoryHeapCount; heapIndex++)
+        {
+            DeviceHeapBudget heap;
+            heap.size = memoryProperties->memoryHeaps[heapIndex].size;
+            heap.budget = budgets[heapIndex].budget;
+            heap.usage = budgets[heapIndex].usage;
+            heap.deviceLocal = memoryProperties->memoryHeaps[heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+            heaps.Add(heap);
+        }
+        return true;
+    }
+
     VkPhysicalDevice RenderDevice::GetPhysicalDevice() const
     {
         return m_PhysicalDevice;
@@ -800,6 +882,11 @@ namespace Nova::Vulkan
         return &m_DescriptorPool;
     }
 
+    Nova::BindlessHeap* RenderDevice::GetBindlessHeap()
+    {
+        return &m_BindlessHeap;
+    }
+
     Semaphore& RenderDevice::GetCurrentSubmitSemaphore()
     {
         return m_Frames[m_CurrentFrameIndex].submitSemaphore;
@@ -820,6 +907,40 @@ namespace Nova::Vulkan
         return &m_Frames[m_CurrentFrameIndex].commandBuffer;
     }
 
+    Nova::CommandBuffer* RenderDevice::AllocateSecondaryCommandBuffer(const uint32_t threadIndex)
+    {
+        NOVA_ASSERT(threadIndex < MaxRecordingThreads, "Recording thread index out of range!");
+        ThreadCommandPool& threadCommandPool = m_ThreadCommandPools[m_CurrentFrameIndex][threadIndex];
+
+        if (!threadCommandPool.pool.GetHandle())
+        {
+            CommandPoolCreateInfo commandPoolCreateInfo;
+            commandPoolCreateInfo.device = this;
+            commandPoolCreateInfo.flags = CommandPoolCreateFlagBits::Transient;
+            commandPoolCreateInfo.queue = &m_GraphicsQueue;
+            if (!threadCommandPool.pool.Initialize(commandPoolCreateInfo))
+            {
+                NOVA_LOG(RenderDevice, Verbosity::Error, "Failed to create command pool for recording thread {}!", threadIndex);
+                return nullptr;
+            }
+        }
+
+        // Command buffers are kept across frames, resetting the pool is enough to record them again
+        if (threadCommandPool.usedCount < threadCommandPool.commandBuffers.Count())
+            return threadCommandPool.commandBuffers[threadCommandPool.usedCount++];
+
+        CommandBuffer* commandBuffer = new CommandBuffer();
+        if (!commandBuffer->Allocate({ this, &threadCommandPool.pool, CommandBufferLevel::Secondary }))
+        {
+            delete commandBuffer;
+            return nullptr;
+        }
+
+        threadCommandPool.commandBuffers.Add(commandBuffer);
+        threadCommandPool.usedCount++;
+        return commandBuffer;
+    }
+
     uint32_t RenderDevice::GetCurrentFrameIndex() const
     {
         return m_CurrentFrameIndex;
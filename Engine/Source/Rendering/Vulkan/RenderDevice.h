@@ -6,6 +6,7 @@
 #include "CommandPool.h"
 #include "CommandBuffer.h"
 #include "DescriptorPool.h"
+#include "BindlessHeap.h"
 #include "Fence.h"
 #include "Semaphore.h"
 
@@ -25,6 +26,14 @@ namespace Nova::Vulkan
         CommandBuffer commandBuffer;
     };
 
+    // Command pool of one recording thread for one frame in flight, with the secondary command buffers allocated from it
+    struct ThreadCommandPool
+    {
+        CommandPool pool;
+        Array<CommandBuffer*> commandBuffers;
+        uint32_t usedCount = 0;
+    };
+
     class RenderDevice final : public Nova::RenderDevice
     {
     public:
@@ -68,11 +77,14 @@ namespace Nova::Vulkan
         Queue* GetComputeQueue() override;
         Queue* GetTransferQueue() override;
         DescriptorPool* GetDescriptorPool();
+        Nova::BindlessHeap* GetBindlessHeap() override;
+        bool GetMemoryHeapBudgets(Array<DeviceHeapBudget>& heaps) const override;
 
         Semaphore& GetCurrentSubmitSemaphore();
         Semaphore& GetCurrentPresentSemaphore();
         Fence& GetCurrentFence();
         Nova::CommandBuffer* GetCurrentCommandBuffer() override;
+        Nova::CommandBuffer* AllocateSecondaryCommandBuffer(uint32_t threadIndex) override;
 
 
         uint32_t GetCurrentFrameIndex() const override;
@@ -87,15 +99,19 @@ namespace Nova::Vulkan
         CommandPool m_TransferPool;
         CommandPool m_ComputePool;
         DescriptorPool m_DescriptorPool;
+        BindlessHeap m_BindlessHeap;
 
         Queue m_GraphicsQueue;
         Queue m_PresentQueue;
         Queue m_ComputeQueue;
         Queue m_TransferQueue;
         Frame m_Frames[3];
+        // Created on first use by each thread, reset when their frame comes around again
+        ThreadCommandPool m_ThreadCommandPools[3][MaxRecordingThreads];
 
         uint32_t m_CurrentFrameIndex = 0;
         uint32_t m_LastFrameIndex = 0;
+        bool m_MemoryBudgetSupported = false;
 
 #if defined(NOVA_DEV) || defined(NOVA_DEBUG)
         static inline VkDebugUtilsMessengerEXT s_DebugMessenger = nullptr;
@@ -1,6 +1,7 @@
 ﻿#include "Sampler.h"
 #include "RenderDevice.h"
 #include "Conversions.h"
+#include "Rendering/BindlessHeap.h"
 #include <vulkan/vulkan.h>
 
 
@@ -46,6 +47,8 @@ namespace Nova::Vulkan
 
     void Sampler::Destroy()
     {
+        if (Nova::BindlessHeap* bindlessHeap = m_Device->GetBindlessHeap())
+            bindlessHeap->Release(*this);
         const VkDevice deviceHandle = m_Device->GetHandle();
         vkDestroySampler(deviceHandle, m_Handle, nullptr);
     }
@@ -3,6 +3,7 @@
 #include "Rendering/SlangCommon.h"
 #include "DescriptorPool.h"
 #include "RenderDevice.h"
+#include "BindlessHeap.h"
 #include "Conversions.h"
 #include "Runtime/Application.h"
 
@@ -22,6 +23,7 @@ namespace Nova::Vulkan
         m_EntryPoints.Clear();
         m_ShaderModules.Clear();
         m_BindingSetLayouts.Clear();
+        m_UsesBindlessHeap = false;
 
         Application& application = Application::GetCurrentApplication();
         slang::IGlobalSession* slangSession = application.GetSlangSession();
@@ -220,6 +222,13 @@ namespace Nova::Vulkan
 
             for (const SpvReflectDescriptorSet* set : sets)
             {
+                // The heap set is owned by the device, shaders only reference its layout
+                if (set->set == BindlessHeap::SetIndex)
+                {
+                    m_UsesBindlessHeap = true;
+                    continue;
+                }
+
                 Ref<ShaderBindingSetLayout>* bindingSetLayout = m_BindingSetLayouts.Single([&set](const Ref<ShaderBindingSetLayout>& layout) { return layout->GetSetIndex() == set->set; });
                 if (bindingSetLayout)
                 {
@@ -259,11 +268,8 @@ namespace Nova::Vulkan
 
         RenderDevice* device = (RenderDevice*)createInfo.device;
 
-        Array<VkDescriptorSetLayout> descriptorSetLayouts = m_BindingSetLayouts.Transform<VkDescriptorSetLayout>(
-            [](const Ref<ShaderBindingSetLayout>& setLayout)
-        {
-            return setLayout->GetHandle();
-        });
+        m_Device = device;
+        Array<VkDescriptorSetLayout> descriptorSetLayouts = GetDescriptorSetLayouts();
 
         Array<VkPushConstantRange> pushConstantRanges = ranges.Transform<VkPushConstantRange>([](const ShaderPushConstantRange& range)
         {
@@ -282,8 +288,6 @@ namespace Nova::Vulkan
 
         vkDestroyPipelineLayout(device->GetHandle(), m_PipelineLayout, nullptr);
         vkCreatePipelineLayout(device->GetHandle(), &pipelineLayoutCreateInfo, nullptr, &m_PipelineLayout);
-
-        m_Device = device;
         return true;
     }
 
@@ -372,12 +376,36 @@ namespace Nova::Vulkan
         return m_PipelineLayout;
     }
 
+    bool Shader::UsesBindlessHeap() const
+    {
+        return m_UsesBindlessHeap;
+    }
+
     Array<VkDescriptorSetLayout> Shader::GetDescriptorSetLayouts() const
     {
-        return m_BindingSetLayouts.Transform<VkDescriptorSetLayout>(
-            [](const Ref<ShaderBindingSetLayout>& bindingSetLayout)
-            {
-                return bindingSetLayout->GetHandle();
-            });
+        if (!m_UsesBindlessHeap)
+        {
+            return m_BindingSetLayouts.Transform<VkDescriptorSetLayout>(
+                [](const Ref<ShaderBindingSetLayout>& bindingSetLayout)
+                {
+                    return bindingSetLayout->GetHandle();
+                });
+        }
+
+        // Pipeline layouts are indexed by set, sets the shader skips before the heap get an empty layout
+        const BindlessHeap* bindlessHeap = (const BindlessHeap*)m_Device->GetBindlessHeap();
+        Array<VkDescriptorSetLayout> descriptorSetLayouts(BindlessHeap::SetIndex + 1);
+        for (VkDescriptorSetLayout& descriptorSetLayout : descriptorSetLayouts)
+            descriptorSetLayout = bindlessHeap->GetEmptySetLayout().GetHandle();
+
+        for (const Ref<ShaderBindingSetLayout>& bindingSetLayout : m_BindingSetLayouts)
+        {
+            const uint32_t setIndex = bindingSetLayout->GetSetIndex();
+            NOVA_ASSERT(setIndex < BindlessHeap::SetIndex, "Shaders using the bindless heap must declare their sets below it!");
+            descriptorSetLayouts[setIndex] = bindingSetLayout->GetHandle();
+        }
+
+        descriptorSetLayouts[BindlessHeap::SetIndex] = bindlessHeap->GetBindingSetLayout().GetHandle();
+        return descriptorSetLayouts;
     }
 }
@@ -30,6 +30,8 @@ namespace Nova::Vulkan
         ShaderStageFlags GetShaderStageFlags() const;
         VkPipelineLayout GetPipelineLayout() const;
 
+        // True when the shader imports Bindless.slang, its pipeline layout then includes the heap set
+        bool UsesBindlessHeap() const;
         Array<VkDescriptorSetLayout> GetDescriptorSetLayouts() const;
     private:
         RenderDevice* m_Device = nullptr;
@@ -43,5 +45,6 @@ namespace Nova::Vulkan
         Array<ShaderModule> m_ShaderModules;
         Array<Ref<ShaderBindingSetLayout>> m_BindingSetLayouts;
         VkPipelineLayout m_PipelineLayout = nullptr;
+        bool m_UsesBindlessHeap = false;
     };
 }
@@ -29,6 +29,13 @@ namespace Nova::Vulkan
                                        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
                                        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
                                        : 0;
+
+            if (m_UpdateAfterBind)
+            {
+                bindingFlag = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                              VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                              VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+            }
             bindingFlags.Add(bindingFlag);
             bindings.Add(vkBinding);
         }
@@ -38,7 +45,7 @@ namespace Nova::Vulkan
         bindingFlagCreateInfo.pBindingFlags = bindingFlags.Data();
 
         VkDescriptorSetLayoutCreateInfo layoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
-        layoutCreateInfo.flags = 0;
+        layoutCreateInfo.flags = m_UpdateAfterBind ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT : 0;
         layoutCreateInfo.pNext = &bindingFlagCreateInfo;
         layoutCreateInfo.bindingCount = bindings.Count();
         layoutCreateInfo.pBindings = bindings.Data();
@@ -16,9 +16,13 @@ namespace Nova::Vulkan
         bool Build() override;
 
         const VkDescriptorSetLayout& GetHandle() const;
+
+        // Every binding becomes partially bound and writable while in use, the sets need an update after bind pool
+        void SetUpdateAfterBind(bool updateAfterBind) { m_UpdateAfterBind = updateAfterBind; }
     private:
         RenderDevice* m_Device = nullptr;
         VkDescriptorSetLayout m_Handle = nullptr;
+        bool m_UpdateAfterBind = false;
     };
 }
 
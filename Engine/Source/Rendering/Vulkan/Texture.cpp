@@ -3,6 +3,7 @@
 #include "RenderDevice.h"
 #include "Conversions.h"
 #include "Buffer.h"
+#include "Rendering/BindlessHeap.h"
 #include "Runtime/Log.h"
 #include "Utils/TextureUtils.h"
 #include <vulkan/vulkan.h>
@@ -22,7 +23,15 @@ namespace Nova::Vulkan
 
         RenderDevice* device = static_cast<RenderDevice*>(createInfo.device);
         const VmaAllocator allocatorHandle = device->GetAllocator();
-        vmaDestroyImage(allocatorHandle, m_Image, m_Allocation);
+        if (m_Allocation)
+        {
+            // Recreated in place, the previous image goes first so a streamed texture never holds both
+            vmaDestroyImage(allocatorHandle, m_Image, m_Allocation);
+            device->GetResidencyManager().OnFree(GetMemoryCategory(), m_AllocationSize);
+            m_Image = nullptr;
+            m_Allocation = nullptr;
+            m_AllocationSize = 0;
+        }
 
         const TextureDimension dimension = TextureUtils::GetTextureDimension(createInfo.width, createInfo.height, createInfo.depth);
 
@@ -44,14 +53,20 @@ namespace Nova::Vulkan
         allocationCreateInfo.priority = 1.0f;
         allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 
+        VmaAllocationInfo allocationInfo;
         const VkResult result = vmaCreateImage(allocatorHandle,
            &imageCreateInfo,
            &allocationCreateInfo,
            &m_Image,
            &m_Allocation,
-           nullptr);
+           &allocationInfo);
         if (result != VK_SUCCESS)
+        {
+            NOVA_LOG(RenderDevice, Verbosity::Warning, "Failed to allocate a {}x{} texture: {}", createInfo.width, createInfo.height, (int32_t)result);
+            m_Image = nullptr;
+            m_Allocation = nullptr;
             return false;
+        }
 
         const auto& usageFlags = createInfo.usageFlags;
         const bool isColorAttachment = usageFlags & TextureUsageFlagBits::ColorAttachment;
@@ -76,6 +91,8 @@ namespace Nova::Vulkan
         m_SampleCount = createInfo.sampleCount;
         m_UsageFlags = createInfo.usageFlags;
         m_Dimension = dimension;
+        m_AllocationSize = allocationInfo.size;
+        device->GetResidencyManager().OnAllocate(GetMemoryCategory(), m_AllocationSize);
 
         TextureViewCreateInfo tvCreateInfo;
         tvCreateInfo.device = device;
@@ -116,16 +133,26 @@ namespace Nova::Vulkan
         barrier.destQueue = nullptr;
         barrier.destQueue = nullptr;
         RenderDevice::ImmediateTextureBarrier(device, barrier);
+
+        // A registered texture recreated in place, e.g. on resize, keeps its index
+        if (Nova::BindlessHeap* bindlessHeap = device->GetBindlessHeap())
+            bindlessHeap->Update(*this);
         return true;
     }
 
     void Texture::Destroy()
     {
+        if (Nova::BindlessHeap* bindlessHeap = m_Device->GetBindlessHeap())
+            bindlessHeap->Release(*this);
         if (m_View) m_View->Destroy();
         const VmaAllocator allocatorHandle = m_Device->GetAllocator();
         vmaDestroyImage(allocatorHandle, m_Image, m_Allocation);
+        if (m_Allocation)
+            m_Device->GetResidencyManager().OnFree(GetMemoryCategory(), m_AllocationSize);
         m_Device = nullptr;
         m_Image = nullptr;
+        m_Allocation = nullptr;
+        m_AllocationSize = 0;
     }
 
     bool Texture::IsValid()
@@ -30,5 +30,6 @@ namespace Nova::Vulkan
         RenderDevice* m_Device = nullptr;
         VkImage m_Image = nullptr;
         VmaAllocation m_Allocation = nullptr;
+        uint64_t m_AllocationSize = 0;
     };
 }
@@ -1,5 +1,9 @@
 ﻿#include "Application.h"
+#include "Arena.h"
+#include "Log.h"
+#include "Memory.h"
 #include "Path.h"
+#include "Profiler.h"
 #include "Scene.h"
 #include "Time.h"
 #include "Window.h"
@@ -7,7 +11,10 @@
 #include "Components/Camera.h"
 #include "Editor/HierarchyWindow.h"
 #include "Editor/InspectorWindow.h"
+#include "Editor/MemoryWindow.h"
+#include "Editor/ProfilerWindow.h"
 #include "Rendering/DebugRenderer.h"
+#include "Rendering/SpriteBatchRenderer.h"
 #include "Rendering/Shader.h"
 #include "Rendering/CommandBuffer.h"
 #include "Rendering/Swapchain.h"
@@ -15,7 +22,11 @@
 #include "Rendering/RenderPass.h"
 #include <imgui.h>
 #include <slang/slang.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
+NOVA_DECLARE_LOG_CATEGORY_STATIC(Application, "APPLICATION")
 
 namespace Nova
 {
@@ -26,6 +37,7 @@ namespace Nova
         const Array<String>& includes =  {},
         const Array<Pair<String, String>>& defines = {})
     {
+        const Memory::ScopedTag memoryTag(MemoryTag::Assets);
         const ShaderEntryPoint entryPoints[]
         {
             {"vert", ShaderStageFlagBits::Vertex},
@@ -50,6 +62,7 @@ namespace Nova
 
     static Ref<TextureAsset> LoadTextureBasic(AssetDatabase& database, StringView filepath, const String& assetName)
     {
+        const Memory::ScopedTag memoryTag(MemoryTag::Assets);
         Ref<TextureAsset> texture = database.CreateAsset<TextureAsset>(assetName);
         if (!texture->LoadFromFile(Path::GetEngineAssetPath(filepath)))
         {
@@ -61,9 +74,27 @@ namespace Nova
 
     void Application::Run()
     {
-        const ApplicationConfiguration configuration = GetConfiguration();
+        m_Configuration = GetConfiguration();
+        const ApplicationConfiguration& configuration = m_Configuration;
         const RenderDeviceType deviceType = GetRenderDeviceType();
 
+        NOVA_PROFILE_THREAD("Main");
+        Log::Initialize();
+        if (!m_ThreadPool.Initialize())
+        {
+            NOVA_LOG(Application, Verbosity::Error, "Failed to create worker threads");
+            Destroy();
+            return;
+        }
+
+        if (configuration.headless)
+        {
+            OnInit();
+            UpdateHeadless();
+            Destroy();
+            return;
+        }
+
         // Creating window
         WindowCreateInfo windowCreateInfo;
         windowCreateInfo.title = configuration.applicationName;
@@ -112,6 +143,12 @@ namespace Nova
             swapchain->ResizedEvent.BindMember(m_RenderTarget.Get(), &RenderTarget::Resize);
         }
 
+        if (!m_RenderGraph.Initialize(m_Device))
+        {
+            Destroy();
+            return;
+        }
+
         // Creating imgui renderer
         m_ImGuiRenderer = CreateImGuiRenderer(m_Window, m_Device, configuration.msaaSamples);
         if (!m_ImGuiRenderer)
@@ -150,7 +187,7 @@ namespace Nova
         }
 
         // Load engine shaders
-        LoadShaderBasic(m_AssetDatabase, m_Device, "Sprite", "Shaders/Sprite.slang");
+        Ref<Shader> spriteBatchShader = LoadShaderBasic(m_AssetDatabase, m_Device, "SpriteBatch", "Shaders/SpriteBatch.slang");
         //LoadShaderBasic(m_AssetDatabase, m_Device, "BlinnPhongOpaque", "Shaders/BlinnPhong.slang");
         //LoadShaderBasic(m_AssetDatabase, m_Device, "BlinnPhongTransparent", "Shaders/BlinnPhong.slang", {}, {{"NOVA_MATERIAL_TRANSPARENT"}});
         //LoadShaderBasic(m_AssetDatabase, m_Device, "BlinnPhongCutout", "Shaders/BlinnPhong.slang", {}, {{"NOVA_MATERIAL_CUTOUT"}});
@@ -169,16 +206,24 @@ namespace Nova
         DebugRendererCreateInfo debugRendererCreateInfo;
         debugRendererCreateInfo.device = m_Device;
         debugRendererCreateInfo.shader = debugShader;
-        debugRendererCreateInfo.maxVertices = 64;
         if (!DebugRenderer::Initialize(debugRendererCreateInfo))
         {
             Destroy();
             return;
         }
 
+        SpriteBatchRendererCreateInfo spriteBatchRendererCreateInfo;
+        spriteBatchRendererCreateInfo.device = m_Device;
+        spriteBatchRendererCreateInfo.shader = spriteBatchShader;
+        // Needs a bindless heap, backends without one run without sprites
+        if (!SpriteBatchRenderer::Initialize(spriteBatchRendererCreateInfo))
+            NOVA_LOG(Application, Verbosity::Warning, "Failed to initialize the sprite batch renderer, sprites will not be drawn");
+
 
         m_EditorWindows.Add(EditorWindow::CreateWindow<HierarchyWindow>());
         m_EditorWindows.Add(EditorWindow::CreateWindow<InspectorWindow>());
+        m_EditorWindows.Add(EditorWindow::CreateWindow<ProfilerWindow>());
+        m_EditorWindows.Add(EditorWindow::CreateWindow<MemoryWindow>());
 
         OnInit();
         Update();
@@ -190,6 +235,16 @@ namespace Nova
         m_IsRunning = false;
     }
 
+    void Application::SetExitCode(const int32_t exitCode)
+    {
+        m_ExitCode = exitCode;
+    }
+
+    int32_t Application::GetExitCode() const
+    {
+        return m_ExitCode;
+    }
+
     Application& Application::GetCurrentApplication()
     {
         extern Application* g_Application;
@@ -200,30 +255,99 @@ namespace Nova
     {
         while (m_IsRunning)
         {
+            NOVA_PROFILE_FRAME();
+            Memory::NewFrame();
+            FrameAllocator::NewFrame();
             const double currentTime = Time::Get();
             m_DeltaTime = currentTime - m_LastTime;
             m_LastTime = currentTime;
-            m_Window->PollEvents();
+            {
+                NOVA_PROFILE_SCOPE("Window::PollEvents");
+                m_Window->PollEvents();
+            }
+
+            {
+                NOVA_PROFILE_SCOPE("Application::OnUpdate");
+                for (Ref<EditorWindow>& window : m_EditorWindows)
+                    window->OnUpdate(m_DeltaTime);
 
-            for (Ref<EditorWindow>& window : m_EditorWindows)
-                window->OnUpdate(m_DeltaTime);
+                m_SceneManager.OnUpdate(m_DeltaTime);
+                OnUpdate(m_DeltaTime);
+            }
 
-            m_SceneManager.OnUpdate(m_DeltaTime);
-            OnUpdate(m_DeltaTime);
+            {
+                NOVA_PROFILE_SCOPE("AudioDevice::Update");
+                m_AudioDevice->Update(m_DeltaTime);
+            }
 
-            m_ImGuiRenderer->BeginFrame();
-            ImGui::DockSpaceOverViewport(ImGui::GetID("Dockspace"), ImGui::GetMainViewport(), ImGuiDockNodeFlags_PassthruCentralNode);
-            for (Ref<EditorWindow>& window : m_EditorWindows)
-                window->OnGui();
-            OnGUI();
-            m_ImGuiRenderer->EndFrame();
+            {
+                NOVA_PROFILE_SCOPE("Application::OnGUI");
+                m_ImGuiRenderer->BeginFrame();
+                ImGui::DockSpaceOverViewport(ImGui::GetID("Dockspace"), ImGui::GetMainViewport(), ImGuiDockNodeFlags_PassthruCentralNode);
+                for (Ref<EditorWindow>& window : m_EditorWindows)
+                    window->OnGui();
+                OnGUI();
+                m_ImGuiRenderer->EndFrame();
+            }
 
             Render();
         }
     }
 
+    void Application::UpdateHeadless()
+    {
+        const double tickDuration = 1.0 / (double)std::max(m_Configuration.tickRate, 1u);
+        double nextTickTime = Time::Get();
+        m_LastTime = nextTickTime;
+
+        while (m_IsRunning)
+        {
+            NOVA_PROFILE_FRAME();
+            Memory::NewFrame();
+            FrameAllocator::NewFrame();
+            const double tickBegin = Time::Get();
+
+            // Simulation always advances by a whole tick, even when the loop runs faster or falls behind
+            m_DeltaTime = tickDuration;
+            m_LastTime = tickBegin;
+            {
+                NOVA_PROFILE_SCOPE("Application::OnUpdate");
+                m_SceneManager.OnUpdate(m_DeltaTime);
+                OnUpdate(m_DeltaTime);
+            }
+
+            const double tickEnd = Time::Get();
+            m_TickStatistics.Add(tickEnd - tickBegin);
+
+            if (m_Configuration.maxSpeed)
+                continue;
+
+            // A late tick starts the next one right away, without trying to catch up on the missed ones
+            nextTickTime = std::max(nextTickTime + tickDuration, tickEnd);
+            if (nextTickTime > tickEnd)
+                std::this_thread::sleep_for(std::chrono::duration<double>(nextTickTime - tickEnd));
+        }
+
+        NOVA_LOG(Application, Verbosity::Info, "{} ticks, average {:.3f} ms, min {:.3f} ms, max {:.3f} ms",
+            m_TickStatistics.tickCount,
+            m_TickStatistics.GetAverageTime() * 1000.0,
+            m_TickStatistics.minTime * 1000.0,
+            m_TickStatistics.maxTime * 1000.0);
+    }
+
     void Application::Render()
     {
+        NOVA_PROFILE_SCOPE("Application::Render");
+        const Memory::ScopedTag memoryTag(MemoryTag::Rendering);
+
+        // Compact the shared geometry after unloads, nothing is recording yet
+        GeometryBuffer& geometryBuffer = m_Device->GetGeometryBuffer();
+        if (geometryBuffer.NeedsDefragment())
+            geometryBuffer.Defragment();
+
+        // Textures are streamed in place, this has to happen before recording too
+        m_Device->GetResidencyManager().Update();
+
         if (m_Device->BeginFrame())
         {
             CommandBuffer* cmdBuffer = m_Device->GetCurrentCommandBuffer();
@@ -234,71 +358,127 @@ namespace Nova
                 return;
             }
 
+            Scene* scene = m_SceneManager.GetActiveScene();
+            Camera* camera = scene ? scene->GetFirstComponent<Camera>() : nullptr;
+
+            // Sprite renderers submit their sprite while pre-rendering, the batch is drawn with the scene
+            SpriteBatchRenderer::BeginFrame(camera ? camera->GetViewProjectionMatrix() : Matrix4::Identity);
             m_SceneManager.OnPreRender(*cmdBuffer);
             OnPreRender(*cmdBuffer);
+            SpriteBatchRenderer::EndFrame(*cmdBuffer);
 
-            if (Scene* scene = m_SceneManager.GetActiveScene())
+            if (camera)
             {
-                if (Camera* camera = scene->GetFirstComponent<Camera>())
-                {
-                    DebugRenderer::Begin(camera->GetViewProjectionMatrix());
-                    m_SceneManager.OnDrawDebug();
-                    OnDrawDebug();
-                    DebugRenderer::End(*cmdBuffer);
-                }
+                DebugRenderer::Begin(camera->GetViewProjectionMatrix());
+                m_SceneManager.OnDrawDebug();
+                OnDrawDebug();
+                DebugRenderer::End(*cmdBuffer);
             }
 
 
             Swapchain* swapchain = m_Device->GetSwapchain();
+            const Rect2D<uint32_t> renderArea = {0, 0, GetWindowWidth(), GetWindowHeight()};
+
+            // Redeclared every frame, the graph is only compiled again when its passes or resources change
+            m_RenderGraph.Reset();
+            const RenderGraphHandle colorTarget = m_RenderGraph.ImportTexture("SceneColor", m_RenderTarget->GetColorTexture());
+            const RenderGraphHandle depthTarget = m_RenderGraph.ImportTexture("SceneDepth", m_RenderTarget->GetDepthTexture());
+
+            m_RenderGraph.AddPass("Scene", [this, swapchain, renderArea, camera](const RenderGraph&, CommandBuffer& cmdBuffer)
+            {
+                RenderPassAttachmentInfo colorAttachment;
+                colorAttachment.type = RenderPassAttachmentType::Color;
+                colorAttachment.loadOp = LoadOperation::Clear;
+                colorAttachment.storeOp = StoreOperation::Store;
+                colorAttachment.clearValue.color = Color::Black;
+                colorAttachment.resolveMode = ResolveMode::Average;
+                colorAttachment.textureView = m_RenderTarget->GetColorTextureView();
+                colorAttachment.resolveTextureView = swapchain->GetTextureView();
+
+                RenderPassAttachmentInfo depthAttachment;
+                depthAttachment.type = RenderPassAttachmentType::Depth;
+                depthAttachment.loadOp = LoadOperation::Clear;
+                depthAttachment.storeOp = StoreOperation::Store;
+                depthAttachment.clearValue.depth = 1.0f;
+                depthAttachment.clearValue.stencil = 0;
+                depthAttachment.resolveMode = ResolveMode::Average;
+                depthAttachment.textureView = m_RenderTarget->GetDepthTextureView();
+
+                RenderPassBeginInfo renderPassBeginInfo;
+                renderPassBeginInfo.renderArea = renderArea;
+                renderPassBeginInfo.colorAttachmentCount = 1;
+                renderPassBeginInfo.colorAttachments = &colorAttachment;
+                renderPassBeginInfo.depthAttachment = &depthAttachment;
+
+                const bool parallelRecording = m_Configuration.parallelRecording
+                    && m_Device->SupportsParallelRecording()
+                    && m_ThreadPool.GetThreadCount() <= RenderDevice::MaxRecordingThreads;
+
+                if (!parallelRecording)
+                {
+                    cmdBuffer.BeginRenderPass(renderPassBeginInfo);
+                    m_SceneManager.OnRender(cmdBuffer);
+                    if (camera) SpriteBatchRenderer::Render(cmdBuffer);
+                    OnRender(cmdBuffer);
+                    DebugRenderer::Render(cmdBuffer);
+                    cmdBuffer.EndRenderPass();
+                    return;
+                }
+
+                // A pass with secondary contents cannot record draws inline, the sprite, application and debug
+                // draws get their own secondary command buffer recorded after the scene ones
+                renderPassBeginInfo.contents = RenderPassContents::SecondaryCommandBuffers;
+                cmdBuffer.BeginRenderPass(renderPassBeginInfo);
+
+                Array<const CommandBuffer*> secondaryCmdBuffers;
+                m_SceneManager.OnRender(renderPassBeginInfo, secondaryCmdBuffers);
+
+                if (CommandBuffer* mainCmdBuffer = m_Device->AllocateSecondaryCommandBuffer(0))
+                {
+                    CommandBufferBeginInfo beginInfo;
+                    beginInfo.flags = CommandBufferUsageFlagBits::OneTimeSubmit | CommandBufferUsageFlagBits::RenderPassContinue;
+                    beginInfo.renderPass = &renderPassBeginInfo;
+                    if (mainCmdBuffer->Begin(beginInfo))
+                    {
+                        if (camera) SpriteBatchRenderer::Render(*mainCmdBuffer);
+                        OnRender(*mainCmdBuffer);
+                        DebugRenderer::Render(*mainCmdBuffer);
+                        mainCmdBuffer->End();
+                        secondaryCmdBuffers.Add(mainCmdBuffer);
+                    }
+                }
 
-            RenderPassAttachmentInfo colorAttachment;
-            colorAttachment.type = RenderPassAttachmentType::Color;
-            colorAttachment.loadOp = LoadOperation::Clear;
-            colorAttachment.storeOp = StoreOperation::Store;
-            colorAttachment.clearValue.color = Color::Black;
-            colorAttachment.resolveMode = ResolveMode::Average;
-            colorAttachment.textureView = m_RenderTarget->GetColorTextureView();
-            colorAttachment.resolveTextureView = swapchain->GetTextureView();
-
-            RenderPassAttachmentInfo depthAttachment;
-            depthAttachment.type = RenderPassAttachmentType::Depth;
-            depthAttachment.loadOp = LoadOperation::Clear;
-            depthAttachment.storeOp = StoreOperation::Store;
-            depthAttachment.clearValue.depth = 1.0f;
-            depthAttachment.clearValue.stencil = 0;
-            depthAttachment.resolveMode = ResolveMode::Average;
-            depthAttachment.textureView = m_RenderTarget->GetDepthTextureView();
-
-            RenderPassBeginInfo renderPassBeginInfo;
-            renderPassBeginInfo.renderArea = {0, 0, GetWindowWidth(), GetWindowHeight()};
-            renderPassBeginInfo.colorAttachmentCount = 1;
-            renderPassBeginInfo.colorAttachments = &colorAttachment;
-            renderPassBeginInfo.depthAttachment = &depthAttachment;
-
-            cmdBuffer->BeginRenderPass(renderPassBeginInfo);
-            m_SceneManager.OnRender(*cmdBuffer);
-            OnRender(*cmdBuffer);
-            DebugRenderer::Render(*cmdBuffer);
-            cmdBuffer->EndRenderPass();
-
-
-            RenderPassAttachmentInfo imguiColorAttachment;
-            imguiColorAttachment.type = RenderPassAttachmentType::Color;
-            imguiColorAttachment.loadOp = LoadOperation::Load;
-            imguiColorAttachment.storeOp = StoreOperation::Store;
-            imguiColorAttachment.textureView = m_RenderTarget->GetColorTextureView();
-            imguiColorAttachment.resolveMode = ResolveMode::Average;
-            imguiColorAttachment.resolveTextureView = swapchain->GetTextureView();
-
-            RenderPassBeginInfo imguiRenderPassBeginInfo;
-            imguiRenderPassBeginInfo.renderArea = {0, 0, GetWindowWidth(), GetWindowHeight()};
-            imguiRenderPassBeginInfo.colorAttachmentCount = 1;
-            imguiRenderPassBeginInfo.colorAttachments = &imguiColorAttachment;
-            imguiRenderPassBeginInfo.depthAttachment = nullptr;
-
-            cmdBuffer->BeginRenderPass(imguiRenderPassBeginInfo);
-            m_ImGuiRenderer->Render(*cmdBuffer);
-            cmdBuffer->EndRenderPass();
+                if (!secondaryCmdBuffers.IsEmpty())
+                    cmdBuffer.ExecuteCommandBuffers(secondaryCmdBuffers);
+                cmdBuffer.EndRenderPass();
+            })
+            .Write(colorTarget, ResourceState::ColorAttachment)
+            .Write(depthTarget, ResourceState::DepthStencilAttachment);
+
+            m_RenderGraph.AddPass("ImGui", [this, swapchain, renderArea](const RenderGraph&, CommandBuffer& cmdBuffer)
+            {
+                RenderPassAttachmentInfo imguiColorAttachment;
+                imguiColorAttachment.type = RenderPassAttachmentType::Color;
+                imguiColorAttachment.loadOp = LoadOperation::Load;
+                imguiColorAttachment.storeOp = StoreOperation::Store;
+                imguiColorAttachment.textureView = m_RenderTarget->GetColorTextureView();
+                imguiColorAttachment.resolveMode = ResolveMode::Average;
+                imguiColorAttachment.resolveTextureView = swapchain->GetTextureView();
+
+                RenderPassBeginInfo imguiRenderPassBeginInfo;
+                imguiRenderPassBeginInfo.renderArea = renderArea;
+                imguiRenderPassBeginInfo.colorAttachmentCount = 1;
+                imguiRenderPassBeginInfo.colorAttachments = &imguiColorAttachment;
+                imguiRenderPassBeginInfo.depthAttachment = nullptr;
+
+                cmdBuffer.BeginRenderPass(imguiRenderPassBeginInfo);
+                m_ImGuiRenderer->Render(cmdBuffer);
+                cmdBuffer.EndRenderPass();
+            })
+            .Write(colorTarget, ResourceState::ColorAttachment);
+
+            if (m_RenderGraph.Compile())
+                m_RenderGraph.Execute(*cmdBuffer);
 
             m_Device->EndFrame();
             m_Device->Present();
@@ -311,13 +491,17 @@ namespace Nova
         m_SceneManager.Destroy();
         OnDestroy();
         DebugRenderer::Destroy();
+        SpriteBatchRenderer::Destroy();
         m_AssetDatabase.UnloadAll();
         if (m_SlangSession) m_SlangSession->release();
         slang::shutdown();
+        m_RenderGraph.Destroy();
         if (m_RenderTarget) m_RenderTarget->Destroy();
         if (m_ImGuiRenderer) m_ImGuiRenderer->Destroy();
         if (m_Device) m_Device->Destroy();
         if (m_Window) m_Window->Destroy();
+        m_ThreadPool.Destroy();
+        Log::Shutdown();
     }
 
     float Application::GetDeltaTime() const
@@ -325,6 +509,16 @@ namespace Nova
         return m_DeltaTime;
     }
 
+    bool Application::IsHeadless() const
+    {
+        return m_Configuration.headless;
+    }
+
+    const TickStatistics& Application::GetTickStatistics() const
+    {
+        return m_TickStatistics;
+    }
+
     const Ref<Window>& Application::GetWindow() const
     {
         return m_Window;
@@ -360,6 +554,16 @@ namespace Nova
         return &m_SceneManager;
     }
 
+    ThreadPool& Application::GetThreadPool()
+    {
+        return m_ThreadPool;
+    }
+
+    const RenderGraph& Application::GetRenderGraph() const
+    {
+        return m_RenderGraph;
+    }
+
     const Ref<RenderTarget>& Application::GetRenderTarget() const
     {
         return m_RenderTarget;
@@ -387,11 +591,25 @@ namespace Nova
 
     uint32_t Application::GetWindowWidth() const
     {
-        return m_Window->GetWidth();
+        return m_Window ? m_Window->GetWidth() : m_Configuration.windowWidth;
     }
 
     uint32_t Application::GetWindowHeight() const
     {
-        return m_Window->GetHeight();
+        return m_Window ? m_Window->GetHeight() : m_Configuration.windowHeight;
+    }
+
+    void TickStatistics::Add(const double tickTime)
+    {
+        minTime = tickCount ? std::min(minTime, tickTime) : tickTime;
+        maxTime = tickCount ? std::max(maxTime, tickTime) : tickTime;
+        lastTime = tickTime;
+        totalTime += tickTime;
+        tickCount++;
+    }
+
+    double TickStatistics::GetAverageTime() const
+    {
+        return tickCount ? totalTime / (double)tickCount : 0.0;
     }
 }
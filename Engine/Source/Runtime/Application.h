@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Containers/String.h"
 #include "Rendering/RenderDevice.h"
+#include "Rendering/RenderGraph.h"
 #include "Rendering/RenderTarget.h"
 #include "Rendering/ImGuiRenderer.h"
 #include "SceneManager.h"
@@ -8,6 +9,7 @@
 #include "Ref.h"
 #include "AssetDatabase.h"
 #include "CmdLineArgs.h"
+#include "ThreadPool.h"
 
 #include <cstdint>
 
@@ -27,6 +29,28 @@ namespace Nova
         WindowCreateFlags windowFlags = WindowCreateFlagBits::Default;
         bool vsync = false;
         uint32_t msaaSamples = 8;
+        // Records the scene on the thread pool into secondary command buffers when the render device supports it
+        bool parallelRecording = true;
+
+        // Runs without window, render device, ImGui and audio, scenes are updated on a fixed tick
+        bool headless = false;
+        // Ticks per second of the headless loop
+        uint32_t tickRate = 60;
+        // Steps the headless loop back to back instead of sleeping until the next tick
+        bool maxSpeed = false;
+    };
+
+    // Time spent in each tick of the headless loop, in seconds
+    struct TickStatistics
+    {
+        uint64_t tickCount = 0;
+        double lastTime = 0.0;
+        double minTime = 0.0;
+        double maxTime = 0.0;
+        double totalTime = 0.0;
+
+        void Add(double tickTime);
+        double GetAverageTime() const;
     };
 
     class Application
@@ -37,6 +61,9 @@ namespace Nova
 
         void Run();
         void Exit();
+        // Returned by the engine entry point once the application finished running
+        void SetExitCode(int32_t exitCode);
+        int32_t GetExitCode() const;
 
         static Application& GetCurrentApplication();
 
@@ -54,6 +81,8 @@ namespace Nova
         virtual RenderDeviceType GetRenderDeviceType() const { return RenderDeviceType::Vulkan; }
 
         float GetDeltaTime() const;
+        bool IsHeadless() const;
+        const TickStatistics& GetTickStatistics() const;
         const Ref<Window>& GetWindow() const;
         Ref<Window>& GetWindow();
         const Ref<RenderDevice>& GetRenderDevice() const;
@@ -61,7 +90,9 @@ namespace Nova
         Ref<ImGuiRenderer>& GetImGuiRenderer();
         const Ref<ImGuiRenderer>& GetImGuiRenderer() const;
         SceneManager* GetSceneManager();
+        ThreadPool& GetThreadPool();
 
+        const RenderGraph& GetRenderGraph() const;
         const Ref<RenderTarget>& GetRenderTarget() const;
         Ref<RenderTarget>& GetRenderTarget();
 
@@ -87,25 +118,31 @@ namespace Nova
 
     protected:
         void Update();
+        void UpdateHeadless();
         void Render();
         void Destroy();
 
     private:
         CmdLineArgs m_Args;
+        ApplicationConfiguration m_Configuration;
+        TickStatistics m_TickStatistics;
         Ref<Window> m_Window = nullptr;
         Ref<RenderDevice> m_Device = nullptr;
         Ref<AudioDevice> m_AudioDevice = nullptr;
         slang::IGlobalSession* m_SlangSession = nullptr;
 
         Ref<RenderTarget> m_RenderTarget = nullptr;
+        RenderGraph m_RenderGraph;
         Ref<ImGuiRenderer> m_ImGuiRenderer = nullptr;
 
         SceneManager m_SceneManager;
         AssetDatabase m_AssetDatabase;
+        ThreadPool m_ThreadPool;
 
         Array<Ref<EditorWindow>> m_EditorWindows;
 
         bool m_IsRunning = true;
+        int32_t m_ExitCode = 0;
         double m_LastTime = 0.0f;
         double m_DeltaTime = 0.0f;
     };
@@ -0,0 +1,175 @@
+﻿#include "Arena.h"
+#include "Assertion.h"
+#include <algorithm>
+
+namespace Nova
+{
+    static uintptr_t AlignUp(const uintptr_t value, const size_t alignment)
+    {
+        return (value + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    Arena::Arena(const size_t blockSize, const MemoryTag tag) : m_BlockSize(blockSize), m_Tag(tag)
+    {
+    }
+
+    Arena::~Arena()
+    {
+        Release();
+    }
+
+    void* Arena::Allocate(const size_t size, const size_t alignment)
+    {
+        NOVA_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+        while (m_Current)
+        {
+            const uintptr_t begin = (uintptr_t)GetBlockData(m_Current);
+            const uintptr_t address = AlignUp(begin + m_Current->offset, alignment);
+            if (address + size <= begin + m_Current->capacity)
+            {
+                m_Current->offset = address + size - begin;
+                return (void*)address;
+            }
+
+            // Blocks kept by a previous Reset or Rewind are reused before allocating new ones
+            if (!m_Current->next || m_Current->next->capacity < size + alignment)
+                break;
+
+            m_Current = m_Current->next;
+            m_Current->offset = 0;
+        }
+
+        Block* block = AllocateBlock(std::max(m_BlockSize, size + alignment));
+        if (!block) return nullptr;
+
+        if (m_Current)
+        {
+            block->next = m_Current->next;
+            m_Current->next = block;
+        }
+        else
+        {
+            block->next = m_First;
+            m_First = block;
+        }
+
+        m_Current = block;
+        const uintptr_t begin = (uintptr_t)GetBlockData(block);
+        const uintptr_t address = AlignUp(begin, alignment);
+        block->offset = address + size - begin;
+        return (void*)address;
+    }
+
+    Arena::Marker Arena::GetMarker() const
+    {
+        if (!m_Current) return {};
+        return { m_Current, m_Current->offset };
+    }
+
+    void Arena::Rewind(const Marker& marker)
+    {
+        if (!marker.block)
+        {
+            m_Current = m_First;
+            if (m_Current) m_Current->offset = 0;
+            return;
+        }
+
+        m_Current = (Block*)marker.block;
+        m_Current->offset = marker.offset;
+    }
+
+    void Arena::Reset()
+    {
+        if (m_First && m_First->next)
+        {
+            size_t capacity = 0;
+            for (Block* block = m_First; block; block = block->next)
+                capacity += block->capacity;
+
+            Release();
+            m_First = AllocateBlock(capacity);
+            if (m_First) m_First->next = nullptr;
+        }
+
+        m_Current = m_First;
+        if (m_Current) m_Current->offset = 0;
+    }
+
+    void Arena::Release()
+    {
+        Block* block = m_First;
+        while (block)
+        {
+            Block* next = block->next;
+            Memory::Free(block);
+            block = next;
+        }
+        m_First = nullptr;
+        m_Current = nullptr;
+    }
+
+    size_t Arena::GetUsedBytes() const
+    {
+        size_t usedBytes = 0;
+        for (Block* block = m_First; block; block = block->next)
+        {
+            usedBytes += block->offset;
+            if (block == m_Current) break;
+        }
+        return usedBytes;
+    }
+
+    size_t Arena::GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (Block* block = m_First; block; block = block->next)
+            capacity += block->capacity;
+        return capacity;
+    }
+
+    Arena::Block* Arena::AllocateBlock(const size_t capacity) const
+    {
+        Block* block = (Block*)Memory::Malloc<uint8_t>(sizeof(Block) + capacity, m_Tag);
+        if (!block) return nullptr;
+        block->next = nullptr;
+        block->capacity = capacity;
+        block->offset = 0;
+        return block;
+    }
+
+    static_assert(FrameAllocator::FrameCount == 2, "FrameArenas initializes one arena per frame in flight");
+
+    struct FrameArenas
+    {
+        Arena arenas[FrameAllocator::FrameCount] = { Arena(Arena::DefaultBlockSize, MemoryTag::Frame), Arena(Arena::DefaultBlockSize, MemoryTag::Frame) };
+        uint64_t frameIndex = ~0ull;
+    };
+
+    std::atomic<uint64_t> FrameAllocator::s_FrameIndex = 0;
+    static thread_local FrameArenas s_FrameArenas;
+
+    Arena& FrameAllocator::Get()
+    {
+        const uint64_t frameIndex = s_FrameIndex.load(std::memory_order_acquire);
+        Arena& arena = s_FrameArenas.arenas[frameIndex % FrameCount];
+        if (s_FrameArenas.frameIndex != frameIndex)
+        {
+            // Whatever this arena holds was allocated at least FrameCount frames ago
+            arena.Reset();
+            s_FrameArenas.frameIndex = frameIndex;
+        }
+        return arena;
+    }
+
+    void FrameAllocator::NewFrame()
+    {
+        s_FrameIndex.fetch_add(1, std::memory_order_release);
+    }
+
+    uint64_t FrameAllocator::GetFrameIndex()
+    {
+        return s_FrameIndex.load(std::memory_order_acquire);
+    }
+}
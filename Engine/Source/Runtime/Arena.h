@@ -0,0 +1,90 @@
+﻿#pragma once
+#include "Memory.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Nova
+{
+    // Bump allocator handing out memory from a chain of blocks.
+    // Nothing is freed individually, Reset or Rewind release everything allocated after a point at once.
+    class Arena
+    {
+    public:
+        static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+        struct Marker
+        {
+            void* block = nullptr;
+            size_t offset = 0;
+        };
+
+        explicit Arena(size_t blockSize = DefaultBlockSize, MemoryTag tag = MemoryTag::General);
+        ~Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        T* Allocate(const size_t count = 1)
+        {
+            return (T*)Allocate(count * sizeof(T), alignof(T));
+        }
+
+        Marker GetMarker() const;
+        void Rewind(const Marker& marker);
+
+        // Releases every allocation but keeps the blocks. A chain that grew is merged in a single block
+        // so an arena used the same way every frame stops hitting the heap after the first one.
+        void Reset();
+        void Release();
+
+        size_t GetUsedBytes() const;
+        size_t GetCapacity() const;
+    private:
+        struct Block
+        {
+            Block* next;
+            size_t capacity;
+            size_t offset;
+        };
+
+        Block* AllocateBlock(size_t capacity) const;
+        static uint8_t* GetBlockData(Block* block) { return (uint8_t*)(block + 1); }
+
+        Block* m_First = nullptr;
+        Block* m_Current = nullptr;
+        size_t m_BlockSize = DefaultBlockSize;
+        MemoryTag m_Tag = MemoryTag::General;
+    };
+
+    // Per thread arenas for temporaries that live at most until the end of the next frame.
+    // Each thread owns one arena per frame in flight and rewinds it the first time it allocates in a new frame,
+    // so memory handed out during frame N stays valid while frame N + 1 is being built.
+    // Also usable as the allocator of Array and StringBase, see FrameArray and FrameString.
+    class FrameAllocator
+    {
+    public:
+        static constexpr uint32_t FrameCount = 2;
+
+        // Arena of the calling thread for the current frame
+        static Arena& Get();
+
+        template<typename T>
+        static T* Allocate(const size_t count, MemoryTag)
+        {
+            T* result = Get().Allocate<T>(count);
+            return Memory::Memset(result, 0, count);
+        }
+
+        // Frame memory is only released by the next reset of its arena
+        static void Free(void*) {}
+
+        // Starts a new frame, called once per frame by the application
+        static void NewFrame();
+        static uint64_t GetFrameIndex();
+    private:
+        static std::atomic<uint64_t> s_FrameIndex;
+    };
+}
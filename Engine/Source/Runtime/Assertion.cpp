@@ -1,5 +1,5 @@
 ﻿#include "Assertion.h"
-//#include "Log.h"
+#include "Log.h"
 //#include "Application.h"
 
 namespace Nova
@@ -8,6 +8,7 @@ namespace Nova
     {
         if (Condition == true) return;
         //NOVA_LOG(Application, Verbosity::Error, "{}. File: {}. Line:{}", Message, String(__FILE__), __LINE__);
+        Log::Flush();
         NOVA_BREAK();
     }
 }
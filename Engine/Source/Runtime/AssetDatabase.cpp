@@ -7,15 +7,14 @@
 
 namespace Nova
 {
-    bool AssetDatabase::UnloadAsset(const String& name)
+    bool AssetDatabase::UnloadAsset(const Name name)
     {
-        if (!m_Data.Contains(name))
+        const size_t index = m_Data.FindKey(name);
+        if (index == ~0ull)
             return false;
-            
-        Ref<Asset> asset = m_Data[name];
-        if (!m_Data.Remove({ name, asset }))
-            return false;
-            
+
+        Ref<Asset> asset = m_Data.GetAt(index).value;
+        m_Data.RemoveAt(index);
         asset.Release();
         return true;
     }
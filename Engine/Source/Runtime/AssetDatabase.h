@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Asset.h"
+#include "Name.h"
 #include "Object.h"
 #include "Ref.h"
 #include "Containers/Map.h"
@@ -15,7 +16,7 @@ namespace Nova
         ~AssetDatabase() override = default;
 
         template<typename AssetType> requires std::is_base_of_v<Asset, AssetType>
-        Ref<AssetType> CreateAsset(const String& name)
+        Ref<AssetType> CreateAsset(const Name name)
         {
             for (size_t index = 0; index < m_Data.Count(); index++)
             {
@@ -24,7 +25,7 @@ namespace Nova
                 {
                     pair.key = name;
                     pair.value = new AssetType();
-                    pair.value->SetObjectName(name);
+                    pair.value->SetObjectName(String(name.GetString()));
                     return pair.value;
                 }
             }
@@ -34,25 +35,26 @@ namespace Nova
         }
 
         template<typename AssetType> requires std::is_base_of_v<Asset, AssetType>
-        void AddAsset(const Ref<AssetType>& asset, const String& name)
+        void AddAsset(const Ref<AssetType>& asset, const Name name)
         {
             m_Data[name] = asset;
         }
 
-        bool UnloadAsset(const String& name);
+        bool UnloadAsset(Name name);
         bool UnloadAsset(Ref<Asset> asset);
         void UnloadAll();
 
         template<typename AssetType> requires std::is_base_of_v<Asset, AssetType>
-        Ref<AssetType> Get(const String& name) const
+        Ref<AssetType> Get(const Name name) const
         {
-            if (!m_Data.Contains(name))
+            const size_t index = m_Data.FindKey(name);
+            if (index == ~0ull)
                 return nullptr;
-            return m_Data[name].As<AssetType>();
+            return m_Data.GetAt(index).value.template As<AssetType>();
         }
     
     private:
-        Map<String, Ref<Asset>> m_Data;
+        Map<Name, Ref<Asset>> m_Data;
     };
 
     
@@ -3,6 +3,7 @@
 #include "UUID.h"
 #include "Containers/String.h"
 #include "Flags.h"
+#include "PoolAllocator.h"
 
 
 namespace Nova { class CommandBuffer; }
@@ -33,6 +34,16 @@ namespace Nova
         Component& operator=(Component&&) = delete;
         ~Component() override = default;
 
+        // Components live in per type pools, create them with Entity::AddComponent
+        static void* operator new(size_t size, PoolAllocator& pool)
+        {
+            NOVA_ASSERT(size <= pool.GetBlockSize(), "Component does not fit in its pool!");
+            return pool.Allocate();
+        }
+
+        static void operator delete(void* ptr, PoolAllocator& pool) { pool.Free(ptr); }
+        static void operator delete(void* ptr) { PoolAllocator::Deallocate(ptr); }
+
         Transform* GetTransform() const;
         Entity* GetOwner() const;
         Scene* GetScene() const;
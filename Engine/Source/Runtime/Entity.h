@@ -35,6 +35,16 @@ namespace Nova
         Entity();
         Entity(const String& name, Scene* owner);
         ~Entity() override = default;
+
+        // Entities are pooled, create them with Scene::CreateEntity
+        static void* operator new(size_t size, PoolAllocator& pool)
+        {
+            NOVA_ASSERT(size <= pool.GetBlockSize(), "Entity does not fit in its pool!");
+            return pool.Allocate();
+        }
+
+        static void operator delete(void* ptr, PoolAllocator& pool) { pool.Free(ptr); }
+        static void operator delete(void* ptr) { PoolAllocator::Deallocate(ptr); }
         
         template<typename T> requires std::is_base_of_v<Component, T>
         T* GetComponent() const
@@ -47,10 +57,10 @@ namespace Nova
             return nullptr;
         }
 
-        template<typename T> requires std::is_base_of_v<Component, T>
-        Array<T*> GetAllComponents() const
+        template<typename T, ContainerAllocator Allocator = HeapAllocator> requires std::is_base_of_v<Component, T>
+        Array<T*, Allocator> GetAllComponents() const
         {
-            Array<T*> result;
+            Array<T*, Allocator> result;
             for(Component* component : m_Components)
             {
                 if (!component) continue;
@@ -73,7 +83,7 @@ namespace Nova
         template<typename T> requires std::is_base_of_v<Component, T>
         T* AddComponent()
         {
-            T* newComponent = new T(this);
+            T* newComponent = new (PoolAllocator::Get<T, MemoryTag::Scene>()) T(this);
             m_Components.Add(newComponent);
             newComponent->OnInit();
             return newComponent;
@@ -10,8 +10,9 @@ namespace Nova
     {
         g_Application = CreateApplication(argc, argv);
         g_Application->Run();
+        const int exitCode = g_Application->GetExitCode();
         delete g_Application;
-        return 0;
+        return exitCode;
     }
 }
 #endif
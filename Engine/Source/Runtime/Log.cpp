@@ -4,9 +4,7 @@ namespace Nova
 {
     Logger Log::s_CoreLogger = Logger("CORE");
     Logger Log::s_ClientLogger = Logger("CLIENT");
-    
-    String Log::s_CurrentCategoryName;
-    
+
     Logger& Log::GetCoreLogger()
     {
         return s_CoreLogger;
@@ -17,8 +15,33 @@ namespace Nova
         return s_ClientLogger;
     }
 
-    void Log::SetCurrentCategoryName(String CategoryName)
+    void Log::Initialize()
+    {
+        LogBackend::Get().Start();
+    }
+
+    void Log::Shutdown()
+    {
+        LogBackend::Get().Stop();
+    }
+
+    void Log::Flush()
+    {
+        LogBackend::Get().Flush();
+    }
+
+    void Log::AddSink(LogSink* sink)
+    {
+        LogBackend::Get().AddSink(sink);
+    }
+
+    void Log::RemoveSink(LogSink* sink)
+    {
+        LogBackend::Get().RemoveSink(sink);
+    }
+
+    void Log::SetConsoleOutputEnabled(const bool enabled)
     {
-        s_CurrentCategoryName = std::move(CategoryName);
+        LogBackend::Get().SetConsoleSinkEnabled(enabled);
     }
 }
@@ -1,28 +1,25 @@
 #pragma once
 #include "Containers/String.h"
+#include "LogCategory.h"
 #include "Logger.h"
 
+// Categories below their minimum verbosity are discarded at compile time, before any argument is evaluated
+#define NOVA_LOG_IMPL(logger, category, verbosity, ...) \
+    do { \
+        if constexpr (Nova::IsLogEnabled<category##LogCategory>(verbosity)) \
+            logger.Log(category##LogCategory::s_CategoryName, verbosity, __VA_ARGS__); \
+    } \
+    while(0)
+
 #if defined(NOVA_CORE)
     #if defined(NOVA_DEBUG) || defined(NOVA_DEV)
-        #define NOVA_LOG(category, verbosity, ...) \
-        do { \
-            Nova::Logger& _Logger = Nova::Log::GetCoreLogger(); \
-            _Logger.SetCurrentCategory(category##LogCategory::s_CategoryName);\
-            _Logger.Log(verbosity, __VA_ARGS__);\
-        } \
-        while(0)
+        #define NOVA_LOG(category, verbosity, ...) NOVA_LOG_IMPL(Nova::Log::GetCoreLogger(), category, verbosity, __VA_ARGS__)
     #else
         #define NOVA_LOG(category, verbosity, ...)
     #endif
 #else
     #if defined(NOVA_DEBUG) || defined(NOVA_DEV)
-        #define NOVA_LOG(category, verbosity, ...) \
-        do { \
-        Nova::Logger& _Logger = Nova::Log::GetClientLogger(); \
-        _Logger.SetCurrentCategory(category##LogCategory::s_CategoryName);\
-        _Logger.Log(verbosity, __VA_ARGS__);\
-        } \
-        while(0)
+        #define NOVA_LOG(category, verbosity, ...) NOVA_LOG_IMPL(Nova::Log::GetClientLogger(), category, verbosity, __VA_ARGS__)
     #else
         #define NOVA_LOG(category, verbosity, ...)
     #endif
@@ -30,15 +27,26 @@
 
 namespace Nova
 {
+    class LogSink;
+
     class Log
     {
     public:
         static Logger& GetCoreLogger();
         static Logger& GetClientLogger();
-        static void SetCurrentCategoryName(String CategoryName);
-        friend class LogCategoryFormatter;
+
+        // Starts the logging thread, messages are written synchronously until then
+        static void Initialize();
+        // Writes every pending message and stops the logging thread
+        static void Shutdown();
+        // Blocks until every message logged so far has been written
+        static void Flush();
+
+        // Sinks are not owned, the console sink is registered unless disabled
+        static void AddSink(LogSink* sink);
+        static void RemoveSink(LogSink* sink);
+        static void SetConsoleOutputEnabled(bool enabled);
     private:
-        static String s_CurrentCategoryName;
         static Logger s_CoreLogger;
         static Logger s_ClientLogger;
     };
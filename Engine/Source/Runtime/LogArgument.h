@@ -0,0 +1,104 @@
+﻿#pragma once
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Nova
+{
+    // Describes how a log argument is copied into a log record on the calling thread
+    // and read back on the logging thread. Values are copied as is, strings are copied by content
+    // so the caller's buffers may die as soon as the log call returns.
+    template<typename T>
+    struct LogArgument
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Log arguments must be trivially copyable or strings, format them before logging");
+        using DecodedType = T;
+
+        static size_t GetSize(const T&) { return sizeof(T); }
+
+        static void Encode(uint8_t*& dest, const T& value)
+        {
+            std::memcpy(dest, &value, sizeof(T));
+            dest += sizeof(T);
+        }
+
+        static DecodedType Decode(const uint8_t*& src)
+        {
+            T value;
+            std::memcpy(&value, src, sizeof(T));
+            src += sizeof(T);
+            return value;
+        }
+    };
+
+    struct LogStringArgument
+    {
+        using DecodedType = std::string_view;
+
+        static size_t GetSize(const char*, const size_t count) { return sizeof(uint32_t) + count; }
+
+        static void Encode(uint8_t*& dest, const char* data, const size_t count)
+        {
+            const uint32_t length = (uint32_t)count;
+            std::memcpy(dest, &length, sizeof(uint32_t));
+            if (length) std::memcpy(dest + sizeof(uint32_t), data, length);
+            dest += sizeof(uint32_t) + length;
+        }
+
+        // Points into the record, only valid while the record is being formatted
+        static DecodedType Decode(const uint8_t*& src)
+        {
+            uint32_t length;
+            std::memcpy(&length, src, sizeof(uint32_t));
+            const std::string_view result((const char*)src + sizeof(uint32_t), length);
+            src += sizeof(uint32_t) + length;
+            return result;
+        }
+    };
+
+    template<>
+    struct LogArgument<const char*> : LogStringArgument
+    {
+        static size_t GetSize(const char* value) { return LogStringArgument::GetSize(value, value ? std::strlen(value) : 0); }
+        static void Encode(uint8_t*& dest, const char* value) { LogStringArgument::Encode(dest, value, value ? std::strlen(value) : 0); }
+    };
+
+    template<>
+    struct LogArgument<char*> : LogArgument<const char*> { };
+
+    template<ContainerAllocator Allocator>
+    struct LogArgument<StringBase<char, Allocator>> : LogStringArgument
+    {
+        static size_t GetSize(const StringBase<char, Allocator>& value) { return LogStringArgument::GetSize(value.Data(), value.Count()); }
+        static void Encode(uint8_t*& dest, const StringBase<char, Allocator>& value) { LogStringArgument::Encode(dest, value.Data(), value.Count()); }
+    };
+
+    template<>
+    struct LogArgument<StringView> : LogStringArgument
+    {
+        static size_t GetSize(const StringView& value) { return LogStringArgument::GetSize(value.Data(), value.Count()); }
+        static void Encode(uint8_t*& dest, const StringView& value) { LogStringArgument::Encode(dest, value.Data(), value.Count()); }
+    };
+
+    template<>
+    struct LogArgument<std::string> : LogStringArgument
+    {
+        static size_t GetSize(const std::string& value) { return LogStringArgument::GetSize(value.data(), value.size()); }
+        static void Encode(uint8_t*& dest, const std::string& value) { LogStringArgument::Encode(dest, value.data(), value.size()); }
+    };
+
+    template<>
+    struct LogArgument<std::string_view> : LogStringArgument
+    {
+        static size_t GetSize(const std::string_view& value) { return LogStringArgument::GetSize(value.data(), value.size()); }
+        static void Encode(uint8_t*& dest, const std::string_view& value) { LogStringArgument::Encode(dest, value.data(), value.size()); }
+    };
+
+    // Arrays decay to pointers so string literals are captured by content
+    template<typename T>
+    using LogArgumentType = LogArgument<std::decay_t<T>>;
+}
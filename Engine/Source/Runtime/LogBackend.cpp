@@ -0,0 +1,382 @@
+﻿#include "LogBackend.h"
+#include "Runtime/Memory.h"
+#include "Runtime/Profiler.h"
+#include <algorithm>
+
+namespace Nova
+{
+    LogRingBuffer::LogRingBuffer(const uint32_t threadIndex) : m_ThreadIndex(threadIndex)
+    {
+        m_Data = Memory::Malloc<uint8_t>(Capacity);
+    }
+
+    LogRingBuffer::~LogRingBuffer()
+    {
+        Memory::Free(m_Data);
+    }
+
+    uint8_t* LogRingBuffer::Reserve(const uint32_t size)
+    {
+        const uint64_t head = m_Head.load(std::memory_order_relaxed);
+        const uint32_t offset = (uint32_t)(head % Capacity);
+        const uint32_t remaining = Capacity - offset;
+        const uint32_t padding = remaining < size ? remaining : 0;
+        const uint64_t newHead = head + padding + size;
+
+        if (newHead - m_CachedTail > Capacity)
+        {
+            m_CachedTail = m_Tail.load(std::memory_order_acquire);
+            if (newHead - m_CachedTail > Capacity)
+                return nullptr;
+        }
+
+        // Published together with the record on Commit
+        if (padding)
+        {
+            const uint32_t marker = padding | PaddingBit;
+            Memory::Memcpy(m_Data + offset, &marker, sizeof(uint32_t));
+        }
+
+        m_PendingHead = newHead;
+        return padding ? m_Data : m_Data + offset;
+    }
+
+    void LogRingBuffer::Commit()
+    {
+        m_Head.store(m_PendingHead, std::memory_order_release);
+    }
+
+    const uint8_t* LogRingBuffer::Peek()
+    {
+        uint64_t tail = m_Tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_Head.load(std::memory_order_acquire);
+        while (tail != head)
+        {
+            const uint32_t offset = (uint32_t)(tail % Capacity);
+            uint32_t size;
+            Memory::Memcpy(&size, m_Data + offset, sizeof(uint32_t));
+            if (size & PaddingBit)
+            {
+                tail += size & ~PaddingBit;
+                m_Tail.store(tail, std::memory_order_release);
+                continue;
+            }
+
+            m_PendingTail = tail + size;
+            return m_Data + offset;
+        }
+        return nullptr;
+    }
+
+    void LogRingBuffer::Release()
+    {
+        m_Tail.store(m_PendingTail, std::memory_order_release);
+    }
+
+    bool LogRingBuffer::IsHalfFull() const
+    {
+        return m_PendingHead - m_CachedTail >= Capacity / 2;
+    }
+
+    // Marks the ring of an exiting thread so the logging thread can reclaim it
+    struct LogThreadRing
+    {
+        LogRingBuffer* ring = nullptr;
+        ~LogThreadRing()
+        {
+            if (ring) ring->abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    static thread_local LogThreadRing s_ThreadRing;
+    static std::atomic<uint32_t> s_NextThreadIndex = 0;
+
+    LogBackend& LogBackend::Get()
+    {
+        static LogBackend backend;
+        return backend;
+    }
+
+    LogBackend::LogBackend()
+    {
+        m_StartTimestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_Sinks.Add(&m_ConsoleSink);
+    }
+
+    LogBackend::~LogBackend()
+    {
+        Stop();
+        for (LogRingBuffer* ring : m_Rings)
+            delete ring;
+        m_Rings.Clear();
+    }
+
+    void LogBackend::Start()
+    {
+        if (IsRunning())
+            return;
+
+        m_Stop = false;
+        m_Thread = std::thread(&LogBackend::Run, this);
+        m_Running.store(true, std::memory_order_release);
+    }
+
+    void LogBackend::Stop()
+    {
+        if (!IsRunning())
+            return;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Condition.notify_one();
+        m_Thread.join();
+
+        // Picks up records committed while the thread was exiting, and the ones still being written by producers
+        // that saw the backend running
+        m_Running.store(false, std::memory_order_seq_cst);
+        while (m_ActiveProducers.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+        Drain();
+        FlushSinks();
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_FlushCompleted = m_FlushRequested.load(std::memory_order_acquire);
+        }
+        m_FlushCondition.notify_all();
+    }
+
+    void LogBackend::Flush()
+    {
+        if (!IsRunning())
+        {
+            FlushSinks();
+            return;
+        }
+
+        if (std::this_thread::get_id() == m_Thread.get_id())
+            return;
+
+        std::unique_lock lock(m_Mutex);
+        const uint64_t ticket = m_FlushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+        m_Condition.notify_one();
+        m_FlushCondition.wait(lock, [&] { return m_FlushCompleted >= ticket || !IsRunning(); });
+    }
+
+    void LogBackend::AddSink(LogSink* sink)
+    {
+        if (!sink) return;
+        std::lock_guard lock(m_SinkMutex);
+        m_Sinks.AddUnique(sink);
+    }
+
+    void LogBackend::RemoveSink(LogSink* sink)
+    {
+        Flush();
+        std::lock_guard lock(m_SinkMutex);
+        m_Sinks.Remove(sink);
+    }
+
+    void LogBackend::SetConsoleSinkEnabled(const bool enabled)
+    {
+        if (enabled)
+            AddSink(&m_ConsoleSink);
+        else
+            RemoveSink(&m_ConsoleSink);
+    }
+
+    uint32_t LogBackend::GetThreadIndex()
+    {
+        static thread_local const uint32_t threadIndex = s_NextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+        return threadIndex;
+    }
+
+    LogRecordHeader LogBackend::FormatRecordText(const uint8_t* record, std::string& output)
+    {
+        LogRecordHeader header;
+        Memory::Memcpy(&header, record, sizeof(LogRecordHeader));
+
+        const std::string_view format((const char*)record + sizeof(LogRecordHeader), header.formatCount);
+        const uint8_t* arguments = record + sizeof(LogRecordHeader) + header.formatCount;
+        const size_t offset = output.size();
+        try
+        {
+            header.formatFunction(format, arguments, output);
+        }
+        catch (const std::format_error&)
+        {
+            // A bad format string must not take the logging thread down
+            output.resize(offset);
+            output.append("Invalid log format: ").append(format);
+        }
+        return header;
+    }
+
+    LogRingBuffer* LogBackend::GetThreadRing()
+    {
+        if (!s_ThreadRing.ring)
+        {
+            LogRingBuffer* ring = new LogRingBuffer(GetThreadIndex());
+            std::lock_guard lock(m_RingMutex);
+            m_Rings.Add(ring);
+            s_ThreadRing.ring = ring;
+        }
+        return s_ThreadRing.ring;
+    }
+
+    uint8_t* LogBackend::ReserveBlocking(LogRingBuffer* ring, const uint32_t size)
+    {
+        uint8_t* record = ring->Reserve(size);
+        while (!record)
+        {
+            // Full: let the logging thread catch up rather than dropping the message
+            Wake();
+            std::this_thread::yield();
+            if (!IsRunning())
+                return nullptr;
+            record = ring->Reserve(size);
+        }
+        return record;
+    }
+
+    void LogBackend::WriteImmediate(const uint8_t* record)
+    {
+        // Keeps the order with the records this thread already queued
+        if (IsRunning())
+            Flush();
+
+        std::string text;
+        const LogRecordHeader header = FormatRecordText(record, text);
+        std::lock_guard lock(m_SinkMutex);
+        WriteToSinks(header, GetThreadIndex(), StringView(text.data(), text.size()));
+    }
+
+    void LogBackend::WriteToSinks(const LogRecordHeader& header, const uint32_t threadIndex, const StringView message)
+    {
+        using Period = std::chrono::steady_clock::period;
+
+        LogRecord record;
+        record.loggerName = header.loggerName;
+        record.category = header.category;
+        record.verbosity = header.verbosity;
+        record.threadIndex = threadIndex;
+        record.time = (double)(header.timestamp - m_StartTimestamp) * Period::num / Period::den;
+        record.message = message;
+
+        for (LogSink* sink : m_Sinks)
+            sink->Write(record);
+    }
+
+    void LogBackend::FlushSinks()
+    {
+        std::lock_guard lock(m_SinkMutex);
+        for (LogSink* sink : m_Sinks)
+            sink->Flush();
+    }
+
+    void LogBackend::Wake()
+    {
+        // The logging thread also wakes up on its own, a lost notification only delays the output
+        if (!m_WakeRequested.exchange(true, std::memory_order_acq_rel))
+            m_Condition.notify_one();
+    }
+
+    void LogBackend::Run()
+    {
+        NOVA_PROFILE_THREAD("Log");
+        using namespace std::chrono_literals;
+        while (true)
+        {
+            bool stop;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Condition.wait_for(lock, 10ms, [&]
+                {
+                    return m_Stop || m_WakeRequested.load(std::memory_order_acquire) || m_FlushRequested.load(std::memory_order_acquire) != m_FlushCompleted;
+                });
+                stop = m_Stop;
+            }
+
+            m_WakeRequested.store(false, std::memory_order_release);
+            const uint64_t flushTicket = m_FlushRequested.load(std::memory_order_acquire);
+            {
+                NOVA_PROFILE_SCOPE("LogBackend::Drain");
+                Drain();
+            }
+
+            if (flushTicket != m_FlushCompleted)
+            {
+                FlushSinks();
+                {
+                    std::lock_guard lock(m_Mutex);
+                    m_FlushCompleted = flushTicket;
+                }
+                m_FlushCondition.notify_all();
+            }
+
+            if (stop)
+                break;
+        }
+    }
+
+    void LogBackend::Drain()
+    {
+        m_Pending.Clear();
+        m_Text.clear();
+
+        {
+            std::lock_guard lock(m_RingMutex);
+            for (size_t i = 0; i < m_Rings.Count();)
+            {
+                LogRingBuffer* ring = m_Rings[i];
+                // Read first so every record written before the thread exited is drained below
+                const bool abandoned = ring->abandoned.load(std::memory_order_acquire);
+                while (const uint8_t* record = ring->Peek())
+                {
+                    PendingRecord pending;
+                    pending.offset = m_Text.size();
+                    const LogRecordHeader header = FormatRecordText(record, m_Text);
+                    ring->Release();
+
+                    pending.loggerName = header.loggerName;
+                    pending.category = header.category;
+                    pending.timestamp = header.timestamp;
+                    pending.verbosity = header.verbosity;
+                    pending.threadIndex = ring->GetThreadIndex();
+                    pending.count = m_Text.size() - pending.offset;
+                    m_Pending.Add(pending);
+                }
+
+                if (abandoned)
+                {
+                    delete ring;
+                    m_Rings.RemoveAt(i);
+                    continue;
+                }
+                ++i;
+            }
+        }
+
+        if (m_Pending.IsEmpty())
+            return;
+
+        // Each ring is ordered, merge the threads back into one timeline
+        std::stable_sort(m_Pending.Data(), m_Pending.Data() + m_Pending.Count(), [](const PendingRecord& lhs, const PendingRecord& rhs)
+        {
+            return lhs.timestamp < rhs.timestamp;
+        });
+
+        std::lock_guard lock(m_SinkMutex);
+        for (const PendingRecord& pending : m_Pending)
+        {
+            LogRecordHeader header;
+            header.loggerName = pending.loggerName;
+            header.category = pending.category;
+            header.timestamp = pending.timestamp;
+            header.verbosity = pending.verbosity;
+            WriteToSinks(header, pending.threadIndex, StringView(m_Text.data() + pending.offset, pending.count));
+        }
+    }
+}
@@ -0,0 +1,211 @@
+﻿#pragma once
+#include "LogArgument.h"
+#include "LogSink.h"
+#include "LogVerbosity.h"
+#include "Containers/Array.h"
+#include "Containers/StringView.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace Nova
+{
+    // Formats the captured arguments of a record, runs on the logging thread
+    using LogFormatFunction = void(*)(std::string_view format, const uint8_t* arguments, std::string& output);
+
+    // Fixed part of every record, followed by the format string then the encoded arguments
+    struct LogRecordHeader
+    {
+        uint32_t size;
+        uint32_t formatCount;
+        LogFormatFunction formatFunction;
+        const char* loggerName;
+        const char* category;
+        int64_t timestamp;
+        Verbosity verbosity;
+    };
+
+    // Variable sized records written by one thread and read by the logging thread.
+    // Records are always contiguous, a padding record fills the end of the buffer when one would wrap.
+    class LogRingBuffer
+    {
+    public:
+        static constexpr uint32_t Capacity = 64 * 1024;
+        static constexpr uint32_t Alignment = 8;
+        // Bigger records are formatted on the calling thread
+        static constexpr uint32_t MaxRecordSize = Capacity / 4;
+
+        LogRingBuffer(const LogRingBuffer&) = delete;
+        LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+        explicit LogRingBuffer(uint32_t threadIndex);
+        ~LogRingBuffer();
+
+        // Producer side. Returns nullptr when the buffer is full, size must be aligned
+        uint8_t* Reserve(uint32_t size);
+        void Commit();
+
+        // Consumer side. Returns nullptr when the buffer is empty
+        const uint8_t* Peek();
+        void Release();
+
+        bool IsHalfFull() const;
+        uint32_t GetThreadIndex() const { return m_ThreadIndex; }
+
+        // Set when the owning thread exits, the logging thread deletes the buffer once it is drained
+        std::atomic<bool> abandoned = false;
+    private:
+        static constexpr uint32_t PaddingBit = 1u << 31;
+
+        uint8_t* m_Data = nullptr;
+        uint32_t m_ThreadIndex = 0;
+
+        alignas(64) std::atomic<uint64_t> m_Head = 0;
+        uint64_t m_PendingHead = 0;
+        uint64_t m_CachedTail = 0;
+
+        alignas(64) std::atomic<uint64_t> m_Tail = 0;
+        uint64_t m_PendingTail = 0;
+    };
+
+    // Owns the logging thread and the sinks. Log calls only copy their arguments into a per thread
+    // ring buffer, formatting and writing happen later on the logging thread.
+    // Before Start and after Stop every record is formatted and written on the calling thread.
+    class LogBackend
+    {
+    public:
+        static LogBackend& Get();
+
+        LogBackend(const LogBackend&) = delete;
+        LogBackend& operator=(const LogBackend&) = delete;
+        ~LogBackend();
+
+        void Start();
+        void Stop();
+        bool IsRunning() const { return m_Running.load(std::memory_order_acquire); }
+
+        // Blocks until every record logged before the call went through the sinks
+        void Flush();
+
+        // Sinks are not owned, remove them before destroying them
+        void AddSink(LogSink* sink);
+        void RemoveSink(LogSink* sink);
+        // The console sink is registered by default
+        void SetConsoleSinkEnabled(bool enabled);
+
+        template<typename... Args>
+        void Enqueue(const char* loggerName, const char* category, const Verbosity verbosity, const StringView& format, const Args&... args)
+        {
+            const size_t size = sizeof(LogRecordHeader) + format.Count() + (LogArgumentType<Args>::GetSize(args) + ... + 0);
+            const uint32_t alignedSize = (uint32_t)((size + LogRingBuffer::Alignment - 1) & ~size_t(LogRingBuffer::Alignment - 1));
+
+            // Counted before checking m_Running, Stop waits for the producers that saw it set before its final drain
+            m_ActiveProducers.fetch_add(1, std::memory_order_seq_cst);
+            const bool running = m_Running.load(std::memory_order_seq_cst);
+            LogRingBuffer* ring = alignedSize <= LogRingBuffer::MaxRecordSize && running ? GetThreadRing() : nullptr;
+            uint8_t* record = ring ? ReserveBlocking(ring, alignedSize) : nullptr;
+            const bool queued = record != nullptr;
+            std::string fallback;
+            if (!queued)
+            {
+                fallback.resize(alignedSize);
+                record = (uint8_t*)fallback.data();
+            }
+
+            LogRecordHeader header;
+            header.size = alignedSize;
+            header.formatCount = (uint32_t)format.Count();
+            header.formatFunction = &FormatRecord<std::decay_t<Args>...>;
+            header.loggerName = loggerName;
+            header.category = category;
+            header.timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+            header.verbosity = verbosity;
+            std::memcpy(record, &header, sizeof(LogRecordHeader));
+
+            uint8_t* dest = record + sizeof(LogRecordHeader);
+            std::memcpy(dest, format.Data(), format.Count());
+            dest += format.Count();
+            (LogArgumentType<Args>::Encode(dest, args), ...);
+
+            if (queued)
+            {
+                ring->Commit();
+                if (verbosity == Verbosity::Error || ring->IsHalfFull())
+                    Wake();
+                m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+
+            m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+            WriteImmediate(record);
+        }
+    private:
+        LogBackend();
+
+        template<typename... Args>
+        static void FormatRecord(const std::string_view format, const uint8_t* arguments, std::string& output)
+        {
+            // Braced initialization decodes the arguments in order
+            std::tuple<typename LogArgument<Args>::DecodedType...> values{ LogArgument<Args>::Decode(arguments)... };
+            std::apply([&](auto&... decoded)
+            {
+                std::vformat_to(std::back_inserter(output), format, std::make_format_args(decoded...));
+            }, values);
+        }
+
+        static uint32_t GetThreadIndex();
+        static LogRecordHeader FormatRecordText(const uint8_t* record, std::string& output);
+
+        LogRingBuffer* GetThreadRing();
+        uint8_t* ReserveBlocking(LogRingBuffer* ring, uint32_t size);
+        void WriteImmediate(const uint8_t* record);
+        void WriteToSinks(const LogRecordHeader& header, uint32_t threadIndex, StringView message);
+        void FlushSinks();
+        void Wake();
+        void Run();
+        void Drain();
+
+        struct PendingRecord
+        {
+            const char* loggerName;
+            const char* category;
+            int64_t timestamp;
+            Verbosity verbosity;
+            uint32_t threadIndex;
+            size_t offset;
+            size_t count;
+        };
+
+        std::thread m_Thread;
+        std::atomic<bool> m_Running = false;
+        // Threads inside Enqueue, between the m_Running check and the commit of their record
+        std::atomic<uint32_t> m_ActiveProducers = 0;
+        std::atomic<bool> m_WakeRequested = false;
+        bool m_Stop = false;
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+
+        std::atomic<uint64_t> m_FlushRequested = 0;
+        uint64_t m_FlushCompleted = 0;
+        std::condition_variable m_FlushCondition;
+
+        std::mutex m_RingMutex;
+        Array<LogRingBuffer*> m_Rings;
+        uint32_t m_NextThreadIndex = 0;
+
+        // Serializes sink access between the logging thread and immediate writes
+        std::mutex m_SinkMutex;
+        Array<LogSink*> m_Sinks;
+        ConsoleLogSink m_ConsoleSink;
+        int64_t m_StartTimestamp = 0;
+
+        // Only touched while draining
+        Array<PendingRecord> m_Pending;
+        std::string m_Text;
+    };
+}
@@ -1,8 +1,21 @@
 ﻿#pragma once
-#include "Containers/String.h"
+#include "LogVerbosity.h"
 
-#define NOVA_DECLARE_LOG_CATEGORY_STATIC(ClassName, CategoryName) \
+#define NOVA_DECLARE_LOG_CATEGORY_STATIC_VERBOSITY(ClassName, CategoryName, MinVerbosity) \
 struct ClassName##LogCategory \
 {\
-    static inline Nova::String s_CategoryName = CategoryName; \
-};
\ No newline at end of file
+    static constexpr const char* s_CategoryName = CategoryName; \
+    static constexpr Nova::Verbosity s_MinVerbosity = MinVerbosity; \
+};
+
+#define NOVA_DECLARE_LOG_CATEGORY_STATIC(ClassName, CategoryName) \
+    NOVA_DECLARE_LOG_CATEGORY_STATIC_VERBOSITY(ClassName, CategoryName, NOVA_LOG_MIN_VERBOSITY)
+
+namespace Nova
+{
+    template<typename Category>
+    constexpr bool IsLogEnabled(const Verbosity verbosity)
+    {
+        return verbosity >= NOVA_LOG_MIN_VERBOSITY && verbosity >= Category::s_MinVerbosity;
+    }
+}
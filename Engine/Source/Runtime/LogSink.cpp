@@ -0,0 +1,117 @@
+﻿#include "LogSink.h"
+#include "Containers/StringFormat.h"
+#include <iostream>
+
+namespace Nova
+{
+    static ConsoleColor GetVerbosityColor(const Verbosity verbosity)
+    {
+        switch (verbosity)
+        {
+        case Verbosity::Trace: return ConsoleColor::Reset;
+        case Verbosity::Info: return ConsoleColor::Green;
+        case Verbosity::Warning: return ConsoleColor::Yellow;
+        case Verbosity::Error: return ConsoleColor::Red;
+        }
+        return ConsoleColor::Reset;
+    }
+
+    static StringView GetVerbosityName(const Verbosity verbosity)
+    {
+        switch (verbosity)
+        {
+        case Verbosity::Trace: return "Trace";
+        case Verbosity::Info: return "Info";
+        case Verbosity::Warning: return "Warning";
+        case Verbosity::Error: return "Error";
+        }
+        return "";
+    }
+
+    void ConsoleLogSink::Write(const LogRecord& record)
+    {
+        const StringView code = GetConsoleColorCode(GetVerbosityColor(record.verbosity));
+        if (record.category)
+            std::cout << code << '[' << record.loggerName << "] [" << record.category << "] " << record.message << '\n';
+        else
+            std::cout << code << '[' << record.loggerName << "] " << record.message << '\n';
+    }
+
+    void ConsoleLogSink::Flush()
+    {
+        std::cout.flush();
+    }
+
+    FileLogSink::~FileLogSink()
+    {
+        Close();
+    }
+
+    bool FileLogSink::Open(const StringView& filepath)
+    {
+        Close();
+        m_Filepath = String((char*)filepath.Data(), filepath.Count());
+        return m_Stream.Open(m_Filepath, OpenModeFlagBits::WriteText);
+    }
+
+    void FileLogSink::Close()
+    {
+        if (m_Stream.IsOpened())
+            m_Stream.Close();
+    }
+
+    void FileLogSink::Write(const LogRecord& record)
+    {
+        if (!m_Stream.IsOpened())
+            return;
+
+        const String line = record.category
+            ? StringFormat("[{:.3f}] [{}] [{}] [{}] [{}] {}\n", record.time, record.threadIndex, record.loggerName, record.category, GetVerbosityName(record.verbosity), record.message)
+            : StringFormat("[{:.3f}] [{}] [{}] [{}] {}\n", record.time, record.threadIndex, record.loggerName, GetVerbosityName(record.verbosity), record.message);
+        m_Stream.WriteRaw(line.Data(), line.Count());
+    }
+
+    void FileLogSink::Flush()
+    {
+        if (m_Stream.IsOpened())
+            m_Stream.Flush();
+    }
+
+    void MemoryLogSink::Write(const LogRecord& record)
+    {
+        if (m_MaxEntries == 0)
+            return;
+
+        Entry entry;
+        entry.category = record.category ? Name(record.category) : Name();
+        entry.verbosity = record.verbosity;
+        entry.time = record.time;
+        entry.message = String((char*)record.message.Data(), record.message.Count());
+
+        std::lock_guard lock(m_Mutex);
+        if (m_Entries.Count() < m_MaxEntries)
+        {
+            m_Entries.Add(entry);
+            return;
+        }
+
+        m_Entries[m_Next] = entry;
+        m_Next = (m_Next + 1) % m_MaxEntries;
+    }
+
+    Array<MemoryLogSink::Entry> MemoryLogSink::GetEntries() const
+    {
+        std::lock_guard lock(m_Mutex);
+        Array<Entry> result;
+        for (size_t i = 0; i < m_Entries.Count(); ++i)
+            result.Add(m_Entries[(m_Next + i) % m_Entries.Count()]);
+        return result;
+    }
+
+    void MemoryLogSink::Clear()
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Entries.Clear();
+        m_Next = 0;
+    }
+}
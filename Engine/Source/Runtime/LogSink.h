@@ -0,0 +1,126 @@
+﻿#pragma once
+#include "LogVerbosity.h"
+#include "Name.h"
+#include "Containers/Array.h"
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include "IO/FileStream.h"
+#include <mutex>
+
+namespace Nova
+{
+    enum class ConsoleColor
+    {
+        Black = 30,	
+        Red = 31,	
+        Green = 32,	
+        Yellow = 33,	
+        Blue = 34,	
+        Magenta = 35,	
+        Cyan = 36,	
+        White = 37,
+        BrightBlack = 90,
+        BrightRed = 91,
+        BrightGreen = 92,
+        BrightYellow = 93,
+        BrightBlue = 94,
+        BrightMagenta = 95,
+        BrightCyan = 96,
+        BrightWhite = 97,
+        Reset
+    };
+
+    static StringView GetConsoleColorCode(ConsoleColor Color)
+    {
+        switch (Color)
+        {
+        case ConsoleColor::Black: return "\033[30m";
+        case ConsoleColor::Red: return "\033[31m";
+        case ConsoleColor::Green: return "\033[32m";
+        case ConsoleColor::Yellow: return "\033[33m";
+        case ConsoleColor::Blue: return "\033[34m";
+        case ConsoleColor::Magenta: return "\033[35m";
+        case ConsoleColor::Cyan: return "\033[36m";
+        case ConsoleColor::White: return "\033[37m";
+        case ConsoleColor::BrightBlack: return "\033[90m";
+        case ConsoleColor::BrightRed: return "\033[91m";
+        case ConsoleColor::BrightGreen: return "\033[92m";
+        case ConsoleColor::BrightYellow: return "\033[93m";
+        case ConsoleColor::BrightBlue: return "\033[94m";
+        case ConsoleColor::BrightMagenta: return "\033[95m";
+        case ConsoleColor::BrightCyan: return "\033[96m";
+        case ConsoleColor::BrightWhite: return "\033[97m";
+        case ConsoleColor::Reset: return "\033[0m";
+        }
+        return nullptr;
+    }
+
+    // A formatted log message, only valid for the duration of LogSink::Write
+    struct LogRecord
+    {
+        const char* loggerName = nullptr;
+        const char* category = nullptr;
+        Verbosity verbosity = Verbosity::Trace;
+        uint32_t threadIndex = 0;
+        // Seconds since the log backend was created
+        double time = 0.0;
+        StringView message;
+    };
+
+    // Sinks are only called from one thread at a time, usually the logging thread
+    class LogSink
+    {
+    public:
+        virtual ~LogSink() = default;
+        virtual void Write(const LogRecord& record) = 0;
+        virtual void Flush() {}
+    };
+
+    class ConsoleLogSink final : public LogSink
+    {
+    public:
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+    };
+
+    class FileLogSink final : public LogSink
+    {
+    public:
+        ~FileLogSink() override;
+
+        bool Open(const StringView& filepath);
+        void Close();
+
+        void Write(const LogRecord& record) override;
+        void Flush() override;
+    private:
+        String m_Filepath;
+        FileStream m_Stream;
+    };
+
+    // Keeps the last messages in memory, for in-game consoles and tests
+    class MemoryLogSink final : public LogSink
+    {
+    public:
+        struct Entry
+        {
+            Name category;
+            Verbosity verbosity = Verbosity::Trace;
+            double time = 0.0;
+            String message;
+        };
+
+        explicit MemoryLogSink(size_t maxEntries = 1024) : m_MaxEntries(maxEntries) {}
+
+        void Write(const LogRecord& record) override;
+
+        // Copies the entries, oldest first
+        Array<Entry> GetEntries() const;
+        void Clear();
+    private:
+        mutable std::mutex m_Mutex;
+        Array<Entry> m_Entries;
+        size_t m_MaxEntries = 0;
+        size_t m_Next = 0;
+    };
+}
@@ -10,3 +10,12 @@ namespace Nova
         Error
     };
 }
+
+// Messages below this verbosity are compiled out, whatever their category
+#ifndef NOVA_LOG_MIN_VERBOSITY
+    #if defined(NOVA_DEBUG)
+        #define NOVA_LOG_MIN_VERBOSITY Nova::Verbosity::Trace
+    #else
+        #define NOVA_LOG_MIN_VERBOSITY Nova::Verbosity::Info
+    #endif
+#endif
@@ -0,0 +1,144 @@
+﻿#include "Memory.h"
+#include "Assertion.h"
+#include <atomic>
+#include <cstddef>
+
+namespace Nova::Memory
+{
+    const char* GetTagName(const MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::General: return "General";
+        case MemoryTag::Containers: return "Containers";
+        case MemoryTag::Strings: return "Strings";
+        case MemoryTag::Rendering: return "Rendering";
+        case MemoryTag::Audio: return "Audio";
+        case MemoryTag::Physics: return "Physics";
+        case MemoryTag::Assets: return "Assets";
+        case MemoryTag::Scene: return "Scene";
+        case MemoryTag::Frame: return "Frame";
+        default: return "Unknown";
+        }
+    }
+
+#if defined(NOVA_MEMORY_TRACKING)
+    // Prepended to every tracked allocation, keeps the user pointer aligned like malloc does
+    struct alignas(alignof(std::max_align_t)) AllocationHeader
+    {
+        size_t size;
+        uint32_t magic;
+        MemoryTag tag;
+    };
+
+    static constexpr uint32_t AllocationMagic = 0x4E4F5641;
+
+    struct TagCounters
+    {
+        alignas(64) std::atomic<size_t> liveBytes = 0;
+        std::atomic<size_t> peakBytes = 0;
+        std::atomic<size_t> liveAllocations = 0;
+        std::atomic<size_t> totalAllocations = 0;
+        std::atomic<size_t> frameAllocations = 0;
+        std::atomic<size_t> lastFrameAllocations = 0;
+    };
+
+    static TagCounters s_Counters[(size_t)MemoryTag::Count];
+    static thread_local MemoryTag s_CurrentTag = MemoryTag::Count;
+
+    static void OnAllocated(const MemoryTag tag, const size_t size)
+    {
+        TagCounters& counters = s_Counters[(size_t)tag];
+        const size_t liveBytes = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        while (liveBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {}
+        counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void OnFreed(const MemoryTag tag, const size_t size)
+    {
+        TagCounters& counters = s_Counters[(size_t)tag];
+        counters.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static AllocationHeader* GetHeader(void* ptr)
+    {
+        AllocationHeader* header = (AllocationHeader*)ptr - 1;
+        NOVA_ASSERT(header->magic == AllocationMagic, "Freeing memory that was not allocated by Nova::Memory!");
+        return header;
+    }
+
+    MemoryTag GetCurrentTag(const MemoryTag fallback)
+    {
+        return s_CurrentTag != MemoryTag::Count ? s_CurrentTag : fallback;
+    }
+
+    void* TrackedMalloc(const size_t size, const MemoryTag tag)
+    {
+        AllocationHeader* header = (AllocationHeader*)NOVA_MALLOC(sizeof(AllocationHeader) + size);
+        if (!header) return nullptr;
+        header->size = size;
+        header->magic = AllocationMagic;
+        header->tag = tag;
+        OnAllocated(tag, size);
+        return header + 1;
+    }
+
+    void* TrackedRealloc(void* ptr, const size_t size, const MemoryTag tag)
+    {
+        if (!ptr)
+            return TrackedMalloc(size, tag);
+
+        AllocationHeader* header = GetHeader(ptr);
+        const MemoryTag originalTag = header->tag;
+        const size_t originalSize = header->size;
+        AllocationHeader* newHeader = (AllocationHeader*)NOVA_REALLOC(header, sizeof(AllocationHeader) + size);
+        if (!newHeader) return nullptr;
+
+        newHeader->size = size;
+        OnFreed(originalTag, originalSize);
+        OnAllocated(originalTag, size);
+        return newHeader + 1;
+    }
+
+    void TrackedFree(void* ptr)
+    {
+        if (!ptr) return;
+        AllocationHeader* header = GetHeader(ptr);
+        OnFreed(header->tag, header->size);
+        header->magic = 0;
+        NOVA_FREE(header);
+    }
+
+    MemoryTagStats GetTagStats(const MemoryTag tag)
+    {
+        const TagCounters& counters = s_Counters[(size_t)tag];
+        MemoryTagStats stats;
+        stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+        stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+        stats.frameAllocations = counters.lastFrameAllocations.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void NewFrame()
+    {
+        for (TagCounters& counters : s_Counters)
+            counters.lastFrameAllocations.store(counters.frameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    ScopedTag::ScopedTag(const MemoryTag tag) : m_Previous(s_CurrentTag)
+    {
+        s_CurrentTag = tag;
+    }
+
+    ScopedTag::~ScopedTag()
+    {
+        s_CurrentTag = m_Previous;
+    }
+#endif
+}
@@ -17,18 +17,90 @@
 #define NOVA_FREE(ptr) std::free((ptr))
 #endif
 
+namespace Nova
+{
+    enum class MemoryTag : uint8_t
+    {
+        General,
+        Containers,
+        Strings,
+        Rendering,
+        Audio,
+        Physics,
+        Assets,
+        Scene,
+        Frame,
+        Count
+    };
+
+    struct MemoryTagStats
+    {
+        size_t liveBytes = 0;
+        size_t peakBytes = 0;
+        size_t liveAllocations = 0;
+        size_t totalAllocations = 0;
+        // Allocations made during the last completed frame
+        size_t frameAllocations = 0;
+    };
+}
+
 namespace Nova::Memory
 {
+    const char* GetTagName(MemoryTag tag);
+
+#if defined(NOVA_MEMORY_TRACKING)
+    // Tag of the innermost ScopedTag on this thread, or fallback
+    MemoryTag GetCurrentTag(MemoryTag fallback = MemoryTag::General);
+
+    void* TrackedMalloc(size_t size, MemoryTag tag);
+    void* TrackedRealloc(void* ptr, size_t size, MemoryTag tag);
+    void TrackedFree(void* ptr);
+
+    MemoryTagStats GetTagStats(MemoryTag tag);
+    // Closes the per frame allocation counters, called once per frame by the application
+    void NewFrame();
+
+    // Tags every untagged allocation made by this thread while alive
+    class ScopedTag
+    {
+    public:
+        explicit ScopedTag(MemoryTag tag);
+        ~ScopedTag();
+        ScopedTag(const ScopedTag&) = delete;
+        ScopedTag& operator=(const ScopedTag&) = delete;
+    private:
+        MemoryTag m_Previous;
+    };
+
+    #define NOVA_MALLOC_TAGGED(size, tag) Nova::Memory::TrackedMalloc((size), (tag))
+    #define NOVA_REALLOC_TAGGED(ptr, size, tag) Nova::Memory::TrackedRealloc((ptr), (size), (tag))
+    #define NOVA_FREE_TAGGED(ptr) Nova::Memory::TrackedFree((ptr))
+#else
+    inline MemoryTag GetCurrentTag(const MemoryTag fallback = MemoryTag::General) { return fallback; }
+    inline MemoryTagStats GetTagStats(MemoryTag) { return {}; }
+    inline void NewFrame() {}
+
+    class ScopedTag
+    {
+    public:
+        explicit ScopedTag(MemoryTag) {}
+    };
+
+    #define NOVA_MALLOC_TAGGED(size, tag) NOVA_MALLOC((size))
+    #define NOVA_REALLOC_TAGGED(ptr, size, tag) NOVA_REALLOC((ptr), (size))
+    #define NOVA_FREE_TAGGED(ptr) NOVA_FREE((ptr))
+#endif
+
     template<typename T>
-    T* Malloc(const size_t count = 1)
+    T* Malloc(const size_t count = 1, const MemoryTag tag = GetCurrentTag())
     {
-        return (T*)NOVA_MALLOC(count * sizeof(T));
+        return (T*)NOVA_MALLOC_TAGGED(count * sizeof(T), tag);
     }
     
     template<typename T>
-    T* Realloc(T* ptr, const size_t count = 1)
+    T* Realloc(T* ptr, const size_t count = 1, const MemoryTag tag = GetCurrentTag())
     {
-        return (T*)NOVA_REALLOC(ptr, count * sizeof(T));
+        return (T*)NOVA_REALLOC_TAGGED(ptr, count * sizeof(T), tag);
     }
 
     template<typename T>
@@ -56,9 +128,9 @@ namespace Nova::Memory
     }
 
     template<typename T>
-    T* Calloc(size_t count = 1)
+    T* Calloc(size_t count = 1, const MemoryTag tag = GetCurrentTag())
     {
-        T* result = Malloc<T>(count);
+        T* result = Malloc<T>(count, tag);
         result = Memset(result, 0, count);
         return result;
     }
@@ -66,7 +138,7 @@ namespace Nova::Memory
     template<typename T>
     void Free(T* ptr)
     {
-        NOVA_FREE(ptr);
+        NOVA_FREE_TAGGED((void*)ptr);
     }
 
     template<typename SourceType, typename DestType>
@@ -0,0 +1,193 @@
+﻿#include "Name.h"
+#include "Arena.h"
+#include "Assertion.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Nova
+{
+    struct NameEntry
+    {
+        const char* data;
+        uint32_t count;
+        uint32_t hash;
+    };
+
+    // Entries live in fixed size chunks that never move so strings can be read back without locking.
+    // Lookups go through an open addressing table of ids guarded by a reader/writer lock.
+    class NameTable
+    {
+    public:
+        static constexpr uint32_t ChunkSize = 4096;
+        static constexpr uint32_t MaxChunks = 1024;
+
+        NameTable() : m_Strings(Arena::DefaultBlockSize, MemoryTag::Strings)
+        {
+            // Id 0 is None
+            Insert("", 0, Hash("", 0));
+        }
+
+        static NameTable& Get()
+        {
+            static NameTable table;
+            return table;
+        }
+
+        static uint32_t Hash(const char* data, const size_t count)
+        {
+            // FNV-1a
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < count; ++i)
+            {
+                hash ^= (uint8_t)data[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        uint32_t Find(const char* data, const size_t count, const uint32_t hash) const
+        {
+            std::shared_lock lock(m_Mutex);
+            return Probe(data, count, hash);
+        }
+
+        uint32_t FindOrAdd(const char* data, const size_t count)
+        {
+            const uint32_t hash = Hash(data, count);
+            if (const uint32_t id = Find(data, count, hash))
+                return id;
+
+            std::unique_lock lock(m_Mutex);
+            // Another thread may have added it between the two locks
+            if (const uint32_t id = Probe(data, count, hash))
+                return id;
+            return Insert(data, count, hash);
+        }
+
+        const NameEntry& GetEntry(const uint32_t id) const
+        {
+            NOVA_ASSERT(id < m_Count.load(std::memory_order_acquire), "Invalid name id!");
+            return m_Chunks[id / ChunkSize].load(std::memory_order_acquire)[id % ChunkSize];
+        }
+
+        uint32_t GetCount() const { return m_Count.load(std::memory_order_acquire); }
+    private:
+        // Expects m_Mutex to be locked, returns 0 when not found
+        uint32_t Probe(const char* data, const size_t count, const uint32_t hash) const
+        {
+            if (m_Slots.IsEmpty())
+                return 0;
+
+            const uint32_t mask = (uint32_t)m_Slots.Count() - 1;
+            for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask)
+            {
+                const uint32_t id = m_Slots[slot];
+                if (id == 0)
+                    return 0;
+
+                const NameEntry& entry = GetEntry(id);
+                if (entry.hash == hash && entry.count == count && std::memcmp(entry.data, data, count) == 0)
+                    return id;
+            }
+        }
+
+        // Expects m_Mutex to be locked for writing
+        uint32_t Insert(const char* data, const size_t count, const uint32_t hash)
+        {
+            const uint32_t id = m_Count.load(std::memory_order_relaxed);
+            NOVA_ASSERT(id < ChunkSize * MaxChunks, "Too many names!");
+
+            NameEntry* chunk = m_Chunks[id / ChunkSize].load(std::memory_order_relaxed);
+            if (!chunk)
+            {
+                chunk = Memory::Malloc<NameEntry>(ChunkSize, MemoryTag::Strings);
+                m_Chunks[id / ChunkSize].store(chunk, std::memory_order_release);
+            }
+
+            char* string = m_Strings.Allocate<char>(count + 1);
+            std::memcpy(string, data, count);
+            string[count] = 0;
+            chunk[id % ChunkSize] = { string, (uint32_t)count, hash };
+            m_Count.store(id + 1, std::memory_order_release);
+
+            // None is never looked up, it is the empty slot marker
+            if (id == 0)
+                return id;
+
+            if ((id + 1) * 2 > m_Slots.Count())
+                Rehash(std::max<size_t>(m_Slots.Count() * 2, 1024));
+
+            const uint32_t mask = (uint32_t)m_Slots.Count() - 1;
+            uint32_t slot = hash & mask;
+            while (m_Slots[slot] != 0)
+                slot = (slot + 1) & mask;
+            m_Slots[slot] = id;
+            return id;
+        }
+
+        void Rehash(const size_t slotCount)
+        {
+            // Array storage is zeroed, every slot starts empty
+            Array<uint32_t> slots(slotCount);
+
+            const uint32_t mask = (uint32_t)slotCount - 1;
+            for (const uint32_t id : m_Slots)
+            {
+                if (id == 0) continue;
+                uint32_t slot = GetEntry(id).hash & mask;
+                while (slots[slot] != 0)
+                    slot = (slot + 1) & mask;
+                slots[slot] = id;
+            }
+            m_Slots = std::move(slots);
+        }
+
+        mutable std::shared_mutex m_Mutex;
+        Arena m_Strings;
+        Array<uint32_t> m_Slots;
+        std::atomic<NameEntry*> m_Chunks[MaxChunks] = {};
+        std::atomic<uint32_t> m_Count = 0;
+    };
+
+    Name::Name(const char* string) : Name(StringView(string))
+    {
+    }
+
+    Name::Name(const StringView string)
+    {
+        if (string.IsEmpty())
+            return;
+        m_Id = NameTable::Get().FindOrAdd(string.Data(), string.Count());
+    }
+
+    Name Name::Find(const StringView string)
+    {
+        if (string.IsEmpty())
+            return {};
+        return Name(NameTable::Get().Find(string.Data(), string.Count(), NameTable::Hash(string.Data(), string.Count())));
+    }
+
+    StringView Name::GetString() const
+    {
+        const NameEntry& entry = NameTable::Get().GetEntry(m_Id);
+        return { entry.data, entry.count };
+    }
+
+    const char* Name::GetCString() const
+    {
+        return NameTable::Get().GetEntry(m_Id).data;
+    }
+
+    uint32_t Name::GetCount()
+    {
+        return NameTable::Get().GetCount();
+    }
+}
+
+std::format_context::iterator std::formatter<Nova::Name>::format(const Nova::Name& name, format_context& context) const
+{
+    const Nova::StringView string = name.GetString();
+    return formatter<string_view>::format(string_view(string.Data(), string.Count()), context);
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include <cstdint>
+#include <format>
+
+namespace Nova
+{
+    // Case sensitive string interned once in a global table and referred to by a 32-bit id afterwards.
+    // Comparing, copying and hashing a name never touches the characters, which stay valid until the program exits.
+    // The default constructed name is None and its string is empty.
+    class Name
+    {
+    public:
+        Name() = default;
+        Name(const char* string);
+        Name(StringView string);
+
+        template<ContainerAllocator Allocator>
+        Name(const StringBase<char, Allocator>& string) : Name(StringView(string)) {}
+
+        // Returns the name if the string was already interned, None otherwise. Never adds to the table.
+        static Name Find(StringView string);
+
+        uint32_t GetId() const { return m_Id; }
+        bool IsNone() const { return m_Id == 0; }
+        StringView GetString() const;
+        // Null terminated
+        const char* GetCString() const;
+
+        bool operator==(const Name& other) const { return m_Id == other.m_Id; }
+        bool operator<(const Name& other) const { return m_Id < other.m_Id; }
+
+        // Number of interned strings, None included
+        static uint32_t GetCount();
+    private:
+        explicit Name(const uint32_t id) : m_Id(id) {}
+
+        uint32_t m_Id = 0;
+    };
+}
+
+template<>
+struct std::formatter<Nova::Name> : std::formatter<std::string_view>
+{
+    std::format_context::iterator format(const Nova::Name& name, format_context& context) const;
+};
+
+template<>
+struct std::hash<Nova::Name>
+{
+    size_t operator()(const Nova::Name& name) const noexcept { return name.GetId(); }
+};
@@ -0,0 +1,213 @@
+﻿#include "PoolAllocator.h"
+#include "Assertion.h"
+#include <algorithm>
+
+namespace Nova
+{
+    static constexpr uint32_t MaxCachedPools = 128;
+
+    static std::atomic<PoolAllocator*> s_CachedPools[MaxCachedPools];
+    static std::atomic<uint32_t> s_CachedPoolCount = 0;
+
+    static uintptr_t AlignUp(const uintptr_t value, const size_t alignment)
+    {
+        return (value + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    // Hands the blocks cached by an exiting thread back to their pools
+    struct PoolThreadCaches
+    {
+        PoolAllocator::ThreadCache caches[MaxCachedPools];
+
+        ~PoolThreadCaches()
+        {
+            for (uint32_t index = 0; index < MaxCachedPools; ++index)
+            {
+                PoolAllocator::ThreadCache& cache = caches[index];
+                if (!cache.head) continue;
+
+                PoolAllocator* pool = s_CachedPools[index].load(std::memory_order_acquire);
+                if (!pool) continue;
+
+                PoolAllocator::FreeNode* tail = cache.head;
+                while (tail->next)
+                    tail = tail->next;
+
+                std::scoped_lock lock(pool->m_Mutex);
+                pool->Return(cache.head, tail);
+            }
+        }
+    };
+
+    static thread_local PoolThreadCaches s_ThreadCaches;
+
+    PoolAllocator::PoolAllocator(const size_t blockSize, const size_t alignment, const uint32_t blocksPerChunk, const MemoryTag tag, const bool threadCache)
+        : m_BlockSize(blockSize), m_BlocksPerChunk(blocksPerChunk), m_Tag(tag)
+    {
+        NOVA_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+        NOVA_ASSERT(blocksPerChunk > 0, "A chunk needs at least one block!");
+
+        // Every block is preceded by a pointer to its pool so it can be freed without knowing its type
+        m_Alignment = std::max(alignment, alignof(PoolAllocator*));
+        m_Stride = AlignUp(std::max(blockSize, sizeof(FreeNode)) + sizeof(PoolAllocator*), m_Alignment);
+
+        if (threadCache)
+        {
+            const uint32_t index = s_CachedPoolCount.fetch_add(1, std::memory_order_relaxed);
+            if (index < MaxCachedPools)
+            {
+                m_CacheIndex = index;
+                s_CachedPools[index].store(this, std::memory_order_release);
+            }
+        }
+    }
+
+    PoolAllocator::~PoolAllocator()
+    {
+        if (m_CacheIndex != NoThreadCache)
+            s_CachedPools[m_CacheIndex].store(nullptr, std::memory_order_release);
+
+        Chunk* chunk = m_Chunks;
+        while (chunk)
+        {
+            Chunk* next = chunk->next;
+            Memory::Free(chunk);
+            chunk = next;
+        }
+    }
+
+    void* PoolAllocator::Allocate()
+    {
+        FreeNode* node = nullptr;
+        if (ThreadCache* cache = GetThreadCache())
+        {
+            if (!cache->head)
+                Refill(*cache);
+
+            node = cache->head;
+            if (!node) return nullptr;
+            cache->head = node->next;
+            cache->count--;
+        }
+        else
+        {
+            std::scoped_lock lock(m_Mutex);
+            if (!m_FreeList && !AllocateChunk())
+                return nullptr;
+
+            node = m_FreeList;
+            m_FreeList = node->next;
+        }
+
+        m_LiveCount.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    void PoolAllocator::Free(void* block)
+    {
+        if (!block) return;
+        NOVA_ASSERT(GetOwner(block) == this, "Freeing a block allocated by another pool!");
+
+        m_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+        FreeNode* node = (FreeNode*)block;
+
+        ThreadCache* cache = GetThreadCache();
+        if (!cache)
+        {
+            std::scoped_lock lock(m_Mutex);
+            Return(node, node);
+            return;
+        }
+
+        node->next = cache->head;
+        cache->head = node;
+        cache->count++;
+        if (cache->count < CacheBatchSize * 2)
+            return;
+
+        // Keep one batch cached, give the rest back so other threads can reuse it
+        FreeNode* tail = cache->head;
+        for (uint32_t i = 1; i < CacheBatchSize; ++i)
+            tail = tail->next;
+
+        FreeNode* returned = tail->next;
+        tail->next = nullptr;
+
+        FreeNode* returnedTail = returned;
+        while (returnedTail->next)
+            returnedTail = returnedTail->next;
+
+        cache->count = CacheBatchSize;
+
+        std::scoped_lock lock(m_Mutex);
+        Return(returned, returnedTail);
+    }
+
+    void PoolAllocator::Deallocate(void* block)
+    {
+        if (!block) return;
+        GetOwner(block)->Free(block);
+    }
+
+    bool PoolAllocator::AllocateChunk()
+    {
+        const size_t size = sizeof(Chunk) + sizeof(PoolAllocator*) + m_Alignment + m_Stride * m_BlocksPerChunk;
+        Chunk* chunk = (Chunk*)Memory::Malloc<uint8_t>(size, m_Tag);
+        if (!chunk) return false;
+
+        chunk->next = m_Chunks;
+        m_Chunks = chunk;
+
+        // Link the blocks in address order so consecutive allocations are contiguous
+        const uintptr_t first = AlignUp((uintptr_t)(chunk + 1) + sizeof(PoolAllocator*), m_Alignment);
+        FreeNode* head = nullptr;
+        for (uint32_t i = m_BlocksPerChunk; i-- > 0;)
+        {
+            void* block = (void*)(first + i * m_Stride);
+            GetOwner(block) = this;
+            FreeNode* node = (FreeNode*)block;
+            node->next = head;
+            head = node;
+        }
+
+        FreeNode* tail = (FreeNode*)(first + (m_BlocksPerChunk - 1) * m_Stride);
+        tail->next = m_FreeList;
+        m_FreeList = head;
+        m_Capacity.fetch_add(m_BlocksPerChunk, std::memory_order_relaxed);
+        return true;
+    }
+
+    void PoolAllocator::Return(FreeNode* head, FreeNode* tail)
+    {
+        tail->next = m_FreeList;
+        m_FreeList = head;
+    }
+
+    void PoolAllocator::Refill(ThreadCache& cache)
+    {
+        std::scoped_lock lock(m_Mutex);
+        if (!m_FreeList && !AllocateChunk())
+            return;
+
+        // Move a whole batch off the front of the free list, keeping its order
+        FreeNode* tail = m_FreeList;
+        uint32_t count = 1;
+        while (count < CacheBatchSize && tail->next)
+        {
+            tail = tail->next;
+            count++;
+        }
+
+        cache.head = m_FreeList;
+        cache.count = count;
+        m_FreeList = tail->next;
+        tail->next = nullptr;
+    }
+
+    PoolAllocator::ThreadCache* PoolAllocator::GetThreadCache() const
+    {
+        if (m_CacheIndex == NoThreadCache)
+            return nullptr;
+        return &s_ThreadCaches.caches[m_CacheIndex];
+    }
+}
@@ -0,0 +1,83 @@
+﻿#pragma once
+#include "Memory.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Nova
+{
+    // Fixed size block allocator carving blocks out of chunks and recycling them through a free list.
+    // With thread caching enabled, each thread keeps a small private free list and only locks the pool
+    // to exchange blocks in batches.
+    class PoolAllocator
+    {
+    public:
+        static constexpr uint32_t DefaultBlocksPerChunk = 64;
+
+        PoolAllocator(size_t blockSize, size_t alignment, uint32_t blocksPerChunk = DefaultBlocksPerChunk, MemoryTag tag = MemoryTag::General, bool threadCache = true);
+        ~PoolAllocator();
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        void* Allocate();
+        void Free(void* block);
+
+        // Returns a block to the pool that allocated it
+        static void Deallocate(void* block);
+
+        // Pool shared by every object of type T
+        template<typename T, MemoryTag Tag = MemoryTag::General>
+        static PoolAllocator& Get()
+        {
+            static PoolAllocator pool(sizeof(T), alignof(T), DefaultBlocksPerChunk, Tag);
+            return pool;
+        }
+
+        size_t GetBlockSize() const { return m_BlockSize; }
+        size_t GetLiveCount() const { return m_LiveCount.load(std::memory_order_relaxed); }
+        size_t GetCapacity() const { return m_Capacity.load(std::memory_order_relaxed); }
+    private:
+        friend struct PoolThreadCaches;
+
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        struct Chunk
+        {
+            Chunk* next;
+        };
+
+        struct ThreadCache
+        {
+            FreeNode* head = nullptr;
+            uint32_t count = 0;
+        };
+
+        static constexpr uint32_t NoThreadCache = ~0u;
+        static constexpr uint32_t CacheBatchSize = 32;
+
+        static PoolAllocator*& GetOwner(void* block) { return *((PoolAllocator**)block - 1); }
+
+        // Both expect m_Mutex to be locked
+        bool AllocateChunk();
+        void Return(FreeNode* head, FreeNode* tail);
+
+        void Refill(ThreadCache& cache);
+        ThreadCache* GetThreadCache() const;
+
+        std::mutex m_Mutex;
+        FreeNode* m_FreeList = nullptr;
+        Chunk* m_Chunks = nullptr;
+        size_t m_BlockSize = 0;
+        size_t m_Alignment = 0;
+        size_t m_Stride = 0;
+        uint32_t m_BlocksPerChunk = 0;
+        uint32_t m_CacheIndex = NoThreadCache;
+        MemoryTag m_Tag = MemoryTag::General;
+        std::atomic<size_t> m_LiveCount = 0;
+        std::atomic<size_t> m_Capacity = 0;
+    };
+}
@@ -0,0 +1,310 @@
+﻿#include "Profiler.h"
+#include "Containers/StringFormat.h"
+#include "IO/FileStream.h"
+#include <cstring>
+#include <format>
+#include <string>
+
+namespace Nova
+{
+    // Marks the buffer of an exiting thread so the main thread can reclaim it
+    struct ProfileThreadHandle
+    {
+        ProfileThreadBuffer* buffer = nullptr;
+        ~ProfileThreadHandle()
+        {
+            if (buffer) buffer->abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    static thread_local ProfileThreadHandle s_ThreadHandle;
+
+    static void AppendJsonString(std::string& output, const char* string)
+    {
+        output.push_back('"');
+        for (const char* c = string; c && *c; ++c)
+        {
+            switch (*c)
+            {
+            case '"': output.append("\\\""); break;
+            case '\\': output.append("\\\\"); break;
+            case '\n': output.append("\\n"); break;
+            case '\t': output.append("\\t"); break;
+            default:
+                if ((unsigned char)*c < 0x20) continue;
+                output.push_back(*c);
+            }
+        }
+        output.push_back('"');
+    }
+
+    Profiler& Profiler::Get()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    Profiler::Profiler()
+    {
+        m_CalibrationTicks = GetTicks();
+        m_CalibrationTime = std::chrono::steady_clock::now().time_since_epoch().count();
+        m_FrameBegin = m_CalibrationTicks;
+    }
+
+    Profiler::~Profiler()
+    {
+        for (ProfileThreadBuffer* buffer : m_Buffers)
+            delete buffer;
+        m_Buffers.Clear();
+    }
+
+    ProfileThreadBuffer* Profiler::GetThreadBuffer()
+    {
+        if (!s_ThreadHandle.buffer)
+        {
+            ProfileThreadBuffer* buffer = new ProfileThreadBuffer();
+            std::lock_guard lock(m_BufferMutex);
+            buffer->threadIndex = m_NextThreadIndex++;
+            m_Buffers.Add(buffer);
+            m_ThreadNames.Add(StringFormat("Thread {}", buffer->threadIndex));
+            s_ThreadHandle.buffer = buffer;
+        }
+        return s_ThreadHandle.buffer;
+    }
+
+    void Profiler::BeginScope(const char*, uint64_t& outBegin, uint32_t& outDepth)
+    {
+        ProfileThreadBuffer* buffer = GetThreadBuffer();
+        outDepth = buffer->depth++;
+        outBegin = GetTicks();
+    }
+
+    void Profiler::EndScope(const char* name, const uint64_t begin, const uint32_t depth)
+    {
+        const uint64_t end = GetTicks();
+        ProfileThreadBuffer* buffer = s_ThreadHandle.buffer;
+        buffer->depth = depth;
+
+        ProfileEvent event;
+        event.name = name;
+        event.begin = begin;
+        event.end = end;
+        event.threadIndex = buffer->threadIndex;
+        event.depth = depth;
+        if (!buffer->events.TryEnqueue(event))
+            buffer->droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Profiler::SetThreadName(const StringView& name)
+    {
+        const ProfileThreadBuffer* buffer = GetThreadBuffer();
+        std::lock_guard lock(m_BufferMutex);
+        m_ThreadNames[buffer->threadIndex] = String((char*)name.Data(), name.Count());
+    }
+
+    void Profiler::AddCounter(const char* name, const int64_t value)
+    {
+        std::lock_guard lock(m_CounterMutex);
+        for (ProfileCounterStats& counter : m_Counters)
+        {
+            if (counter.name == name || std::strcmp(counter.name, name) == 0)
+            {
+                counter.currentValue += value;
+                return;
+            }
+        }
+
+        ProfileCounterStats counter;
+        counter.name = name;
+        counter.currentValue = value;
+        m_Counters.Add(counter);
+    }
+
+    void Profiler::Calibrate()
+    {
+        const uint64_t ticks = GetTicks();
+        const int64_t time = std::chrono::steady_clock::now().time_since_epoch().count();
+        const double elapsedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::duration(time - m_CalibrationTime)).count();
+        if (elapsedMilliseconds > 1.0 && ticks > m_CalibrationTicks)
+            m_TicksPerMillisecond = (double)(ticks - m_CalibrationTicks) / elapsedMilliseconds;
+    }
+
+    double Profiler::TicksToMilliseconds(const uint64_t ticks) const
+    {
+        return (double)ticks / m_TicksPerMillisecond;
+    }
+
+    void Profiler::Accumulate(const ProfileEvent& event)
+    {
+        const double duration = TicksToMilliseconds(event.end - event.begin);
+
+        ProfileScopeStats* stats = nullptr;
+        for (ProfileScopeStats& candidate : m_Stats)
+        {
+            // The same literal may live at different addresses in different translation units
+            if (candidate.name == event.name || std::strcmp(candidate.name, event.name) == 0)
+            {
+                stats = &candidate;
+                break;
+            }
+        }
+
+        if (!stats)
+        {
+            ProfileScopeStats newStats;
+            newStats.name = event.name;
+            m_Stats.Add(newStats);
+            stats = &m_Stats.Last();
+        }
+
+        stats->callCount++;
+        stats->frameTime += duration;
+        if (duration > stats->maxTime)
+            stats->maxTime = duration;
+    }
+
+    void Profiler::EndFrame()
+    {
+        const uint64_t frameEnd = GetTicks();
+        Calibrate();
+
+        for (ProfileScopeStats& stats : m_Stats)
+        {
+            stats.callCount = 0;
+            stats.frameTime = 0.0;
+        }
+
+        const uint32_t mainThreadIndex = GetThreadBuffer()->threadIndex;
+        {
+            std::lock_guard lock(m_BufferMutex);
+            for (size_t i = 0; i < m_Buffers.Count();)
+            {
+                ProfileThreadBuffer* buffer = m_Buffers[i];
+                const bool abandoned = buffer->abandoned.load(std::memory_order_acquire);
+
+                ProfileEvent event;
+                while (buffer->events.TryDequeue(event))
+                {
+                    Accumulate(event);
+                    if (m_Capturing && m_Captured.Count() < m_MaxCapturedEvents)
+                        m_Captured.Add(event);
+                }
+                m_DroppedEvents += buffer->droppedEvents.exchange(0, std::memory_order_relaxed);
+
+                if (abandoned)
+                {
+                    delete buffer;
+                    m_Buffers.RemoveAt(i);
+                    continue;
+                }
+                ++i;
+            }
+        }
+
+        for (ProfileScopeStats& stats : m_Stats)
+            stats.averageTime = stats.averageTime * 0.9 + stats.frameTime * 0.1;
+
+        {
+            std::lock_guard lock(m_CounterMutex);
+            for (ProfileCounterStats& counter : m_Counters)
+            {
+                counter.frameValue = counter.currentValue;
+                counter.currentValue = 0;
+            }
+        }
+
+        if (m_Capturing && m_Captured.Count() < m_MaxCapturedEvents)
+        {
+            ProfileEvent frame;
+            frame.name = "Frame";
+            frame.begin = m_FrameBegin;
+            frame.end = frameEnd;
+            frame.threadIndex = mainThreadIndex;
+            m_Captured.Add(frame);
+        }
+
+        m_FrameTimes[m_FrameIndex] = (float)TicksToMilliseconds(frameEnd - m_FrameBegin);
+        m_FrameIndex = (m_FrameIndex + 1) % FrameHistory;
+        m_FrameBegin = frameEnd;
+    }
+
+    void Profiler::StartCapture(const size_t maxEvents)
+    {
+        m_Captured.Clear();
+        m_MaxCapturedEvents = maxEvents;
+        m_Capturing = true;
+    }
+
+    void Profiler::StopCapture()
+    {
+        m_Capturing = false;
+    }
+
+    bool Profiler::ExportChromeTrace(const StringView& filepath) const
+    {
+        if (m_Captured.IsEmpty())
+            return false;
+
+        uint64_t origin = m_Captured[0].begin;
+        for (const ProfileEvent& event : m_Captured)
+            origin = event.begin < origin ? event.begin : origin;
+
+        std::string json;
+        json.reserve(m_Captured.Count() * 96);
+        json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+        {
+            std::lock_guard lock(m_BufferMutex);
+            for (size_t threadIndex = 0; threadIndex < m_ThreadNames.Count(); ++threadIndex)
+            {
+                std::format_to(std::back_inserter(json), "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":", threadIndex);
+                AppendJsonString(json, m_ThreadNames[threadIndex].Data());
+                json.append("}},\n");
+            }
+        }
+
+        for (size_t i = 0; i < m_Captured.Count(); ++i)
+        {
+            const ProfileEvent& event = m_Captured[i];
+            const double begin = TicksToMilliseconds(event.begin - origin) * 1000.0;
+            const double duration = TicksToMilliseconds(event.end - event.begin) * 1000.0;
+
+            json.append("{\"name\":");
+            AppendJsonString(json, event.name);
+            std::format_to(std::back_inserter(json), ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", event.threadIndex, begin, duration);
+            json.append(i + 1 < m_Captured.Count() ? ",\n" : "\n");
+        }
+        json.append("]}\n");
+
+        FileStream stream;
+        if (!stream.Open(filepath, OpenModeFlagBits::WriteText))
+            return false;
+        const bool written = stream.WriteRaw(json.data(), json.size()) == json.size();
+        stream.Close();
+        return written;
+    }
+
+    Array<float> Profiler::GetFrameTimes() const
+    {
+        Array<float> frameTimes(FrameHistory);
+        for (size_t i = 0; i < FrameHistory; ++i)
+            frameTimes[i] = m_FrameTimes[(m_FrameIndex + i) % FrameHistory];
+        return frameTimes;
+    }
+
+    Array<ProfileCounterStats> Profiler::GetCounters() const
+    {
+        std::lock_guard lock(m_CounterMutex);
+        return m_Counters;
+    }
+
+    void Profiler::ResetStats()
+    {
+        m_Stats.Clear();
+        {
+            std::lock_guard lock(m_CounterMutex);
+            m_Counters.Clear();
+        }
+        m_DroppedEvents = 0;
+    }
+}
@@ -0,0 +1,179 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include "Containers/SpscQueue.h"
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define NOVA_PROFILER_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define NOVA_PROFILER_HAS_RDTSC
+#endif
+
+#if defined(NOVA_PROFILING)
+    #define NOVA_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define NOVA_PROFILE_CONCAT(a, b) NOVA_PROFILE_CONCAT_IMPL(a, b)
+    // Name must outlive the profiler, use string literals
+    #define NOVA_PROFILE_SCOPE(name) const Nova::ProfileScope NOVA_PROFILE_CONCAT(_ProfileScope, __LINE__)(name)
+    #define NOVA_PROFILE_FUNCTION() NOVA_PROFILE_SCOPE(__FUNCTION__)
+    #define NOVA_PROFILE_FRAME() Nova::Profiler::Get().EndFrame()
+    #define NOVA_PROFILE_THREAD(name) Nova::Profiler::Get().SetThreadName(name)
+    // Name must outlive the profiler, use string literals
+    #define NOVA_PROFILE_COUNTER(name, value) Nova::Profiler::Get().AddCounter(name, value)
+#else
+    #define NOVA_PROFILE_SCOPE(name)
+    #define NOVA_PROFILE_FUNCTION()
+    #define NOVA_PROFILE_FRAME()
+    #define NOVA_PROFILE_THREAD(name)
+    #define NOVA_PROFILE_COUNTER(name, value)
+#endif
+
+namespace Nova
+{
+    struct ProfileEvent
+    {
+        const char* name = nullptr;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        uint32_t threadIndex = 0;
+        uint32_t depth = 0;
+    };
+
+    struct ProfileScopeStats
+    {
+        const char* name = nullptr;
+        uint32_t callCount = 0;
+        // Milliseconds, spent in the last completed frame
+        double frameTime = 0.0;
+        // Milliseconds, smoothed over the last frames
+        double averageTime = 0.0;
+        // Milliseconds, longest single call since the last reset
+        double maxTime = 0.0;
+    };
+
+    struct ProfileCounterStats
+    {
+        const char* name = nullptr;
+        // Summed over the last completed frame
+        int64_t frameValue = 0;
+        // Summed over the frame being recorded
+        int64_t currentValue = 0;
+    };
+
+    // Events of a thread, written by that thread only and drained on the main thread at each frame
+    struct ProfileThreadBuffer
+    {
+        static constexpr size_t Capacity = 8192;
+
+        SpscQueue<ProfileEvent, Capacity> events;
+        uint32_t threadIndex = 0;
+        uint32_t depth = 0;
+        std::atomic<uint32_t> droppedEvents = 0;
+        std::atomic<bool> abandoned = false;
+    };
+
+    class Profiler
+    {
+    public:
+        static constexpr size_t FrameHistory = 256;
+
+        static Profiler& Get();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+        ~Profiler();
+
+        static uint64_t GetTicks()
+        {
+#if defined(NOVA_PROFILER_HAS_RDTSC)
+            return __rdtsc();
+#else
+            return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+
+        void BeginScope(const char* name, uint64_t& outBegin, uint32_t& outDepth);
+        void EndScope(const char* name, uint64_t begin, uint32_t depth);
+
+        // Drains every thread and closes the current frame, main thread only
+        void EndFrame();
+        void SetThreadName(const StringView& name);
+        // Adds to a counter summed over each frame, any thread
+        void AddCounter(const char* name, int64_t value);
+
+        // Keeps every event between the two calls for export
+        void StartCapture(size_t maxEvents = 1 << 20);
+        void StopCapture();
+        bool IsCapturing() const { return m_Capturing; }
+        size_t GetCapturedEventCount() const { return m_Captured.Count(); }
+        // Writes the captured events as Chrome trace JSON, readable by chrome://tracing and Perfetto
+        bool ExportChromeTrace(const StringView& filepath) const;
+
+        const Array<ProfileScopeStats>& GetScopeStats() const { return m_Stats; }
+        // Milliseconds, oldest first
+        Array<float> GetFrameTimes() const;
+        Array<ProfileCounterStats> GetCounters() const;
+        uint32_t GetDroppedEvents() const { return m_DroppedEvents; }
+        void ResetStats();
+
+        double TicksToMilliseconds(uint64_t ticks) const;
+    private:
+        Profiler();
+
+        ProfileThreadBuffer* GetThreadBuffer();
+        void Calibrate();
+        void Accumulate(const ProfileEvent& event);
+
+        mutable std::mutex m_BufferMutex;
+        Array<ProfileThreadBuffer*> m_Buffers;
+        // Indexed by thread index, guarded by the buffer mutex
+        Array<String> m_ThreadNames;
+        uint32_t m_NextThreadIndex = 0;
+
+        // Main thread only
+        Array<ProfileScopeStats> m_Stats;
+        float m_FrameTimes[FrameHistory] = {};
+        size_t m_FrameIndex = 0;
+        uint64_t m_FrameBegin = 0;
+        uint32_t m_DroppedEvents = 0;
+
+        mutable std::mutex m_CounterMutex;
+        Array<ProfileCounterStats> m_Counters;
+
+        Array<ProfileEvent> m_Captured;
+        size_t m_MaxCapturedEvents = 0;
+        bool m_Capturing = false;
+
+        uint64_t m_CalibrationTicks = 0;
+        int64_t m_CalibrationTime = 0;
+        double m_TicksPerMillisecond = 1.0;
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name) : m_Name(name)
+        {
+            Profiler::Get().BeginScope(name, m_Begin, m_Depth);
+        }
+
+        ~ProfileScope()
+        {
+            Profiler::Get().EndScope(m_Name, m_Begin, m_Depth);
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    private:
+        const char* m_Name;
+        uint64_t m_Begin = 0;
+        uint32_t m_Depth = 0;
+    };
+}
@@ -1,12 +1,23 @@
 #include "Scene.h"
 #include "Entity.h"
+#include "Application.h"
+#include "ThreadPool.h"
+#include "Rendering/RenderDevice.h"
+#include "Rendering/CommandBuffer.h"
+
+#include <algorithm>
 
 #ifdef NOVA_HAS_PHYSICS
 #include "Physics/PhysicsWorld2D.h"
+#include "Physics/PhysicsBody.h"
+#include "Components/Physics/PhysicsComponent.h"
 #endif
 
 namespace Nova
 {
+    // Below this, recording a secondary command buffer costs more than the draws it holds
+    static constexpr size_t MinEntitiesPerCommandBuffer = 64;
+
     void Scene::OnInit()
     {
 #ifdef NOVA_HAS_PHYSICS
@@ -35,6 +46,15 @@ namespace Nova
 
 #ifdef NOVA_HAS_PHYSICS
         m_PhysicsWorld2D->Step();
+
+        // Only bodies that actually moved during the step push their transform back
+        for (const PhysicsBodyMoveEvent& moveEvent : m_PhysicsWorld2D->GetMoveEvents())
+        {
+            PhysicsComponent* component = (PhysicsComponent*)moveEvent.body->GetUserPointer();
+            if (!component || !component->IsEnabled() || !component->GetOwner()->IsEnabled())
+                continue;
+            component->SyncTransform(moveEvent.position, moveEvent.rotation);
+        }
 #endif
 
 #ifdef NOVA_HAS_PHYSICS3D
@@ -63,6 +83,49 @@ namespace Nova
         }
     }
 
+    void Scene::OnRender(const RenderPassBeginInfo& renderPass, Array<const CommandBuffer*>& outCommandBuffers)
+    {
+        if (m_Entities.IsEmpty())
+            return;
+
+        RenderDevice* device = m_Owner->GetRenderDevice();
+        NOVA_ASSERT(device && device->SupportsParallelRecording(), "Render device cannot record secondary command buffers!");
+        ThreadPool& threadPool = m_Owner->GetThreadPool();
+
+        // Two batches per thread keeps every thread busy when some entities take longer to record
+        const size_t entityCount = m_Entities.Count();
+        const size_t targetBatchCount = (size_t)threadPool.GetThreadCount() * 2;
+        const size_t batchSize = std::max(MinEntitiesPerCommandBuffer, (entityCount + targetBatchCount - 1) / targetBatchCount);
+        const size_t batchCount = (entityCount + batchSize - 1) / batchSize;
+
+        // One slot per batch so the command buffers execute in entity order whichever thread recorded them
+        FrameArray<CommandBuffer*> batchCommandBuffers(batchCount);
+        for (size_t batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+            batchCommandBuffers[batchIndex] = nullptr;
+
+        threadPool.ParallelFor(entityCount, batchSize, [&](const size_t begin, const size_t end, const uint32_t threadIndex)
+        {
+            CommandBuffer* cmdBuffer = device->AllocateSecondaryCommandBuffer(threadIndex);
+            if (!cmdBuffer) return;
+
+            CommandBufferBeginInfo beginInfo;
+            beginInfo.flags = CommandBufferUsageFlagBits::OneTimeSubmit | CommandBufferUsageFlagBits::RenderPassContinue;
+            beginInfo.renderPass = &renderPass;
+            if (!cmdBuffer->Begin(beginInfo)) return;
+
+            for (size_t entityIndex = begin; entityIndex < end; ++entityIndex)
+                m_Entities[entityIndex]->OnRender(*cmdBuffer);
+
+            cmdBuffer->End();
+            batchCommandBuffers[begin / batchSize] = cmdBuffer;
+        });
+
+        for (const CommandBuffer* cmdBuffer : batchCommandBuffers)
+        {
+            if (cmdBuffer) outCommandBuffers.Add(cmdBuffer);
+        }
+    }
+
     void Scene::OnDrawDebug()
     {
         for (Entity* entity : m_Entities)
@@ -89,7 +152,7 @@ namespace Nova
 
     EntityHandle Scene::CreateEntity(const String& name)
     {
-        Entity* entity = new Entity(name, this);
+        Entity* entity = new (PoolAllocator::Get<Entity, MemoryTag::Scene>()) Entity(name, this);
         entity->m_Enabled = true;
         entity->OnInit();
         m_Entities.Add(entity);
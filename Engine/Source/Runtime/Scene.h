@@ -11,7 +11,7 @@
 #include "Physics/PhysicsWorld3D.h"
 #endif
 
-namespace Nova { class CommandBuffer; }
+namespace Nova { class CommandBuffer; struct RenderPassBeginInfo; }
 
 namespace Nova
 {
@@ -31,6 +31,9 @@ namespace Nova
         void OnUpdate(float deltaTime);
         void OnPreRender(CommandBuffer& cmdBuffer);
         void OnRender(CommandBuffer& cmdBuffer);
+        // Records the entities into secondary command buffers on the thread pool and appends them in entity order.
+        // The render pass must be begun with RenderPassContents::SecondaryCommandBuffers.
+        void OnRender(const RenderPassBeginInfo& renderPass, Array<const CommandBuffer*>& outCommandBuffers);
         void OnDrawDebug();
         void OnDestroy();
 
@@ -58,13 +61,13 @@ namespace Nova
             return nullptr;
         }
 
-        template <typename ComponentType>
-        Array<ComponentType*> GetAllComponents()
+        template <typename ComponentType, ContainerAllocator Allocator = HeapAllocator>
+        Array<ComponentType*, Allocator> GetAllComponents()
         {
-            Array<ComponentType*> result;
+            Array<ComponentType*, Allocator> result;
             ForEach([&result](const EntityHandle& handle)
             {
-                if (Array<ComponentType*> components = handle->GetAllComponents<ComponentType>(); !components.IsEmpty())
+                if (Array<ComponentType*, Allocator> components = handle->GetAllComponents<ComponentType, Allocator>(); !components.IsEmpty())
                     result.AddRange(components);
             });
             return result;
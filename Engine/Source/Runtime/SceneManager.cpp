@@ -37,6 +37,12 @@ namespace Nova
             m_ActiveScene->OnRender(cmdBuffer);
     }
 
+    void SceneManager::OnRender(const RenderPassBeginInfo& renderPass, Array<const CommandBuffer*>& outCommandBuffers)
+    {
+        if (m_ActiveScene)
+            m_ActiveScene->OnRender(renderPass, outCommandBuffers);
+    }
+
     void SceneManager::OnDrawDebug()
     {
         if (m_ActiveScene)
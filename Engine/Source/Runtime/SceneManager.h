@@ -2,7 +2,7 @@
 #include "Object.h"
 
 
-namespace Nova { class CommandBuffer; }
+namespace Nova { class CommandBuffer; struct RenderPassBeginInfo; }
 
 namespace Nova
 {
@@ -17,6 +17,7 @@ namespace Nova
         void OnUpdate(float deltaTime);
         void OnPreRender(CommandBuffer& cmdBuffer);
         void OnRender(CommandBuffer& cmdBuffer);
+        void OnRender(const RenderPassBeginInfo& renderPass, Array<const CommandBuffer*>& outCommandBuffers);
         void OnDrawDebug();
         void Destroy();
 
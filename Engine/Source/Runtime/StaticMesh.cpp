@@ -4,9 +4,7 @@
 #include "Math/Vector3.h"
 #include "Math/Vector4.h"
 #include "Rendering/RenderDevice.h"
-#include "Rendering/Buffer.h"
 #include "Rendering/Vertex.h"
-#include "Utils/BufferUtils.h"
 #include "Utils/TextureUtils.h"
 #include "Rendering/Shader.h"
 #include "Rendering/Material.h"
@@ -26,8 +24,7 @@ namespace Nova
 
     StaticMesh::~StaticMesh()
     {
-        if (m_VertexBuffer) m_VertexBuffer->Destroy();
-        if (m_IndexBuffer) m_IndexBuffer->Destroy();
+        FreeGeometry();
     }
 
     AssetType StaticMesh::GetAssetType() const
@@ -102,8 +99,8 @@ namespace Nova
 
         Array<Vertex> allVertices;
         Array<uint32_t> allIndices;
-        size_t vertexOffset = 0;
-        size_t indexOffset = 0;
+        uint32_t vertexOffset = 0;
+        uint32_t indexOffset = 0;
 
         for (size_t meshIndex = 0; meshIndex < loadedScene->mNumMeshes; meshIndex++)
         {
@@ -119,22 +116,20 @@ namespace Nova
             allIndices.AddRange(indices);
 
             SubMeshInfo subMeshInfo { };
-            subMeshInfo.vertexBufferSize = vertices.Size();
-            subMeshInfo.vertexBufferOffset = vertexOffset;
-            subMeshInfo.indexBufferSize = indices.Size();
-            subMeshInfo.indexBufferOffset = indexOffset;
+            subMeshInfo.vertexCount = (uint32_t)vertices.Count();
+            subMeshInfo.vertexOffset = vertexOffset;
+            subMeshInfo.indexCount = (uint32_t)indices.Count();
+            subMeshInfo.indexOffset = indexOffset;
             materialInfo.subMeshes.Add(subMeshInfo);
 
-            vertexOffset += subMeshInfo.vertexBufferSize;
-            indexOffset += subMeshInfo.indexBufferSize;
+            vertexOffset += subMeshInfo.vertexCount;
+            indexOffset += subMeshInfo.indexCount;
         }
 
-
-        if (m_VertexBuffer) m_VertexBuffer->Destroy();
-        m_VertexBuffer = BufferUtils::CreateVertexBuffer(device, allVertices.Data(), allVertices.Size());
-        if (m_IndexBuffer) m_IndexBuffer->Destroy();
-        m_IndexBuffer = BufferUtils::CreateIndexBuffer(device, allIndices.Data(), allIndices.Size());
-        return true;
+        FreeGeometry();
+        GeometryBuffer& geometryBuffer = device->GetGeometryBuffer();
+        m_Geometry = geometryBuffer.Allocate(allVertices.Data(), (uint32_t)allVertices.Count(), allIndices.Data(), (uint32_t)allIndices.Count());
+        return m_Geometry != InvalidGeometryHandle;
     }
 
     void StaticMesh::SetMaterial(const uint32_t slot, Ref<Material> material)
@@ -157,14 +152,18 @@ namespace Nova
         return m_MaterialInfos;
     }
 
-    Ref<Buffer> StaticMesh::GetVertexBuffer() const
+    GeometryHandle StaticMesh::GetGeometry() const
     {
-        return m_VertexBuffer;
+        return m_Geometry;
     }
 
-    Ref<Buffer> StaticMesh::GetIndexBuffer() const
+    void StaticMesh::FreeGeometry()
     {
-        return m_IndexBuffer;
+        if (m_Geometry == InvalidGeometryHandle) return;
+
+        const Ref<RenderDevice>& device = Application::GetCurrentApplication().GetRenderDevice();
+        if (device) device->GetGeometryBuffer().Free(m_Geometry);
+        m_Geometry = InvalidGeometryHandle;
     }
 
     bool StaticMesh::MaterialSlotExists(uint32_t slot) const
@@ -2,20 +2,21 @@
 #include "Asset.h"
 #include "Containers/Array.h"
 #include "Containers/StringView.h"
+#include "Rendering/GeometryBuffer.h"
 #include "Rendering/Texture.h"
 #include "Runtime/Ref.h"
 
 namespace Nova
 {
-    class Buffer;
     class Material;
 
+    // Relative to the mesh range in the device geometry buffer
     struct SubMeshInfo
     {
-        size_t vertexBufferOffset = 0;
-        size_t vertexBufferSize = 0;
-        size_t indexBufferOffset = 0;
-        size_t indexBufferSize = 0;
+        uint32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;
     };
 
     enum class MaterialType
@@ -48,15 +49,15 @@ namespace Nova
         Ref<Material> GetMaterial(uint32_t slot);
 
         const Array<MaterialInfo>& GetMaterialInfos() const;
-        Ref<Buffer> GetVertexBuffer() const;
-        Ref<Buffer> GetIndexBuffer() const;
+        GeometryHandle GetGeometry() const;
     private:
         bool MaterialSlotExists(uint32_t slot) const;
         MaterialInfo& CreateMaterialSlot(const String& name, uint32_t slot);
 
+        void FreeGeometry();
+
         Array<MaterialInfo> m_MaterialInfos;
-        Ref<Buffer> m_VertexBuffer = nullptr;
-        Ref<Buffer> m_IndexBuffer = nullptr;
+        GeometryHandle m_Geometry = InvalidGeometryHandle;
     };
     
 }
@@ -5,16 +5,64 @@
 
 namespace Nova
 {
+    // Streaming never takes a texture below this size on its larger side
+    static constexpr uint32_t MinStreamedSize = 64;
+
     bool TextureAsset::LoadFromMemory(const uint8_t* data, const size_t dataSize)
     {
         Ref<RenderDevice> device = RenderDevice::GetInstance();
         if (!device) return false;
-        Ref<Texture> loadedTexture = TextureUtils::LoadTexture(device, data, dataSize);
+
+        uint32_t width = 0, height = 0;
+        if (!TextureUtils::GetImageInfo(data, dataSize, width, height))
+            return false;
+
+        uint32_t maxMip = 0;
+        while ((Math::Max(width, height) >> (maxMip + 1)) >= MinStreamedSize)
+            maxMip++;
+
+        // Out of device memory a smaller mip is loaded instead, the residency manager brings it back when there is room
+        Ref<Texture> loadedTexture = device->CreateTextureUnitialized();
         if (!loadedTexture) return false;
+
+        uint32_t mipLevel = 0;
+        while (!TextureUtils::LoadTextureMip(device, loadedTexture, data, dataSize, mipLevel))
+        {
+            if (++mipLevel > maxMip)
+            {
+                if (loadedTexture->IsValid()) loadedTexture->Destroy();
+                return false;
+            }
+        }
+
+        if (m_Texture)
+        {
+            m_Device->GetResidencyManager().UnregisterTexture(*m_Texture);
+            m_Texture->Destroy();
+        }
+
         m_Texture = loadedTexture;
+        m_Device = device.Get();
+        m_MaxMip = maxMip;
+        m_SourceData = maxMip ? Array<uint8_t>(data, dataSize) : Array<uint8_t>();
+        m_Device->GetResidencyManager().RegisterTexture(*m_Texture, *this, m_MaxMip);
         return true;
     }
 
+    bool TextureAsset::StreamMip(const uint32_t mipLevel)
+    {
+        if (!m_Texture || m_SourceData.IsEmpty()) return false;
+
+        // The previous image is gone once recreation starts, a failed level falls back to smaller ones
+        Ref<RenderDevice> device = m_Device;
+        for (uint32_t level = mipLevel; level <= m_MaxMip; level++)
+        {
+            if (TextureUtils::LoadTextureMip(device, m_Texture, m_SourceData.Data(), m_SourceData.Count(), level))
+                return level == mipLevel;
+        }
+        return false;
+    }
+
     bool TextureAsset::LoadFromFile(const StringView filepath)
     {
         Array<uint8_t> data = FileUtils::ReadToBuffer(filepath);
@@ -31,6 +79,8 @@ namespace Nova
 
     TextureAsset::~TextureAsset()
     {
+        if (!m_Texture) return;
+        m_Device->GetResidencyManager().UnregisterTexture(*m_Texture);
         m_Texture->Destroy();
         m_Texture = nullptr;
     }
@@ -47,12 +97,12 @@ namespace Nova
 
     uint32_t TextureAsset::GetWidth() const
     {
-        return m_Texture->GetWidth();
+        return m_Texture->GetSourceWidth();
     }
 
     uint32_t TextureAsset::GetHeight() const
     {
-        return m_Texture->GetHeight();
+        return m_Texture->GetSourceHeight();
     }
 
     uint32_t TextureAsset::GetDepth() const
@@ -70,6 +120,11 @@ namespace Nova
         return m_Texture->GetArrayCount();
     }
 
+    uint32_t TextureAsset::GetResidentMip() const
+    {
+        return m_Texture->GetResidentMip();
+    }
+
     Format TextureAsset::GetFormat() const
     {
         return m_Texture->GetFormat();
@@ -2,12 +2,15 @@
 #include "Asset.h"
 #include "Containers/StringView.h"
 #include "Rendering/Texture.h"
+#include "Rendering/ResidencyManager.h"
+#include "Containers/Array.h"
 
 namespace Nova
 {
     class Stream;
 
-    class TextureAsset final : public Asset
+    // Keeps its encoded image so the residency manager can stream the texture down to a lower mip and back
+    class TextureAsset final : public Asset, public TextureStreamSource
     {
     public:
         ~TextureAsset() override;
@@ -17,17 +20,24 @@ namespace Nova
         bool LoadFromFile(StringView filepath);
         bool LoadFromStream(Stream& stream);
 
+        bool StreamMip(uint32_t mipLevel) override;
+
         bool IsValid() const;
+        // Size of the source image, the texture may hold a lower mip of it
         uint32_t GetWidth() const;
         uint32_t GetHeight() const;
         uint32_t GetDepth() const;
         uint32_t GetMipCount() const;
         uint32_t GetArrayCount() const;
+        uint32_t GetResidentMip() const;
         Format GetFormat() const;
         TextureDimension GetDimension() const;
 
         WeakRef<Texture> GetTexture();
     private:
         Ref<Texture> m_Texture = nullptr;
+        RenderDevice* m_Device = nullptr;
+        Array<uint8_t> m_SourceData;
+        uint32_t m_MaxMip = 0;
     };
 }
@@ -0,0 +1,133 @@
+﻿#include "ThreadPool.h"
+#include "Profiler.h"
+#include "Containers/StringFormat.h"
+#include "Math/Functions.h"
+
+#include <system_error>
+
+namespace Nova
+{
+    ThreadPool::~ThreadPool()
+    {
+        Destroy();
+    }
+
+    bool ThreadPool::Initialize(uint32_t threadCount)
+    {
+        if (!m_Threads.IsEmpty())
+            return true;
+
+        if (threadCount == 0)
+        {
+            const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        m_Stop = false;
+        m_Generation = 0;
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            // std::thread reports resource exhaustion by throwing, join whatever was already started
+            try
+            {
+                m_Threads.Add(new std::thread(&ThreadPool::WorkerLoop, this, i + 1));
+            }
+            catch (const std::system_error&)
+            {
+                Destroy();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void ThreadPool::Destroy()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_WakeCondition.notify_all();
+
+        for (std::thread* thread : m_Threads)
+        {
+            thread->join();
+            delete thread;
+        }
+        m_Threads.Clear();
+    }
+
+    void ThreadPool::ParallelFor(const size_t count, size_t batchSize, const TaskFunction& task)
+    {
+        if (count == 0 || !task)
+            return;
+
+        batchSize = Math::Max<size_t>(batchSize, 1);
+        if (m_Threads.IsEmpty() || count <= batchSize)
+        {
+            task(0, count, 0);
+            return;
+        }
+
+        std::lock_guard submitLock(m_SubmitMutex);
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Task = &task;
+            m_Count = count;
+            m_BatchSize = batchSize;
+            m_NextIndex.store(0, std::memory_order_relaxed);
+            m_FinishedWorkers = 0;
+            ++m_Generation;
+        }
+        m_WakeCondition.notify_all();
+
+        RunBatches(0);
+
+        // Every worker acknowledges each generation so none of them can pick up a stale task later
+        std::unique_lock lock(m_Mutex);
+        m_DoneCondition.wait(lock, [this] { return m_FinishedWorkers == m_Threads.Count(); });
+        m_Task = nullptr;
+    }
+
+    uint32_t ThreadPool::GetThreadCount() const
+    {
+        return (uint32_t)m_Threads.Count() + 1;
+    }
+
+    void ThreadPool::WorkerLoop(const uint32_t threadIndex)
+    {
+        NOVA_PROFILE_THREAD(StringFormat("Worker {}", threadIndex));
+        uint64_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock(m_Mutex);
+                m_WakeCondition.wait(lock, [this, generation] { return m_Stop || m_Generation != generation; });
+                if (m_Stop) return;
+                generation = m_Generation;
+            }
+
+            RunBatches(threadIndex);
+
+            {
+                std::lock_guard lock(m_Mutex);
+                ++m_FinishedWorkers;
+            }
+            m_DoneCondition.notify_one();
+        }
+    }
+
+    void ThreadPool::RunBatches(const uint32_t threadIndex)
+    {
+        NOVA_PROFILE_SCOPE("ThreadPool::RunBatches");
+        while (true)
+        {
+            const size_t begin = m_NextIndex.fetch_add(m_BatchSize, std::memory_order_relaxed);
+            if (begin >= m_Count)
+                break;
+
+            const size_t end = Math::Min(begin + m_BatchSize, m_Count);
+            (*m_Task)(begin, end, threadIndex);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include "Containers/Function.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Nova
+{
+    class ThreadPool
+    {
+    public:
+        // Called with a [begin, end) range and the index of the thread running it (0 is the calling thread)
+        using TaskFunction = Function<void(size_t begin, size_t end, uint32_t threadIndex)>;
+
+        ThreadPool() = default;
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        // A thread count of zero uses every hardware thread but the calling one
+        bool Initialize(uint32_t threadCount = 0);
+        void Destroy();
+
+        // Splits [0, count) into batches and runs them on the workers and the calling thread.
+        // Returns once every batch completed. Must not be called from inside a task.
+        void ParallelFor(size_t count, size_t batchSize, const TaskFunction& task);
+
+        // Worker threads plus the calling thread
+        uint32_t GetThreadCount() const;
+    private:
+        void WorkerLoop(uint32_t threadIndex);
+        void RunBatches(uint32_t threadIndex);
+
+        Array<std::thread*> m_Threads;
+        std::mutex m_SubmitMutex;
+        std::mutex m_Mutex;
+        std::condition_variable m_WakeCondition;
+        std::condition_variable m_DoneCondition;
+        uint64_t m_Generation = 0;
+        uint32_t m_FinishedWorkers = 0;
+        bool m_Stop = false;
+
+        const TaskFunction* m_Task = nullptr;
+        size_t m_Count = 0;
+        size_t m_BatchSize = 1;
+        std::atomic<size_t> m_NextIndex = 0;
+    };
+}
@@ -0,0 +1,264 @@
+﻿#include "TlsfAllocator.h"
+#include "Assertion.h"
+#include <bit>
+
+namespace Nova
+{
+    static constexpr uint32_t MantissaBits = 3;
+    static constexpr uint32_t MantissaValue = 1 << MantissaBits;
+    static constexpr uint32_t MantissaMask = MantissaValue - 1;
+
+    // Sizes are binned as a float with a 3 bit mantissa, exact below 8 and within 12.5% above
+    static uint32_t SizeToBinRoundUp(const uint32_t size)
+    {
+        if (size < MantissaValue)
+            return size;
+
+        const uint32_t mantissaStartBit = (31 - std::countl_zero(size)) - MantissaBits;
+        const uint32_t exponent = mantissaStartBit + 1;
+        uint32_t mantissa = (size >> mantissaStartBit) & MantissaMask;
+        if (size & ((1u << mantissaStartBit) - 1))
+            mantissa++;
+
+        // A mantissa overflowing into the exponent is still the right bin
+        return (exponent << MantissaBits) + mantissa;
+    }
+
+    static uint32_t SizeToBinRoundDown(const uint32_t size)
+    {
+        if (size < MantissaValue)
+            return size;
+
+        const uint32_t mantissaStartBit = (31 - std::countl_zero(size)) - MantissaBits;
+        const uint32_t exponent = mantissaStartBit + 1;
+        const uint32_t mantissa = (size >> mantissaStartBit) & MantissaMask;
+        return (exponent << MantissaBits) | mantissa;
+    }
+
+    static uint32_t BinToSize(const uint32_t bin)
+    {
+        const uint32_t exponent = bin >> MantissaBits;
+        const uint32_t mantissa = bin & MantissaMask;
+        if (exponent == 0)
+            return mantissa;
+        return (mantissa | MantissaValue) << (exponent - 1);
+    }
+
+    static uint32_t FindLowestSetBitAfter(const uint32_t mask, const uint32_t startBit)
+    {
+        if (startBit >= 32)
+            return ~0u;
+
+        const uint32_t bits = mask & ~((1u << startBit) - 1);
+        return bits ? (uint32_t)std::countr_zero(bits) : ~0u;
+    }
+
+    TlsfAllocator::TlsfAllocator(const uint32_t size, const uint32_t maxAllocations)
+    {
+        Reset(size, maxAllocations);
+    }
+
+    void TlsfAllocator::Reset(const uint32_t size, const uint32_t maxAllocations)
+    {
+        NOVA_ASSERT(maxAllocations > 0, "Allocator needs at least one node!");
+
+        m_Size = size;
+        m_FreeSize = 0;
+        m_UsedTopBins = 0;
+        for (uint32_t& binHead : m_BinHeads)
+            binHead = Unused;
+        for (uint8_t& usedLeafBins : m_UsedLeafBins)
+            usedLeafBins = 0;
+
+        // One extra node because splitting the last free region needs a node before releasing one
+        const size_t nodeCount = (size_t)maxAllocations + 1;
+        m_Nodes = Array<Node>(nodeCount);
+        m_FreeNodes = Array<uint32_t>(nodeCount);
+        for (uint32_t index = 0; index < m_FreeNodes.Count(); ++index)
+            m_FreeNodes[index] = (uint32_t)m_FreeNodes.Count() - index - 1;
+
+        if (size > 0)
+            InsertNodeIntoBin(size, 0);
+    }
+
+    TlsfAllocator::Allocation TlsfAllocator::Allocate(const uint32_t size)
+    {
+        if (size == 0 || m_FreeNodes.IsEmpty())
+            return {};
+
+        // Round up so any region in the bin found is big enough
+        const uint32_t minBin = SizeToBinRoundUp(size);
+        const uint32_t minTopBin = minBin >> MantissaBits;
+        const uint32_t minLeafBin = minBin & MantissaMask;
+
+        uint32_t topBin = minTopBin;
+        uint32_t leafBin = ~0u;
+        if (m_UsedTopBins & (1u << topBin))
+            leafBin = FindLowestSetBitAfter(m_UsedLeafBins[topBin], minLeafBin);
+
+        if (leafBin == ~0u)
+        {
+            topBin = FindLowestSetBitAfter(m_UsedTopBins, minTopBin + 1);
+            if (topBin == ~0u)
+                return {};
+            leafBin = std::countr_zero(m_UsedLeafBins[topBin]);
+        }
+
+        const uint32_t bin = (topBin << MantissaBits) | leafBin;
+        const uint32_t nodeIndex = m_BinHeads[bin];
+        Node& node = m_Nodes[nodeIndex];
+        const uint32_t nodeSize = node.size;
+        node.size = size;
+        node.used = true;
+
+        m_BinHeads[bin] = node.binNext;
+        if (node.binNext != Unused)
+            m_Nodes[node.binNext].binPrevious = Unused;
+        m_FreeSize -= nodeSize;
+
+        if (m_BinHeads[bin] == Unused)
+        {
+            m_UsedLeafBins[topBin] &= ~(1u << leafBin);
+            if (m_UsedLeafBins[topBin] == 0)
+                m_UsedTopBins &= ~(1u << topBin);
+        }
+
+        // The rest of the region goes back as a free neighbour
+        const uint32_t remainder = nodeSize - size;
+        if (remainder > 0)
+        {
+            const uint32_t remainderIndex = InsertNodeIntoBin(remainder, node.offset + size);
+            Node& remainderNode = m_Nodes[remainderIndex];
+            Node& usedNode = m_Nodes[nodeIndex];
+            if (usedNode.neighborNext != Unused)
+                m_Nodes[usedNode.neighborNext].neighborPrevious = remainderIndex;
+            remainderNode.neighborPrevious = nodeIndex;
+            remainderNode.neighborNext = usedNode.neighborNext;
+            usedNode.neighborNext = remainderIndex;
+        }
+
+        return { m_Nodes[nodeIndex].offset, nodeIndex };
+    }
+
+    void TlsfAllocator::Free(const Allocation& allocation)
+    {
+        if (!allocation.IsValid())
+            return;
+
+        NOVA_ASSERT(allocation.node < m_Nodes.Count() && m_Nodes[allocation.node].used, "Freeing an allocation twice!");
+        const Node node = m_Nodes[allocation.node];
+        uint32_t offset = node.offset;
+        uint32_t size = node.size;
+        uint32_t neighborPrevious = node.neighborPrevious;
+        uint32_t neighborNext = node.neighborNext;
+
+        if (neighborPrevious != Unused && !m_Nodes[neighborPrevious].used)
+        {
+            const Node& previous = m_Nodes[neighborPrevious];
+            offset = previous.offset;
+            size += previous.size;
+            const uint32_t previousIndex = neighborPrevious;
+            neighborPrevious = previous.neighborPrevious;
+            RemoveNodeFromBin(previousIndex);
+        }
+
+        if (neighborNext != Unused && !m_Nodes[neighborNext].used)
+        {
+            const Node& next = m_Nodes[neighborNext];
+            size += next.size;
+            const uint32_t nextIndex = neighborNext;
+            neighborNext = next.neighborNext;
+            RemoveNodeFromBin(nextIndex);
+        }
+
+        m_Nodes[allocation.node] = Node();
+        m_FreeNodes.Add(allocation.node);
+
+        const uint32_t mergedIndex = InsertNodeIntoBin(size, offset);
+        Node& merged = m_Nodes[mergedIndex];
+        merged.neighborPrevious = neighborPrevious;
+        merged.neighborNext = neighborNext;
+        if (neighborPrevious != Unused)
+            m_Nodes[neighborPrevious].neighborNext = mergedIndex;
+        if (neighborNext != Unused)
+            m_Nodes[neighborNext].neighborPrevious = mergedIndex;
+    }
+
+    uint32_t TlsfAllocator::GetAllocationSize(const Allocation& allocation) const
+    {
+        if (!allocation.IsValid())
+            return 0;
+        return m_Nodes[allocation.node].size;
+    }
+
+    uint32_t TlsfAllocator::GetLargestFreeRegion() const
+    {
+        if (m_UsedTopBins == 0)
+            return 0;
+
+        const uint32_t topBin = 31 - std::countl_zero(m_UsedTopBins);
+        const uint32_t leafBin = 31 - std::countl_zero((uint32_t)m_UsedLeafBins[topBin]);
+        return BinToSize((topBin << MantissaBits) | leafBin);
+    }
+
+    uint32_t TlsfAllocator::InsertNodeIntoBin(const uint32_t size, const uint32_t offset)
+    {
+        // Round down, a region is only ever handed to requests it can hold
+        const uint32_t bin = SizeToBinRoundDown(size);
+        const uint32_t topBin = bin >> MantissaBits;
+        const uint32_t leafBin = bin & MantissaMask;
+
+        if (m_BinHeads[bin] == Unused)
+        {
+            m_UsedLeafBins[topBin] |= 1u << leafBin;
+            m_UsedTopBins |= 1u << topBin;
+        }
+
+        const uint32_t nodeIndex = m_FreeNodes.Last();
+        m_FreeNodes.PopBack();
+
+        Node& node = m_Nodes[nodeIndex];
+        node = Node();
+        node.offset = offset;
+        node.size = size;
+        node.binNext = m_BinHeads[bin];
+        if (node.binNext != Unused)
+            m_Nodes[node.binNext].binPrevious = nodeIndex;
+        m_BinHeads[bin] = nodeIndex;
+
+        m_FreeSize += size;
+        return nodeIndex;
+    }
+
+    void TlsfAllocator::RemoveNodeFromBin(const uint32_t nodeIndex)
+    {
+        const Node& node = m_Nodes[nodeIndex];
+        if (node.binPrevious != Unused)
+        {
+            m_Nodes[node.binPrevious].binNext = node.binNext;
+            if (node.binNext != Unused)
+                m_Nodes[node.binNext].binPrevious = node.binPrevious;
+        }
+        else
+        {
+            const uint32_t bin = SizeToBinRoundDown(node.size);
+            const uint32_t topBin = bin >> MantissaBits;
+            const uint32_t leafBin = bin & MantissaMask;
+
+            m_BinHeads[bin] = node.binNext;
+            if (node.binNext != Unused)
+                m_Nodes[node.binNext].binPrevious = Unused;
+
+            if (m_BinHeads[bin] == Unused)
+            {
+                m_UsedLeafBins[topBin] &= ~(1u << leafBin);
+                if (m_UsedLeafBins[topBin] == 0)
+                    m_UsedTopBins &= ~(1u << topBin);
+            }
+        }
+
+        m_FreeSize -= node.size;
+        m_Nodes[nodeIndex] = Node();
+        m_FreeNodes.Add(nodeIndex);
+    }
+}
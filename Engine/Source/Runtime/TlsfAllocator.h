@@ -0,0 +1,68 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include <cstdint>
+
+namespace Nova
+{
+    // Two level segregated fit allocator over an abstract range of units, e.g. vertices of a GPU buffer.
+    // It owns no memory, only offsets. Free regions are binned by a small float of their size, 32 exponents
+    // with 8 linear subdivisions each, so allocating and freeing are a couple of bit scans, and freed regions
+    // merge with their free neighbours right away.
+    class TlsfAllocator
+    {
+    public:
+        static constexpr uint32_t InvalidOffset = ~0u;
+        static constexpr uint32_t DefaultMaxAllocations = 64 * 1024;
+
+        struct Allocation
+        {
+            uint32_t offset = InvalidOffset;
+            uint32_t node = InvalidOffset;
+
+            bool IsValid() const { return offset != InvalidOffset; }
+        };
+
+        TlsfAllocator() = default;
+        explicit TlsfAllocator(uint32_t size, uint32_t maxAllocations = DefaultMaxAllocations);
+
+        // Forgets every allocation and starts over with a single free region
+        void Reset(uint32_t size, uint32_t maxAllocations = DefaultMaxAllocations);
+
+        Allocation Allocate(uint32_t size);
+        void Free(const Allocation& allocation);
+
+        uint32_t GetAllocationSize(const Allocation& allocation) const;
+        uint32_t GetSize() const { return m_Size; }
+        uint32_t GetFreeSize() const { return m_FreeSize; }
+
+        // Lower bound of the biggest request that can currently succeed
+        uint32_t GetLargestFreeRegion() const;
+    private:
+        static constexpr uint32_t TopBinCount = 32;
+        static constexpr uint32_t BinsPerLeaf = 8;
+        static constexpr uint32_t LeafBinCount = TopBinCount * BinsPerLeaf;
+        static constexpr uint32_t Unused = ~0u;
+
+        struct Node
+        {
+            uint32_t offset = 0;
+            uint32_t size = 0;
+            uint32_t binPrevious = Unused;
+            uint32_t binNext = Unused;
+            uint32_t neighborPrevious = Unused;
+            uint32_t neighborNext = Unused;
+            bool used = false;
+        };
+
+        uint32_t InsertNodeIntoBin(uint32_t size, uint32_t offset);
+        void RemoveNodeFromBin(uint32_t nodeIndex);
+
+        Array<Node> m_Nodes;
+        Array<uint32_t> m_FreeNodes;
+        uint32_t m_BinHeads[LeafBinCount] = {};
+        uint8_t m_UsedLeafBins[TopBinCount] = {};
+        uint32_t m_UsedTopBins = 0;
+        uint32_t m_Size = 0;
+        uint32_t m_FreeSize = 0;
+    };
+}
@@ -107,4 +107,68 @@ namespace Nova::TextureUtils
         stbi_image_free(pixels);
         return texture;
     }
+
+    bool GetImageInfo(const void* data, const size_t dataSize, uint32_t& width, uint32_t& height)
+    {
+        int32_t imageWidth = 0, imageHeight = 0;
+        if (!stbi_info_from_memory((const uint8_t*)data, (int)dataSize, &imageWidth, &imageHeight, nullptr))
+            return false;
+        width = (uint32_t)imageWidth;
+        height = (uint32_t)imageHeight;
+        return true;
+    }
+
+    // Box filters 8-bit RGBA pixels down to half their size, odd edges repeat their last texel
+    static void DownsamplePixels(const uint8_t* source, const uint32_t width, const uint32_t height, uint8_t* destination)
+    {
+        const uint32_t halfWidth = Math::Max(1u, width / 2);
+        const uint32_t halfHeight = Math::Max(1u, height / 2);
+        for (uint32_t y = 0; y < halfHeight; y++)
+        {
+            const uint8_t* row0 = source + (size_t)Math::Min(y * 2, height - 1) * width * 4;
+            const uint8_t* row1 = source + (size_t)Math::Min(y * 2 + 1, height - 1) * width * 4;
+            for (uint32_t x = 0; x < halfWidth; x++)
+            {
+                const uint32_t x0 = Math::Min(x * 2, width - 1) * 4;
+                const uint32_t x1 = Math::Min(x * 2 + 1, width - 1) * 4;
+                uint8_t* texel = destination + ((size_t)y * halfWidth + x) * 4;
+                for (uint32_t channel = 0; channel < 4; channel++)
+                {
+                    const uint32_t sum = row0[x0 + channel] + row0[x1 + channel] + row1[x0 + channel] + row1[x1 + channel];
+                    texel[channel] = (uint8_t)((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    bool LoadTextureMip(Ref<RenderDevice>& device, Ref<Texture>& texture, const void* data, const size_t dataSize, const uint32_t mipLevel)
+    {
+        stbi_set_flip_vertically_on_load(true);
+        int32_t sourceWidth = 0, sourceHeight = 0;
+        stbi_uc* pixels = stbi_load_from_memory((const uint8_t*)data, (int)dataSize, &sourceWidth, &sourceHeight, nullptr, STBI_rgb_alpha);
+        if (!pixels) return false;
+
+        // Halving in place is safe, each destination texel is written after the source texels it reads
+        uint32_t width = (uint32_t)sourceWidth, height = (uint32_t)sourceHeight;
+        for (uint32_t level = 0; level < mipLevel && (width > 1 || height > 1); level++)
+        {
+            DownsamplePixels(pixels, width, height, pixels);
+            width = Math::Max(1u, width / 2);
+            height = Math::Max(1u, height / 2);
+        }
+
+        TextureCreateInfo createInfo = TextureCreateInfo::Texture2D(width, height, Format::R8G8B8A8_SRGB, 1, 1);
+        createInfo.device = device.Get();
+        if (!texture->Initialize(createInfo))
+        {
+            stbi_image_free(pixels);
+            return false;
+        }
+
+        texture->SetResidentMip(mipLevel, sourceWidth, sourceHeight);
+        const size_t pixelsSize = (size_t)width * height * 4 * sizeof(stbi_uc);
+        const bool uploaded = UploadTextureData(device, texture, 0, 0, pixels, pixelsSize);
+        stbi_image_free(pixels);
+        return uploaded;
+    }
 }
@@ -9,4 +9,10 @@ namespace Nova::TextureUtils
    Ref<Texture> LoadTexture(Ref<RenderDevice>& device, StringView filepath);
    Ref<Texture> LoadTexture(Ref<RenderDevice>& device, const void* data, size_t dataSize);
    bool UploadTextureData(Ref<RenderDevice>& device, Ref<Texture>& texture, uint32_t arrayIndex, uint32_t mipLevel, const void* data, size_t dataSize);
+
+   // Reads the size of an encoded image without decoding it
+   bool GetImageInfo(const void* data, size_t dataSize, uint32_t& width, uint32_t& height);
+
+   // Decodes an image and recreates texture in place with the given mip of it, downsampled on the CPU, as its only level
+   bool LoadTextureMip(Ref<RenderDevice>& device, Ref<Texture>& texture, const void* data, size_t dataSize, uint32_t mipLevel);
 }
@@ -17,6 +17,8 @@ namespace Nova
     {
         ApplicationConfiguration config = {};
         config.applicationName = "Nova Asset Packer";
+        config.headless = true;
+        config.maxSpeed = true;
         return config;
     }
 
@@ -60,15 +62,12 @@ namespace Nova
 
         String projectDir = parser.GetString('p');
 
+        // Packing runs to completion in OnInit, there is nothing to tick afterwards
+        Exit();
     }
 
     void AssetPackerApplication::OnDestroy()
     {
         Application::OnDestroy();
     }
-
-    RenderDeviceType AssetPackerApplication::GetRenderDeviceType() const
-    {
-        return RenderDeviceType::Vulkan;
-    }
 }
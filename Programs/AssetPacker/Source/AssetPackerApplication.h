@@ -11,6 +11,5 @@ namespace Nova
         ApplicationConfiguration GetConfiguration() const override;
         void OnInit() override;
         void OnDestroy() override;
-        RenderDeviceType GetRenderDeviceType() const override;
     };
 }
@@ -0,0 +1,106 @@
+﻿#include "Benchmark.h"
+#include "Runtime/Arena.h"
+#include "Runtime/Memory.h"
+
+namespace Nova
+{
+    static constexpr uint32_t ArenaObjectCount = 200;
+    static constexpr uint32_t ArenaLightCount = 16;
+    static constexpr uint32_t ArenaWarmupFrameCount = 4;
+    static constexpr uint32_t ArenaFrameCount = 100;
+
+    struct ArenaBenchmarkLight
+    {
+        uint32_t type = 0;
+    };
+
+    // The per object work of a pre-render pass: gather the lights, filter them by type and build a label
+    template<ContainerAllocator Allocator>
+    static size_t BuildFrame(const Array<ArenaBenchmarkLight>& lights)
+    {
+        size_t result = 0;
+        for (uint32_t object = 0; object < ArenaObjectCount; ++object)
+        {
+            Array<const ArenaBenchmarkLight*, Allocator> gathered;
+            for (const ArenaBenchmarkLight& light : lights)
+                gathered.Add(&light);
+
+            const auto directional = gathered.Where([](const ArenaBenchmarkLight* const& light) { return light->type == 0; });
+            const auto ambient = gathered.Where([](const ArenaBenchmarkLight* const& light) { return light->type == 1; });
+            const auto label = StringFormat<Allocator>("Object {} has {} lights", object, gathered.Count());
+            result += directional.Count() + ambient.Count() + label.Count();
+        }
+        return result;
+    }
+
+    static size_t GetFrameAllocationCount()
+    {
+        size_t count = 0;
+        for (size_t tag = 0; tag < (size_t)MemoryTag::Count; ++tag)
+            count += Memory::GetTagStats((MemoryTag)tag).frameAllocations;
+        return count;
+    }
+
+    struct ArenaFrameResult
+    {
+        double averageTime = 0.0;
+        size_t allocationCount = 0;
+        size_t checksum = 0;
+    };
+
+    // Runs whole frames so the frame arena is rewound the same way the application loop does it
+    template<ContainerAllocator Allocator>
+    static ArenaFrameResult RunFrames(const Array<ArenaBenchmarkLight>& lights)
+    {
+        ArenaFrameResult result;
+        for (uint32_t frame = 0; frame < ArenaWarmupFrameCount + ArenaFrameCount; ++frame)
+        {
+            Memory::NewFrame();
+            FrameAllocator::NewFrame();
+
+            const double start = Time::Get();
+            result.checksum = BuildFrame<Allocator>(lights);
+            const double elapsed = Time::Get() - start;
+
+            Memory::NewFrame();
+            if (frame < ArenaWarmupFrameCount)
+                continue;
+            result.averageTime += elapsed * 1000.0 / (double)ArenaFrameCount;
+            result.allocationCount = Math::Max(result.allocationCount, GetFrameAllocationCount());
+        }
+        return result;
+    }
+
+    // Heap and frame arena temporaries for the same per frame workload
+    NOVA_BENCHMARK(FrameArena)
+    {
+        Array<ArenaBenchmarkLight> lights;
+        for (uint32_t i = 0; i < ArenaLightCount; ++i)
+            lights.Add({ i % 3 });
+
+        const ArenaFrameResult heap = RunFrames<HeapAllocator>(lights);
+        const ArenaFrameResult frame = RunFrames<FrameAllocator>(lights);
+
+        BenchmarkPrint("{} objects per frame, {} lights, {} frames", ArenaObjectCount, ArenaLightCount, ArenaFrameCount);
+        BenchmarkPrint("Heap:  {:.3f} ms per frame", heap.averageTime);
+        BenchmarkPrint("Frame: {:.3f} ms per frame ({:.2f}x)", frame.averageTime, heap.averageTime / frame.averageTime);
+
+        if (heap.checksum != frame.checksum)
+        {
+            BenchmarkPrint("Frame allocator results differ from the heap ones");
+            return false;
+        }
+
+#if defined(NOVA_MEMORY_TRACKING)
+        BenchmarkPrint("Tracked allocations per frame: {} heap, {} frame", heap.allocationCount, frame.allocationCount);
+        if (frame.allocationCount != 0)
+        {
+            BenchmarkPrint("The frame allocator still allocates once warmed up");
+            return false;
+        }
+#else
+        BenchmarkPrint("Allocation counts need NOVA_ENGINE_MEMORY_TRACKING");
+#endif
+        return true;
+    }
+}
@@ -0,0 +1,87 @@
+﻿#include "Benchmark.h"
+#include "Containers/Array.h"
+
+namespace Nova
+{
+    // Counts the live instances, every construction has to be matched by one destruction
+    struct LifetimeCounter
+    {
+        static inline int32_t s_LiveCount = 0;
+
+        LifetimeCounter() { ++s_LiveCount; }
+        LifetimeCounter(const int32_t inValue) : value(inValue) { ++s_LiveCount; }
+        LifetimeCounter(const LifetimeCounter& other) : value(other.value) { ++s_LiveCount; }
+        LifetimeCounter(LifetimeCounter&& other) noexcept : value(other.value) { ++s_LiveCount; }
+        ~LifetimeCounter() { --s_LiveCount; }
+
+        LifetimeCounter& operator=(const LifetimeCounter&) = default;
+        LifetimeCounter& operator=(LifetimeCounter&&) noexcept = default;
+        bool operator==(const LifetimeCounter& other) const { return value == other.value; }
+
+        int32_t value = 0;
+    };
+
+    static bool CheckLiveCount(const char* operation, const int32_t expected)
+    {
+        if (LifetimeCounter::s_LiveCount == expected)
+            return true;
+
+        BenchmarkPrint("{}: {} live elements, expected {}", operation, LifetimeCounter::s_LiveCount, expected);
+        return false;
+    }
+
+    NOVA_BENCHMARK(ArrayLifetime)
+    {
+        bool passed = true;
+        {
+            Array<LifetimeCounter> counters((size_t)5);
+            passed &= CheckLiveCount("Array(count)", 5);
+
+            for (int32_t i = 0; i < 100; ++i)
+                counters.Add(LifetimeCounter(i));
+            passed &= CheckLiveCount("Add", 105);
+
+            for (int32_t i = 0; i < 100; ++i)
+                counters.Emplace(i);
+            passed &= CheckLiveCount("Emplace", 205);
+
+            counters.Add(counters[0]);
+            counters.AddRange(counters.Data(), 50);
+            passed &= CheckLiveCount("AddRange", 256);
+
+            counters.RemoveAt(0);
+            passed &= CheckLiveCount("RemoveAt", 255);
+
+            counters.Remove(LifetimeCounter(99));
+            passed &= CheckLiveCount("Remove", 254);
+
+            // 13 zeros are left from the value initialized elements and the copies of them
+            counters.RemoveAll(LifetimeCounter(0));
+            passed &= CheckLiveCount("RemoveAll", 241);
+
+            counters.PopBack();
+            passed &= CheckLiveCount("PopBack", 240);
+
+            const int32_t count = (int32_t)counters.Count();
+            {
+                Array<LifetimeCounter> copy = counters;
+                passed &= CheckLiveCount("Copy", count * 2);
+                copy = Array<LifetimeCounter>({ 1, 2, 3 });
+                passed &= CheckLiveCount("Assignment", count + 3);
+            }
+            passed &= CheckLiveCount("Destructor", count);
+
+            counters.Clear();
+            passed &= CheckLiveCount("Clear", 0);
+
+            counters.Add(LifetimeCounter(7));
+            counters.Free();
+            passed &= CheckLiveCount("Free", 0);
+
+            counters.Add(LifetimeCounter(8));
+            passed &= CheckLiveCount("Add after Free", 1);
+        }
+        passed &= CheckLiveCount("Scope exit", 0);
+        return passed;
+    }
+}
@@ -0,0 +1,183 @@
+﻿#include "Benchmark.h"
+
+#ifdef NOVA_HAS_AUDIO
+#include "Audio/AudioClip.h"
+#include "Audio/AudioDevice.h"
+#include "Math/Functions.h"
+
+namespace Nova
+{
+    static constexpr uint32_t AudioSampleRate = 48000;
+    static constexpr uint32_t AudioChannels = 2;
+
+    static void WriteWavValue(Array<uint8_t>& data, const uint32_t value, const uint32_t size)
+    {
+        for (uint32_t i = 0; i < size; ++i)
+            data.Add((uint8_t)(value >> (i * 8)));
+    }
+
+    // 16-bit mono WAV file holding a sine tone, decoded like any other clip
+    static Array<uint8_t> MakeSineWav(const float frequency, const float seconds)
+    {
+        const uint32_t frameCount = (uint32_t)(seconds * (float)AudioSampleRate);
+        const uint32_t dataSize = frameCount * sizeof(int16_t);
+
+        Array<uint8_t> data;
+        data.AddRange({ 'R', 'I', 'F', 'F' });
+        WriteWavValue(data, 36 + dataSize, 4);
+        data.AddRange({ 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+        WriteWavValue(data, 16, 4);
+        WriteWavValue(data, 1, 2);
+        WriteWavValue(data, 1, 2);
+        WriteWavValue(data, AudioSampleRate, 4);
+        WriteWavValue(data, AudioSampleRate * sizeof(int16_t), 4);
+        WriteWavValue(data, sizeof(int16_t), 2);
+        WriteWavValue(data, 16, 2);
+        data.AddRange({ 'd', 'a', 't', 'a' });
+        WriteWavValue(data, dataSize, 4);
+
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            const float sample = Math::Sin(Math::Tau * frequency * (float)frame / (float)AudioSampleRate) * 0.5f;
+            WriteWavValue(data, (uint16_t)(int16_t)(sample * 32767.0f), 2);
+        }
+        return data;
+    }
+
+    static Ref<AudioDevice> CreateOfflineDevice(const uint32_t voiceCount, const uint32_t maxRealVoices)
+    {
+        AudioDeviceCreateInfo createInfo;
+        createInfo.channels = AudioChannels;
+        createInfo.sampleRate = AudioSampleRate;
+        createInfo.voiceCount = voiceCount;
+        createInfo.maxRealVoices = maxRealVoices;
+        createInfo.offline = true;
+        return CreateAudioDevice(createInfo);
+    }
+
+    static uint64_t HashFrames(const Array<float>& frames)
+    {
+        // FNV-1a over the raw sample bits, any change in the mix changes the hash
+        uint64_t hash = 0xCBF29CE484222325ull;
+        const uint8_t* bytes = (const uint8_t*)frames.Data();
+        for (size_t i = 0; i < frames.Size(); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    // Mixes a fixed set of one shots with different pitches, pans and loop settings, returns false on failure
+    static bool RenderAudioScene(const uint64_t frameCount, Array<float>& outFrames)
+    {
+        Ref<AudioDevice> device = CreateOfflineDevice(32, 16);
+        if (!device)
+            return false;
+
+        const Array<uint8_t> lowTone = MakeSineWav(220.0f, 1.5f);
+        const Array<uint8_t> highTone = MakeSineWav(880.0f, 0.25f);
+        Ref<AudioClip> lowClip = MakeRef<AudioClip>();
+        Ref<AudioClip> highClip = MakeRef<AudioClip>();
+        bool success = lowClip->LoadFromMemory(lowTone.Data(), lowTone.Count(), AudioPlaybackFlagBits::FullInMemory)
+            && highClip->LoadFromMemory(highTone.Data(), highTone.Count(), AudioPlaybackFlagBits::FullInMemory);
+
+        if (success)
+        {
+            AudioVoiceDesc desc;
+            desc.volume = 0.5f;
+            desc.looping = true;
+            device->PlayOneShot(lowClip, desc);
+
+            desc.volume = 0.3f;
+            desc.looping = false;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                desc.pitch = 1.0f + 0.25f * (float)i;
+                desc.pan = -1.0f + 0.5f * (float)i;
+                device->PlayOneShot(highClip, desc);
+            }
+
+            outFrames = Array<float>(frameCount * AudioChannels);
+            success = device->RenderFrames(outFrames.Data(), frameCount) == frameCount;
+        }
+
+        lowClip->Destroy();
+        highClip->Destroy();
+        device->Destroy();
+        return success;
+    }
+
+    // Renders the same scene twice offline, the two mixes must match bit for bit and not be silent.
+    // The printed hash can be compared between builds to catch changes in the mixer output.
+    NOVA_BENCHMARK(AudioOfflineRender)
+    {
+        const uint64_t frameCount = AudioSampleRate * 2;
+        Array<float> firstRender, secondRender;
+        if (!RenderAudioScene(frameCount, firstRender) || !RenderAudioScene(frameCount, secondRender))
+        {
+            BenchmarkPrint("Failed to render the audio scene");
+            return false;
+        }
+
+        float peak = 0.0f;
+        for (const float sample : firstRender)
+            peak = Math::Max(peak, Math::Abs(sample));
+
+        const uint64_t firstHash = HashFrames(firstRender);
+        const uint64_t secondHash = HashFrames(secondRender);
+        BenchmarkPrint("{} frames, peak {:.4f}, hash {:016x}", frameCount, peak, firstHash);
+        if (firstHash != secondHash)
+        {
+            BenchmarkPrint("Offline renders differ, second hash {:016x}", secondHash);
+            return false;
+        }
+        return peak > 0.0f;
+    }
+
+    // Offline mixing speed with every voice real, reported as a multiple of real time
+    NOVA_BENCHMARK(AudioMixerThroughput)
+    {
+        static constexpr uint32_t VoiceCount = 64;
+        static constexpr uint64_t FrameCount = AudioSampleRate * 10;
+
+        Ref<AudioDevice> device = CreateOfflineDevice(VoiceCount, VoiceCount);
+        if (!device)
+            return false;
+
+        const Array<uint8_t> tone = MakeSineWav(440.0f, 1.0f);
+        Ref<AudioClip> clip = MakeRef<AudioClip>();
+        if (!clip->LoadFromMemory(tone.Data(), tone.Count(), AudioPlaybackFlagBits::FullInMemory))
+        {
+            device->Destroy();
+            return false;
+        }
+
+        AudioVoiceDesc desc;
+        desc.volume = 1.0f / (float)VoiceCount;
+        desc.looping = true;
+        for (uint32_t i = 0; i < VoiceCount; ++i)
+        {
+            desc.pitch = 0.5f + (float)i / (float)VoiceCount;
+            device->PlayOneShot(clip, desc);
+        }
+
+        Array<float> frames(FrameCount * AudioChannels);
+        uint64_t framesRendered = 0;
+        const double time = MeasureBest(3, [&]
+        {
+            framesRendered = device->RenderFrames(frames.Data(), FrameCount);
+        });
+
+        const uint32_t realVoices = device->GetVoicePool().GetRealVoiceCount();
+        clip->Destroy();
+        device->Destroy();
+
+        const double seconds = (double)FrameCount / AudioSampleRate;
+        BenchmarkPrint("{} voices ({} real), {:.1f} s of audio", VoiceCount, realVoices, seconds);
+        BenchmarkPrint("Mix: {:.3f} ms, {:.1f}x real time, {:.2f} ns per voice frame",
+            time, seconds * 1000.0 / time, time * 1000000.0 / ((double)FrameCount * VoiceCount));
+        return framesRendered == FrameCount && realVoices == VoiceCount;
+    }
+}
+#endif
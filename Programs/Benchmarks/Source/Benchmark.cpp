@@ -0,0 +1,24 @@
+﻿#include "Benchmark.h"
+
+#include <iostream>
+
+namespace Nova
+{
+    Array<BenchmarkInfo>& GetBenchmarks()
+    {
+        static Array<BenchmarkInfo> benchmarks;
+        return benchmarks;
+    }
+
+    BenchmarkRegistrar::BenchmarkRegistrar(const char* name, const BenchmarkFunction function)
+    {
+        GetBenchmarks().Add({ name, function });
+    }
+
+    void WriteBenchmarkLine(const StringView line)
+    {
+        std::cout.write(line.Data(), (std::streamsize)line.Count());
+        std::cout << '\n';
+        std::cout.flush();
+    }
+}
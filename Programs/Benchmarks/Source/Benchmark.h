@@ -0,0 +1,58 @@
+﻿#pragma once
+#include "Containers/Array.h"
+#include "Containers/StringFormat.h"
+#include "Containers/StringView.h"
+#include "Runtime/Time.h"
+#include "Math/Functions.h"
+
+#include <limits>
+
+// Defines a benchmark run by the Benchmarks program. The body returns false when one of its checks failed.
+#define NOVA_BENCHMARK(Name) \
+    static bool Benchmark##Name(::Nova::Application& application); \
+    static const ::Nova::BenchmarkRegistrar s_Benchmark##Name##Registrar(#Name, &Benchmark##Name); \
+    static bool Benchmark##Name(::Nova::Application& application)
+
+namespace Nova
+{
+    class Application;
+
+    using BenchmarkFunction = bool(*)(Application& application);
+
+    struct BenchmarkInfo
+    {
+        const char* name = nullptr;
+        BenchmarkFunction function = nullptr;
+    };
+
+    Array<BenchmarkInfo>& GetBenchmarks();
+
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar(const char* name, BenchmarkFunction function);
+    };
+
+    // Results go to stdout directly, logging is compiled out of release builds
+    void WriteBenchmarkLine(StringView line);
+
+    template<typename... Args>
+    void BenchmarkPrint(const StringView format, const Args&... args)
+    {
+        const String line = StringFormat(format, args...);
+        WriteBenchmarkLine(line);
+    }
+
+    // Runs the callable runCount times and returns the fastest run in milliseconds
+    template<typename Callable>
+    double MeasureBest(const uint32_t runCount, Callable&& callable)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (uint32_t run = 0; run < runCount; ++run)
+        {
+            const double start = Time::Get();
+            callable();
+            best = Math::Min(best, (Time::Get() - start) * 1000.0);
+        }
+        return best;
+    }
+}
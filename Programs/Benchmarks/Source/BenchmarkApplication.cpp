@@ -0,0 +1,58 @@
+﻿#include "BenchmarkApplication.h"
+#include "Benchmark.h"
+
+namespace Nova
+{
+    extern "C" Application* CreateApplication(const int argc, char** argv)
+    {
+        return new BenchmarkApplication(argc, argv);
+    }
+
+    ApplicationConfiguration BenchmarkApplication::GetConfiguration() const
+    {
+        ApplicationConfiguration config = {};
+        config.applicationName = "Nova Benchmarks";
+        config.headless = true;
+        config.maxSpeed = true;
+        return config;
+    }
+
+    // Every benchmark runs when none is named on the command line
+    static bool ShouldRun(const CmdLineArgs& args, const StringView name)
+    {
+        if (args.Count() <= 1)
+            return true;
+
+        for (size_t i = 1; i < args.Count(); ++i)
+        {
+            if (args.GetArgument(i) == name)
+                return true;
+        }
+        return false;
+    }
+
+    void BenchmarkApplication::OnInit()
+    {
+        const CmdLineArgs& args = GetProgramArguments();
+
+        uint32_t runCount = 0;
+        uint32_t failedCount = 0;
+        for (const BenchmarkInfo& benchmark : GetBenchmarks())
+        {
+            if (!ShouldRun(args, benchmark.name))
+                continue;
+
+            BenchmarkPrint("[{}]", benchmark.name);
+            if (!benchmark.function(*this))
+            {
+                BenchmarkPrint("[{}] FAILED", benchmark.name);
+                ++failedCount;
+            }
+            ++runCount;
+        }
+
+        BenchmarkPrint("{} benchmarks run, {} failed", runCount, failedCount);
+        SetExitCode(failedCount > 0 || runCount == 0 ? 1 : 0);
+        Exit();
+    }
+}
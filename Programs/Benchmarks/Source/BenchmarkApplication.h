@@ -0,0 +1,14 @@
+﻿#pragma once
+#include "Runtime/Application.h"
+
+namespace Nova
+{
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication(const int32_t argc, char** argv) : Application(argc, argv){}
+
+        ApplicationConfiguration GetConfiguration() const override;
+        void OnInit() override;
+    };
+}
@@ -0,0 +1,99 @@
+﻿#include "Benchmark.h"
+#include "Math/Matrix4.h"
+#include "Rendering/Buffer.h"
+#include "Rendering/Shader.h"
+#include "Rendering/ShaderEntryPoint.h"
+#include "Rendering/Null/RenderDevice.h"
+#include "Runtime/Memory.h"
+
+namespace Nova
+{
+    static constexpr uint32_t CommandTripletCount = 100000;
+    static constexpr uint32_t CommandBufferCount = 4;
+    static constexpr uint32_t CommandWarmupFrameCount = 4;
+    static constexpr uint32_t CommandFrameCount = 20;
+
+    // Records bind/push/draw triplets on the Null device, which measures the command stream itself
+    NOVA_BENCHMARK(NullCommandRecording)
+    {
+        Ref<Null::RenderDevice> device = MakeRef<Null::RenderDevice>();
+        if (!device->Initialize(RenderDeviceCreateInfo()))
+            return false;
+        RenderDevice& baseDevice = *device;
+
+        ShaderCreateInfo shaderCreateInfo;
+        shaderCreateInfo.device = device;
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultVertex());
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultFragment());
+        const Ref<Shader> shader = device->CreateShader(shaderCreateInfo);
+        if (!shader)
+            return false;
+
+        // Cycling through a few vertex buffers makes every bind a real state change
+        Array<Ref<Buffer>> buffers;
+        for (uint32_t i = 0; i < CommandBufferCount; ++i)
+            buffers.Add(baseDevice.CreateBuffer(BufferUsage::VertexBuffer, 1024));
+
+        double totalTime = 0.0;
+        size_t allocationCount = 0;
+        bool statsValid = true;
+        for (uint32_t frame = 0; frame < CommandWarmupFrameCount + CommandFrameCount; ++frame)
+        {
+            Memory::NewFrame();
+            if (!device->BeginFrame())
+                return false;
+
+            CommandBuffer* commandBuffer = device->GetCurrentCommandBuffer();
+            const double start = Time::Get();
+            for (uint32_t i = 0; i < CommandTripletCount; ++i)
+            {
+                const Matrix4 transform = Matrix4::Identity;
+                commandBuffer->BindVertexBuffer(*buffers[i % CommandBufferCount], 0);
+                commandBuffer->PushConstants(*shader, ShaderStageFlagBits::Vertex, 0, sizeof(Matrix4), &transform);
+                commandBuffer->Draw(6, 1, 0, 0);
+            }
+            const double elapsed = Time::Get() - start;
+
+            device->EndFrame();
+            device->Present();
+            Memory::NewFrame();
+
+            const Null::CommandBufferStats& stats = device->GetLastFrameStats();
+            statsValid &= stats.drawCount == CommandTripletCount
+                && stats.bufferBindCount == CommandTripletCount
+                && stats.stateChangeCount == CommandTripletCount
+                && stats.pushConstantBytes == (uint64_t)CommandTripletCount * sizeof(Matrix4);
+
+            if (frame < CommandWarmupFrameCount)
+                continue;
+            totalTime += elapsed;
+            allocationCount = Math::Max(allocationCount, Memory::GetTagStats(MemoryTag::Rendering).frameAllocations);
+        }
+
+        const Null::CommandBufferStats& stats = device->GetLastFrameStats();
+        BenchmarkPrint("{} bind/push/draw triplets per frame, {} frames", CommandTripletCount, CommandFrameCount);
+        BenchmarkPrint("Recording: {:.3f} ms per frame, {:.1f} ns per triplet, {} byte stream",
+            totalTime * 1000.0 / CommandFrameCount, totalTime * 1e9 / ((double)CommandTripletCount * CommandFrameCount), stats.streamSize);
+
+        buffers.Clear();
+        device->Destroy();
+
+        if (!statsValid)
+        {
+            BenchmarkPrint("Command buffer stats do not match the recorded commands");
+            return false;
+        }
+
+#if defined(NOVA_MEMORY_TRACKING)
+        BenchmarkPrint("Rendering tag allocations in a steady frame: {}", allocationCount);
+        if (allocationCount != 0)
+        {
+            BenchmarkPrint("Re-recording a frame still allocates");
+            return false;
+        }
+#else
+        BenchmarkPrint("Allocation counts need NOVA_ENGINE_MEMORY_TRACKING");
+#endif
+        return true;
+    }
+}
@@ -0,0 +1,102 @@
+﻿#include "Benchmark.h"
+#include "Math/Matrix4.h"
+#include "Math/Vector3.h"
+#include "Rendering/DebugRenderer.h"
+#include "Rendering/Shader.h"
+#include "Rendering/ShaderEntryPoint.h"
+#include "Rendering/Null/RenderDevice.h"
+#include "Runtime/Application.h"
+#include "Runtime/Color.h"
+#include "Runtime/ThreadPool.h"
+
+namespace Nova
+{
+    static constexpr uint32_t DebugLineCount = 1000000;
+    static constexpr uint32_t DebugLinesPerBatch = 16 * 1024;
+    static constexpr uint32_t DebugWarmupFrameCount = 2;
+    static constexpr uint32_t DebugFrameCount = 10;
+
+    static void DrawDebugLines(const size_t begin, const size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float x = (float)i;
+            const DebugLayer layer = i & 1 ? DebugLayer::Overlay : DebugLayer::World;
+            DebugRenderer::DrawLine(Vector3(x, 0.0f, 0.0f), Vector3(x, 1.0f, 0.0f), Color::Yellow, 1.0f, layer);
+        }
+    }
+
+    // DrawLine and End cost with one line per segment, from the main thread then from the thread pool
+    NOVA_BENCHMARK(DebugLines)
+    {
+        Ref<Null::RenderDevice> device = MakeRef<Null::RenderDevice>();
+        if (!device->Initialize(RenderDeviceCreateInfo()))
+            return false;
+
+        ShaderCreateInfo shaderCreateInfo;
+        shaderCreateInfo.device = device;
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultVertex());
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultFragment());
+        const Ref<Shader> shader = device->CreateShader(shaderCreateInfo);
+        if (!shader)
+            return false;
+
+        DebugRendererCreateInfo createInfo;
+        createInfo.device = device;
+        createInfo.shader = shader;
+        if (!DebugRenderer::Initialize(createInfo))
+            return false;
+
+        ThreadPool& threadPool = application.GetThreadPool();
+        bool countsValid = true;
+        BenchmarkPrint("{} lines per frame, {} frames", DebugLineCount, DebugFrameCount);
+        for (const bool parallel : { false, true })
+        {
+            double drawTime = 0.0;
+            double endTime = 0.0;
+            for (uint32_t frame = 0; frame < DebugWarmupFrameCount + DebugFrameCount; ++frame)
+            {
+                if (!device->BeginFrame())
+                    return false;
+
+                DebugRenderer::Begin(Matrix4::Identity);
+                const double start = Time::Get();
+                if (parallel)
+                {
+                    threadPool.ParallelFor(DebugLineCount, DebugLinesPerBatch, [](const size_t begin, const size_t end, const uint32_t)
+                    {
+                        DrawDebugLines(begin, end);
+                    });
+                }
+                else
+                {
+                    DrawDebugLines(0, DebugLineCount);
+                }
+                const double drawEnd = Time::Get();
+                DebugRenderer::End(*device->GetCurrentCommandBuffer());
+                const double end = Time::Get();
+                countsValid &= DebugRenderer::GetLineCount() == DebugLineCount;
+
+                device->EndFrame();
+                device->Present();
+                if (frame < DebugWarmupFrameCount)
+                    continue;
+                drawTime += (drawEnd - start) * 1000.0 / DebugFrameCount;
+                endTime += (end - drawEnd) * 1000.0 / DebugFrameCount;
+            }
+
+            const uint32_t threadCount = parallel ? threadPool.GetThreadCount() : 1;
+            BenchmarkPrint("{} threads: DrawLine {:.2f} ms, End {:.2f} ms, capacity {} lines", threadCount, drawTime, endTime, DebugRenderer::GetCapacity());
+        }
+
+        DebugRenderer::Destroy();
+        device->Destroy();
+
+        if (!countsValid)
+        {
+            BenchmarkPrint("End did not collect every line drawn in a frame");
+            return false;
+        }
+        return true;
+    }
+}
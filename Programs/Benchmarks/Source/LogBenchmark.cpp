@@ -0,0 +1,66 @@
+﻿#include "Benchmark.h"
+#include "Runtime/Log.h"
+#include "Runtime/LogBackend.h"
+#include "Runtime/LogSink.h"
+
+namespace Nova
+{
+    static constexpr uint32_t LogBurstSize = 500;
+    static constexpr uint32_t LogRoundCount = 200;
+
+    // Counts the records so the benchmark can check that none were dropped
+    class CountingLogSink final : public LogSink
+    {
+    public:
+        void Write(const LogRecord&) override
+        {
+            m_Count++;
+        }
+
+        size_t GetCount() const { return m_Count; }
+    private:
+        size_t m_Count = 0;
+    };
+
+    // Cost of a Log call on the calling thread, with the logging thread draining between bursts
+    NOVA_BENCHMARK(LoggerThroughput)
+    {
+        Logger& logger = Log::GetCoreLogger();
+        const Verbosity minVerbosity = logger.GetMinVerbosity();
+        logger.SetMinVerbosity(Verbosity::Trace);
+        CountingLogSink sink;
+        Log::Flush();
+        Log::SetConsoleOutputEnabled(false);
+        Log::AddSink(&sink);
+
+        double totalTime = 0.0;
+        double bestTime = std::numeric_limits<double>::max();
+        for (uint32_t round = 0; round < LogRoundCount; ++round)
+        {
+            const double start = Time::Get();
+            for (uint32_t i = 0; i < LogBurstSize; ++i)
+                logger.Log("BENCH", Verbosity::Trace, "value {} {} {}", i, 3.5f, "literal");
+            const double elapsed = Time::Get() - start;
+            totalTime += elapsed;
+            bestTime = Math::Min(bestTime, elapsed);
+            Log::Flush();
+        }
+
+        Log::RemoveSink(&sink);
+        Log::SetConsoleOutputEnabled(true);
+        logger.SetMinVerbosity(minVerbosity);
+
+        const size_t expected = (size_t)LogBurstSize * LogRoundCount;
+        const double averageNs = totalTime * 1e9 / (double)expected;
+        const double bestNs = bestTime * 1e9 / (double)LogBurstSize;
+        BenchmarkPrint("{} calls in bursts of {}, logging thread {}", expected, LogBurstSize, LogBackend::Get().IsRunning() ? "running" : "stopped");
+        BenchmarkPrint("Log call: {:.1f} ns average, {:.1f} ns best burst", averageNs, bestNs);
+
+        if (sink.GetCount() != expected)
+        {
+            BenchmarkPrint("{} records written, expected {}", sink.GetCount(), expected);
+            return false;
+        }
+        return true;
+    }
+}
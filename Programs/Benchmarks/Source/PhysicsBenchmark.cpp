@@ -0,0 +1,103 @@
+﻿#include "Benchmark.h"
+
+#ifdef NOVA_HAS_PHYSICS
+#include "Physics/BoxShape2D.h"
+#include "Physics/PhysicsBody2D.h"
+#include "Physics/PhysicsWorld2D.h"
+#include "Runtime/Application.h"
+#include "Runtime/Scene.h"
+#include "Runtime/ThreadPool.h"
+
+namespace Nova
+{
+    static constexpr uint32_t RayCastGridSize = 32;
+    static constexpr float RayCastGridSpacing = 4.0f;
+    static constexpr size_t RayCastCount = 10000;
+    static constexpr uint32_t RayCastRunCount = 20;
+
+    // Serial and batched ray casts over a static grid of boxes, the batch must return the same hits
+    NOVA_BENCHMARK(RayCastBatch)
+    {
+        Scene scene(&application, "RayCastBenchmark");
+        Ref<PhysicsWorld2D> world = MakeRef<PhysicsWorld2D>();
+
+        PhysicsWorldCreateInfo createInfo;
+        createInfo.scene = &scene;
+        createInfo.gravity = Vector3::Zero;
+        if (!world->Initialize(createInfo))
+            return false;
+
+        Array<PhysicsBody*> bodies;
+        Array<BoxShape2D*> shapes;
+        for (uint32_t y = 0; y < RayCastGridSize; ++y)
+        {
+            for (uint32_t x = 0; x < RayCastGridSize; ++x)
+            {
+                PhysicsBodyDefinition definition;
+                definition.position = Vector3((float)x * RayCastGridSpacing, (float)y * RayCastGridSpacing, 0.0f);
+                definition.type = PhysicsBodyType::Static;
+
+                PhysicsBody2D* body = (PhysicsBody2D*)world->CreateBody(definition);
+                BoxShape2D* shape = new BoxShape2D();
+                shape->SetWidth(1.0f + (float)(x % 3));
+                shape->SetHeight(1.0f + (float)(y % 3));
+                body->AttachShape(shape);
+                bodies.Add(body);
+                shapes.Add(shape);
+            }
+        }
+
+        // Rays fan out from points spread over the grid so most of them cross several boxes
+        const float extent = (float)RayCastGridSize * RayCastGridSpacing;
+        Array<PhysicsRay> rays(RayCastCount);
+        for (size_t i = 0; i < RayCastCount; ++i)
+        {
+            const float angle = (float)i * 2.39996f;
+            PhysicsRay& ray = rays[i];
+            ray.origin = Vector3((float)(i % 97) / 97.0f * extent, (float)(i % 89) / 89.0f * extent, 0.0f);
+            ray.direction = Vector3(Math::Cos(angle), Math::Sin(angle), 0.0f);
+            ray.maxDistance = extent * 0.5f;
+        }
+
+        Array<PhysicsCastHit> serialHits(RayCastCount);
+        Array<PhysicsCastHit> batchHits(RayCastCount);
+        const double serialTime = MeasureBest(RayCastRunCount, [&]
+        {
+            for (size_t i = 0; i < RayCastCount; ++i)
+                world->RayCast(rays[i], serialHits[i]);
+        });
+        const double batchTime = MeasureBest(RayCastRunCount, [&]
+        {
+            world->RayCastBatch(rays, batchHits);
+        });
+
+        size_t hitCount = 0;
+        size_t mismatchCount = 0;
+        for (size_t i = 0; i < RayCastCount; ++i)
+        {
+            const PhysicsCastHit& serial = serialHits[i];
+            const PhysicsCastHit& batch = batchHits[i];
+            if (serial.hit != batch.hit || serial.shape != batch.shape || serial.fraction != batch.fraction)
+                ++mismatchCount;
+            hitCount += serial.hit ? 1 : 0;
+        }
+
+        BenchmarkPrint("{} rays, {} hits, {} worker threads", RayCastCount, hitCount, application.GetThreadPool().GetThreadCount());
+        BenchmarkPrint("RayCast loop:  {:.3f} ms", serialTime);
+        BenchmarkPrint("RayCastBatch:  {:.3f} ms ({:.2f}x)", batchTime, serialTime / batchTime);
+
+        for (PhysicsBody* body : bodies)
+            world->DestroyBody(body);
+        world->Destroy();
+        for (BoxShape2D* shape : shapes)
+            delete shape;
+
+        if (mismatchCount > 0)
+        {
+            BenchmarkPrint("{} batched hits differ from the serial ray casts", mismatchCount);
+            return false;
+        }
+        return hitCount > 0;
+    }
+}
+#endif
@@ -0,0 +1,118 @@
+﻿#include "Benchmark.h"
+#include "Runtime/Memory.h"
+#include "Runtime/PoolAllocator.h"
+
+namespace Nova
+{
+    static constexpr uint32_t PoolObjectCount = 10000;
+    static constexpr uint32_t PoolFrameCount = 60;
+
+    // Mirrors the pool operators of Component and Entity
+    struct PooledObject
+    {
+        virtual ~PooledObject() = default;
+
+        static void* operator new(size_t size, PoolAllocator& pool)
+        {
+            NOVA_ASSERT(size <= pool.GetBlockSize(), "Object does not fit in its pool!");
+            return pool.Allocate();
+        }
+
+        static void operator delete(void* ptr, PoolAllocator& pool) { pool.Free(ptr); }
+        static void operator delete(void* ptr) { PoolAllocator::Deallocate(ptr); }
+
+        float data[20] = {};
+    };
+
+    struct PooledBullet final : PooledObject
+    {
+        double velocity[3] = {};
+    };
+
+    struct alignas(64) PooledParticle final : PooledObject
+    {
+        uint32_t seed = 0;
+    };
+
+    struct HeapObject
+    {
+        virtual ~HeapObject() = default;
+        float data[20] = {};
+    };
+
+    struct HeapBullet final : HeapObject
+    {
+        double velocity[3] = {};
+    };
+
+    struct alignas(64) HeapParticle final : HeapObject
+    {
+        uint32_t seed = 0;
+    };
+
+    // Spawns and despawns a mix of two object sizes every frame
+    template<typename Base, typename Spawn>
+    static double RunChurn(Spawn&& spawn, size_t& steadyAllocationCount)
+    {
+        Array<Base*> objects(PoolObjectCount);
+        steadyAllocationCount = 0;
+
+        Memory::NewFrame();
+        const double start = Time::Get();
+        for (uint32_t frame = 0; frame < PoolFrameCount; ++frame)
+        {
+            for (uint32_t i = 0; i < PoolObjectCount; ++i)
+                objects[i] = spawn(i);
+            for (Base* object : objects)
+                delete object;
+
+            Memory::NewFrame();
+            if (frame > 0)
+                steadyAllocationCount = Math::Max(steadyAllocationCount, Memory::GetTagStats(MemoryTag::Scene).frameAllocations);
+        }
+        return (Time::Get() - start) * 1e9 / ((double)PoolObjectCount * PoolFrameCount);
+    }
+
+    // Plain new/delete against the per type pools used for components and entities
+    NOVA_BENCHMARK(PoolChurn)
+    {
+        PoolAllocator& bulletPool = PoolAllocator::Get<PooledBullet, MemoryTag::Scene>();
+        PoolAllocator& particlePool = PoolAllocator::Get<PooledParticle, MemoryTag::Scene>();
+
+        size_t heapAllocations = 0;
+        const double heapTime = RunChurn<HeapObject>([](const uint32_t i) -> HeapObject*
+        {
+            if (i % 2) return new HeapBullet();
+            return new HeapParticle();
+        }, heapAllocations);
+
+        size_t poolAllocations = 0;
+        const double poolTime = RunChurn<PooledObject>([&](const uint32_t i) -> PooledObject*
+        {
+            if (i % 2) return new (bulletPool) PooledBullet();
+            return new (particlePool) PooledParticle();
+        }, poolAllocations);
+
+        BenchmarkPrint("{} objects spawned and despawned per frame, {} frames", PoolObjectCount, PoolFrameCount);
+        BenchmarkPrint("new/delete: {:.1f} ns per pair", heapTime);
+        BenchmarkPrint("Pool:       {:.1f} ns per pair ({:.2f}x), {} blocks", poolTime, heapTime / poolTime, bulletPool.GetCapacity() + particlePool.GetCapacity());
+
+        if (bulletPool.GetLiveCount() != 0 || particlePool.GetLiveCount() != 0)
+        {
+            BenchmarkPrint("{} pool blocks were not returned", bulletPool.GetLiveCount() + particlePool.GetLiveCount());
+            return false;
+        }
+
+#if defined(NOVA_MEMORY_TRACKING)
+        BenchmarkPrint("Scene tag allocations in a steady frame: {}", poolAllocations);
+        if (poolAllocations != 0)
+        {
+            BenchmarkPrint("The pools still allocate once warmed up");
+            return false;
+        }
+#else
+        BenchmarkPrint("Allocation counts need NOVA_ENGINE_MEMORY_TRACKING");
+#endif
+        return true;
+    }
+}
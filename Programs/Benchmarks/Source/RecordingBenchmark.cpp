@@ -0,0 +1,178 @@
+﻿#include "Benchmark.h"
+#include "Components/Transform.h"
+#include "Math/Matrix4.h"
+#include "Rendering/Buffer.h"
+#include "Rendering/RenderPass.h"
+#include "Rendering/Shader.h"
+#include "Rendering/ShaderEntryPoint.h"
+#include "Rendering/Null/RenderDevice.h"
+#include "Runtime/Application.h"
+#include "Runtime/Color.h"
+#include "Runtime/Component.h"
+#include "Runtime/Entity.h"
+#include "Runtime/Scene.h"
+#include "Runtime/ThreadPool.h"
+
+namespace Nova
+{
+    static constexpr uint32_t RecordingWarmupFrameCount = 10;
+    static constexpr uint32_t RecordingFrameCount = 200;
+
+    // Shared by every benchmark component, set while the benchmark runs
+    struct RecordingBenchmarkResources
+    {
+        Shader* shader = nullptr;
+        Buffer* vertexBuffer = nullptr;
+        Buffer* indexBuffer = nullptr;
+        Matrix4 viewProjection = Matrix4::Identity;
+    };
+
+    static RecordingBenchmarkResources s_RecordingResources;
+
+    // Records what a mesh renderer records for one draw: 7 commands and an MVP multiply
+    class RecordingBenchmarkComponent final : public Component
+    {
+    public:
+        explicit RecordingBenchmarkComponent(Entity* owner) : Component(owner, "Recording Benchmark") {}
+
+        void OnRender(CommandBuffer& cmdBuffer) override
+        {
+            const RecordingBenchmarkResources& resources = s_RecordingResources;
+            const Matrix4 mvp = resources.viewProjection * GetTransform()->GetWorldSpaceMatrix();
+            const Color color = Color::White;
+
+            cmdBuffer.SetViewport(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f);
+            cmdBuffer.SetScissor(0, 0, 1280, 720);
+            cmdBuffer.BindVertexBuffer(*resources.vertexBuffer, 0);
+            cmdBuffer.BindIndexBuffer(*resources.indexBuffer, 0, Format::R32_UINT);
+            cmdBuffer.PushConstants(*resources.shader, ShaderStageFlagBits::Vertex, 0, sizeof(Matrix4), &mvp);
+            cmdBuffer.PushConstants(*resources.shader, ShaderStageFlagBits::Fragment, sizeof(Matrix4), sizeof(Color), &color);
+            cmdBuffer.DrawIndexed(36, 1, 0, 0, 0);
+        }
+    };
+
+    struct RecordingResult
+    {
+        double inlineTime = 0.0;
+        double parallelTime = 0.0;
+        Null::CommandBufferStats inlineStats;
+        Null::CommandBufferStats parallelStats;
+    };
+
+    // Records the scene pass like Application does, inline or split into per thread secondary command buffers
+    static double RecordFrames(Null::RenderDevice& device, Scene& scene, const bool parallel, Null::CommandBufferStats& outStats)
+    {
+        RenderPassBeginInfo renderPass;
+        renderPass.renderArea = { 0, 0, Null::RenderDevice::DefaultWidth, Null::RenderDevice::DefaultHeight };
+        renderPass.contents = parallel ? RenderPassContents::SecondaryCommandBuffers : RenderPassContents::Inline;
+
+        double totalTime = 0.0;
+        Array<const CommandBuffer*> secondaryCmdBuffers;
+        for (uint32_t frame = 0; frame < RecordingWarmupFrameCount + RecordingFrameCount; ++frame)
+        {
+            if (!device.BeginFrame())
+                return 0.0;
+
+            CommandBuffer& cmdBuffer = *device.GetCurrentCommandBuffer();
+            const double start = Time::Get();
+            cmdBuffer.BeginRenderPass(renderPass);
+            if (parallel)
+            {
+                secondaryCmdBuffers.Clear();
+                scene.OnRender(renderPass, secondaryCmdBuffers);
+                cmdBuffer.ExecuteCommandBuffers(secondaryCmdBuffers);
+            }
+            else
+            {
+                scene.OnRender(cmdBuffer);
+            }
+            cmdBuffer.EndRenderPass();
+            const double elapsed = Time::Get() - start;
+
+            device.EndFrame();
+            device.Present();
+            if (frame >= RecordingWarmupFrameCount)
+                totalTime += elapsed;
+        }
+
+        outStats = device.GetLastFrameStats();
+        return totalTime * 1000.0 / RecordingFrameCount;
+    }
+
+    static RecordingResult RunRecording(Application& application, Null::RenderDevice& device, const uint32_t drawCount)
+    {
+        Scene scene(&application, "RecordingBenchmark");
+        scene.OnInit();
+        for (uint32_t i = 0; i < drawCount; ++i)
+        {
+            EntityHandle entity = scene.CreateEntity("Entity");
+            entity->GetTransform()->SetPosition(Vector3((float)(i % 100), (float)(i / 100), 0.0f));
+            entity->AddComponent<RecordingBenchmarkComponent>();
+        }
+
+        RecordingResult result;
+        result.inlineTime = RecordFrames(device, scene, false, result.inlineStats);
+        result.parallelTime = RecordFrames(device, scene, true, result.parallelStats);
+        scene.OnDestroy();
+        return result;
+    }
+
+    // Inline scene recording against Scene::OnRender with per thread secondary command buffers
+    NOVA_BENCHMARK(ParallelRecording)
+    {
+        ThreadPool& threadPool = application.GetThreadPool();
+        if (threadPool.GetThreadCount() > RenderDevice::MaxRecordingThreads)
+            return false;
+
+        Ref<Null::RenderDevice> device = MakeRef<Null::RenderDevice>();
+        if (!device->Initialize(RenderDeviceCreateInfo()))
+            return false;
+        RenderDevice& baseDevice = *device;
+
+        ShaderCreateInfo shaderCreateInfo;
+        shaderCreateInfo.device = device;
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultVertex());
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultFragment());
+        const Ref<Shader> shader = device->CreateShader(shaderCreateInfo);
+        const Ref<Buffer> vertexBuffer = baseDevice.CreateBuffer(BufferUsage::VertexBuffer, 1024);
+        const Ref<Buffer> indexBuffer = baseDevice.CreateBuffer(BufferUsage::IndexBuffer, 1024);
+        if (!shader || !vertexBuffer || !indexBuffer)
+            return false;
+
+        s_RecordingResources.shader = shader;
+        s_RecordingResources.vertexBuffer = vertexBuffer;
+        s_RecordingResources.indexBuffer = indexBuffer;
+
+        // Scenes record through the application's device, headless applications have none
+        Ref<RenderDevice>& applicationDevice = application.GetRenderDevice();
+        applicationDevice = device;
+
+        bool statsMatch = true;
+        BenchmarkPrint("{} worker threads, {} frames", threadPool.GetThreadCount(), RecordingFrameCount);
+        for (const uint32_t drawCount : { 10000u, 50000u })
+        {
+            const RecordingResult result = RunRecording(application, *device, drawCount);
+            BenchmarkPrint("{} draws: inline {:.3f} ms, parallel {:.3f} ms ({:.2f}x)",
+                drawCount, result.inlineTime, result.parallelTime, result.inlineTime / result.parallelTime);
+
+            const Null::CommandBufferStats& inlineStats = result.inlineStats;
+            const Null::CommandBufferStats& parallelStats = result.parallelStats;
+            statsMatch &= inlineStats.drawCount == drawCount
+                && parallelStats.drawCount == drawCount
+                && inlineStats.vertexCount == parallelStats.vertexCount
+                && inlineStats.pushConstantBytes == parallelStats.pushConstantBytes
+                && inlineStats.bufferBindCount == parallelStats.bufferBindCount;
+        }
+
+        applicationDevice = nullptr;
+        s_RecordingResources = RecordingBenchmarkResources();
+        device->Destroy();
+
+        if (!statsMatch)
+        {
+            BenchmarkPrint("Parallel recording does not record the same draws as inline recording");
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,123 @@
+﻿#include "Benchmark.h"
+#include "Math/Matrix4.h"
+#include "Rendering/Shader.h"
+#include "Rendering/ShaderEntryPoint.h"
+#include "Rendering/SpriteBatchRenderer.h"
+#include "Rendering/Texture.h"
+#include "Rendering/Null/RenderDevice.h"
+#include "Runtime/Color.h"
+
+namespace Nova
+{
+    static constexpr uint32_t SpriteCount = 200000;
+    static constexpr uint32_t SpriteTextureCount = 16;
+    static constexpr uint32_t SpriteWarmupFrameCount = 2;
+    static constexpr uint32_t SpriteFrameCount = 20;
+
+    static const char* GetSortModeName(const SpriteSortMode sortMode)
+    {
+        switch (sortMode)
+        {
+        case SpriteSortMode::None: return "None";
+        case SpriteSortMode::Texture: return "Texture";
+        case SpriteSortMode::BackToFront: return "BackToFront";
+        }
+        return "Unknown";
+    }
+
+    // DrawSprite and EndFrame cost for each sort mode, the instances go to a Null device buffer
+    NOVA_BENCHMARK(SpriteBatch)
+    {
+        Ref<Null::RenderDevice> device = MakeRef<Null::RenderDevice>();
+        if (!device->Initialize(RenderDeviceCreateInfo()))
+            return false;
+        RenderDevice& baseDevice = *device;
+
+        ShaderCreateInfo shaderCreateInfo;
+        shaderCreateInfo.device = device;
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultVertex());
+        shaderCreateInfo.entryPoints.Add(ShaderEntryPoint::DefaultFragment());
+        const Ref<Shader> shader = device->CreateShader(shaderCreateInfo);
+        if (!shader)
+            return false;
+
+        Array<Sprite> sprites;
+        for (uint32_t i = 0; i < SpriteTextureCount; ++i)
+        {
+            const Ref<Texture> texture = baseDevice.CreateTexture(TextureUsageFlagBits::Sampled, 256, 256, Format::R8G8B8A8_UNORM);
+            if (!texture)
+                return false;
+            sprites.Add(Sprite{ 0, 0, 256, 256, texture });
+        }
+
+        SpriteBatchRendererCreateInfo createInfo;
+        createInfo.device = device;
+        createInfo.shader = shader;
+        if (!SpriteBatchRenderer::Initialize(createInfo))
+            return false;
+
+        // A fixed pseudo random scene so every run draws the same sprites
+        Array<Matrix4> transforms(SpriteCount);
+        Array<uint32_t> spriteIndices((size_t)SpriteCount);
+        uint32_t state = 1;
+        const auto random = [&state]
+        {
+            state = state * 1664525u + 1013904223u;
+            return state >> 8;
+        };
+        const auto randomRange = [&random](const float range)
+        {
+            return ((float)random() / (float)(1u << 24) - 0.5f) * range;
+        };
+        for (uint32_t i = 0; i < SpriteCount; ++i)
+        {
+            const Vector3 position(randomRange(100.0f), randomRange(100.0f), randomRange(100.0f));
+            transforms[i] = Matrix4::TRS(position, Vector3(0.0f, 0.0f, randomRange(360.0f)), Vector3::One);
+            spriteIndices[i] = random() % SpriteTextureCount;
+        }
+
+        bool countsValid = true;
+        BenchmarkPrint("{} sprites, {} textures, {} frames", SpriteCount, SpriteTextureCount, SpriteFrameCount);
+        for (const SpriteSortMode sortMode : { SpriteSortMode::None, SpriteSortMode::Texture, SpriteSortMode::BackToFront })
+        {
+            SpriteBatchRenderer::SetSortMode(sortMode);
+
+            double drawTime = 0.0;
+            double endTime = 0.0;
+            for (uint32_t frame = 0; frame < SpriteWarmupFrameCount + SpriteFrameCount; ++frame)
+            {
+                if (!device->BeginFrame())
+                    return false;
+
+                const double start = Time::Get();
+                SpriteBatchRenderer::BeginFrame(Matrix4::Identity);
+                for (uint32_t i = 0; i < SpriteCount; ++i)
+                    SpriteBatchRenderer::DrawSprite(sprites[spriteIndices[i]], transforms[i], SpriteRendererFlagBits::None, Color::White, Vector2::One, Vector2::Zero, 100.0f);
+                const double drawEnd = Time::Get();
+                countsValid &= SpriteBatchRenderer::EndFrame(*device->GetCurrentCommandBuffer());
+                const double end = Time::Get();
+                countsValid &= SpriteBatchRenderer::GetSpriteCount() == SpriteCount;
+
+                device->EndFrame();
+                device->Present();
+                if (frame < SpriteWarmupFrameCount)
+                    continue;
+                drawTime += (drawEnd - start) * 1000.0 / SpriteFrameCount;
+                endTime += (end - drawEnd) * 1000.0 / SpriteFrameCount;
+            }
+
+            BenchmarkPrint("{}: DrawSprite {:.2f} ms, EndFrame {:.2f} ms", GetSortModeName(sortMode), drawTime, endTime);
+        }
+
+        SpriteBatchRenderer::Destroy();
+        sprites.Clear();
+        device->Destroy();
+
+        if (!countsValid)
+        {
+            BenchmarkPrint("The batch did not hold every sprite drawn in a frame");
+            return false;
+        }
+        return true;
+    }
+}
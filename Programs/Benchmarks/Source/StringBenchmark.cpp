@@ -0,0 +1,150 @@
+﻿#include "Benchmark.h"
+#include "Containers/Map.h"
+#include "Containers/String.h"
+#include "Runtime/Memory.h"
+
+namespace Nova
+{
+    static constexpr uint32_t StringIterationCount = 100000;
+    static constexpr uint32_t StringAppendCount = 100;
+    static constexpr uint32_t StringRunCount = 5;
+
+    static constexpr const char* ShortLiteral = "MainCamera";
+    static constexpr const char* LongLiteral = "Assets/Textures/Environment/SkyboxDiffuse.png";
+    static constexpr const char* LongPrefix = "Assets/Textures/Environment/";
+
+    struct StringCaseResult
+    {
+        double nanoseconds = 0.0;
+        double allocations = 0.0;
+    };
+
+    static size_t GetStringAllocationCount()
+    {
+#if defined(NOVA_MEMORY_TRACKING)
+        return Memory::GetTagStats(MemoryTag::Strings).totalAllocations;
+#else
+        return 0;
+#endif
+    }
+
+    // Runs the callable StringIterationCount times, the returned values are summed so the work is not optimized out
+    template<typename Callable>
+    static StringCaseResult MeasureStringCase(const StringView name, size_t& checksum, Callable&& callable)
+    {
+        StringCaseResult result;
+        const size_t allocationCount = GetStringAllocationCount();
+        const double best = MeasureBest(StringRunCount, [&]
+        {
+            for (uint32_t i = 0; i < StringIterationCount; ++i)
+                checksum += callable(i);
+        });
+        result.nanoseconds = best * 1e6 / StringIterationCount;
+        result.allocations = (double)(GetStringAllocationCount() - allocationCount) / ((double)StringIterationCount * StringRunCount);
+        BenchmarkPrint("{:<32} {:9.1f} ns {:8.2f} allocations", name, result.nanoseconds, result.allocations);
+        return result;
+    }
+
+    // Construction, growth and copies of short (inline) and long strings, and the StringView
+    // overloads against building a temporary String the way callers had to before
+    NOVA_BENCHMARK(StringOperations)
+    {
+        size_t checksum = 0;
+        bool passed = true;
+
+#if defined(NOVA_MEMORY_TRACKING)
+        const auto expectNoAllocation = [&](const StringView name, const StringCaseResult& result)
+        {
+            if (result.allocations == 0.0) return;
+            BenchmarkPrint("{} allocates", name);
+            passed = false;
+        };
+#else
+        const auto expectNoAllocation = [](const StringView, const StringCaseResult&) { };
+#endif
+
+        BenchmarkPrint("{} iterations per case, best of {} runs", StringIterationCount, StringRunCount);
+
+        const StringCaseResult shortLiteral = MeasureStringCase("Short literal", checksum, [](uint32_t)
+        {
+            const String string(ShortLiteral);
+            return string.Count();
+        });
+        expectNoAllocation("Short literal", shortLiteral);
+
+        MeasureStringCase("Long literal", checksum, [](uint32_t)
+        {
+            const String string(LongLiteral);
+            return string.Count();
+        });
+
+        MeasureStringCase("Append growth", checksum, [](uint32_t)
+        {
+            String string;
+            for (uint32_t i = 0; i < StringAppendCount; ++i)
+                string.Append("word ");
+            return string.Count();
+        });
+
+        const String shortSource(ShortLiteral);
+        const StringCaseResult shortCopy = MeasureStringCase("Short copy", checksum, [&](uint32_t)
+        {
+            const String copy(shortSource);
+            return copy.Count();
+        });
+        expectNoAllocation("Short copy", shortCopy);
+
+        const String longSource(LongLiteral);
+        MeasureStringCase("Long copy", checksum, [&](uint32_t)
+        {
+            const String copy(longSource);
+            return copy.Count();
+        });
+
+        const StringCaseResult compareView = MeasureStringCase("Compare, view", checksum, [&](uint32_t)
+        {
+            return (size_t)(longSource == LongLiteral);
+        });
+        expectNoAllocation("Compare, view", compareView);
+
+        MeasureStringCase("Compare, temporary", checksum, [&](uint32_t)
+        {
+            return (size_t)(longSource == String(LongLiteral));
+        });
+
+        const StringCaseResult prefixView = MeasureStringCase("StartsWith, view", checksum, [&](uint32_t)
+        {
+            return (size_t)longSource.StartsWith(LongPrefix);
+        });
+        expectNoAllocation("StartsWith, view", prefixView);
+
+        MeasureStringCase("StartsWith, temporary", checksum, [&](uint32_t)
+        {
+            return (size_t)longSource.StartsWith(String(LongPrefix));
+        });
+
+        // Asset lookups by name, the way AssetDatabase::Get searches its map
+        Map<String, uint32_t> assets;
+        for (uint32_t i = 0; i < 16; ++i)
+            assets[StringFormat("Assets/Textures/Environment/Texture{}.png", i)] = i;
+        assets[String(LongLiteral)] = 16;
+
+        const StringCaseResult lookupView = MeasureStringCase("Map lookup, view", checksum, [&](uint32_t)
+        {
+            return assets.FindKey(StringView(LongLiteral));
+        });
+        expectNoAllocation("Map lookup, view", lookupView);
+
+        MeasureStringCase("Map lookup, temporary", checksum, [&](uint32_t)
+        {
+            return assets.FindKey(String(LongLiteral));
+        });
+
+        BenchmarkPrint("Checksum {}", checksum);
+
+#if !defined(NOVA_MEMORY_TRACKING)
+        BenchmarkPrint("Allocation counts need NOVA_ENGINE_MEMORY_TRACKING");
+#endif
+        return passed;
+    }
+}